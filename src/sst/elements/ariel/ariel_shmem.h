@@ -27,6 +27,7 @@
  */
 
 #include <inttypes.h>
+#include <string.h>
 #include <string>
 #include <vector>
 #include <sys/time.h>
@@ -45,6 +46,37 @@
 
 #define ARIEL_MAX_PAYLOAD_SIZE 64
 
+/*
+ * Instruction and memory access records are packed into ARIEL_BATCH commands so
+ * that one tunnel slot carries many of them. Records are variable length, the
+ * first byte is the record type:
+ *
+ *   ARIEL_RECORD_START_INSTRUCTION  type, instClass (1B), simdElemCount (1B)
+ *   ARIEL_RECORD_END_INSTRUCTION    type
+ *   ARIEL_RECORD_NOOP               type
+ *   ARIEL_RECORD_READ               type, size (2B), addr (8B)
+ *   ARIEL_RECORD_WRITE              type, size (2B), addr (8B), payload
+ *
+ * A write carries min(size, ARIEL_MAX_PAYLOAD_SIZE) payload bytes only if
+ * ARIEL_RECORD_HAS_PAYLOAD is set in its type byte (writepayloadtrace is on).
+ * An instruction's records may continue into the next batch.
+ *
+ * ARIEL_BATCH_BYTES makes an ArielCommand exactly 512 bytes (8 cache lines).
+ */
+#define ARIEL_BATCH_BYTES 492
+
+#define ARIEL_RECORD_START_INSTRUCTION 1
+#define ARIEL_RECORD_END_INSTRUCTION   2
+#define ARIEL_RECORD_NOOP              3
+#define ARIEL_RECORD_READ              4
+#define ARIEL_RECORD_WRITE             5
+#define ARIEL_RECORD_TYPE_MASK         0x7F
+#define ARIEL_RECORD_HAS_PAYLOAD       0x80
+
+#define ARIEL_RECORD_INSTRUCTION_SIZE  3
+#define ARIEL_RECORD_MARKER_SIZE       1
+#define ARIEL_RECORD_ACCESS_SIZE       11
+
 namespace SST {
 namespace ArielComponent {
 
@@ -68,6 +100,7 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_RTL = 150,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_BATCH = 160,
 };
 
 #ifdef HAVE_CUDA
@@ -175,6 +208,11 @@ struct ArielCommand {
         struct {
             uint64_t vaddr;
         } flushline;
+        struct {
+            uint16_t records;
+            uint16_t bytes;
+            uint8_t  data[ARIEL_BATCH_BYTES];
+        } batch;
         struct {
             void* inp_ptr;
             void* ctrl_ptr;
@@ -193,6 +231,35 @@ struct ArielCommand {
     };
 };
 
+/*
+ * Helpers for building a batch, used by the frontend. Multi-byte fields are
+ * copied in host order, both ends of the tunnel are on the same machine.
+ */
+static inline void arielBatchReset(ArielCommand* ac) {
+    ac->command = ARIEL_BATCH;
+    ac->instPtr = 0;
+    ac->batch.records = 0;
+    ac->batch.bytes = 0;
+}
+
+static inline bool arielBatchFits(const ArielCommand* ac, uint32_t length) {
+    return (ac->batch.bytes + length) <= ARIEL_BATCH_BYTES;
+}
+
+/* Caller must check arielBatchFits first */
+static inline uint8_t* arielBatchAppend(ArielCommand* ac, uint32_t length) {
+    uint8_t* record = &ac->batch.data[ac->batch.bytes];
+    ac->batch.bytes += length;
+    ac->batch.records++;
+    return record;
+}
+
+static inline void arielRecordAccess(uint8_t* record, uint8_t type, uint16_t size, uint64_t addr) {
+    record[0] = type;
+    memcpy(&record[1], &size, sizeof(size));
+    memcpy(&record[3], &addr, sizeof(addr));
+}
+
 struct ArielSharedData {
     size_t numCores;
     uint64_t simTime;
@@ -0,0 +1,197 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+
+#include <climits>
+
+#include "arielchunkedtracegen.h"
+
+using namespace SST::ArielComponent;
+using namespace SST::Prospero;
+
+ArielChunkedTraceGenerator::ArielChunkedTraceGenerator(Params& params) :
+    ArielTraceGenerator(), traceFile(NULL), coreID(0), fileOffset(0), entriesWritten(0),
+    writeFailed(false), finished(false) {
+
+    tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
+    chunkEntries = params.find<uint32_t>("chunk_entries", 65536);
+    compressionLevel = params.find<int>("compression_level", 1);
+    maxPendingChunks = params.find<size_t>("max_pending_chunks", 4);
+
+    if(0 == chunkEntries) {
+        chunkEntries = 1;
+    }
+
+    if(0 == maxPendingChunks) {
+        maxPendingChunks = 1;
+    }
+}
+
+ArielChunkedTraceGenerator::~ArielChunkedTraceGenerator() {
+    if(NULL == traceFile) {
+        return;
+    }
+
+    if(encoder.entries() > 0) {
+        submitChunk();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pendingLock);
+        finished = true;
+    }
+    pendingChanged.notify_all();
+    compressor.join();
+
+    writeIndex();
+    fclose(traceFile);
+
+    if(writeFailed) {
+        fprintf(stderr, "ARIEL: error writing chunked trace for core %" PRIu32 ", the trace is incomplete\n", coreID);
+    }
+}
+
+void ArielChunkedTraceGenerator::publishEntry(const uint64_t picoS,
+        const uint64_t physAddr,
+        const uint32_t reqLength,
+        const ArielTraceEntryOperation op) {
+
+    if(NULL == traceFile) {
+        return;
+    }
+
+    encoder.append(picoS, physAddr, reqLength, WRITE == op);
+
+    if(encoder.entries() >= chunkEntries) {
+        submitChunk();
+    }
+}
+
+void ArielChunkedTraceGenerator::setCoreID(const uint32_t core) {
+    coreID = core;
+    size_t size = sizeof(char) * PATH_MAX;
+    char* tracePath = (char*) malloc(size);
+    snprintf(tracePath, size, "%s-%" PRIu32 ".trace.chk", tracePrefix.c_str(), core);
+
+    traceFile = fopen(tracePath, "wb");
+
+    if(NULL == traceFile) {
+        fprintf(stderr, "ARIEL: unable to open chunked trace file %s, tracing is disabled for core %" PRIu32 "\n", tracePath, core);
+        free(tracePath);
+        return;
+    }
+
+    free(tracePath);
+
+    uint8_t header[PROSPERO_CHUNK_HEADER_BYTES];
+    memcpy(&header[0], PROSPERO_CHUNK_FILE_MAGIC, PROSPERO_CHUNK_MAGIC_LENGTH);
+    prosperoPutLE(&header[PROSPERO_CHUNK_MAGIC_LENGTH], PROSPERO_CHUNK_VERSION, 4);
+    prosperoPutLE(&header[PROSPERO_CHUNK_MAGIC_LENGTH + 4], PROSPERO_CHUNK_CODEC_ZLIB, 4);
+    prosperoPutLE(&header[PROSPERO_CHUNK_MAGIC_LENGTH + 8], chunkEntries, 4);
+
+    writeFailed = fwrite(header, 1, sizeof(header), traceFile) != sizeof(header);
+    fileOffset = sizeof(header);
+
+    compressor = std::thread(&ArielChunkedTraceGenerator::compressLoop, this);
+}
+
+// Hand the current chunk to the compression thread, waiting if it is too far behind
+void ArielChunkedTraceGenerator::submitChunk() {
+    std::unique_lock<std::mutex> lock(pendingLock);
+    pendingChanged.wait(lock, [this] { return pending.size() < maxPendingChunks; });
+
+    pending.push_back(PendingChunk());
+    pending.back().raw.swap(encoder.data());
+    pending.back().entries = encoder.entries();
+    pending.back().firstCycle = encoder.getFirstCycle();
+
+    lock.unlock();
+    pendingChanged.notify_all();
+
+    encoder.reset();
+}
+
+void ArielChunkedTraceGenerator::compressLoop() {
+    std::unique_lock<std::mutex> lock(pendingLock);
+
+    while(true) {
+        pendingChanged.wait(lock, [this] { return finished || !pending.empty(); });
+
+        if(pending.empty()) {
+            return;
+        }
+
+        // Chunks leave the queue in order so the file is written in order
+        PendingChunk chunk;
+        chunk.raw.swap(pending.front().raw);
+        chunk.entries = pending.front().entries;
+        chunk.firstCycle = pending.front().firstCycle;
+
+        lock.unlock();
+        writeChunk(chunk.raw, chunk.entries, chunk.firstCycle);
+        lock.lock();
+
+        pending.pop_front();
+        pendingChanged.notify_all();
+    }
+}
+
+void ArielChunkedTraceGenerator::writeChunk(std::vector<uint8_t>& raw, const uint32_t entries, const uint64_t firstCycle) {
+    if(writeFailed) {
+        return;
+    }
+
+    if(!prosperoCompressChunk(raw, compressed, compressionLevel)) {
+        writeFailed = true;
+        return;
+    }
+
+    ProsperoChunkIndexEntry entry;
+    entry.offset = fileOffset;
+    entry.firstEntry = entriesWritten;
+    entry.firstCycle = firstCycle;
+    entry.compressedBytes = (uint32_t) compressed.size();
+    entry.rawBytes = (uint32_t) raw.size();
+    entry.entries = entries;
+
+    if(fwrite(&compressed[0], 1, compressed.size(), traceFile) != compressed.size()) {
+        writeFailed = true;
+        return;
+    }
+
+    chunkIndex.push_back(entry);
+    fileOffset += compressed.size();
+    entriesWritten += entries;
+}
+
+void ArielChunkedTraceGenerator::writeIndex() {
+    if(writeFailed) {
+        return;
+    }
+
+    std::vector<uint8_t> index(chunkIndex.size() * PROSPERO_CHUNK_INDEX_ENTRY_BYTES + PROSPERO_CHUNK_TRAILER_BYTES);
+
+    for(size_t i = 0; i < chunkIndex.size(); ++i) {
+        prosperoPackIndexEntry(&index[i * PROSPERO_CHUNK_INDEX_ENTRY_BYTES], chunkIndex[i]);
+    }
+
+    uint8_t* trailer = &index[chunkIndex.size() * PROSPERO_CHUNK_INDEX_ENTRY_BYTES];
+    prosperoPutLE(&trailer[0], fileOffset, 8);
+    prosperoPutLE(&trailer[8], chunkIndex.size(), 8);
+    prosperoPutLE(&trailer[16], entriesWritten, 8);
+    memcpy(&trailer[24], PROSPERO_CHUNK_INDEX_MAGIC, PROSPERO_CHUNK_MAGIC_LENGTH);
+
+    writeFailed = fwrite(&index[0], 1, index.size(), traceFile) != index.size();
+}
@@ -0,0 +1,105 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_CHUNKED_TRACE_GEN
+#define _H_SST_ARIEL_CHUNKED_TRACE_GEN
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <sst/core/params.h>
+#include "arieltracegen.h"
+#include "../prospero/prostracechunk.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Writes the chunked, indexed trace format described in
+ * prospero/prostracechunk.h. Entries are delta encoded into a chunk as they
+ * arrive; full chunks are compressed and written by a background thread so
+ * the simulation only pays for the encoding.
+ */
+class ArielChunkedTraceGenerator : public ArielTraceGenerator {
+
+    public:
+
+        SST_ELI_REGISTER_MODULE(
+            SST::ArielComponent::ArielChunkedTraceGenerator,
+            "ariel",
+            "ChunkedTraceGenerator",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Provides tracing to a chunked, compressed and indexed file (read by prospero.ProsperoChunkedTraceReader)",
+            SST::ArielComponent::ArielTraceGenerator
+        )
+
+        SST_ELI_DOCUMENT_PARAMS(
+            { "trace_prefix", "Sets the prefix for the trace file", "ariel-core" },
+            { "chunk_entries", "Number of trace entries in each compressed chunk", "65536" },
+            { "compression_level", "zlib compression level, 1 (fastest) to 9 (smallest)", "1" },
+            { "max_pending_chunks", "Number of chunks which may wait for the compression thread before tracing blocks", "4" }
+        )
+
+        ArielChunkedTraceGenerator(Params& params);
+
+        ~ArielChunkedTraceGenerator();
+
+        void publishEntry(const uint64_t picoS, const uint64_t physAddr,
+                const uint32_t reqLength, const ArielTraceEntryOperation op);
+
+        void setCoreID(const uint32_t core);
+
+    private:
+        void submitChunk();
+        void compressLoop();
+        void writeChunk(std::vector<uint8_t>& raw, const uint32_t entries, const uint64_t firstCycle);
+        void writeIndex();
+
+        struct PendingChunk {
+            std::vector<uint8_t> raw;
+            uint32_t entries;
+            uint64_t firstCycle;
+        };
+
+        FILE* traceFile;
+        std::string tracePrefix;
+        uint32_t coreID;
+        uint32_t chunkEntries;
+        int compressionLevel;
+        size_t maxPendingChunks;
+
+        SST::Prospero::ProsperoChunkEncoder encoder;
+
+        // Owned by the compression thread once it is running
+        std::vector<SST::Prospero::ProsperoChunkIndexEntry> chunkIndex;
+        std::vector<uint8_t> compressed;
+        uint64_t fileOffset;
+        uint64_t entriesWritten;
+        bool writeFailed;
+
+        std::thread compressor;
+        std::mutex pendingLock;
+        std::condition_variable pendingChanged;
+        std::deque<PendingChunk> pending;
+        bool finished;
+};
+
+}
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <exception>
 #include <stdexcept>
+#include <cstdarg>
 
 #ifdef HAVE_CUDA
 #include <../balar/balar_event.h>
@@ -29,6 +30,9 @@ using namespace SST::ArielComponent;
 
 #define ARIEL_CORE_VERBOSE(LEVEL, OUTPUT) if(verbosity >= (LEVEL)) OUTPUT
 
+// Decoding may run on a tunnel reader thread, which must leave the Output to the simulation thread
+#define ARIEL_DECODE_VERBOSE(LEVEL, OUTPUT) if(NULL == eventRing && verbosity >= (LEVEL)) OUTPUT
+
 
 ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
 #ifdef HAVE_CUDA
@@ -53,6 +57,10 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     isHalted = false;
     isStalled = false;
     isFenced = false;
+    inBatchedInstruction = false;
+    inTunnelInstruction = false;
+    eventRing = NULL;
+    decodeFailed = false;
     maxIssuePerCycle = maxIssuePerCyc;
     maxQLength = maxQLen;
     cacheLineSize = cacheLineSz;
@@ -138,6 +146,11 @@ ArielCore::~ArielCore() {
     }
 
     delete stdMemHandlers;
+
+    // Whatever the reader thread decoded but could not hand over before it was stopped
+    for(std::deque<ArielDecodedEntry>::iterator it = stagedEntries.begin(); it != stagedEntries.end(); ++it) {
+        delete it->event;
+    }
 }
 
 void ArielCore::setCacheLink(StandardMem* newLink) {
@@ -364,7 +377,7 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                     }
 
                     ArielWriteEvent* awe;
-                    awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
+                    awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index], current_transfer);
                     handleWriteRequest(awe);
                     setCurrentAddress(getCurrentAddress() + current_transfer);
                     setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
@@ -579,7 +592,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
     uint64_t addr_offset;
     uint64_t current_transfer;
     current_transfer = (getRemainingTransfer() > 64) ? 64 : getRemainingTransfer();
-    phy_addr = memmgr->translateAddress(getCurrentAddress());
+    phy_addr = memmgr->translateCoreAddress(coreID, getCurrentAddress());
     addr_offset = phy_addr % ((uint64_t) cacheLineSize);
     if((addr_offset + current_transfer <= cacheLineSize)){
         physicalAddresses.push_back(phy_addr);
@@ -589,7 +602,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
         uint64_t rightAddr = (getCurrentAddress() + ((uint64_t) cacheLineSize)) - addr_offset;
         uint64_t rightSize = current_transfer - leftSize;
         uint64_t physLeftAddr = phy_addr;
-        uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        uint64_t physRightAddr = memmgr->translateCoreAddress(coreID, rightAddr);
         physicalAddresses.push_back(physLeftAddr);
     }
 }
@@ -665,74 +678,74 @@ void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
 
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
     ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
-    coreQ->push(ev);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
 void ArielCore::createNoOpEvent() {
     ArielNoOpEvent* ev = new ArielNoOpEvent();
-    coreQ->push(ev);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
     ArielReadEvent* ev = new ArielReadEvent(address, length);
-    coreQ->push(ev);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
     ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
+    ARIEL_DECODE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
     ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
+    ARIEL_DECODE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
     ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
-    coreQ->push(ev);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
+    ARIEL_DECODE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
-void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
-    coreQ->push(ev);
+void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload, uint32_t payloadLength) {
+    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload, payloadLength);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
     ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
-    coreQ->push(ev);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
 }
 
 void ArielCore::createFenceEvent(){
     ArielFenceEvent *ev = new ArielFenceEvent();
-    coreQ->push(ev);
+    queueEvent(ev);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
 }
 
 void ArielCore::createExitEvent() {
     ArielExitEvent* xEv = new ArielExitEvent();
-    coreQ->push(xEv);
+    queueEvent(xEv);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
 }
 
 bool ArielCore::isCoreHalted() const {
@@ -751,17 +764,17 @@ void ArielCore::createRtlEvent(void* inp_ptr, void* ctrl_ptr, void* updated_para
     Ev->set_rtl_inp_size(inp_size);
     Ev->set_rtl_ctrl_size(ctrl_size);
     Ev->set_updated_rtl_params_size(updated_rtl_params_size);
-    coreQ->push(Ev);
+    queueEvent(Ev);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a RTL event.\n"));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a RTL event.\n"));
 }
 
 #ifdef HAVE_CUDA
 void ArielCore::createGpuEvent(GpuApi_t API, CudaArguments CA) {
     ArielGpuEvent* gEv = new ArielGpuEvent(API, CA);
-    coreQ->push(gEv);
+    queueEvent(gEv);
 
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a CUDA event.\n"));
+    ARIEL_DECODE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a CUDA event.\n"));
 }
 
 cudaMemcpyKind ArielCore::getKind() const {
@@ -837,6 +850,10 @@ bool ArielCore::hasDrainCompleted() const {
 bool ArielCore::refillQueue() {
     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 "...\n", coreID));
 
+    if(NULL != eventRing) {
+        return refillQueueFromRing();
+    }
+
     while(coreQ->size() < maxQLength) {
         ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Attempting to fill events for core: %" PRIu32 " current queue size=%" PRIu32 ", max length=%" PRIu32 "\n",
                             coreID, (uint32_t) coreQ->size(), (uint32_t) maxQLength));
@@ -851,115 +868,348 @@ bool ArielCore::refillQueue() {
 
         ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel reads data on core: %" PRIu32 "\n", coreID));
 
-        // There is data on the pipe
-        switch(ac.command) {
-            case ARIEL_OUTPUT_STATS:
+        // Wait for the rest of an instruction so that all of its events are queued together
+        while(decodeCommand(ac)) {
+            ac = tunnel->readMessage(coreID);
+        }
+    }
+
+    ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 " is complete\n", coreID));
+    return true;
+}
+
+/*
+ * Same as reading the tunnel directly, but the commands have already been
+ * decoded by a reader thread.
+ */
+bool ArielCore::refillQueueFromRing() {
+    if(decodeFailed.load(std::memory_order_acquire)) {
+        output->fatal(CALL_INFO, -1, "%s", decodeErrorMessage.c_str());
+    }
+
+    while(coreQ->size() < maxQLength) {
+        ArielDecodedEntry entry;
+
+        if( !eventRing->pop(entry) ) {
+                ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Reader has no decoded events for core: %" PRIu32 "\n", coreID));
+                return false;
+        }
+
+        switch(entry.kind) {
+            case DECODED_EVENT:
+                coreQ->push(entry.event);
+                break;
+
+            case DECODED_INSTRUCTION:
+                updateInstructionStats(entry.instClass, entry.simdElemCount);
+                break;
+
+            case DECODED_OUTPUT_STATS:
                 fprintf(stdout, "Performing statistics output at simulation time = %" PRIu64 " cycles\n", getCurrentSimTimeNano());
                 performGlobalStatisticOutput();
                 break;
+        }
+    }
 
-            case ARIEL_START_INSTRUCTION:
-                if(ARIEL_INST_SP_FP == ac.inst.instClass) {
-                        statFPSPIns->addData(1);
+    return true;
+}
 
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPSPSIMDIns->addData(1);
-                        } else {
-                            statFPSPScalarIns->addData(1);
-                        }
+/*
+ * Called from the reader thread. Decodes at most one command for this core
+ * and hands its entries to the core's ring, holding back whatever does not
+ * fit. Never waits on the tunnel, an instruction split over several commands
+ * is resumed on the next call. Returns true if anything was passed on.
+ */
+bool ArielCore::decodeAhead() {
+    bool progress = flushStagedEntries();
 
-                        if(ac.inst.simdElemCount < 32)
-                            statFPSPOps->addData(ac.inst.simdElemCount);
-                } else if(ARIEL_INST_DP_FP == ac.inst.instClass) {
-                        statFPDPIns->addData(1);
+    if(decodeFailed.load(std::memory_order_relaxed)) {
+        return progress;
+    }
 
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPDPSIMDIns->addData(1);
-                        } else {
-                            statFPDPScalarIns->addData(1);
-                        }
+    // Only read past entries the ring could not take to finish an instruction
+    if(!stagedEntries.empty() && !inBatchedInstruction && !inTunnelInstruction) {
+        return progress;
+    }
 
-                        if(ac.inst.simdElemCount < 16)
-                            statFPDPOps->addData(ac.inst.simdElemCount);
-                }
+    ArielCommand ac;
+    if(!tunnel->readMessageNB(coreID, &ac)) {
+        return progress;
+    }
 
-                while(ac.command != ARIEL_END_INSTRUCTION) {
-                        ac = tunnel->readMessage(coreID);
+    decodeCommand(ac);
+    flushStagedEntries();
 
-                        switch(ac.command) {
-                            case ARIEL_PERFORM_READ:
-                                    createReadEvent(ac.inst.addr, ac.inst.size);
-                                    break;
+    return true;
+}
 
-                            case ARIEL_PERFORM_WRITE:
-                                    createWriteEvent(ac.inst.addr, ac.inst.size, &ac.inst.payload[0]);
-                                    break;
+/*
+ * Pass staged entries on to the ring. The entries of an instruction are
+ * held back until its last command has been decoded.
+ */
+bool ArielCore::flushStagedEntries() {
+    bool progress = false;
 
-                            case ARIEL_END_INSTRUCTION:
-                                    break;
+    if(inBatchedInstruction || inTunnelInstruction) {
+        return progress;
+    }
 
-                            default:
-                                    // Not sure what this is
-                                    output->fatal(CALL_INFO, -1, "Error: Ariel did not understand command (%d) provided during instruction queue refill.\n", (int)(ac.command));
-                                    break;
-                        }
-                }
+    while(!stagedEntries.empty() && eventRing->push(stagedEntries.front())) {
+        stagedEntries.pop_front();
+        progress = true;
+    }
 
-                // Add one to our instruction counts
-                //statInstructionCount->addData(1);
+    return progress;
+}
 
-                break;
+/*
+ * Report a malformed command. Without a reader thread this is fatal right
+ * away, otherwise the core reports it from its next tick.
+ */
+void ArielCore::decodeError(const char* format, ...) {
+    char message[512];
 
-            case ARIEL_NOOP:
-                createNoOpEvent();
-                break;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
 
-            case ARIEL_FLUSHLINE_INSTRUCTION:
-                createFlushEvent(ac.flushline.vaddr);
-                break;
+    inBatchedInstruction = false;
+    inTunnelInstruction = false;
+
+    if(NULL == eventRing) {
+        output->fatal(CALL_INFO, -1, "%s", message);
+    }
 
-            case ARIEL_FENCE_INSTRUCTION:
-                createFenceEvent();
+    decodeErrorMessage = message;
+    decodeFailed.store(true, std::memory_order_release);
+}
+
+/*
+ * Decode one command from the tunnel. Returns true while an instruction is
+ * unfinished, the following command(s) for this core complete it.
+ */
+bool ArielCore::decodeCommand(const ArielCommand& ac) {
+    if(inBatchedInstruction) {
+        // An instruction whose records run past the end of the batch is finished
+        // from the following batch(es)
+        if(ac.command != ARIEL_BATCH) {
+            decodeError("Error: Ariel expected the rest of an instruction in a batch but received command (%d) during instruction queue refill.\n", (int)(ac.command));
+            return false;
+        }
+
+        return decodeBatch(ac);
+    }
+
+    if(inTunnelInstruction) {
+        switch(ac.command) {
+            case ARIEL_PERFORM_READ:
+                createReadEvent(ac.inst.addr, ac.inst.size);
                 break;
 
-            case ARIEL_ISSUE_TLM_MMAP:
-                createMmapEvent(ac.mlm_mmap.fileID, ac.mlm_mmap.vaddr, ac.mlm_mmap.alloc_len, ac.mlm_mmap.alloc_level, ac.instPtr);
+            case ARIEL_PERFORM_WRITE:
+                createWriteEvent(ac.inst.addr, ac.inst.size, &ac.inst.payload[0], std::min(ac.inst.size, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE));
                 break;
 
-            case ARIEL_ISSUE_TLM_MAP:
-                createAllocateEvent(ac.mlm_map.vaddr, ac.mlm_map.alloc_len, ac.mlm_map.alloc_level, ac.instPtr);
+            case ARIEL_END_INSTRUCTION:
+                inTunnelInstruction = false;
                 break;
 
-            case ARIEL_ISSUE_TLM_FREE:
-                createFreeEvent(ac.mlm_free.vaddr);
+            default:
+                // Not sure what this is
+                decodeError("Error: Ariel did not understand command (%d) provided during instruction queue refill.\n", (int)(ac.command));
                 break;
+        }
+
+        return inTunnelInstruction;
+    }
+
+    switch(ac.command) {
+        case ARIEL_OUTPUT_STATS:
+            queueStatisticsOutput();
+            break;
+
+        case ARIEL_BATCH:
+            return decodeBatch(ac);
+
+        case ARIEL_START_INSTRUCTION:
+            queueInstruction(ac.inst.instClass, ac.inst.simdElemCount);
+            inTunnelInstruction = true;
+            return true;
+
+        case ARIEL_NOOP:
+            createNoOpEvent();
+            break;
 
-            case ARIEL_SWITCH_POOL:
-                createSwitchPoolEvent(ac.switchPool.pool);
+        case ARIEL_FLUSHLINE_INSTRUCTION:
+            createFlushEvent(ac.flushline.vaddr);
+            break;
+
+        case ARIEL_FENCE_INSTRUCTION:
+            createFenceEvent();
+            break;
+
+        case ARIEL_ISSUE_TLM_MMAP:
+            createMmapEvent(ac.mlm_mmap.fileID, ac.mlm_mmap.vaddr, ac.mlm_mmap.alloc_len, ac.mlm_mmap.alloc_level, ac.instPtr);
+            break;
+
+        case ARIEL_ISSUE_TLM_MAP:
+            createAllocateEvent(ac.mlm_map.vaddr, ac.mlm_map.alloc_len, ac.mlm_map.alloc_level, ac.instPtr);
+            break;
+
+        case ARIEL_ISSUE_TLM_FREE:
+            createFreeEvent(ac.mlm_free.vaddr);
+            break;
+
+        case ARIEL_SWITCH_POOL:
+            createSwitchPoolEvent(ac.switchPool.pool);
+            break;
+
+        case ARIEL_PERFORM_EXIT:
+            createExitEvent();
+            break;
+#ifdef HAVE_CUDA
+        case ARIEL_ISSUE_CUDA:
+            createGpuEvent(ac.API.name, ac.API.CA);
+            break;
+#endif
+
+        case ARIEL_ISSUE_RTL: 
+            createRtlEvent(ac.shmem.inp_ptr, ac.shmem.ctrl_ptr, ac.shmem.updated_rtl_params, ac.shmem.inp_size, ac.shmem.ctrl_size, ac.shmem.updated_rtl_params_size); 
+            break;
+
+        default:
+            // Not sure what this is
+            decodeError("Error: Ariel did not understand command (%d) provided during instruction queue refill.\n", (int)(ac.command));
+            break;
+    }
+
+    return false;
+}
+
+void ArielCore::queueEvent(ArielEvent* ev) {
+    if(NULL == eventRing) {
+        coreQ->push(ev);
+    } else {
+        ArielDecodedEntry entry;
+        entry.event = ev;
+        stagedEntries.push_back(entry);
+    }
+}
+
+void ArielCore::queueInstruction(uint32_t instClass, uint32_t simdElemCount) {
+    if(NULL == eventRing) {
+        updateInstructionStats(instClass, simdElemCount);
+    } else {
+        ArielDecodedEntry entry;
+        entry.kind = DECODED_INSTRUCTION;
+        entry.instClass = instClass;
+        entry.simdElemCount = simdElemCount;
+        stagedEntries.push_back(entry);
+    }
+}
+
+void ArielCore::queueStatisticsOutput() {
+    if(NULL == eventRing) {
+        fprintf(stdout, "Performing statistics output at simulation time = %" PRIu64 " cycles\n", getCurrentSimTimeNano());
+        performGlobalStatisticOutput();
+    } else {
+        ArielDecodedEntry entry;
+        entry.kind = DECODED_OUTPUT_STATS;
+        stagedEntries.push_back(entry);
+    }
+}
+
+/*
+ * Queue the events for every record in a batch. Returns true if the batch ends
+ * part way through an instruction (between its start and end records).
+ */
+bool ArielCore::decodeBatch(const ArielCommand& ac) {
+    const uint8_t* record = &ac.batch.data[0];
+    const uint8_t* end    = &ac.batch.data[ac.batch.bytes];
+
+    if(ac.batch.bytes > ARIEL_BATCH_BYTES) {
+        decodeError("Error: Ariel received a batch of %" PRIu16 " bytes, the limit is %d.\n", ac.batch.bytes, ARIEL_BATCH_BYTES);
+        return false;
+    }
+
+    ARIEL_DECODE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Core %" PRIu32 " decoding a batch of %" PRIu16 " records (%" PRIu16 " bytes)\n",
+                        coreID, ac.batch.records, ac.batch.bytes));
+
+    while(record < end) {
+        switch(record[0] & ARIEL_RECORD_TYPE_MASK) {
+            case ARIEL_RECORD_START_INSTRUCTION:
+                queueInstruction(record[1], record[2]);
+                inBatchedInstruction = true;
+                record += ARIEL_RECORD_INSTRUCTION_SIZE;
                 break;
 
-            case ARIEL_PERFORM_EXIT:
-                createExitEvent();
+            case ARIEL_RECORD_END_INSTRUCTION:
+                inBatchedInstruction = false;
+                record += ARIEL_RECORD_MARKER_SIZE;
                 break;
-#ifdef HAVE_CUDA
-            case ARIEL_ISSUE_CUDA:
-                createGpuEvent(ac.API.name, ac.API.CA);
+
+            case ARIEL_RECORD_NOOP:
+                createNoOpEvent();
+                record += ARIEL_RECORD_MARKER_SIZE;
                 break;
-#endif
 
-            case ARIEL_ISSUE_RTL: 
-                createRtlEvent(ac.shmem.inp_ptr, ac.shmem.ctrl_ptr, ac.shmem.updated_rtl_params, ac.shmem.inp_size, ac.shmem.ctrl_size, ac.shmem.updated_rtl_params_size); 
+            case ARIEL_RECORD_READ:
+            case ARIEL_RECORD_WRITE:
+                {
+                    uint16_t size;
+                    uint64_t addr;
+                    memcpy(&size, &record[1], sizeof(size));
+                    memcpy(&addr, &record[3], sizeof(addr));
+
+                    if(ARIEL_RECORD_READ == (record[0] & ARIEL_RECORD_TYPE_MASK)) {
+                        createReadEvent(addr, size);
+                        record += ARIEL_RECORD_ACCESS_SIZE;
+                    } else if(record[0] & ARIEL_RECORD_HAS_PAYLOAD) {
+                        const uint32_t payloadLength = std::min((uint32_t) size, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE);
+                        createWriteEvent(addr, size, &record[ARIEL_RECORD_ACCESS_SIZE], payloadLength);
+                        record += ARIEL_RECORD_ACCESS_SIZE + payloadLength;
+                    } else {
+                        createWriteEvent(addr, size, NULL, 0);
+                        record += ARIEL_RECORD_ACCESS_SIZE;
+                    }
+                }
                 break;
 
             default:
-                // Not sure what this is
-                output->fatal(CALL_INFO, -1, "Error: Ariel did not understand command (%d) provided during instruction queue refill.\n", (int)(ac.command));
-                break;
+                decodeError("Error: Ariel did not understand record type (%d) at offset %d of a batch.\n",
+                        (int)(record[0]), (int)(record - &ac.batch.data[0]));
+                return false;
         }
     }
 
-    ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 " is complete\n", coreID));
-    return true;
+    return inBatchedInstruction;
+}
+
+void ArielCore::updateInstructionStats(uint32_t instClass, uint32_t simdElemCount) {
+    if(ARIEL_INST_SP_FP == instClass) {
+            statFPSPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPSPSIMDIns->addData(1);
+            } else {
+                statFPSPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 32)
+                statFPSPOps->addData(simdElemCount);
+    } else if(ARIEL_INST_DP_FP == instClass) {
+            statFPDPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPDPSIMDIns->addData(1);
+            } else {
+                statFPDPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 16)
+                statFPDPOps->addData(simdElemCount);
+    }
 }
 
 void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
@@ -985,7 +1235,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     // There is a chance that the non-alignment causes an undetected bug if an access spans multiple malloc regions that are contiguous in VA space but non-contiguous in PA space.
     // However, a single access spanning multiple malloc'd regions shouldn't happen...
     // Addresses mapped via first touch are always line/page aligned
-    const uint64_t physAddr = memmgr->translateAddress(readAddress);
+    const uint64_t physAddr = memmgr->translateCoreAddress(coreID, readAddress);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     if((addr_offset + readLength) <= cacheLineSize) {
@@ -1010,7 +1260,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
         const uint64_t rightSize = readLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = memmgr->translateCoreAddress(coreID, rightAddr);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address read, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1056,7 +1306,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
     }*/
 
     // See note in handleReadRequest() on alignment issues
-    const uint64_t physAddr = memmgr->translateAddress(writeAddress);
+    const uint64_t physAddr = memmgr->translateCoreAddress(coreID, writeAddress);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     // We do not need to perform a split operation
@@ -1093,7 +1343,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         const uint64_t rightSize = writeLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = memmgr->translateCoreAddress(coreID, rightAddr);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address write, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1148,7 +1398,7 @@ void ArielCore::handleFlushEvent(ArielFlushEvent *flEv) {
     const uint64_t virtualAddress = (uint64_t) flEv->getVirtualAddress();
     const uint64_t readLength = (uint64_t) flEv->getLength();
 
-    const uint64_t physAddr = memmgr->translateAddress(virtualAddress);
+    const uint64_t physAddr = memmgr->translateCoreAddress(coreID, virtualAddress);
     commitFlushEvent(physAddr, virtualAddress, (uint32_t) readLength);
 }
 
@@ -1235,7 +1485,7 @@ void ArielCore::handleGpuEvent(ArielGpuEvent* gEv){
                             }
 
                             ArielWriteEvent* awe;
-                            awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
+                            awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index], current_transfer);
                             handleWriteRequest(awe);
                             setCurrentAddress(getCurrentAddress() + current_transfer);
                             setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
@@ -31,6 +31,7 @@
 #include <stdint.h>
 #include <poll.h>
 
+#include <atomic>
 #include <string>
 #include <queue>
 #include <unordered_map>
@@ -51,6 +52,7 @@
 
 #include "ariel_shmem.h"
 #include "arieltracegen.h"
+#include "arieltunnelreader.h"
 
 #ifdef HAVE_CUDA
 #include "arielgpuev.h"
@@ -117,7 +119,7 @@ class ArielCore : public ComponentExtension {
         void unfence();
         void finishCore();
         void createReadEvent(uint64_t addr, uint32_t size);
-        void createWriteEvent(uint64_t addr, uint32_t size, const uint8_t* payload);
+        void createWriteEvent(uint64_t addr, uint32_t size, const uint8_t* payload, uint32_t payloadLength);
         void createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t ip);
         void createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr);
         void createNoOpEvent();
@@ -191,9 +193,24 @@ class ArielCore : public ComponentExtension {
         void printCoreStatistics();
         void printTraceEntry(const bool isRead, const uint64_t address, const uint32_t length);
 
+        // Used when a tunnel reader thread decodes for this core
+        void setEventRing(ArielEventRing* ring) { eventRing = ring; }
+        bool decodeAhead();
+
     private:
         bool processNextEvent();
         bool refillQueue();
+        bool refillQueueFromRing();
+        bool decodeCommand(const ArielCommand& ac);
+        bool decodeBatch(const ArielCommand& ac);
+        void decodeError(const char* format, ...);
+        bool flushStagedEntries();
+        void queueEvent(ArielEvent* ev);
+        void queueInstruction(uint32_t instClass, uint32_t simdElemCount);
+        void queueStatisticsOutput();
+        void updateInstructionStats(uint32_t instClass, uint32_t simdElemCount);
+        bool inBatchedInstruction;
+        bool inTunnelInstruction;
         bool writePayloads;
         uint32_t coreID;
         uint32_t maxPendingTransactions;
@@ -218,6 +235,13 @@ class ArielCore : public ComponentExtension {
 
         Output* output;
         std::queue<ArielEvent*>* coreQ;
+
+        // Only set when a reader thread decodes the tunnel, the staged entries are owned by that thread.
+        // A decode error on the reader thread is kept here and reported on the next tick.
+        ArielEventRing* eventRing;
+        std::deque<ArielDecodedEntry> stagedEntries;
+        std::atomic<bool> decodeFailed;
+        std::string decodeErrorMessage;
         bool isStalled;
         bool isHalted;
         bool isFenced;
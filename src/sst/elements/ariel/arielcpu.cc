@@ -26,6 +26,8 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 using namespace SST::ArielComponent;
 
 ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
@@ -238,6 +240,18 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
     }
 
 
+    tunnelReader = NULL;
+    uint32_t readerThreads = (uint32_t) params.find<uint32_t>("tunnel_reader_threads", 0);
+    if (readerThreads > 0) {
+        uint32_t readerQueue = (uint32_t) params.find<uint32_t>("tunnel_reader_queue", 4096);
+        if (readerQueue == 0) {
+            output->fatal(CALL_INFO, -1, "%s, Error: tunnel_reader_queue must be at least 1.\n", getName().c_str());
+        }
+        tunnelReader = new ArielTunnelReader(cpu_cores, readerThreads, readerQueue);
+        output->verbose(CALL_INFO, 1, 0, "Tunnel will be read by %" PRIu32 " threads, %" PRIu32 " entries per core\n",
+                std::min(readerThreads, core_count), readerQueue);
+    }
+
     // Register us as an important component
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -257,7 +271,17 @@ void ArielCPU::init(unsigned int phase)
     }
 }
 
+void ArielCPU::setup() {
+    if (tunnelReader) {
+        tunnelReader->start();
+    }
+}
+
 void ArielCPU::finish() {
+    if (tunnelReader) {
+        tunnelReader->stop();
+    }
+
     for(uint32_t i = 0; i < core_count; ++i) {
         cpu_cores[i]->finishCore();
     }
@@ -298,9 +322,15 @@ bool ArielCPU::tick( SST::Cycle_t cycle) {
     return stopTicking;
 }
 
-ArielCPU::~ArielCPU() { }
+ArielCPU::~ArielCPU() {
+    delete tunnelReader;
+}
 
 void ArielCPU::emergencyShutdown() {
+    if (tunnelReader) {
+        tunnelReader->stop();
+    }
+
     /* Ask the cores to finish up.  This should flush logging */
     for(uint32_t i = 0; i < core_count; ++i) {
         cpu_cores[i]->finishCore();
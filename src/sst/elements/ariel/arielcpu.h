@@ -78,7 +78,9 @@ class ArielCPU : public SST::Component {
         {"memmgr", "Memory manager to use for address translation", "ariel.MemoryManagerSimple"},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
-        {"gpu_enabled", "If enabled, gpu links will be set up", "0"})
+        {"gpu_enabled", "If enabled, gpu links will be set up", "0"},
+        {"tunnel_reader_threads", "Number of background threads which read and decode the tunnel ahead of the cores, 0 = cores read the tunnel as they tick", "0"},
+        {"tunnel_reader_queue", "Decoded entries buffered per core when tunnel_reader_threads > 0", "4096"})
 
     SST_ELI_DOCUMENT_PORTS( {"cache_link_%(corecount)d", "Each core's link to its cache", {}},
        {"gpu_link_%(corecount)d", "Each core's link to the GPU", {}},
@@ -118,7 +120,7 @@ class ArielCPU : public SST::Component {
         ~ArielCPU();
         virtual void emergencyShutdown();
         virtual void init(unsigned int phase);
-        virtual void setup() {}
+        virtual void setup();
         virtual void finish();
         virtual bool tick( SST::Cycle_t );
 
@@ -135,6 +137,7 @@ class ArielCPU : public SST::Component {
 
         ArielFrontend* frontend;
         ArielTunnel* tunnel;
+        ArielTunnelReader* tunnelReader;
         bool stopTicking;
 
 #ifdef HAVE_CUDA
@@ -26,6 +26,7 @@
 #include <unordered_map>
 
 #include "arielmemmgr.h"
+#include "arielpagetable.h"
 
 using namespace SST;
 using namespace SST::RNG;
@@ -47,7 +48,7 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
     #define ARIEL_ELI_MEMMGR_CACHE_PARAMS {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},\
         {"vtop_translate",  "Set to yes to perform virt-phys translation (TLB) or no to disable", "yes"},\
         {"pagemappolicy",   "Select the page mapping policy for Ariel [LINEAR|RANDOMIZED]", "LINEAR"},\
-        {"translatecacheentries", "Keep a translation cache of this many entries to improve emulated core performance", "4096"}
+        {"translatecacheentries", "Keep a direct-mapped translation cache of this many page entries per core to improve emulated core performance, 0 disables it", "4096"}
 
     #define ARIEL_ELI_MEMMGR_CACHE_STATS { "tlb_hits", "Hits in the simple Ariel TLB", "hits", 2 },\
         { "tlb_evicts",           "Number of evictions in the simple Ariel TLB", "evictions", 2 },\
@@ -82,16 +83,34 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             output->fatal(CALL_INFO, -8, "Ariel memory manager - unknown page mapping policy \"%s\"\n", mappingPolicy.c_str());
             }
 
-            // Set up translation cache
-            translationCache = new std::unordered_map<uint64_t, uint64_t>();
+            // Set up translation cache, rounded up to a power of two so it can be indexed with a mask
             translationCacheEntries = (uint32_t) params.find<uint32_t>("translatecacheentries", 4096);
+            while (translationCacheEntries & (translationCacheEntries - 1)) {
+                translationCacheEntries = (translationCacheEntries | (translationCacheEntries - 1)) + 1;
+            }
+            translationCacheShift = 12;
 
             /* Statistics used by all memory managers; managers may also have their own */
         } // End constructor
 
         ~ArielMemoryManagerCache() {};
+
+        /* Translations requested without a core use core 0's cache */
+        uint64_t translateAddress(uint64_t virtAddr) {
+            return translateCoreAddress(0, virtAddr);
+        }
+
+        virtual uint64_t translateCoreAddress(uint32_t core, uint64_t virtAddr) = 0;
+
         void get_tlb_info(std::unordered_map<uint64_t, uint64_t>* translationcache, uint32_t& translationcacheentries, bool& translationenabled) {
-            memcpy((void*)translationcache, (void*)translationCache, sizeof(*translationCache));
+            translationcache->clear();
+            for (auto& coreCache : translationCache) {
+                for (auto& entry : coreCache) {
+                    if (entry.virtualPage != INVALID_TRANSLATION) {
+                        translationcache->insert(std::pair<uint64_t, uint64_t>(entry.virtualPage << translationCacheShift, entry.physicalBase));
+                    }
+                }
+            }
             translationcacheentries = translationCacheEntries;
             translationenabled = translationEnabled;
 
@@ -106,22 +125,41 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
         Statistic<uint64_t>* statTranslationShootdown;
         Statistic<uint64_t>* statPageAllocationCount;
 
-        std::unordered_map<uint64_t, uint64_t>* translationCache;
+        /* Direct-mapped, page granularity. Entries translate the whole page so a hit needs no page table walk. */
+        struct TranslationCacheEntry {
+            TranslationCacheEntry() : virtualPage(INVALID_TRANSLATION), physicalBase(0) {}
+            uint64_t virtualPage;
+            uint64_t physicalBase;
+        };
+        static const uint64_t INVALID_TRANSLATION = ~0ULL;
+
+        std::vector<std::vector<TranslationCacheEntry> > translationCache;  // One per core
         uint32_t translationCacheEntries;
+        uint32_t translationCacheShift;
         bool translationEnabled;
         ArielPageMappingPolicy mapPolicy;
 
-        void mapPagesLinear(uint64_t pageCount, uint64_t pageSize, uint64_t startAddr, std::deque<uint64_t>* freePagePool) {
-            output->verbose(CALL_INFO, 2, 0, "Page mapping policy is LINEAR map...\n");
-            uint64_t nextMemoryAddress = startAddr;
+        /* Page tables are radix trees, which need power of two page sizes */
+        void checkPageSize(uint64_t pageSize) {
+            if (!ArielPageTable::isPowerOfTwo(pageSize)) {
+                output->fatal(CALL_INFO, -1, "Ariel memory manager - page size %" PRIu64 " is not a power of two\n", pageSize);
+            }
+        }
 
-            for (uint64_t j = 0; j < pageCount; ++j) {
-                freePagePool->push_back(nextMemoryAddress);
-                nextMemoryAddress += pageSize;
+        /* Cache entries cover pages of this size, which must not be larger than any page the manager maps */
+        void setTranslationCachePageSize(uint64_t pageSize) {
+            translationCacheShift = 0;
+            while ((1ULL << translationCacheShift) < pageSize) {
+                translationCacheShift++;
             }
         }
 
-        void mapPagesRandom(uint64_t pageCount, uint64_t pageSize, uint64_t startAddr, std::deque<uint64_t>* freePagePool) {
+        void mapPagesLinear(uint64_t pageCount, uint64_t pageSize, uint64_t startAddr, ArielPagePool* freePagePool) {
+            output->verbose(CALL_INFO, 2, 0, "Page mapping policy is LINEAR map...\n");
+            freePagePool->pushRange(startAddr, pageCount);
+        }
+
+        void mapPagesRandom(uint64_t pageCount, uint64_t pageSize, uint64_t startAddr, ArielPagePool* freePagePool) {
             output->verbose(CALL_INFO, 2, 0, "Page mapping policy is RANDOMIZED map...\n");
 
             uint64_t nextMemoryAddress = startAddr;
@@ -153,7 +191,7 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             }
         }
 
-        void populatePageTable(std::string popFilePath, std::unordered_map<uint64_t, uint64_t> * pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
+        void populatePageTable(std::string popFilePath, ArielPageTable* pageTable, ArielPagePool* freePagePool, uint64_t pageSize) {
             FILE * popFile = fopen(popFilePath.c_str(), "rt");
             uint64_t pinAddr = 0;
 
@@ -177,21 +215,83 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
                 output->verbose(CALL_INFO, 4, 0, "Pinning address %" PRIu64 " (physical=%" PRIu64 "\n",
                             pinAddr, freePhysical);
 
-                pageTable->insert( std::pair<uint64_t, uint64_t>( pinAddr, freePhysical ) );
+                pageTable->map(pinAddr, freePhysical, pageSize);
             }
 
             fclose(popFile);
         }
 
-        void cacheTranslation(uint64_t virtualA, uint64_t physicalA) {
-            // Remove the oldest entry if we do not have enough slots TODO is begin() really the oldest...?
-            if(translationCache->size() == translationCacheEntries) {
-            statTranslationCacheEvict->addData(1);
-            translationCache->erase(translationCache->begin());
+        bool lookupTranslation(uint32_t core, uint64_t virtualA, uint64_t& physicalA) {
+            if (core >= translationCache.size() || translationCacheEntries == 0) {
+                return false;
             }
 
-            // Insert the translated entry into the cache
-            translationCache->insert(std::pair<uint64_t, uint64_t>(virtualA, physicalA));
+            const uint64_t virtualPage = virtualA >> translationCacheShift;
+            const TranslationCacheEntry& entry = translationCache[core][virtualPage & (translationCacheEntries - 1)];
+
+            if (entry.virtualPage != virtualPage) {
+                return false;
+            }
+
+            physicalA = entry.physicalBase + (virtualA & ((1ULL << translationCacheShift) - 1));
+            return true;
+        }
+
+        void cacheTranslation(uint32_t core, uint64_t virtualA, uint64_t physicalA) {
+            if (translationCacheEntries == 0) {
+                return;
+            }
+
+            if (core >= translationCache.size()) {
+                translationCache.resize(core + 1);
+            }
+
+            std::vector<TranslationCacheEntry>& coreCache = translationCache[core];
+            if (coreCache.empty()) {
+                coreCache.resize(translationCacheEntries);
+            }
+
+            const uint64_t pageOffset = virtualA & ((1ULL << translationCacheShift) - 1);
+            TranslationCacheEntry& entry = coreCache[(virtualA >> translationCacheShift) & (translationCacheEntries - 1)];
+
+            if (entry.virtualPage != INVALID_TRANSLATION) {
+                statTranslationCacheEvict->addData(1);
+            }
+
+            entry.virtualPage = virtualA >> translationCacheShift;
+            entry.physicalBase = physicalA - pageOffset;
+        }
+
+        /* Drop any cached translation in [virtualA, virtualA + length) from every core */
+        void invalidateTranslations(uint64_t virtualA, uint64_t length) {
+            if (translationCacheEntries == 0 || length == 0) {
+                return;
+            }
+
+            statTranslationShootdown->addData(1);
+
+            const uint64_t firstPage = virtualA >> translationCacheShift;
+            const uint64_t lastPage = (virtualA + length - 1) >> translationCacheShift;
+
+            for (auto& coreCache : translationCache) {
+                if (coreCache.empty()) {
+                    continue;
+                }
+
+                if (lastPage - firstPage >= translationCacheEntries) {
+                    for (auto& entry : coreCache) {
+                        entry.virtualPage = INVALID_TRANSLATION;
+                    }
+                    continue;
+                }
+
+                for (uint64_t page = firstPage; page <= lastPage; page++) {
+                    TranslationCacheEntry& entry = coreCache[page & (translationCacheEntries - 1)];
+                    if (entry.virtualPage == page) {
+                        entry.virtualPage = INVALID_TRANSLATION;
+                    }
+                }
+            }
         }
 
 };
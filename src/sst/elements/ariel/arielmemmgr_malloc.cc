@@ -15,6 +15,7 @@
 
 #include <sst_config.h>
 #include <stdio.h>
+#include <algorithm>
 
 #include "arielmemmgr_malloc.h"
 
@@ -28,26 +29,32 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     output->verbose(CALL_INFO, 1, 0, "Configuring for %" PRIu32 " memory levels; default level is %" PRIu32 ".\n", memoryLevels, defaultLevel);
 
     // Configure each memory level's free page pool
-    freePages = (std::deque<uint64_t>**) malloc(sizeof(std::deque<uint64_t>*) * memoryLevels);
+    freePages = (ArielPagePool**) malloc(sizeof(ArielPagePool*) * memoryLevels);
     pageSizes = (uint64_t*) malloc(sizeof(uint64_t) * memoryLevels);
 
     // PageAllocation and PageTable structures
     pageAllocations = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
-    pageTables = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
+    pageTables = (ArielPageTable**) malloc(sizeof(ArielPageTable*) * memoryLevels);
     for (uint32_t i = 0; i <memoryLevels; ++i) {
         pageAllocations[i] = new std::unordered_map<uint64_t, uint64_t>();
-        pageTables[i] = new std::unordered_map<uint64_t, uint64_t>();
     }
 
     // Initialize data structures
     size_t level_buffer_size = sizeof(char) * 256;
     char * level_buffer = (char*) malloc(level_buffer_size);
     uint64_t nextMemoryAddress = 0;
+    uint64_t smallestPageSize = 0;
     for (uint32_t i = 0; i < memoryLevels; ++i) {
         // Page size
         snprintf(level_buffer, level_buffer_size, "pagesize%" PRIu32, i);
         pageSizes[i] = (uint64_t) params.find<uint64_t>(level_buffer, 4096);
         output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " page size is %" PRIu64 "\n", i, pageSizes[i]);
+        checkPageSize(pageSizes[i]);
+
+        if (smallestPageSize == 0 || pageSizes[i] < smallestPageSize) {
+            smallestPageSize = pageSizes[i];
+        }
+        pageTables[i] = new ArielPageTable(pageSizes[i]);
 
         // Page count
         snprintf(level_buffer, level_buffer_size, "pagecount%" PRIu32, i);
@@ -55,7 +62,7 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
         output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " page count is %" PRIu64 "\n", i, pageCount);
 
         // Configure page pool
-        freePages[i] = new std::deque<uint64_t>();
+        freePages[i] = new ArielPagePool(pageSizes[i]);
 
         if (ArielPageMappingPolicy::LINEAR == mapPolicy) {
             mapPagesLinear(pageCount, pageSizes[i], nextMemoryAddress, freePages[i]);
@@ -64,7 +71,7 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
         }
         nextMemoryAddress += pageCount * pageSizes[i];
 
-        output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " usable (free) page queue contains %" PRIu32 " entries\n", i, (uint32_t) freePages[i]->size());
+        output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " usable (free) page queue contains %" PRIu64 " entries\n", i, freePages[i]->size());
 
         // Populate page table if needed
         snprintf(level_buffer, level_buffer_size, "page_populate_%" PRIu32, i);
@@ -82,6 +89,8 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     }
 
     free(level_buffer);
+
+    setTranslationCachePageSize(smallestPageSize);
 }
 
 ArielMemoryManagerMalloc::~ArielMemoryManagerMalloc() {
@@ -133,8 +142,9 @@ void ArielMemoryManagerMalloc::allocate(const uint64_t size, const uint32_t leve
 
     statDemandAllocs[level]->addData(roundedSize/pageSize);
 
+    // Map physically contiguous runs of free pages at once so the page table can use large entries
     uint64_t nextVirtPage = virtualAddress;
-    for(uint64_t bytesLeft = 0; bytesLeft < roundedSize; bytesLeft += pageSize) {
+    for(uint64_t pagesLeft = roundedSize / pageSize; pagesLeft > 0; ) {
         if(freePages[level]->empty()) {
                 output->verbose(CALL_INFO, 4, 0, "Requesting a memory allocation at level: %" PRIu32 " which will fail due to not having enough free pages\n",
                     level);
@@ -145,19 +155,20 @@ void ArielMemoryManagerMalloc::allocate(const uint64_t size, const uint32_t leve
                             level, size);
         }
 
-        const uint64_t nextPhysPage = freePages[level]->front();
-        freePages[level]->pop_front();
+        uint64_t nextPhysPage;
+        const uint64_t runPages = freePages[level]->takeRun(pagesLeft, nextPhysPage);
 
-        pageTables[level]->insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+        pageTables[level]->map(nextVirtPage, nextPhysPage, runPages * pageSize);
 
-        output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
-                nextPhysPage, nextVirtPage);
+        output->verbose(CALL_INFO, 4, 0, "Allocating %" PRIu64 " memory pages, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
+                runPages, nextPhysPage, nextVirtPage);
 
-        nextVirtPage += pageSize;
+        nextVirtPage += runPages * pageSize;
+        pagesLeft -= runPages;
     }
 
-    output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu32 " free pages at level: %" PRIu32 "\n",
-        (uint32_t) freePages[level]->size(), level);
+    output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu64 " free pages at level: %" PRIu32 "\n",
+        freePages[level]->size(), level);
 
     // Record the complete entry in the allocation table (what we allocated in size against the virtual address)
     // this means we know how much to free and can translate the address successfully.
@@ -219,6 +230,9 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
     // Record malloc
     mallocInformation.insert(std::make_pair(virtualAddress, mallocInfo(size, level, virtualPages)));
 
+    // Cached translations of these pages came from the page tables, which the malloc now overrides
+    invalidateTranslations(virtualAddress, pageCount * pageSizes[level]);
+
     statBytesAlloc[level]->addData(size);
     return true;
 }
@@ -232,6 +246,7 @@ void ArielMemoryManagerMalloc::freeMalloc(const uint64_t virtualAddress) {
     if (it == mallocInformation.end()) return;
 
     statBytesFree[it->second.level]->addData(it->second.size);
+    invalidateTranslations(virtualAddress, it->second.VAKeys->size() * pageSizes[it->second.level]);
 
     // Free each VA in mallocInformation from mallocTranslations & mallocPrimaryVAMap TODO fix so that mapping stays but address is available for future mallocs
     std::unordered_set<uint64_t>* myKeys = (it->second.VAKeys);
@@ -247,7 +262,7 @@ void ArielMemoryManagerMalloc::freeMalloc(const uint64_t virtualAddress) {
 }
 
 
-uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
+uint64_t ArielMemoryManagerMalloc::translateCoreAddress(uint32_t core, uint64_t virtAddr) {
     // If translation is disabled, then just return address
     if( ! translationEnabled ) {
         return virtAddr;
@@ -262,12 +277,16 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
     // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
+    if(lookupTranslation(core, virtAddr, physAddr)) {
         statTranslationCacheHits->addData(1);
-        return checkCache->second;
+        return physAddr;
     }
 
+    // Cache entries cover a whole aligned block, which is only safe if the block translates as one piece
+    const uint64_t blockStart = virtAddr & ~((1ULL << translationCacheShift) - 1);
+    const uint64_t blockEnd = blockStart + (1ULL << translationCacheShift);
+    bool cacheable = false;
+
     // Check malloc mappings
     if (!mallocTranslations.empty()) {
         std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.upper_bound(virtAddr);
@@ -276,41 +295,32 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
 
         if (it != mallocTranslations.end() && (it->first <= virtAddr)) {
             uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-            if (virtAddr < (primaryAddr + (mallocInformation.find(primaryAddr)->second).size)) {
+            const mallocInfo& info = mallocInformation.find(primaryAddr)->second;
+            if (virtAddr < (primaryAddr + info.size)) {
                 uint64_t offset = virtAddr - it->first;
                 physAddr = offset + it->second;
                 found = true;
+                cacheable = blockStart >= it->first && blockEnd <= it->first + pageSizes[info.level] && blockEnd <= primaryAddr + info.size;
             }
         }
     }
 
     // We will have to search every memory level to find where the address lies
-    for(uint32_t i = 0; i < memoryLevels; ++i) {
-        if (!found) {
-        std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-        const uint64_t pageSize = pageSizes[i];
-            const uint64_t page_offset = virtAddr % pageSize;
-        const uint64_t page_start = virtAddr - page_offset;
-
-        page_itr = pageTables[i]->find(page_start);
-
-            if (page_itr != pageTables[i]->end()) {
-                // Located
-            physAddr = page_itr->second + page_offset;
-
-                output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                    virtAddr, i, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
+    for(uint32_t i = 0; i < memoryLevels && !found; ++i) {
+        if (pageTables[i]->translate(virtAddr, physAddr)) {
+            // Located
+            output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", translates to: phys address: %" PRIu64 "\n",
+                virtAddr, i, physAddr);
 
             found = true;
-            break;
-        }
-        } else {
-            break;
+            cacheable = !mallocOverlaps(blockStart, blockEnd);
         }
     }
 
     if(found) {
-        cacheTranslation(virtAddr, physAddr);
+        if (cacheable) {
+            cacheTranslation(core, virtAddr, physAddr);
+        }
         return physAddr;
     } else {
         output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
@@ -339,7 +349,7 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
             }
 
         // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
+        const uint64_t newPhysAddr = translateCoreAddress(core, virtAddr);
 
         output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
 
@@ -347,6 +357,22 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
     }
 }
 
+/*
+ *  Whether any malloc mapping covers part of [start, end)
+ */
+bool ArielMemoryManagerMalloc::mallocOverlaps(const uint64_t start, const uint64_t end) {
+    std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.lower_bound(end);
+    if (it == mallocTranslations.begin()) return false;
+    it--;
+
+    // Malloc pages do not overlap, so only the last one starting before 'end' can reach into the range
+    const uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
+    const mallocInfo& info = mallocInformation.find(primaryAddr)->second;
+    const uint64_t pageEnd = std::min(it->first + pageSizes[info.level], primaryAddr + info.size);
+
+    return pageEnd > start;
+}
+
 void ArielMemoryManagerMalloc::printStats() {
     output->output("\n");
     output->output("Ariel Memory Management Statistics:\n");
@@ -354,14 +380,19 @@ void ArielMemoryManagerMalloc::printStats() {
     output->output("Page Table Sizes:\n");
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
-        output->output("- Demand map entries at level %" PRIu32 "         %" PRIu32 "\n",
-            i, (uint32_t) pageTables[i]->size());
+        output->output("- Demand map entries at level %" PRIu32 "         %" PRIu64 "\n",
+            i, pageTables[i]->getEntryCount());
+    }
+
+    for(uint32_t i = 0; i < memoryLevels; ++i) {
+        output->output("- Demand table bytes at level %" PRIu32 "         %" PRIu64 "\n",
+            i, pageTables[i]->getTableBytes());
     }
 
     output->output("Page Table Coverages:\n");
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
         output->output("- Demand bytes at level %" PRIu32 "              %" PRIu64 "\n",
-            i, ((uint64_t) pageTables[i]->size()) * ((uint64_t) pageSizes[i]));
+            i, pageTables[i]->getMappedBytes());
     }
 }
@@ -48,7 +48,7 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
 #define ARIEL_MEMMGR_MALLOC_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
             {"memorylevels",    "Number of memory levels in the system", "1"},\
             {"defaultlevel",    "Default memory level", "0"},\
-            {"pagesize%(memorylevels)d", "Page size for memory Level x", "4096"},\
+            {"pagesize%(memorylevels)d", "Page size for memory Level x, must be a power of two (2MiB and 1GiB pages are mapped with a single page table entry)", "4096"},\
             {"pagecount%(memorylevels)d", "Page count for memory Level x", "131072"},\
             {"page_populate_%(memorylevels)d", "Pre-populate/partially pre-populate a page table for a level in memory, this is the file to read in.", ""}
 #define ARIEL_MEMMGR_MALLOC_ELI_STATS ARIEL_ELI_MEMMGR_CACHE_STATS, \
@@ -66,7 +66,7 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
         void setDefaultPool(uint32_t pool);
         uint32_t getDefaultPool();
 
-        uint64_t translateAddress(uint64_t virtAddr);
+        uint64_t translateCoreAddress(uint32_t core, uint64_t virtAddr);
         void printStats();
 
         void freeMalloc(const uint64_t vAddr);
@@ -75,6 +75,7 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
         bool canAllocateInLevel(const uint64_t size, const uint32_t level);
+        bool mallocOverlaps(const uint64_t start, const uint64_t end);
 
         struct mallocInfo {
             uint64_t size;
@@ -91,9 +92,9 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
         uint32_t memoryLevels;
         uint64_t* pageSizes;
 
-        std::deque<uint64_t>** freePages;
+        ArielPagePool** freePages;
         std::unordered_map<uint64_t, uint64_t>** pageAllocations;
-        std::unordered_map<uint64_t, uint64_t>** pageTables;
+        ArielPageTable** pageTables;
 
         std::vector<Statistic<uint64_t>* > statBytesAlloc;
         std::vector<Statistic<uint64_t>* > statBytesFree;
@@ -25,27 +25,34 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
 
     pageSize = (uint64_t) params.find<uint64_t>("pagesize0", 4096);
     output->verbose(CALL_INFO, 2, 0, "Page size is %" PRIu64 "\n", pageSize);
+    checkPageSize(pageSize);
+    setTranslationCachePageSize(pageSize);
+
+    freePages = new ArielPagePool(pageSize);
+    pageTable = new ArielPageTable(pageSize);
 
     uint64_t pageCount = (uint64_t) params.find<uint64_t>("pagecount0", 131072);
     output->verbose(CALL_INFO, 2, 0, "Page count is %" PRIu64 "\n", pageCount);
 
     if (mapPolicy == ArielPageMappingPolicy::LINEAR) {
-        mapPagesLinear(pageCount, pageSize, 0, &freePages);
+        mapPagesLinear(pageCount, pageSize, 0, freePages);
     } else {
-        mapPagesRandom(pageCount, pageSize, 0, &freePages);
+        mapPagesRandom(pageCount, pageSize, 0, freePages);
     }
 
-    output->verbose(CALL_INFO, 2, 0, "Usable (free) page queue contains %" PRIu32 " entries\n", (uint32_t) freePages.size());
+    output->verbose(CALL_INFO, 2, 0, "Usable (free) page queue contains %" PRIu64 " entries\n", freePages->size());
 
     std::string popFilePath = params.find<std::string>("page_populate_0", "");
     if (popFilePath != "") {
         output->verbose(CALL_INFO, 1, 0, "Populating page table from %s...\n", popFilePath.c_str());
-        populatePageTable(popFilePath, &pageTable, &freePages, pageSize);
+        populatePageTable(popFilePath, pageTable, freePages, pageSize);
     }
 
 }
 
 ArielMemoryManagerSimple::~ArielMemoryManagerSimple() {
+    delete pageTable;
+    delete freePages;
 }
 
 
@@ -67,30 +74,32 @@ void ArielMemoryManagerSimple::allocate(const uint64_t size, const uint32_t leve
 
     output->verbose(CALL_INFO, 4, 0, "Requesting rounded to %" PRIu64 " bytes\n", roundedSize);
 
+    // Map physically contiguous runs of free pages at once so the page table can use large entries
     uint64_t nextVirtPage = virtualAddress;
-    for(uint64_t bytesLeft = 0; bytesLeft < roundedSize; bytesLeft += pageSize) {
-        if(freePages.empty()) {
+    for(uint64_t pagesLeft = roundedSize / pageSize; pagesLeft > 0; ) {
+        if(freePages->empty()) {
                 output->fatal(CALL_INFO, -1, "Requested a memory allocation of size: %" PRIu64 " which failed due to not having enough free pages\n",
                     size);
         }
 
-        const uint64_t nextPhysPage = freePages.front();
-        freePages.pop_front();
+        uint64_t nextPhysPage;
+        const uint64_t runPages = freePages->takeRun(pagesLeft, nextPhysPage);
 
-        pageTable.insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+        pageTable->map(nextVirtPage, nextPhysPage, runPages * pageSize);
 
-        output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
-                nextPhysPage, nextVirtPage);
+        output->verbose(CALL_INFO, 4, 0, "Allocating %" PRIu64 " memory pages, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
+                runPages, nextPhysPage, nextVirtPage);
 
-        nextVirtPage += pageSize;
+        nextVirtPage += runPages * pageSize;
+        pagesLeft -= runPages;
     }
 
-    output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu32 " free pages\n",
-        (uint32_t) freePages.size());
+    output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu64 " free pages\n",
+        freePages->size());
 
 }
 
-uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
+uint64_t ArielMemoryManagerSimple::translateCoreAddress(uint32_t core, uint64_t virtAddr) {
     // If translation is disabled, then just return address
     if( ! translationEnabled ) {
         return virtAddr;
@@ -106,26 +115,18 @@ uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
     // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
+    uint64_t physAddr;
+    if(lookupTranslation(core, virtAddr, physAddr)) {
         statTranslationCacheHits->addData(1);
-        return checkCache->second;
+        return physAddr;
     }
 
-    std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-    const uint64_t page_offset = virtAddr % pageSize;
-    const uint64_t page_start = virtAddr - page_offset;
-
-    page_itr = pageTable.find(page_start);
-
-    if(page_itr != pageTable.end()) {
+    if(pageTable->translate(virtAddr, physAddr)) {
         // Located
-        uint64_t physAddr = page_itr->second + page_offset;
+        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " translates to: phys address: %" PRIu64 "\n",
+                virtAddr, physAddr);
 
-        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                virtAddr, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
-
-        cacheTranslation(virtAddr, physAddr);
+        cacheTranslation(core, virtAddr, physAddr);
         return physAddr;
 
     } else {
@@ -141,7 +142,7 @@ uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
         allocate(8, 0, virtAddr - offset);
 
         // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
+        const uint64_t newPhysAddr = translateCoreAddress(core, virtAddr);
 
         output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
 
@@ -155,13 +156,16 @@ void ArielMemoryManagerSimple::printStats() {
     output->output("---------------------------------------------------------------------\n");
     output->output("Page Table Sizes:\n");
 
-    output->output("- Map entries         %" PRIu32 "\n",
-        (uint32_t) pageTable.size());
+    output->output("- Map entries         %" PRIu64 "\n",
+        pageTable->getEntryCount());
+
+    output->output("- Table bytes         %" PRIu64 "\n",
+        pageTable->getTableBytes());
 
     output->output("Page Table Coverages:\n");
 
     output->output("- Bytes               %" PRIu64 "\n",
-        ((uint64_t) pageTable.size()) * ((uint64_t) pageSize));
+        pageTable->getMappedBytes());
 }
 
 void ArielMemoryManagerSimple::printTable() {
@@ -169,18 +173,26 @@ void ArielMemoryManagerSimple::printTable() {
     	output->output("---------------------------------------------------------------------\n");
 	output->verbose(CALL_INFO, 16, 0, "Page Table Map:\n");
 
-	for( auto table_itr : pageTable ) {
-		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 "\n",
-			table_itr.first, table_itr.second);
-	}
+	pageTable->visit([this](uint64_t virtAddr, uint64_t physAddr, uint64_t bytes) {
+		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 " (%" PRIu64 " bytes)\n",
+			virtAddr, physAddr, bytes);
+	});
 
     	output->output("---------------------------------------------------------------------\n");
 
 }
 
 void ArielMemoryManagerSimple::get_page_info(std::unordered_map<uint64_t, uint64_t>* pagetable, std::deque<uint64_t>* freepages, uint64_t& pagesize) {
-    memcpy((void*)pagetable, (void*)(&pageTable), sizeof(pageTable));
-    memcpy((void*)freepages, (void*)(&freePages), sizeof(freePages)); 
+    // The RTL model expects one entry per page
+    pagetable->clear();
+    pageTable->visit([this, pagetable](uint64_t virtAddr, uint64_t physAddr, uint64_t bytes) {
+        for (uint64_t offset = 0; offset < bytes; offset += pageSize) {
+            pagetable->insert(std::pair<uint64_t, uint64_t>(virtAddr + offset, physAddr + offset));
+        }
+    });
+
+    freepages->clear();
+    freePages->getPages(freepages);
     pagesize = pageSize;
 
     return;
@@ -45,7 +45,7 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         )
 
 #define MEMMGR_SIMPLE_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
-            {"pagesize0", "Page size", "4096"},\
+            {"pagesize0", "Page size, must be a power of two (2MiB and 1GiB pages are mapped with a single page table entry)", "4096"},\
             {"pagecount0", "Page count", "131072"},\
             {"page_populate_0", "Pre-populate/partially pre-populate the page table, this is the file to read in.", ""}
 
@@ -56,7 +56,7 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         ArielMemoryManagerSimple(ComponentId_t id, Params& params);
         ~ArielMemoryManagerSimple();
 
-        uint64_t translateAddress(uint64_t virtAddr);
+        uint64_t translateCoreAddress(uint32_t core, uint64_t virtAddr);
         void printStats();
         void get_page_info(std::unordered_map<uint64_t, uint64_t>*, std::deque<uint64_t>*, uint64_t&); 
 
@@ -65,9 +65,9 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
 	void printTable();
 
         uint64_t pageSize;
-        std::deque<uint64_t> freePages;
+        ArielPagePool* freePages;
 
-        std::unordered_map<uint64_t, uint64_t> pageTable;
+        ArielPageTable* pageTable;
 };
 
 }
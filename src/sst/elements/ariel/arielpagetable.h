@@ -0,0 +1,310 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ARIEL_PAGE_TABLE
+#define _H_ARIEL_PAGE_TABLE
+
+#include <stdint.h>
+#include <deque>
+#include <unordered_map>
+
+namespace SST {
+
+namespace ArielComponent {
+
+/*
+ * Radix tree page table.
+ *
+ * Four levels of 512 entries sit under a sparse root, the same shape as
+ * an x86-64 page table. With 4KiB base pages the lower three levels map
+ * 1GiB, 2MiB and 4KiB, so a huge page or a large physically contiguous
+ * range needs a single entry rather than one per base page. Smaller base
+ * pages shift every level down.
+ *
+ * Mappings are only ever added. As with the map this replaces, mapping
+ * an address which is already mapped keeps the existing translation.
+ */
+class ArielPageTable {
+
+    public:
+        /* basePageSize must be a power of two */
+        ArielPageTable(uint64_t basePageSize) : lastRootKey(0), lastRoot(nullptr), nodeCount(0), leafCount(0), mappedBytes(0) {
+            uint32_t pageShift = 0;
+            while ((1ULL << pageShift) < basePageSize && pageShift < 12) {
+                pageShift++;
+            }
+
+            for (int level = 0; level < LEVELS; level++) {
+                levelShift[level] = pageShift + (LEVELS - 1 - level) * INDEX_BITS;
+            }
+            rootShift = levelShift[0] + INDEX_BITS;
+        }
+
+        ~ArielPageTable() {
+            for (auto root : roots) {
+                freeNode(root.second, 0);
+            }
+        }
+
+        static bool isPowerOfTwo(uint64_t v) { return v != 0 && (v & (v - 1)) == 0; }
+
+        /* Map [virtAddr, virtAddr + bytes) to the physically contiguous range at physAddr using the largest entries
+         * which fit. virtAddr and bytes must be multiples of the base page size. */
+        void map(uint64_t virtAddr, uint64_t physAddr, uint64_t bytes) {
+            while (bytes > 0) {
+                int level = LEVELS - 1;
+                while (level > 1 && (virtAddr & (span(level - 1) - 1)) == 0 && bytes >= span(level - 1)) {
+                    level--;
+                }
+
+                mapEntry(virtAddr, physAddr, level);
+
+                virtAddr += span(level);
+                physAddr += span(level);
+                bytes -= span(level);
+            }
+        }
+
+        bool translate(uint64_t virtAddr, uint64_t& physAddr) {
+            const Node* node = findRoot(virtAddr);
+
+            for (int level = 0; node != nullptr; level++) {
+                const uint32_t index = (virtAddr >> levelShift[level]) & INDEX_MASK;
+
+                if (node->child[index] == nullptr) {
+                    if (node->phys[index] == UNMAPPED) {
+                        return false;
+                    }
+                    physAddr = node->phys[index] + (virtAddr & (span(level) - 1));
+                    return true;
+                }
+                node = node->child[index];
+            }
+            return false;
+        }
+
+        /* Calls visitor(virtAddr, physAddr, bytes) for every mapping */
+        template<typename Visitor>
+        void visit(Visitor visitor) const {
+            for (auto root : roots) {
+                visitNode(root.second, 0, root.first << rootShift, visitor);
+            }
+        }
+
+        uint64_t getMappedBytes() const { return mappedBytes; }
+        uint64_t getEntryCount() const { return leafCount; }
+        uint64_t getTableBytes() const { return nodeCount * sizeof(Node); }
+
+    private:
+        static const int INDEX_BITS = 9;
+        static const int LEVELS = 4;
+        static const uint32_t INDEX_MASK = (1 << INDEX_BITS) - 1;
+        static const uint64_t UNMAPPED = ~0ULL;
+
+        /* An entry holds either a child table or, at the lower three levels, a leaf mapping */
+        struct Node {
+            Node() {
+                for (uint32_t i = 0; i <= INDEX_MASK; i++) {
+                    phys[i] = UNMAPPED;
+                    child[i] = nullptr;
+                }
+            }
+            uint64_t phys[INDEX_MASK + 1];
+            Node* child[INDEX_MASK + 1];
+        };
+
+        uint64_t span(int level) const { return 1ULL << levelShift[level]; }
+
+        Node* findRoot(uint64_t virtAddr) {
+            const uint64_t key = virtAddr >> rootShift;
+            if (lastRoot == nullptr || key != lastRootKey) {
+                auto root = roots.find(key);
+                if (root == roots.end()) {
+                    return nullptr;
+                }
+                lastRootKey = key;
+                lastRoot = root->second;
+            }
+            return lastRoot;
+        }
+
+        void mapEntry(uint64_t virtAddr, uint64_t physAddr, int target) {
+            Node* node = findRoot(virtAddr);
+            if (node == nullptr) {
+                node = newNode();
+                roots[virtAddr >> rootShift] = node;
+                lastRootKey = virtAddr >> rootShift;
+                lastRoot = node;
+            }
+
+            for (int level = 0; level < target; level++) {
+                const uint32_t index = (virtAddr >> levelShift[level]) & INDEX_MASK;
+
+                if (node->child[index] == nullptr) {
+                    if (node->phys[index] != UNMAPPED) {
+                        return;     // Already covered by a larger mapping
+                    }
+                    node->child[index] = newNode();
+                }
+                node = node->child[index];
+            }
+
+            const uint32_t index = (virtAddr >> levelShift[target]) & INDEX_MASK;
+
+            if (node->child[index] != nullptr) {
+                // Part of the range is already mapped by smaller entries, fill in around them
+                const uint64_t step = span(target + 1);
+                for (uint64_t offset = 0; offset < span(target); offset += step) {
+                    mapEntry(virtAddr + offset, physAddr + offset, target + 1);
+                }
+            } else if (node->phys[index] == UNMAPPED) {
+                node->phys[index] = physAddr;
+                leafCount++;
+                mappedBytes += span(target);
+            }
+        }
+
+        Node* newNode() {
+            nodeCount++;
+            return new Node();
+        }
+
+        void freeNode(Node* node, int level) {
+            if (level + 1 < LEVELS) {
+                for (uint32_t i = 0; i <= INDEX_MASK; i++) {
+                    if (node->child[i] != nullptr) {
+                        freeNode(node->child[i], level + 1);
+                    }
+                }
+            }
+            delete node;
+        }
+
+        template<typename Visitor>
+        void visitNode(const Node* node, int level, uint64_t base, Visitor& visitor) const {
+            for (uint32_t i = 0; i <= INDEX_MASK; i++) {
+                const uint64_t virtAddr = base + (((uint64_t) i) << levelShift[level]);
+
+                if (node->child[i] != nullptr) {
+                    visitNode(node->child[i], level + 1, virtAddr, visitor);
+                } else if (node->phys[i] != UNMAPPED) {
+                    visitor(virtAddr, node->phys[i], span(level));
+                }
+            }
+        }
+
+        uint32_t levelShift[LEVELS];
+        uint32_t rootShift;
+
+        std::unordered_map<uint64_t, Node*> roots;
+        uint64_t lastRootKey;
+        Node* lastRoot;
+
+        uint64_t nodeCount;
+        uint64_t leafCount;
+        uint64_t mappedBytes;
+};
+
+/*
+ * Pool of free physical pages kept as runs of contiguous pages, so a
+ * linearly mapped pool of any size is a single entry. Pages come off the
+ * front, freed pages go back on the front, as with the deque this replaces.
+ */
+class ArielPagePool {
+
+    public:
+        ArielPagePool(uint64_t pageSize) : pageSize(pageSize), pageCount(0) {}
+
+        bool empty() const { return pageCount == 0; }
+        uint64_t size() const { return pageCount; }
+
+        uint64_t front() const { return runs.front().start; }
+
+        void pop_front() {
+            PageRun& run = runs.front();
+            run.start += pageSize;
+            pageCount--;
+            if (--run.count == 0) {
+                runs.pop_front();
+            }
+        }
+
+        void push_front(uint64_t page) {
+            if (!runs.empty() && page + pageSize == runs.front().start) {
+                runs.front().start = page;
+                runs.front().count++;
+            } else {
+                runs.push_front(PageRun(page, 1));
+            }
+            pageCount++;
+        }
+
+        void push_back(uint64_t page) {
+            pushRange(page, 1);
+        }
+
+        void pushRange(uint64_t start, uint64_t count) {
+            if (count == 0) {
+                return;
+            }
+            if (!runs.empty() && runs.back().start + runs.back().count * pageSize == start) {
+                runs.back().count += count;
+            } else {
+                runs.push_back(PageRun(start, count));
+            }
+            pageCount += count;
+        }
+
+        /* Take up to maxPages physically contiguous pages from the front of the pool, returns the number taken */
+        uint64_t takeRun(uint64_t maxPages, uint64_t& start) {
+            PageRun& run = runs.front();
+            const uint64_t taken = (run.count < maxPages) ? run.count : maxPages;
+
+            start = run.start;
+            run.start += taken * pageSize;
+            run.count -= taken;
+            pageCount -= taken;
+            if (run.count == 0) {
+                runs.pop_front();
+            }
+            return taken;
+        }
+
+        /* Expand into one entry per page */
+        void getPages(std::deque<uint64_t>* pages) const {
+            for (auto run : runs) {
+                for (uint64_t i = 0; i < run.count; i++) {
+                    pages->push_back(run.start + i * pageSize);
+                }
+            }
+        }
+
+    private:
+        struct PageRun {
+            PageRun(uint64_t start, uint64_t count) : start(start), count(count) {}
+            uint64_t start;
+            uint64_t count;
+        };
+
+        uint64_t pageSize;
+        uint64_t pageCount;
+        std::deque<PageRun> runs;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <chrono>
+
+#include "arieltunnelreader.h"
+#include "arielcore.h"
+
+using namespace SST::ArielComponent;
+
+ArielTunnelReader::ArielTunnelReader(std::vector<ArielCore*>& cores, uint32_t threadCount, uint32_t ringEntries) :
+    cores(cores), stopping(false) {
+
+    if (threadCount > cores.size()) {
+        threadCount = cores.size();
+    }
+    this->threadCount = threadCount;
+
+    for (uint32_t i = 0; i < cores.size(); ++i) {
+        rings.push_back(new ArielEventRing(ringEntries));
+        cores[i]->setEventRing(rings[i]);
+    }
+}
+
+ArielTunnelReader::~ArielTunnelReader() {
+    stop();
+
+    for (uint32_t i = 0; i < rings.size(); ++i) {
+        delete rings[i];
+    }
+}
+
+void ArielTunnelReader::start() {
+    const uint32_t coreCount = cores.size();
+
+    for (uint32_t t = 0; t < threadCount; ++t) {
+        readers.push_back(std::thread(&ArielTunnelReader::readLoop, this,
+                    (t * coreCount) / threadCount, ((t + 1) * coreCount) / threadCount));
+    }
+}
+
+void ArielTunnelReader::stop() {
+    stopping.store(true);
+
+    for (uint32_t i = 0; i < readers.size(); ++i) {
+        readers[i].join();
+    }
+    readers.clear();
+}
+
+void ArielTunnelReader::readLoop(uint32_t first, uint32_t last) {
+    uint32_t idlePasses = 0;
+
+    while (!stopping.load(std::memory_order_relaxed)) {
+        bool progress = false;
+
+        for (uint32_t i = first; i < last; ++i) {
+            progress |= cores[i]->decodeAhead();
+        }
+
+        // Back off when every core in the group is idle or its ring is full
+        if (progress) {
+            idlePasses = 0;
+        } else if (++idlePasses < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
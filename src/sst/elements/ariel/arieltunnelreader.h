@@ -0,0 +1,130 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_TUNNEL_READER
+#define _H_SST_ARIEL_TUNNEL_READER
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "arielevent.h"
+
+namespace SST {
+namespace ArielComponent {
+
+class ArielCore;
+
+enum ArielDecodedKind {
+    DECODED_EVENT,              // Event for the core's queue
+    DECODED_INSTRUCTION,        // Start of an instruction, for the instruction mix statistics
+    DECODED_OUTPUT_STATS        // Application asked for a statistics dump
+};
+
+/* What a reader thread hands to a core. Statistics are only touched on the simulation thread. */
+struct ArielDecodedEntry {
+    ArielDecodedEntry() : kind(DECODED_EVENT), event(NULL), instClass(0), simdElemCount(0) {}
+
+    ArielDecodedKind kind;
+    ArielEvent* event;
+    uint32_t instClass;
+    uint32_t simdElemCount;
+};
+
+/*
+ * Single producer, single consumer ring of decoded entries. The reader
+ * thread pushes, the core pops on its own tick.
+ */
+class ArielEventRing {
+
+    public:
+        /* capacity is rounded up to a power of two */
+        ArielEventRing(uint32_t capacity) : head(0), tail(0) {
+            uint32_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            entries.resize(size);
+            mask = size - 1;
+        }
+
+        ~ArielEventRing() {
+            ArielDecodedEntry entry;
+            while (pop(entry)) {
+                delete entry.event;
+            }
+        }
+
+        bool push(const ArielDecodedEntry& entry) {
+            const uint64_t t = tail.load(std::memory_order_relaxed);
+            if (t - head.load(std::memory_order_acquire) > mask) {
+                return false;
+            }
+            entries[t & mask] = entry;
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(ArielDecodedEntry& entry) {
+            const uint64_t h = head.load(std::memory_order_relaxed);
+            if (h == tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            entry = entries[h & mask];
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        std::vector<ArielDecodedEntry> entries;
+        uint64_t mask;
+
+        // Kept on separate cache lines, one is written by each thread
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+};
+
+/*
+ * Background threads which poll the tunnel and decode commands ahead of
+ * the cores. Cores are split into contiguous groups, one per thread, and
+ * each core gets its own ring. A core still only takes events from its
+ * ring when it ticks, so the simulated timing does not depend on how far
+ * ahead the readers are.
+ */
+class ArielTunnelReader {
+
+    public:
+        ArielTunnelReader(std::vector<ArielCore*>& cores, uint32_t threadCount, uint32_t ringEntries);
+        ~ArielTunnelReader();
+
+        void start();
+        void stop();
+
+    private:
+        void readLoop(uint32_t first, uint32_t last);
+
+        std::vector<ArielCore*> cores;
+        std::vector<ArielEventRing*> rings;
+        std::vector<std::thread> readers;
+        std::atomic<bool> stopping;
+        uint32_t threadCount;
+};
+
+}
+}
+
+#endif
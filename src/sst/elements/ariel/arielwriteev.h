@@ -27,13 +27,14 @@ namespace ArielComponent {
 class ArielWriteEvent : public ArielEvent {
 
     public:
-        ArielWriteEvent(uint64_t wAddr, uint32_t length, const uint8_t* payloadData) :
+        // Only the first payloadLength bytes are traced, the rest of the payload is zero
+        ArielWriteEvent(uint64_t wAddr, uint32_t length, const uint8_t* payloadData, uint32_t payloadLength) :
                 writeAddress(wAddr), writeLength(length) {
 
                 payload = new uint8_t[length];
 
-                for( int i = 0; i < length; ++i ) {
-                	payload[i] = payloadData[i];
+                for( uint32_t i = 0; i < length; ++i ) {
+                	payload[i] = (i < payloadLength) ? payloadData[i] : 0;
                 }
         }
 
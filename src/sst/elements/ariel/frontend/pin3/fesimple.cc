@@ -96,6 +96,7 @@ PIN_LOCK mainLock;
 // Instrumentation control
 UINT32 instrument_instructions;
 bool writeTrace;
+ArielCommand* batches;  // Per-thread batch of instruction records being filled
 UINT32 funcProfileLevel;
 typedef struct {
     int64_t insExecuted;
@@ -283,16 +284,66 @@ VOID InstrumentTrace (TRACE trace, VOID* args)
 /******************** END SHADOW STACK **************************/
 /****************************************************************/
 
+/****************************************************************/
+/************************ BATCHING ******************************/
+/* Instruction and access records are packed into a per-thread  */
+/* ARIEL_BATCH command which is sent when it is full, before    */
+/* any other command from the thread and at each system call.   */
+/****************************************************************/
+
+VOID FlushBatch(UINT32 thr)
+{
+    if(thr < core_count && batches[thr].batch.records > 0) {
+        tunnel->writeMessage(thr, batches[thr]);
+        arielBatchReset(&batches[thr]);
+    }
+}
+
+/* Send a command which is not batched, records already batched go first */
+VOID WriteCommand(UINT32 thr, ArielCommand& ac)
+{
+    FlushBatch(thr);
+    tunnel->writeMessage(thr, ac);
+}
+
+inline uint8_t* AppendRecord(UINT32 thr, UINT32 length)
+{
+    if(! arielBatchFits(&batches[thr], length)) {
+        FlushBatch(thr);
+    }
+
+    return arielBatchAppend(&batches[thr], length);
+}
+
+/* A thread which blocks in the kernel must not leave its records unsent */
+VOID FlushBatchOnSyscall(THREADID thr, CONTEXT* ctxt, SYSCALL_STANDARD std, VOID* v)
+{
+    FlushBatch(thr);
+}
+
+VOID FlushBatchOnThreadFini(THREADID thr, const CONTEXT* ctxt, INT32 code, VOID* v)
+{
+    FlushBatch(thr);
+}
+
+/****************************************************************/
+/********************** END BATCHING ****************************/
+/****************************************************************/
+
 VOID Fini(INT32 code, VOID* v)
 {
     if(SSTVerbosity.Value() > 0) {
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    for(UINT32 i = 0; i < core_count; i++) {
+        FlushBatch(i);
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(0, ac);
+    WriteCommand(0, ac);
 
     delete tunnelmgr;
 #ifdef HAVE_CUDA
@@ -340,7 +391,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -349,73 +400,43 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
             UINT32 instClass, UINT32 simdOpWidth)
 {
-
-    const uint64_t addr64 = (uint64_t) address;
-
-    ArielCommand ac;
-
-    ac.command = ARIEL_PERFORM_READ;
-    ac.instPtr = (uint64_t) ip;
-    ac.inst.addr = addr64;
-    ac.inst.size = readSize;
-    ac.inst.instClass = instClass;
-    ac.inst.simdElemCount = simdOpWidth;
-
-    tunnel->writeMessage(thr, ac);
+    uint8_t* record = AppendRecord(thr, ARIEL_RECORD_ACCESS_SIZE);
+    arielRecordAccess(record, ARIEL_RECORD_READ, (uint16_t) ARIEL_MIN(readSize, (UINT32) 0xFFFF), (uint64_t) address);
 }
 
 VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADDRINT ip,
             UINT32 instClass, UINT32 simdOpWidth)
 {
+    // Payloads are only sent when the simulator asked for them
+    const UINT32 payloadSize = writeTrace ? ARIEL_MIN( writeSize, (UINT32) ARIEL_MAX_PAYLOAD_SIZE ) : 0;
+    uint8_t* record = AppendRecord(thr, ARIEL_RECORD_ACCESS_SIZE + payloadSize);
 
-    const uint64_t addr64 = (uint64_t) address;
-    ArielCommand ac;
-
-    ac.command = ARIEL_PERFORM_WRITE;
-    ac.instPtr = (uint64_t) ip;
-    ac.inst.addr = addr64;
-    ac.inst.size = writeSize;
-    ac.inst.instClass = instClass;
-    ac.inst.simdElemCount = simdOpWidth;
+    arielRecordAccess(record, writeTrace ? (ARIEL_RECORD_WRITE | ARIEL_RECORD_HAS_PAYLOAD) : ARIEL_RECORD_WRITE,
+        (uint16_t) ARIEL_MIN(writeSize, (UINT32) 0xFFFF), (uint64_t) address);
 
     if( writeTrace ) {
-//      if( writeSize > ARIEL_MAX_PAYLOAD_SIZE ) {
-//          fprintf(stderr, "Error: Payload exceeds maximum size (%d > %d)\n",
-//              writeSize, ARIEL_MAX_PAYLOAD_SIZE);
-//          exit(-1);
-//      }
-        PIN_SafeCopy( &ac.inst.payload[0], address, ARIEL_MIN( writeSize, (UINT32) ARIEL_MAX_PAYLOAD_SIZE ) );
+        PIN_SafeCopy( &record[ARIEL_RECORD_ACCESS_SIZE], address, payloadSize );
     }
-/*
-    printf("CU Instruction %p ",address);
-    for(int i = 0; i < ARIEL_MIN(writeSize, ARIEL_MAX_PAYLOAD_SIZE); i++){
-        printf("%d ", ac.inst.payload[i]);
-    }
-    printf("\n");
-*/
-    tunnel->writeMessage(thr, ac);
 }
 
-VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip)
+VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip, UINT32 instClass, UINT32 simdOpWidth)
 {
-    ArielCommand ac;
-    ac.command = ARIEL_START_INSTRUCTION;
-    ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    uint8_t* record = AppendRecord(thr, ARIEL_RECORD_INSTRUCTION_SIZE);
+    record[0] = ARIEL_RECORD_START_INSTRUCTION;
+    record[1] = (uint8_t) instClass;
+    record[2] = (uint8_t) simdOpWidth;
 }
 
 VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
 {
-    ArielCommand ac;
-    ac.command = ARIEL_END_INSTRUCTION;
-    ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    uint8_t* record = AppendRecord(thr, ARIEL_RECORD_MARKER_SIZE);
+    record[0] = ARIEL_RECORD_END_INSTRUCTION;
 }
 
 VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
@@ -425,7 +446,7 @@ VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
-            WriteStartInstructionMarker( thr, ip );
+            WriteStartInstructionMarker( thr, ip, instClass, simdOpWidth );
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             WriteInstructionWrite( writeAddr, writeSize, thr, ip, instClass, simdOpWidth );
             WriteEndInstructionMarker( thr, ip );
@@ -440,7 +461,7 @@ VOID WriteInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
     if(enable_output) {
         if(thr < core_count) {
             if (first)
-                WriteStartInstructionMarker(thr, ip);
+                WriteStartInstructionMarker(thr, ip, instClass, simdOpWidth);
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             if (last)
                 WriteEndInstructionMarker(thr, ip);
@@ -453,10 +474,8 @@ VOID WriteNoOp(THREADID thr, ADDRINT ip)
 {
     if(enable_output) {
         if(thr < core_count) {
-            ArielCommand ac;
-            ac.command = ARIEL_NOOP;
-            ac.instPtr = (uint64_t) ip;
-            tunnel->writeMessage(thr, ac);
+            uint8_t* record = AppendRecord(thr, ARIEL_RECORD_MARKER_SIZE);
+            record[0] = ARIEL_RECORD_NOOP;
         }
     }
 }
@@ -468,7 +487,7 @@ VOID WriteInstructionWriteOnly(THREADID thr, ADDRINT* writeAddr, UINT32 writeSiz
     if(enable_output) {
         if(thr < core_count) {
             if (first)
-                WriteStartInstructionMarker(thr, ip);
+                WriteStartInstructionMarker(thr, ip, instClass, simdOpWidth);
             WriteInstructionWrite(writeAddr, writeSize,  thr, ip, instClass, simdOpWidth);
             if (last)
                 WriteEndInstructionMarker(thr, ip);
@@ -753,7 +772,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -763,7 +782,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -817,7 +836,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -845,7 +864,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -897,7 +916,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -952,7 +971,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -997,7 +1016,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        WriteCommand(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1049,14 +1068,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                WriteCommand(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1083,7 +1102,7 @@ __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size){
     ac.API.name = GPU_MALLOC;
     ac.API.CA.cuda_malloc.dev_ptr = devPtr;
     ac.API.CA.cuda_malloc.size = size;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail = false;
@@ -1113,7 +1132,7 @@ void** CUDARTAPI __cudaRegisterFatBinary(void *fatCubin) {
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_REG_FAT_BINARY;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1154,7 +1173,7 @@ void CUDARTAPI __cudaRegisterFunction(
     ac.API.CA.register_function.fat_cubin_handle = (unsigned)(unsigned long long)fatCubinHandle;
     ac.API.CA.register_function.host_fun = reinterpret_cast<uint64_t>(hostFun);
     strncpy(ac.API.CA.register_function.device_fun, deviceFun, 512);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1219,7 +1238,7 @@ __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src, size_t cou
     ac.API.CA.cuda_memcpy.src = (uint64_t) src;
     ac.API.CA.cuda_memcpy.count = count;
     ac.API.CA.cuda_memcpy.kind = final_kind;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     if(final_kind == cudaMemcpyHostToDevice) {
         if(count <= max_page_size){
@@ -1348,7 +1367,7 @@ __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 blockDim, si
     ac.API.CA.cfg_call.bdz = blockDim.z;
     ac.API.CA.cfg_call.sharedMem = sharedMem;
     ac.API.CA.cfg_call.stream = stream;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1396,7 +1415,7 @@ __host__ cudaError_t CUDARTAPI cudaSetupArgument(const void *arg, size_t size, s
     ac.API.CA.set_arg.offset = offset;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_SET_ARG;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1421,7 +1440,7 @@ __host__ cudaError_t CUDARTAPI cudaLaunch(const void *func){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_LAUNCH;
     ac.API.CA.cuda_launch.func = reinterpret_cast<uint64_t>(func);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1445,7 +1464,7 @@ __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_FREE;
     ac.API.CA.free_address = (uint64_t)devPtr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1468,7 +1487,7 @@ __host__ __cudart_builtin__ cudaError_t CUDARTAPI cudaGetLastError(void){
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_GET_LAST_ERROR;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
     GpuCommand gc;
 
     bool avail=false;
@@ -1507,7 +1526,7 @@ void CUDARTAPI __cudaRegisterVar(
     ac.API.CA.register_var.size = size;
     ac.API.CA.register_var.constant = constant;
     ac.API.CA.register_var.global = global;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1543,7 +1562,7 @@ __host__ cudaError_t CUDARTAPI __maxActiveBlock(
     ac.API.CA.max_active_block.blockSize = blockSize;
     ac.API.CA.max_active_block.dynamicSMemSize = dynamicSMemSize;
     ac.API.CA.max_active_block.flags = flags;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1571,7 +1590,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1618,7 +1637,7 @@ void ariel_start_RTL_sim(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue successfully delivered via ArielTunnel");
     #endif
@@ -1639,7 +1658,7 @@ void ariel_update_RTL_signals(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue to update RTL signals successfully delivered via ArielTunnel");
     #endif
@@ -1867,6 +1886,8 @@ int main(int argc, char *argv[])
     //PIN_InitSymbolsAlt(IFUNC_SYMBOLS);
     PIN_InitSymbols();
     PIN_AddFiniFunction(Fini, 0);
+    PIN_AddSyscallEntryFunction(FlushBatchOnSyscall, 0);
+    PIN_AddThreadFiniFunction(FlushBatchOnThreadFini, 0);
 
     PIN_InitLock(&mainLock);
     PIN_InitLock(&mallocIndexLock);
@@ -1921,6 +1942,11 @@ int main(int argc, char *argv[])
     lastMallocLoc = (UINT64*) malloc(sizeof(UINT64) * core_count);
     mallocIndex = 0;
 
+    batches = (ArielCommand*) malloc(sizeof(ArielCommand) * core_count);
+    for(unsigned int i = 0; i < core_count; i++) {
+        arielBatchReset(&batches[i]);
+    }
+
     if (KeepMallocStackTrace.Value() == 1) {
         arielStack.resize(core_count);  // Need core_count stacks
         rtnNameMap = fopen("routine_name_map.txt", "wt");
@@ -68,6 +68,11 @@ class testcase_Ariel(SSTTestCase):
     def test_Ariel_test_ivb(self):
         self.ariel_Template("ariel_ivb")
 
+    @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
+    @unittest.skipIf(host_os_is_osx(), "Ariel: Open MP is not supported on OSX.")
+    def test_Ariel_test_ivb_readers(self):
+        self.ariel_Template("ariel_ivb_readers")
+
     @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
     @unittest.skipIf(host_os_is_osx(), "Ariel: Open MP is not supported on OSX.")
     @unittest.skipIf(testing_check_get_num_ranks() > 1, "Ariel: test_Ariel_test_snb skipped if ranks > 1 - Sandy Bridge test is incompatible with Multi-Rank.")
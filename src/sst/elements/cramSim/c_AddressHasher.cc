@@ -267,139 +267,69 @@ void c_AddressHasher::build(Params &params) {
     }
   } // else found in map
 
-} // c_AddressHasher(SST::Params)
-
-
-void c_AddressHasher::fillHashedAddress(c_HashedAddress *x_hashAddr, const ulong x_address) {
-  ulong l_cur=0;
-  ulong l_cnt=0;
-
-  //channel
-  auto l_bitPos = m_bitPositions.find("C");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setChannel(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
-
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setChannel(l_cur);
-  }
-
-  //pseudo channel
-   l_bitPos = m_bitPositions.find("c");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setPChannel(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
-
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setPChannel(l_cur);
-  }
-
-  //rank
-  l_bitPos = m_bitPositions.find("R");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setRank(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
-
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setRank(l_cur);
-  }
+  // compile the address map so that decoding a transaction needs no lookups
+  compileFieldDecode("C", FIELD_CHANNEL);
+  compileFieldDecode("c", FIELD_PCHANNEL);
+  compileFieldDecode("R", FIELD_RANK);
+  compileFieldDecode("B", FIELD_BANKGROUP);
+  compileFieldDecode("b", FIELD_BANK);
+  compileFieldDecode("r", FIELD_ROW);
+  compileFieldDecode("l", FIELD_COL);
+  compileFieldDecode("h", FIELD_CACHELINE);
+
+  m_bankGroupStride = k_pNumBanks;
+  m_rankStride = k_pNumBanks * k_pNumBankGroups;
+  m_pChannelStride = k_pNumBanks * k_pNumBankGroups * k_pNumRanks;
+  m_channelStride = k_pNumPseudoChannels * k_pNumBanks * k_pNumBankGroups * k_pNumRanks;
 
-  //bankGroup
-  l_bitPos = m_bitPositions.find("B");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setBankGroup(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
-
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setBankGroup(l_cur);
-  }
+} // c_AddressHasher(SST::Params)
 
-  //bank
-  l_bitPos = m_bitPositions.find("b");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setBank(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
+// compileFieldDecode
+// bit i of a field is taken from address bit m_bitPositions[field][i]. Runs of
+// consecutive positions are merged so each one is a single shift and mask.
+void c_AddressHasher::compileFieldDecode(const string& x_field, e_AddressField x_fieldId) {
+  m_fieldRuns[x_fieldId].clear();
 
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setBank(l_cur);
+  auto l_bitPos = m_bitPositions.find(x_field);
+  if(l_bitPos == m_bitPositions.end()) { // not found, field is always 0
+    return;
   }
 
-  //row
-  l_bitPos = m_bitPositions.find("r");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setRow(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
-
-      l_cur |= l_tmp;
+  const vector<uint>& l_positions = l_bitPos->second;
+  unsigned l_cnt = 0;
+  while(l_cnt < l_positions.size()) {
+    unsigned l_len = 1;
+    while(l_cnt + l_len < l_positions.size() && l_positions[l_cnt + l_len] == l_positions[l_cnt] + l_len) {
+      l_len++;
     }
-    x_hashAddr->setRow(l_cur);
-  }
 
-  //col
-  l_bitPos = m_bitPositions.find("l");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setCol(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
+    c_BitRun l_run;
+    l_run.srcShift = l_positions[l_cnt];
+    l_run.mask = (l_len >= 64) ? ~(ulong)0 : (((ulong)1 << l_len) - 1);
+    l_run.dstShift = l_cnt;
+    m_fieldRuns[x_fieldId].push_back(l_run);
 
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setCol(l_cur);
+    l_cnt += l_len;
   }
+} // compileFieldDecode(string, e_AddressField)
 
-  //cacheline
-  l_bitPos = m_bitPositions.find("h");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setCacheline(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
 
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setCacheline(l_cur);
-  }
+void c_AddressHasher::fillHashedAddress(c_HashedAddress *x_hashAddr, const ulong x_address) {
+  x_hashAddr->setChannel(extractField(FIELD_CHANNEL, x_address));
+  x_hashAddr->setPChannel(extractField(FIELD_PCHANNEL, x_address));
+  x_hashAddr->setRank(extractField(FIELD_RANK, x_address));
+  x_hashAddr->setBankGroup(extractField(FIELD_BANKGROUP, x_address));
+  x_hashAddr->setBank(extractField(FIELD_BANK, x_address));
+  x_hashAddr->setRow(extractField(FIELD_ROW, x_address));
+  x_hashAddr->setCol(extractField(FIELD_COL, x_address));
+  x_hashAddr->setCacheline(extractField(FIELD_CACHELINE, x_address));
 
   unsigned l_bankId =
     x_hashAddr->getBank()
-    + x_hashAddr->getBankGroup() * k_pNumBanks
-    + x_hashAddr->getRank()    * k_pNumBanks * k_pNumBankGroups
-    + x_hashAddr->getPChannel()  *  k_pNumBanks * k_pNumBankGroups * k_pNumRanks
-    + x_hashAddr->getChannel()   * k_pNumPseudoChannels * k_pNumBanks * k_pNumBankGroups * k_pNumRanks;
+    + x_hashAddr->getBankGroup() * m_bankGroupStride
+    + x_hashAddr->getRank()      * m_rankStride
+    + x_hashAddr->getPChannel()  * m_pChannelStride
+    + x_hashAddr->getChannel()   * m_channelStride;
 
 
   unsigned l_rankId =
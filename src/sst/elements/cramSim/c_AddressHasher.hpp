@@ -113,6 +113,34 @@ namespace SST {
             std::map<std::string, std::vector<uint> > m_bitPositions;
             std::map<std::string, uint> m_structureSizes;  // Used for checking that params agree
 
+            // Address decode compiled from m_bitPositions, each field is extracted by a few mask and shift steps
+            enum e_AddressField {
+                FIELD_CHANNEL, FIELD_PCHANNEL, FIELD_RANK, FIELD_BANKGROUP, FIELD_BANK, FIELD_ROW, FIELD_COL, FIELD_CACHELINE, NUM_FIELDS
+            };
+
+            // A run of contiguous address bits which lands at dstShift in the field
+            struct c_BitRun {
+                unsigned srcShift;
+                ulong mask;
+                unsigned dstShift;
+            };
+
+            std::vector<c_BitRun> m_fieldRuns[NUM_FIELDS];
+            unsigned m_bankGroupStride;
+            unsigned m_rankStride;
+            unsigned m_pChannelStride;
+            unsigned m_channelStride;
+
+            void compileFieldDecode(const std::string& x_field, e_AddressField x_fieldId);
+
+            ulong extractField(e_AddressField x_fieldId, const ulong x_address) const {
+                ulong l_value = 0;
+                for (auto &l_run : m_fieldRuns[x_fieldId]) {
+                    l_value |= ((x_address >> l_run.srcShift) & l_run.mask) << l_run.dstShift;
+                }
+                return l_value;
+            }
+
             // regex replacement stuff
             void parsePattern(std::string *x_inStr, std::pair<std::string, uint> *x_outPair);
 
@@ -42,7 +42,7 @@
 using namespace SST;
 using namespace SST::CramSim;
 
-c_BankGroup::c_BankGroup(std::map<std::string, unsigned>* x_bankParams, unsigned x_Id) {
+c_BankGroup::c_BankGroup(c_TimingParams* x_bankParams, unsigned x_Id) {
     m_rankPtr = nullptr;
     m_bankParams = x_bankParams;
     m_bankGroupId = x_Id;
@@ -99,7 +99,7 @@ void c_BankGroup::updateOtherBanksNextCommandCycles(c_BankInfo* x_initBankPtr,
         case e_BankCommandType::ACT: {
             SimTime_t l_nextCycle = std::max(
                     l_bankPtr->getNextCommandCycle(e_BankCommandType::ACT),
-                    l_time + m_bankParams->at("nRRD_L"));
+                    l_time + m_bankParams->nRRD_L);
             l_bankPtr->setNextCommandCycle(e_BankCommandType::ACT, l_nextCycle);
             break;
         }
@@ -113,8 +113,8 @@ void c_BankGroup::updateOtherBanksNextCommandCycles(c_BankInfo* x_initBankPtr,
                             l_bankPtr->getNextCommandCycle(
                                     e_BankCommandType::READA)),
                     l_time
-                            + std::max(m_bankParams->at("nCCD_L"),
-                                    m_bankParams->at("nBL")));
+                            + std::max(m_bankParams->nCCD_L,
+                                    m_bankParams->nBL));
             l_bankPtr->setNextCommandCycle(e_BankCommandType::READ,
                     l_nextCycle);
             l_bankPtr->setNextCommandCycle(e_BankCommandType::READA,
@@ -128,9 +128,9 @@ void c_BankGroup::updateOtherBanksNextCommandCycles(c_BankInfo* x_initBankPtr,
                             l_bankPtr->getNextCommandCycle(
                                     e_BankCommandType::WRITEA)),
                     l_time
-                            + m_bankParams->at("nCL") + m_bankParams->at("nBL")
-                            + m_bankParams->at("nRTW")
-                            - m_bankParams->at("nCWL"));
+                            + m_bankParams->nCL + m_bankParams->nBL
+                            + m_bankParams->nRTW
+                            - m_bankParams->nCWL);
             l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITE,
                     l_nextCycle);
             l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITEA,
@@ -148,8 +148,8 @@ void c_BankGroup::updateOtherBanksNextCommandCycles(c_BankInfo* x_initBankPtr,
                             l_bankPtr->getNextCommandCycle(
                                     e_BankCommandType::READA)),
                     l_time
-                            + m_bankParams->at("nCWL") + m_bankParams->at("nBL")
-                            + m_bankParams->at("nWTR_L"));
+                            + m_bankParams->nCWL + m_bankParams->nBL
+                            + m_bankParams->nWTR_L);
             l_bankPtr->setNextCommandCycle(e_BankCommandType::READ,
                     l_nextCycle);
             l_bankPtr->setNextCommandCycle(e_BankCommandType::READA,
@@ -163,8 +163,8 @@ void c_BankGroup::updateOtherBanksNextCommandCycles(c_BankInfo* x_initBankPtr,
                             l_bankPtr->getNextCommandCycle(
                                     e_BankCommandType::WRITEA)),
                     l_time
-                            + std::max(m_bankParams->at("nCCD_L"),
-                                    m_bankParams->at("nBL")));
+                            + std::max(m_bankParams->nCCD_L,
+                                    m_bankParams->nBL));
             l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITE,
                     l_nextCycle);
             l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITEA,
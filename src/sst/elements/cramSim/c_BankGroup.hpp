@@ -39,6 +39,9 @@
 #include <sst/core/component.h>
 #include <sst/core/link.h>
 
+// CramSim includes
+#include "c_TimingParams.hpp"
+
 namespace SST {
 namespace CramSim {
 
@@ -50,7 +53,7 @@ class c_BankGroup {
 public:
 
 
-        c_BankGroup(std::map<std::string, unsigned>* x_bankParams, unsigned x_Id);
+        c_BankGroup(c_TimingParams* x_bankParams, unsigned x_Id);
     virtual ~c_BankGroup();
 
     void acceptBank(c_BankInfo* x_bankPtr);
@@ -69,7 +72,7 @@ private:
     std::vector<c_BankInfo*> m_bankPtrs;
     c_Rank* m_rankPtr;
 
-    std::map<std::string, unsigned>* m_bankParams;
+    c_TimingParams* m_bankParams;
 
 };
 
@@ -48,7 +48,7 @@ c_BankInfo::c_BankInfo() :
     m_bankState->enter(this, nullptr, nullptr,0);
 }
 
-c_BankInfo::c_BankInfo(std::map<std::string, unsigned>* x_bankParams,
+c_BankInfo::c_BankInfo(c_TimingParams* x_bankParams,
         unsigned x_bankId) :
         m_bankParams(x_bankParams), m_bankId(x_bankId), m_bankState(
                 new c_BankStateIdle(x_bankParams)),
@@ -154,6 +154,16 @@ void c_BankInfo::clockTic(SimTime_t x_cycle) {
 
 }
 
+SimTime_t c_BankInfo::getIdleCycles() {
+    return m_bankState->getIdleCycles();
+}
+
+void c_BankInfo::skipCycles(SimTime_t x_cycles) {
+    m_autoPrechargeTimer = (m_autoPrechargeTimer > x_cycles) ? m_autoPrechargeTimer - x_cycles : 0;
+
+    m_bankState->skipCycles(x_cycles);
+}
+
 std::list<e_BankCommandType> c_BankInfo::getAllowedCommands() {
     return m_bankState->getAllowedCommands();
 }
@@ -48,7 +48,7 @@ class c_BankInfo {
 public:
 
     c_BankInfo();
-    c_BankInfo(std::map<std::string, unsigned>* x_bankParams,
+    c_BankInfo(c_TimingParams* x_bankParams,
             unsigned x_bankId);
 
     virtual ~c_BankInfo();
@@ -57,6 +57,10 @@ public:
 
     void clockTic(SimTime_t x_cycle);
 
+    // used to skip cycles in which the bank would only count timers down
+    SimTime_t getIdleCycles();
+    void skipCycles(SimTime_t x_cycles);
+
     std::list<e_BankCommandType> getAllowedCommands();
 
     bool isCommandAllowed(c_BankCommand* x_cmdPtr, SimTime_t x_simCycle);
@@ -120,7 +124,7 @@ private:
     c_BankState* m_bankState;
     c_BankGroup* m_bankGroupPtr;
 
-    std::map<std::string, unsigned>* m_bankParams;
+    c_TimingParams* m_bankParams;
     std::map<e_BankCommandType, SimTime_t> m_lastCommandCycleMap;
     std::map<e_BankCommandType, SimTime_t> m_nextCommandCycleMap;
 
@@ -39,6 +39,7 @@
 // CramSim includes
 //#include "c_BankCommand.hpp"
 //#include "c_BankInfo.hpp"
+#include "c_TimingParams.hpp"
 
 namespace SST {
 namespace CramSim {
@@ -72,13 +73,22 @@ public:
     virtual bool isCommandAllowed(c_BankCommand* x_cmdPtr,
             c_BankInfo* x_bankPtr) = 0;
 
+    // number of following clockTic calls which would only count timers down, 0 if the state has work pending
+    virtual SimTime_t getIdleCycles() {
+        return 0;
+    }
+
+    // same as x_cycles calls to clockTic, x_cycles must not exceed getIdleCycles()
+    virtual void skipCycles(SimTime_t x_cycles) {
+    }
+
     e_BankState getCurrentState() {
         return m_currentState;
     }
 
 //private:
 protected:
-    std::map<std::string, unsigned>* m_bankParams;
+    c_TimingParams* m_bankParams;
 
     e_BankState m_currentState;
 
@@ -41,7 +41,7 @@
 using namespace SST;
 using namespace SST::CramSim;
 
-c_BankStateActivating::c_BankStateActivating(std::map<std::string, unsigned>* x_bankParams) :
+c_BankStateActivating::c_BankStateActivating(c_TimingParams* x_bankParams) :
     m_receivedCommandPtr(nullptr) {
 
         //Simulation::getSimulation()->getSimulationOutput().output("Entered %s\n", __PRETTY_FUNCTION__);
@@ -80,7 +80,7 @@ void c_BankStateActivating::enter(c_BankInfo* x_bank,
         //Simulation::getSimulation()->getSimulationOutput().output("Entered %s\n", __PRETTY_FUNCTION__);
 
     // set timer for auto precharge countdown used in the pseudo-open page policy
-    x_bank->setAutoPreTimer(m_bankParams->at("nRAS"));
+    x_bank->setAutoPreTimer(m_bankParams->nRAS);
     x_bank->setRowOpen();
     x_bank->setOpenRowNum(x_cmdPtr->getHashedAddress()->getRow());
 
@@ -49,7 +49,7 @@ class c_BankStateActivating: public c_BankState {
 
 public:
 
-    c_BankStateActivating(std::map<std::string, unsigned>* x_bankParams);
+    c_BankStateActivating(c_TimingParams* x_bankParams);
     ~c_BankStateActivating();
 
     virtual void handleCommand(c_BankInfo* x_bank, c_BankCommand* x_bankCommandPtr, SimTime_t x_cycle);
@@ -32,6 +32,7 @@
 // C++ includes
 #include <memory>
 #include <algorithm>
+#include <limits>
 #include <list>
 #include <assert.h>
 
@@ -50,7 +51,7 @@ using namespace SST;
 using namespace SST::CramSim;
 
 c_BankStateActive::c_BankStateActive(
-        std::map<std::string, unsigned>* x_bankParams) :
+        c_TimingParams* x_bankParams) :
         m_receivedCommandPtr(nullptr) {
                 // Simulation::getSimulation()->getSimulationOutput().output("Entered %s\n", __PRETTY_FUNCTION__);
 
@@ -120,6 +121,17 @@ void c_BankStateActive::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
     }
 }
 
+SimTime_t c_BankStateActive::getIdleCycles() {
+    if (m_receivedCommandPtr)
+        return m_timer;
+
+    return std::numeric_limits<SimTime_t>::max();
+}
+
+void c_BankStateActive::skipCycles(SimTime_t x_cycles) {
+    m_timer = (m_timer > x_cycles) ? m_timer - x_cycles : 0;
+}
+
 void c_BankStateActive::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
         c_BankCommand* x_cmdPtr, SimTime_t x_cycle) {
 
@@ -140,42 +152,42 @@ void c_BankStateActive::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
     m_receivedCommandPtr = nullptr;
 
 
-    m_timer = m_bankParams->at("nCCD_L") - 2;
+    m_timer = m_bankParams->nCCD_L - 2;
 
     m_allowedCommands.clear();
     m_allowedCommands.push_back(e_BankCommandType::READ);
     x_bank->setNextCommandCycle(e_BankCommandType::READ,
             std::max(x_bank->getNextCommandCycle(e_BankCommandType::READ),
-                 l_time + m_bankParams->at("nRCD") - 2));
+                 l_time + m_bankParams->nRCD - 2));
 
     m_allowedCommands.push_back(e_BankCommandType::READA);
     x_bank->setNextCommandCycle(e_BankCommandType::READA,
             std::max(x_bank->getNextCommandCycle(e_BankCommandType::READA),
-                 l_time + m_bankParams->at("nRCD") - 2));
+                 l_time + m_bankParams->nRCD - 2));
 
     m_allowedCommands.push_back(e_BankCommandType::WRITE);
     x_bank->setNextCommandCycle(e_BankCommandType::WRITE,
             std::max(x_bank->getNextCommandCycle(e_BankCommandType::WRITE),
-                 l_time + m_bankParams->at("nRCD") - 2));
+                 l_time + m_bankParams->nRCD - 2));
 
     m_allowedCommands.push_back(e_BankCommandType::WRITEA);
     x_bank->setNextCommandCycle(e_BankCommandType::WRITEA,
             std::max(x_bank->getNextCommandCycle(e_BankCommandType::WRITEA),
-                 l_time + m_bankParams->at("nRCD") - 2));
+                 l_time + m_bankParams->nRCD - 2));
 
     m_allowedCommands.push_back(e_BankCommandType::PRE);
     x_bank->setNextCommandCycle(e_BankCommandType::PRE,
                     (std::max(x_bank->getNextCommandCycle(e_BankCommandType::PRE),
                           std::max(
                                x_bank->getLastCommandCycle(e_BankCommandType::ACT)
-                               + m_bankParams->at("nRAS"),
+                               + m_bankParams->nRAS,
                                std::max(
                                 x_bank->getLastCommandCycle(
                                                 e_BankCommandType::WRITE)
-                                + m_bankParams->at("nWR"),
+                                + m_bankParams->nWR,
                                 x_bank->getLastCommandCycle(
                                                 e_BankCommandType::READ)
-                                + m_bankParams->at("nRTP"))))));
+                                + m_bankParams->nRTP)))));
 
     x_bank->changeState(this);
     if (nullptr != x_prevState)
@@ -47,13 +47,17 @@ class c_BankStateActive: public c_BankState {
 
 public:
 
-    c_BankStateActive(std::map<std::string, unsigned>* x_bankParams);
+    c_BankStateActive(c_TimingParams* x_bankParams);
     ~c_BankStateActive();
 
     virtual void handleCommand(c_BankInfo* x_bank, c_BankCommand* x_bankCommandPtr, SimTime_t x_simCycle);
 
     virtual void clockTic(c_BankInfo* x_bank, SimTime_t x_simCycle);
 
+    virtual SimTime_t getIdleCycles();
+
+    virtual void skipCycles(SimTime_t x_cycles);
+
     virtual void enter(c_BankInfo* x_bank, c_BankState* x_prevState, c_BankCommand* x_cmdPtr, SimTime_t x_simCycle);
 
     virtual std::list<e_BankCommandType> getAllowedCommands();
@@ -45,7 +45,7 @@
 using namespace SST;
 using namespace SST::CramSim;
 
-c_BankStateIdle::c_BankStateIdle(std::map<std::string, unsigned>* x_bankParams) :
+c_BankStateIdle::c_BankStateIdle(c_TimingParams* x_bankParams) :
         m_receivedCommandPtr(nullptr), m_timer(0) {
     //Simulation::getSimulation()->getSimulationOutput().output("Entered %s\n", __PRETTY_FUNCTION__);
     m_bankParams = x_bankParams;
@@ -125,6 +125,19 @@ void c_BankStateIdle::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
     }
 }
 
+// the only event left without a received command is the previous command's response, readied when m_timer
+// counts down from 2. m_timer keeps counting down (and wraps) every cycle, so the distance to 2 wraps as well.
+SimTime_t c_BankStateIdle::getIdleCycles() {
+    if (m_receivedCommandPtr)
+        return 0;
+
+    return m_timer - 2;
+}
+
+void c_BankStateIdle::skipCycles(SimTime_t x_cycles) {
+    m_timer -= x_cycles;
+}
+
 // call this function after receiving a command
 void c_BankStateIdle::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
         c_BankCommand* x_cmdPtr, SimTime_t x_cycle) {
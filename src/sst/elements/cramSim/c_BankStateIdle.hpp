@@ -48,12 +48,17 @@ class c_BankStateIdle: public c_BankState {
 
 public:
 
-    c_BankStateIdle(std::map<std::string, unsigned>* x_bankParams);
+    c_BankStateIdle(c_TimingParams* x_bankParams);
     ~c_BankStateIdle();
 
     virtual void handleCommand(c_BankInfo* x_bank, c_BankCommand* x_bankCommandPtr, SimTime_t x_cycle);
 
     virtual void clockTic(c_BankInfo* x_bank, SimTime_t x_cycle);
+
+    virtual SimTime_t getIdleCycles();
+
+    virtual void skipCycles(SimTime_t x_cycles);
+
     virtual void enter(c_BankInfo* x_bank, c_BankState* x_prevState, c_BankCommand* x_cmdPtr, SimTime_t x_cycle);
     virtual std::list<e_BankCommandType> getAllowedCommands();
 
@@ -47,7 +47,7 @@ class c_BankStatePrecharge: public c_BankState {
 
 public:
 
-    c_BankStatePrecharge(std::map<std::string, unsigned>* x_bankParams);
+    c_BankStatePrecharge(c_TimingParams* x_bankParams);
     ~c_BankStatePrecharge();
 
     virtual void handleCommand(c_BankInfo* x_bank, c_BankCommand* x_bankCommandPtr, SimTime_t x_cycle);
@@ -47,7 +47,7 @@
 using namespace SST;
 using namespace SST::CramSim;
 
-c_BankStateRead::c_BankStateRead(std::map<std::string, unsigned>* x_bankParams) :
+c_BankStateRead::c_BankStateRead(c_TimingParams* x_bankParams) :
         m_receivedCommandPtr(nullptr) {
 
     m_currentState = e_BankState::READ;
@@ -115,8 +115,8 @@ void c_BankStateRead::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
                         if ((l_time
                                 - (x_bank->getLastCommandCycle(
                                         e_BankCommandType::READ)))
-                                < m_bankParams->at("nRTW")) {
-                            m_timerExit = m_bankParams->at("nRTW")
+                                < m_bankParams->nRTW) {
+                            m_timerExit = m_bankParams->nRTW
                                     - (l_time
                                             - (x_bank->getLastCommandCycle(
                                                     e_BankCommandType::READ)));
@@ -124,7 +124,7 @@ void c_BankStateRead::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
                             m_timerExit = 0;
                         }
                     } else {
-                        m_timerExit = m_bankParams->at("nRTW");
+                        m_timerExit = m_bankParams->nRTW;
                     }
                     break;
                 case e_BankCommandType::READ:
@@ -137,8 +137,8 @@ void c_BankStateRead::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
                         if ((l_time
                                 - (x_bank->getLastCommandCycle(
                                         e_BankCommandType::READ)))
-                                < m_bankParams->at("nRTP")) {
-                            m_timerExit = m_bankParams->at("nRTP")
+                                < m_bankParams->nRTP) {
+                            m_timerExit = m_bankParams->nRTP
                                     - (l_time
                                             - (x_bank->getLastCommandCycle(
                                                     e_BankCommandType::READ)));
@@ -146,7 +146,7 @@ void c_BankStateRead::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
                             m_timerExit = 0;
                         }
                     } else {
-                        m_timerExit = m_bankParams->at("nRTP") - 1;
+                        m_timerExit = m_bankParams->nRTP - 1;
                     }
                     break;
                 default:
@@ -179,12 +179,12 @@ void c_BankStateRead::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 
         switch (m_prevCommandPtr->getCommandMnemonic()) {
         case e_BankCommandType::WRITE:
-            m_timer = m_bankParams->at("nCL") - m_bankParams->at("nCWL")
-                    + m_bankParams->at("nBL");
+            m_timer = m_bankParams->nCL - m_bankParams->nCWL
+                    + m_bankParams->nBL;
             break;
         case e_BankCommandType::READ:
-            m_timer = std::max(m_bankParams->at("nCCD_L"),
-                    m_bankParams->at("nBL"))-1;
+            m_timer = std::max(m_bankParams->nCCD_L,
+                    m_bankParams->nBL)-1;
             break;
         case e_BankCommandType::ACT:
             m_timer = 0;
@@ -206,42 +206,42 @@ void c_BankStateRead::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
     x_bank->setNextCommandCycle(e_BankCommandType::READ,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::READ),
                     x_bank->getLastCommandCycle(e_BankCommandType::READ)
-                            + m_bankParams->at("nCCD_L"))));
+                            + m_bankParams->nCCD_L)));
 
     m_allowedCommands.push_back(e_BankCommandType::READA);
     x_bank->setNextCommandCycle(e_BankCommandType::READA,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::READA),
                     x_bank->getLastCommandCycle(e_BankCommandType::READ)
-                            + m_bankParams->at("nCCD_L"))));
+                            + m_bankParams->nCCD_L)));
 
 //  FIXME: below for write going to the same row as the previous WRITE command
     m_allowedCommands.push_back(e_BankCommandType::WRITE);
     x_bank->setNextCommandCycle(e_BankCommandType::WRITE,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::WRITE),
                     x_bank->getLastCommandCycle(e_BankCommandType::READ)
-                            + m_bankParams->at("nCWL") + m_bankParams->at("nBL")
-                            + m_bankParams->at("nWTR"))));
+                            + m_bankParams->nCWL + m_bankParams->nBL
+                            + m_bankParams->nWTR)));
 
     m_allowedCommands.push_back(e_BankCommandType::WRITEA);
     x_bank->setNextCommandCycle(e_BankCommandType::WRITEA,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::WRITEA),
                     x_bank->getLastCommandCycle(e_BankCommandType::READ)
-                            + m_bankParams->at("nCWL") + m_bankParams->at("nBL")
-                            + m_bankParams->at("nWTR"))));
+                            + m_bankParams->nCWL + m_bankParams->nBL
+                            + m_bankParams->nWTR)));
 
     m_allowedCommands.push_back(e_BankCommandType::PRE);
     x_bank->setNextCommandCycle(e_BankCommandType::PRE,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::PRE),
                     std::max(
                             x_bank->getLastCommandCycle(e_BankCommandType::ACT)
-                                    + m_bankParams->at("nRAS"),
+                                    + m_bankParams->nRAS,
                             std::max(
                                     x_bank->getLastCommandCycle(
                                             e_BankCommandType::READA)
-                                            + m_bankParams->at("nRTP"),
+                                            + m_bankParams->nRTP,
                                     x_bank->getLastCommandCycle(
                                             e_BankCommandType::READ)
-                                            + m_bankParams->at("nRTP"))))));
+                                            + m_bankParams->nRTP)))));
     x_bank->changeState(this);
     if (nullptr != x_prevState)
         delete x_prevState;
@@ -44,7 +44,7 @@ class c_BankStateRead: public c_BankState {
 
 public:
 
-    c_BankStateRead(std::map<std::string, unsigned>* x_bankParams);
+    c_BankStateRead(c_TimingParams* x_bankParams);
     ~c_BankStateRead();
 
     virtual void handleCommand(c_BankInfo* x_bank, c_BankCommand* x_bankCommandPtr, SimTime_t x_cycle);
@@ -44,7 +44,7 @@ using namespace SST;
 using namespace SST::CramSim;
 
 c_BankStateReadA::c_BankStateReadA(
-        std::map<std::string, unsigned>* x_bankParams) {
+        c_TimingParams* x_bankParams) {
 
         // Simulation::getSimulation()->getSimulationOutput().output("Entered %s\n", __PRETTY_FUNCTION__);
     m_timerEnter = 0;
@@ -78,14 +78,14 @@ void c_BankStateReadA::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
                     x_bank->getNextCommandCycle(e_BankCommandType::PRE),
                     std::max(
                             x_bank->getLastCommandCycle(e_BankCommandType::ACT)
-                                    + m_bankParams->at("nRAS"),
+                                    + m_bankParams->nRAS,
                             std::max(
                                     x_bank->getLastCommandCycle(
                                             e_BankCommandType::READA)
-                                            + m_bankParams->at("nRTP"),
+                                            + m_bankParams->nRTP,
                                     x_bank->getLastCommandCycle(
                                             e_BankCommandType::READ)
-                                            + m_bankParams->at("nRTP")))) - 1;
+                                            + m_bankParams->nRTP))) - 1;
             m_timerExit = 0;
             if (l_time < l_nextCycle) {
                 m_timerExit = l_nextCycle - l_time;
@@ -115,8 +115,8 @@ void c_BankStateReadA::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 
         switch (m_prevCommandPtr->getCommandMnemonic()) {
         case e_BankCommandType::READA:
-            m_timerEnter = std::max(m_bankParams->at("nCCD_L"),
-                    m_bankParams->at("nBL")) - 1;
+            m_timerEnter = std::max(m_bankParams->nCCD_L,
+                    m_bankParams->nBL) - 1;
             break;
         default:
             Output::getDefaultObject().fatal(CALL_INFO, -1, "%s: Unrecognized state\n", __PRETTY_FUNCTION__);
@@ -135,33 +135,33 @@ void c_BankStateReadA::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
     x_bank->setNextCommandCycle(e_BankCommandType::READ,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::READ),
                     x_bank->getLastCommandCycle(e_BankCommandType::READ)
-                            + m_bankParams->at("nCCD_L"))) - 1);
+                            + m_bankParams->nCCD_L)) - 1);
     x_bank->setNextCommandCycle(e_BankCommandType::READA,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::READA),
                     x_bank->getLastCommandCycle(e_BankCommandType::READ)
-                            + m_bankParams->at("nCCD_L"))) - 1);
+                            + m_bankParams->nCCD_L)) - 1);
     x_bank->setNextCommandCycle(e_BankCommandType::WRITE,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::WRITE),
                     x_bank->getLastCommandCycle(e_BankCommandType::READ)
-                            + m_bankParams->at("nCWL") + m_bankParams->at("nBL")
-                            + m_bankParams->at("nWTR")) - 1));
+                            + m_bankParams->nCWL + m_bankParams->nBL
+                            + m_bankParams->nWTR) - 1));
     x_bank->setNextCommandCycle(e_BankCommandType::WRITEA,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::WRITEA),
                     x_bank->getLastCommandCycle(e_BankCommandType::READ)
-                            + m_bankParams->at("nCWL") + m_bankParams->at("nBL")
-                            + m_bankParams->at("nWTR")) - 1));
+                            + m_bankParams->nCWL + m_bankParams->nBL
+                            + m_bankParams->nWTR) - 1));
     x_bank->setNextCommandCycle(e_BankCommandType::PRE,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::PRE),
                     std::max(
                             x_bank->getLastCommandCycle(e_BankCommandType::ACT)
-                                    + m_bankParams->at("nRAS"),
+                                    + m_bankParams->nRAS,
                             std::max(
                                     x_bank->getLastCommandCycle(
                                             e_BankCommandType::READA)
-                                            + m_bankParams->at("nRTP"),
+                                            + m_bankParams->nRTP,
                                     x_bank->getLastCommandCycle(
                                             e_BankCommandType::READ)
-                                            + m_bankParams->at("nRTP"))))) - 1);
+                                            + m_bankParams->nRTP)))) - 1);
 
     x_bank->changeState(this);
     if (nullptr != x_prevState)
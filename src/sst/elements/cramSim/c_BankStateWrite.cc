@@ -47,7 +47,7 @@ using namespace SST;
 using namespace SST::CramSim;
 
 c_BankStateWrite::c_BankStateWrite(
-        std::map<std::string, unsigned>* x_bankParams) :
+        c_TimingParams* x_bankParams) :
         m_receivedCommandPtr(nullptr) {
     // Simulation::getSimulation()->getSimulationOutput().output("\n%s\n", __PRETTY_FUNCTION__);
     m_bankParams = x_bankParams;
@@ -117,51 +117,51 @@ void c_BankStateWrite::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
                     if ((l_time)
                             > (x_bank->getLastCommandCycle(
                                     e_BankCommandType::WRITE)
-                                    + m_bankParams->at("nWR")
-                                    + m_bankParams->at("nWTR"))) {
+                                    + m_bankParams->nWR
+                                    + m_bankParams->nWTR)) {
                         if ((l_time
                                 - (x_bank->getLastCommandCycle(
                                         e_BankCommandType::WRITE)
-                                        + m_bankParams->at("nWR")
-                                        + m_bankParams->at("nWTR")))
-                                < (m_bankParams->at("nWR")
-                                        + m_bankParams->at("nWTR"))) {
-                            m_timerExit = m_bankParams->at("nWR")
-                                    + m_bankParams->at("nWTR")
+                                        + m_bankParams->nWR
+                                        + m_bankParams->nWTR))
+                                < (m_bankParams->nWR
+                                        + m_bankParams->nWTR)) {
+                            m_timerExit = m_bankParams->nWR
+                                    + m_bankParams->nWTR
                                     - (l_time
                                             - (x_bank->getLastCommandCycle(
                                                     e_BankCommandType::WRITE)
-                                                    + m_bankParams->at("nWR")
-                                                    + m_bankParams->at("nWTR")));
+                                                    + m_bankParams->nWR
+                                                    + m_bankParams->nWTR));
                         } else {
                             m_timerExit = 0;
                         }
                     } else {
-                        m_timerExit = m_bankParams->at("nWR")
-                                + m_bankParams->at("nWTR");
+                        m_timerExit = m_bankParams->nWR
+                                + m_bankParams->nWTR;
                     }
                     break;
                 case e_BankCommandType::PRE:
                     if ((l_time)
                             > (x_bank->getLastCommandCycle(
                                     e_BankCommandType::WRITE)
-                                    + m_bankParams->at("nWR"))) {
+                                    + m_bankParams->nWR)) {
                         if ((l_time
                                 - (x_bank->getLastCommandCycle(
                                         e_BankCommandType::WRITE)
-                                        + m_bankParams->at("nWR")))
-                                < m_bankParams->at("nWR")) {
-                            m_timerExit = m_bankParams->at("nWR")
+                                        + m_bankParams->nWR))
+                                < m_bankParams->nWR) {
+                            m_timerExit = m_bankParams->nWR
                                     - (l_time
                                             - (x_bank->getLastCommandCycle(
                                                     e_BankCommandType::WRITE)
-                                                    + m_bankParams->at("nWR")));
+                                                    + m_bankParams->nWR));
 
                         } else {
                             m_timerExit = 0;
                         }
                     } else {
-                        m_timerExit = m_bankParams->at("nWR");
+                        m_timerExit = m_bankParams->nWR;
                     }
                     break;
                 default:
@@ -193,12 +193,12 @@ void c_BankStateWrite::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 
         switch (m_prevCommandPtr->getCommandMnemonic()) {
         case e_BankCommandType::WRITE:
-            m_timer = std::max(m_bankParams->at("nCCD_L"),
-                    m_bankParams->at("nBL"));
+            m_timer = std::max(m_bankParams->nCCD_L,
+                    m_bankParams->nBL);
             break;
         case e_BankCommandType::READ:
         case e_BankCommandType::ACT:
-            m_timer = m_bankParams->at("nBL") + m_bankParams->at("nCWL");
+            m_timer = m_bankParams->nBL + m_bankParams->nCWL;
             break;
         default:
             Output::getDefaultObject().fatal(CALL_INFO, -1, "Unrecognized state");
@@ -218,46 +218,46 @@ void c_BankStateWrite::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
     x_bank->setNextCommandCycle(e_BankCommandType::READ,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::READ),
                     x_bank->getLastCommandCycle(e_BankCommandType::WRITE)
-                            + m_bankParams->at("nCWL") + m_bankParams->at("nBL")
-                            + m_bankParams->at("nWTR_L"))));
+                            + m_bankParams->nCWL + m_bankParams->nBL
+                            + m_bankParams->nWTR_L)));
 
     m_allowedCommands.push_back(e_BankCommandType::READA);
     x_bank->setNextCommandCycle(e_BankCommandType::READA,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::READA),
                     x_bank->getLastCommandCycle(e_BankCommandType::WRITE)
-                            + m_bankParams->at("nCWL") + m_bankParams->at("nBL")
-                            + m_bankParams->at("nWTR_L"))));
+                            + m_bankParams->nCWL + m_bankParams->nBL
+                            + m_bankParams->nWTR_L)));
 
 //  FIXME: below for write going to the same row as the previous WRITE command
     m_allowedCommands.push_back(e_BankCommandType::WRITE);
     x_bank->setNextCommandCycle(e_BankCommandType::WRITE,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::WRITE),
                     x_bank->getLastCommandCycle(e_BankCommandType::WRITE)
-                            + m_bankParams->at("nCCD_L"))));
+                            + m_bankParams->nCCD_L)));
 
     m_allowedCommands.push_back(e_BankCommandType::WRITEA);
     x_bank->setNextCommandCycle(e_BankCommandType::WRITEA,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::WRITEA),
                     x_bank->getLastCommandCycle(e_BankCommandType::WRITE)
-                            + m_bankParams->at("nCCD_L"))));
+                            + m_bankParams->nCCD_L)));
 
     m_allowedCommands.push_back(e_BankCommandType::PRE);
     x_bank->setNextCommandCycle(e_BankCommandType::PRE,
             (std::max(x_bank->getNextCommandCycle(e_BankCommandType::PRE),
                     std::max(
                             x_bank->getLastCommandCycle(e_BankCommandType::ACT)
-                                    + m_bankParams->at("nRAS"),
+                                    + m_bankParams->nRAS,
                             std::max(
                                     x_bank->getLastCommandCycle(
                                             e_BankCommandType::WRITEA)
-                                            + m_bankParams->at("nCWL")
-                                            + m_bankParams->at("nBL")
-                                            + m_bankParams->at("nWR"),
+                                            + m_bankParams->nCWL
+                                            + m_bankParams->nBL
+                                            + m_bankParams->nWR,
                                     x_bank->getLastCommandCycle(
                                             e_BankCommandType::WRITE)
-                                            + m_bankParams->at("nCWL")
-                                            + m_bankParams->at("nBL")
-                                            + m_bankParams->at("nWR"))))));
+                                            + m_bankParams->nCWL
+                                            + m_bankParams->nBL
+                                            + m_bankParams->nWR)))));
     x_bank->changeState(this);
     if (nullptr != x_prevState)
         delete x_prevState;
@@ -40,12 +40,12 @@
 using namespace SST;
 using namespace SST::CramSim;
 
-c_Channel::c_Channel(std::map<std::string, unsigned>* x_bankParams) {
+c_Channel::c_Channel(c_TimingParams* x_bankParams) {
     m_bankParams = x_bankParams;
     m_rankPtrs.clear();
 }
 
-c_Channel::c_Channel(std::map<std::string, unsigned>* x_bankParams, unsigned x_chId) : c_Channel(x_bankParams) {
+c_Channel::c_Channel(c_TimingParams* x_bankParams, unsigned x_chId) : c_Channel(x_bankParams) {
         m_chId = x_chId;
 }
 
@@ -113,10 +113,10 @@ void c_Channel::updateOtherBanksNextCommandCycles(c_Rank* x_initRankPtr,
                                 l_bankPtr->getNextCommandCycle(
                                         e_BankCommandType::READA)),
                         l_time
-                                + std::max(m_bankParams->at("nBL"),
-                                        std::min(m_bankParams->at("nCCD_S"),
-                                                m_bankParams->at("nCCD_L")))
-                                + m_bankParams->at("nERTR"));
+                                + std::max(m_bankParams->nBL,
+                                        std::min(m_bankParams->nCCD_S,
+                                                m_bankParams->nCCD_L))
+                                + m_bankParams->nERTR);
 
                 l_bankPtr->setNextCommandCycle(e_BankCommandType::READ,
                         l_nextCycle);
@@ -131,12 +131,12 @@ void c_Channel::updateOtherBanksNextCommandCycles(c_Rank* x_initRankPtr,
                                 l_bankPtr->getNextCommandCycle(
                                         e_BankCommandType::WRITEA)),
                         l_time
-                                + m_bankParams->at("nCL")
-                                + std::max(m_bankParams->at("nBL"),
-                                        std::min(m_bankParams->at("nCCD_S"),
-                                                m_bankParams->at("nCCD_L")))
-                                + m_bankParams->at("nERTW")
-                                - m_bankParams->at("nCWL"));
+                                + m_bankParams->nCL
+                                + std::max(m_bankParams->nBL,
+                                        std::min(m_bankParams->nCCD_S,
+                                                m_bankParams->nCCD_L))
+                                + m_bankParams->nERTW
+                                - m_bankParams->nCWL);
 
 
                 l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITE,
@@ -156,12 +156,12 @@ void c_Channel::updateOtherBanksNextCommandCycles(c_Rank* x_initRankPtr,
                                 l_bankPtr->getNextCommandCycle(
                                         e_BankCommandType::READA)),
                         l_time
-                                + m_bankParams->at("nCWL")
-                                + std::max(m_bankParams->at("nBL"),
-                                        std::min(m_bankParams->at("nCCD_S"),
-                                                m_bankParams->at("nCCD_L")))
-                                + m_bankParams->at("nEWTR")
-                                - m_bankParams->at("nCL"));
+                                + m_bankParams->nCWL
+                                + std::max(m_bankParams->nBL,
+                                        std::min(m_bankParams->nCCD_S,
+                                                m_bankParams->nCCD_L))
+                                + m_bankParams->nEWTR
+                                - m_bankParams->nCL);
 
                 l_bankPtr->setNextCommandCycle(e_BankCommandType::READ,
                         l_nextCycle);
@@ -176,10 +176,10 @@ void c_Channel::updateOtherBanksNextCommandCycles(c_Rank* x_initRankPtr,
                                 l_bankPtr->getNextCommandCycle(
                                         e_BankCommandType::WRITEA)),
                         l_time
-                                + std::max(m_bankParams->at("nBL"),
-                                        std::min(m_bankParams->at("nCCD_S"),
-                                                m_bankParams->at("nCCD_L")))
-                                + m_bankParams->at("nEWTW"));
+                                + std::max(m_bankParams->nBL,
+                                        std::min(m_bankParams->nCCD_S,
+                                                m_bankParams->nCCD_L))
+                                + m_bankParams->nEWTW);
 
 
                 l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITE,
@@ -146,6 +146,31 @@ bool c_CmdScheduler::push(c_BankCommand* x_cmd) {
 }
 
 
+bool c_CmdScheduler::isEmpty()
+{
+    for (auto &l_chQueues : m_cmdQueues)
+        for (auto &l_cmdQueue : l_chQueues)
+            if (!l_cmdQueue.empty())
+                return false;
+
+    return true;
+}
+
+
+// With every queue empty, run() only advances the round robin index
+void c_CmdScheduler::skipCycles(SimTime_t x_cycles)
+{
+    for (unsigned l_ch = 0; l_ch < m_numChannels; l_ch++) {
+        if (m_schedulingPolicy == e_SchedulingPolicy::BANK)
+            m_nextCmdQIdx.at(l_ch) = (m_nextCmdQIdx.at(l_ch) + x_cycles % m_numBanksPerChannel) % m_numBanksPerChannel;
+        else if (m_schedulingPolicy == e_SchedulingPolicy::RANK) {
+            unsigned l_size = m_numBanksPerChannel - 1;
+            m_nextCmdQIdx.at(l_ch) = (m_nextCmdQIdx.at(l_ch) + (x_cycles % l_size) * (m_numBanksPerRank % l_size)) % l_size;
+        }
+    }
+}
+
+
 unsigned c_CmdScheduler::getToken(const c_HashedAddress &x_addr)
 {
     unsigned l_ch=x_addr.getChannel();
@@ -27,6 +27,8 @@
 
 #include "sst_config.h"
 
+#include <limits>
+
 #include "c_Controller.hpp"
 #include "c_TxnReqEvent.hpp"
 #include "c_TxnResEvent.hpp"
@@ -123,8 +125,17 @@ c_Controller::c_Controller(ComponentId_t id, Params &params) :
     configure_link();
 
     //set our clock
-    registerClock(k_controllerClockFreqStr,
-                  new Clock::Handler<c_Controller>(this, &c_Controller::clockTic));
+    m_clockHandler = new Clock::Handler<c_Controller>(this, &c_Controller::clockTic);
+    m_clockTC = registerClock(k_controllerClockFreqStr, m_clockHandler);
+
+    k_skipIdleCycles = (uint32_t)params.find<uint32_t>("boolSkipIdleCycles", 0, l_found);
+    m_isSleeping = false;
+    m_lastCycle = 0;
+    m_wakeLink = nullptr;
+    if (k_skipIdleCycles) {
+        m_wakeLink = configureSelfLink("wakeLink", m_clockTC,
+                                       new Event::Handler<c_Controller>(this, &c_Controller::handleWakeEvent));
+    }
 
 
 
@@ -219,11 +230,56 @@ bool c_Controller::clockTic(SST::Cycle_t clock) {
     // 6. run device driver
     m_deviceDriver->run();
 
+    // 7. stop the clock if nothing can happen for a while
+    if (k_skipIdleCycles && isIdle()) {
+        SimTime_t l_idleCycles = m_deviceDriver->getIdleCycles();
+        if (l_idleCycles > 1) {
+            m_isSleeping = true;
+            m_lastCycle = clock;
+
+            // otherwise only a new transaction wakes us up
+            if (l_idleCycles != std::numeric_limits<SimTime_t>::max())
+                m_wakeLink->send(l_idleCycles, new NullEvent());
+
+            return true;
+        }
+    }
 
     return false;
 }
 
 
+bool c_Controller::isIdle() {
+    return m_ReqQ.empty() && m_ResQ.empty()
+        && m_txnScheduler->isEmpty() && m_txnConverter->isEmpty()
+        && m_cmdScheduler->isEmpty() && m_deviceDriver->isIdle();
+}
+
+
+// restart the clock and catch up on the cycles which were skipped
+void c_Controller::wake() {
+    if (!m_isSleeping)
+        return;
+    m_isSleeping = false;
+
+    SST::Cycle_t l_nextCycle = reregisterClock(m_clockTC, m_clockHandler);
+    SimTime_t l_skipped = l_nextCycle - m_lastCycle - 1;
+
+    if (l_skipped > 0) {
+        m_simCycle += l_skipped;
+        m_txnConverter->skipCycles(l_skipped);
+        m_cmdScheduler->skipCycles(l_skipped);
+        m_deviceDriver->skipCycles(l_skipped);
+    }
+}
+
+
+void c_Controller::handleWakeEvent(SST::Event *ev) {
+    delete ev;
+    wake();
+}
+
+
 void c_Controller::sendCommand(c_BankCommand* cmd)
 {
      c_CmdReqEvent *l_cmdReqEventPtr = new c_CmdReqEvent();
@@ -275,6 +331,8 @@ void c_Controller::handleIncomingTransaction(SST::Event *ev){
         newTxn->print(debug,"[c_Controller.handleIncommingTransaction]",m_simCycle);
         #endif
 
+        wake();
+
         m_ReqQ.push_back(newTxn);
         m_ResQ.push_back(newTxn);
 
@@ -289,6 +347,8 @@ void c_Controller::handleIncomingTransaction(SST::Event *ev){
 void c_Controller::handleInDeviceResPtrEvent(SST::Event *ev){
     c_CmdResEvent* l_cmdResEventPtr = dynamic_cast<c_CmdResEvent*>(ev);
     if (l_cmdResEventPtr) {
+        wake();
+
         ulong l_resSeqNum = l_cmdResEventPtr->m_payload->getSeqNum();
         // need to find which txn matches the command seq number in the txnResQ
         c_Transaction* l_txnRes = nullptr;
@@ -65,7 +65,8 @@ namespace SST {
 
             SST_ELI_DOCUMENT_PARAMS(
                 {"verbose", "Output verbosity", "0"},
-                {"strControllerClockFrequency", "Controller clock frequency, with units", "1GHz" }
+                {"strControllerClockFrequency", "Controller clock frequency, with units", "1GHz" },
+                {"boolSkipIdleCycles", "Stop the clock while no transaction or command is queued and restart it when one arrives or a bank or refresh timer is due. Command timing is unchanged", "0"}
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -101,6 +102,11 @@ namespace SST {
 
             virtual bool clockTic(SST::Cycle_t); // called every cycle
 
+            // idle cycle skipping
+            bool isIdle();
+            void wake();
+            void handleWakeEvent(SST::Event *ev);
+
 
             void sendResponse();
             void sendRequest();
@@ -132,6 +138,14 @@ namespace SST {
             // clock frequency
             std::string k_controllerClockFreqStr;
 
+            // idle cycle skipping
+            int k_skipIdleCycles;
+            bool m_isSleeping;
+            SST::Cycle_t m_lastCycle;
+            TimeConverter *m_clockTC;
+            Clock::Handler<c_Controller> *m_clockHandler;
+            SST::Link *m_wakeLink;
+
             // Transaction Generator <-> Controller Links
             SST::Link *m_txngenLink;
             // Controller <-> Memory device Links
@@ -33,6 +33,7 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <limits>
 #include <assert.h>
 
 // CramSim includes
@@ -128,142 +129,142 @@ void c_DeviceDriver::build(Params& params) {
 
     /* Device timing parameters*/
     //FIXME: Move this param reading to inside of c_BankInfo
-    m_bankParams["nRC"] = (uint32_t) params.find<uint32_t>("nRC", 55, l_found);
+    m_bankParams.nRC = (uint32_t) params.find<uint32_t>("nRC", 55, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRC value is missing ... exiting\n");
     }
 
-    m_bankParams["nRRD"] = (uint32_t) params.find<uint32_t>("nRRD", 4, l_found);
+    m_bankParams.nRRD = (uint32_t) params.find<uint32_t>("nRRD", 4, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRRD value is missing ... exiting\n");
     }
 
-    m_bankParams["nRRD_L"] = (uint32_t) params.find<uint32_t>("nRRD_L", 6, l_found);
+    m_bankParams.nRRD_L = (uint32_t) params.find<uint32_t>("nRRD_L", 6, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRRD_L value is missing ... exiting\n");
     }
 
-    m_bankParams["nRRD_S"] = (uint32_t) params.find<uint32_t>("nRRD_S", 4, l_found);
+    m_bankParams.nRRD_S = (uint32_t) params.find<uint32_t>("nRRD_S", 4, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRRD_S value is missing ... exiting\n");
     }
 
-    m_bankParams["nRCD"] = (uint32_t) params.find<uint32_t>("nRCD", 16, l_found);
+    m_bankParams.nRCD = (uint32_t) params.find<uint32_t>("nRCD", 16, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRRD_L value is missing ... exiting\n");
     }
 
-    m_bankParams["nCCD"] = (uint32_t) params.find<uint32_t>("nCCD", 4, l_found);
+    m_bankParams.nCCD = (uint32_t) params.find<uint32_t>("nCCD", 4, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nCCD value is missing ... exiting\n");
     }
 
-    m_bankParams["nCCD_L"] = (uint32_t) params.find<uint32_t>("nCCD_L", 5, l_found);
+    m_bankParams.nCCD_L = (uint32_t) params.find<uint32_t>("nCCD_L", 5, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nCCD_L value is missing ... exiting\n");
     }
 
-    m_bankParams["nCCD_L_WR"] = (uint32_t) params.find<uint32_t>("nCCD_L_WR", 1, l_found);
+    m_bankParams.nCCD_L_WR = (uint32_t) params.find<uint32_t>("nCCD_L_WR", 1, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nCCD_L_WR value is missing ... exiting\n");
     }
 
-    m_bankParams["nCCD_S"] = (uint32_t) params.find<uint32_t>("nCCD_S", 4, l_found);
+    m_bankParams.nCCD_S = (uint32_t) params.find<uint32_t>("nCCD_S", 4, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nCCD_S value is missing ... exiting\n");
     }
 
-    m_bankParams["nAL"] = (uint32_t) params.find<uint32_t>("nAL", 15, l_found);
+    m_bankParams.nAL = (uint32_t) params.find<uint32_t>("nAL", 15, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nAL value is missing ... exiting\n");
     }
 
-    m_bankParams["nCL"] = (uint32_t) params.find<uint32_t>("nCL", 16, l_found);
+    m_bankParams.nCL = (uint32_t) params.find<uint32_t>("nCL", 16, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nCL value is missing ... exiting\n");
     }
 
-    m_bankParams["nCWL"] = (uint32_t) params.find<uint32_t>("nCWL", 16, l_found);
+    m_bankParams.nCWL = (uint32_t) params.find<uint32_t>("nCWL", 16, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nCWL value is missing ... exiting\n");
     }
 
-    m_bankParams["nWR"] = (uint32_t) params.find<uint32_t>("nWR", 16, l_found);
+    m_bankParams.nWR = (uint32_t) params.find<uint32_t>("nWR", 16, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nWR value is missing ... exiting\n");
     }
 
-    m_bankParams["nWTR"] = (uint32_t) params.find<uint32_t>("nWTR", 3, l_found);
+    m_bankParams.nWTR = (uint32_t) params.find<uint32_t>("nWTR", 3, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nWTR value is missing ... exiting\n");
     }
 
-    m_bankParams["nWTR_L"] = (uint32_t) params.find<uint32_t>("nWTR_L", 9, l_found);
+    m_bankParams.nWTR_L = (uint32_t) params.find<uint32_t>("nWTR_L", 9, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nWTR_L value is missing ... exiting\n");
     }
 
-    m_bankParams["nWTR_S"] = (uint32_t) params.find<uint32_t>("nWTR_S", 3, l_found);
+    m_bankParams.nWTR_S = (uint32_t) params.find<uint32_t>("nWTR_S", 3, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nWTR_S value is missing ... exiting\n");
     }
 
-    m_bankParams["nRTW"] = (uint32_t) params.find<uint32_t>("nRTW", 4, l_found);
+    m_bankParams.nRTW = (uint32_t) params.find<uint32_t>("nRTW", 4, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRTW value is missing ... exiting\n");
     }
 
-    m_bankParams["nEWTR"] = (uint32_t) params.find<uint32_t>("nEWTR", 6, l_found);
+    m_bankParams.nEWTR = (uint32_t) params.find<uint32_t>("nEWTR", 6, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nEWTR value is missing ... exiting\n");
     }
 
-    m_bankParams["nERTW"] = (uint32_t) params.find<uint32_t>("nERTW", 6, l_found);
+    m_bankParams.nERTW = (uint32_t) params.find<uint32_t>("nERTW", 6, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nERTW value is missing ... exiting\n");
     }
 
-    m_bankParams["nEWTW"] = (uint32_t) params.find<uint32_t>("nEWTW", 6, l_found);
+    m_bankParams.nEWTW = (uint32_t) params.find<uint32_t>("nEWTW", 6, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nEWTW value is missing ... exiting\n");
     }
 
-    m_bankParams["nERTR"] = (uint32_t) params.find<uint32_t>("nERTR", 6, l_found);
+    m_bankParams.nERTR = (uint32_t) params.find<uint32_t>("nERTR", 6, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nERTR value is missing ... exiting\n");
     }
 
-    m_bankParams["nRAS"] = (uint32_t) params.find<uint32_t>("nRAS", 39, l_found);
+    m_bankParams.nRAS = (uint32_t) params.find<uint32_t>("nRAS", 39, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRAS value is missing ... exiting\n");
     }
 
-    m_bankParams["nRTP"] = (uint32_t) params.find<uint32_t>("nRTP", 9, l_found);
+    m_bankParams.nRTP = (uint32_t) params.find<uint32_t>("nRTP", 9, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRTP value is missing ... exiting\n");
     }
 
-    m_bankParams["nRP"] = (uint32_t) params.find<uint32_t>("nRP", 16, l_found);
+    m_bankParams.nRP = (uint32_t) params.find<uint32_t>("nRP", 16, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRP value is missing ... exiting\n");
     }
 
-    m_bankParams["nRFC"] = (uint32_t) params.find<uint32_t>("nRFC", 420, l_found);
+    m_bankParams.nRFC = (uint32_t) params.find<uint32_t>("nRFC", 420, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nRFC value is missing ... exiting\n");
     }
 
-    m_bankParams["nREFI"] = (uint32_t) params.find<uint32_t>("nREFI", 9360, l_found);
+    m_bankParams.nREFI = (uint32_t) params.find<uint32_t>("nREFI", 9360, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nREFI value is missing ... exiting\n");
     }
 
-    m_bankParams["nFAW"] = (uint32_t) params.find<uint32_t>("nFAW", 16, l_found);
+    m_bankParams.nFAW = (uint32_t) params.find<uint32_t>("nFAW", 16, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nFAW value is missing ... exiting\n");
     }
 
-    m_bankParams["nBL"] = (uint32_t) params.find<uint32_t>("nBL", 4, l_found);
+    m_bankParams.nBL = (uint32_t) params.find<uint32_t>("nBL", 4, l_found);
     if (!l_found) {
         output->fatal(CALL_INFO, -1, "nBL value is missing ... exiting\n");
     }
@@ -407,7 +408,7 @@ void c_DeviceDriver::run() {
                 --m_currentREFICount[l_id];
             } else {
                 createRefreshCmds(l_id);
-                m_currentREFICount[l_id] = m_bankParams.at("nREFI");
+                m_currentREFICount[l_id] = m_bankParams.nREFI;
             }
 
             if (!m_refreshCmdQ[l_id].empty())
@@ -460,9 +461,8 @@ void c_DeviceDriver::update(SimTime_t simCycle) {
     }
     //update ACTFAWTracker info
     for (int l_rankNum = 0; l_rankNum < m_numRanks; l_rankNum++) {
-        m_cmdACTFAWtrackers[l_rankNum].push_back(
+        m_cmdACTFAWtrackers[l_rankNum].push(
                 m_isACTIssued[l_rankNum] ? static_cast<unsigned>(1) : static_cast<unsigned>(0));
-        m_cmdACTFAWtrackers[l_rankNum].pop_front();
     }
 
     // do the member var setup up before calling any req sending policy function
@@ -477,6 +477,69 @@ void c_DeviceDriver::update(SimTime_t simCycle) {
 }
 
 
+/*!
+ * @return "true" if no command is waiting to be issued or to be sent to the device
+ */
+bool c_DeviceDriver::isIdle() {
+    if (!m_inputQ.empty() || !m_outputQ.empty())
+        return false;
+
+    for (auto &l_cmdQ : m_refreshCmdQ)
+        if (!l_cmdQ.empty())
+            return false;
+
+    return true;
+}
+
+/*!
+ * @return number of following cycles in which update() and run() would only count down timers
+ */
+SimTime_t c_DeviceDriver::getIdleCycles() {
+    SimTime_t l_idleCycles = std::numeric_limits<SimTime_t>::max();
+
+    for (auto &l_bank : m_banks)
+        l_idleCycles = std::min(l_idleCycles, l_bank->getIdleCycles());
+
+    // a rank's refresh commands are created in the cycle its counter is found at 0
+    if (k_useRefresh)
+        for (auto &l_count : m_currentREFICount)
+            l_idleCycles = std::min(l_idleCycles, (SimTime_t) l_count);
+
+    return l_idleCycles;
+}
+
+/*!
+ * Same as x_cycles calls to update() and run() while idle
+ * @param x_cycles must not exceed getIdleCycles()
+ */
+void c_DeviceDriver::skipCycles(SimTime_t x_cycles) {
+    m_simCycle += x_cycles;
+
+    for (auto &l_bank : m_banks)
+        l_bank->skipCycles(x_cycles);
+
+    for (int l_rankNum = 0; l_rankNum < m_numRanks; l_rankNum++) {
+        c_ACTFAWTracker &l_tracker = m_cmdACTFAWtrackers[l_rankNum];
+        if (x_cycles > l_tracker.m_issued.size()) {
+            std::fill(l_tracker.m_issued.begin(), l_tracker.m_issued.end(), 0);
+            l_tracker.m_numIssued = 0;
+        } else {
+            l_tracker.push(m_isACTIssued[l_rankNum] ? 1 : 0);
+            for (SimTime_t l_i = 1; l_i < x_cycles; l_i++)
+                l_tracker.push(0);
+        }
+    }
+    m_isACTIssued.clear();
+    m_isACTIssued.resize(m_numRanks, false);
+
+    if (k_useRefresh)
+        for (auto &l_count : m_currentREFICount)
+            l_count -= x_cycles;
+
+    // the command bus is released twice a cycle and never held for more than two
+    std::fill(m_blockColCmd.begin(), m_blockColCmd.end(), 0);
+    std::fill(m_blockRowCmd.begin(), m_blockRowCmd.end(), 0);
+}
 
 
 /*!
@@ -636,8 +699,8 @@ void c_DeviceDriver::sendRequest() {
                                (m_lastPseudoChannel != (l_cmdPtr->getHashedAddress()->getPChannel())) ||
                                (m_lastChannel !=(l_cmdPtr->getHashedAddress()->getChannel())) ||
                                (m_simCycle - m_lastDataCmdIssueCycle) >=
-                               (std::min(m_bankParams.at("nBL"),
-                                         std::max(m_bankParams.at("nCCD_L"), m_bankParams.at("nCCD_S")))));
+                               (std::min(m_bankParams.nBL,
+                                         std::max(m_bankParams.nCCD_L, m_bankParams.nCCD_S))));
 
                         m_lastChannel = ((l_cmdPtr))->getHashedAddress()->getChannel();
                         m_lastDataCmdIssueCycle = m_simCycle;
@@ -879,9 +942,10 @@ void c_DeviceDriver::initACTFAWTracker()
     m_cmdACTFAWtrackers.clear();
     for(int i=0; i<m_numRanks;i++)
     {
-        std::list<unsigned> l_cmdACTFAWTracker;
-        l_cmdACTFAWTracker.clear();
-        l_cmdACTFAWTracker.resize(m_bankParams.at("nFAW")-1, 0);
+        c_ACTFAWTracker l_cmdACTFAWTracker;
+        l_cmdACTFAWTracker.m_issued.resize(m_bankParams.nFAW-1, 0);
+        l_cmdACTFAWTracker.m_head = 0;
+        l_cmdACTFAWTracker.m_numIssued = 0;
         m_cmdACTFAWtrackers.push_back(l_cmdACTFAWTracker);
     }
 }
@@ -899,7 +963,7 @@ void c_DeviceDriver::initRefresh() {
     for(int i=0;i<m_numRanks;i++)
     {
         //refresh commands are timely interleaved to ranks.
-        m_currentREFICount[i]=m_bankParams.at("nREFI")/(i+1);
+        m_currentREFICount[i]=m_bankParams.nREFI/(i+1);
         m_nextBankToRefresh[i]=0;
     }
 }
@@ -914,11 +978,8 @@ unsigned c_DeviceDriver::getNumIssuedACTinFAW(unsigned x_rankid) {
     assert(x_rankid<m_numRanks);
 
     // get count of ACT cmds issued in the FAW
-    unsigned l_cmdACTIssuedInFAW = 0;
-    assert(m_cmdACTFAWtrackers[x_rankid].size() == m_bankParams.at("nFAW")-1);
-    for(auto& l_issued : m_cmdACTFAWtrackers[x_rankid])
-        l_cmdACTIssuedInFAW += l_issued;
-    return l_cmdACTIssuedInFAW;
+    assert(m_cmdACTFAWtrackers[x_rankid].m_issued.size() == m_bankParams.nFAW-1);
+    return m_cmdACTFAWtrackers[x_rankid].m_numIssued;
 }
 
 /*!
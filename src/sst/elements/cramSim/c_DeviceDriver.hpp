@@ -137,6 +137,11 @@ public:
     virtual c_BankInfo* getBankInfo(unsigned x_bankId);
     void update(SimTime_t simCycle);
 
+    // idle cycle skipping, see c_Controller
+    bool isIdle();
+    SimTime_t getIdleCycles();
+    void skipCycles(SimTime_t x_cycles);
+
     unsigned getNumChannel(){return k_numChannels;}
     unsigned getNumPChPerChannel(){return k_numPChannelsPerChannel;}
     unsigned getNumRanksPerChannel(){return k_numRanksPerChannel;}
@@ -184,7 +189,21 @@ private:
     e_BankCommandType m_lastDataCmdType;
     unsigned m_lastChannel;
     unsigned m_lastPseudoChannel;
-    std::vector<std::list<unsigned>> m_cmdACTFAWtrackers; // FIXME: change this to a circular buffer for speed. Could also implement as shift register.
+    // per-rank ring buffer of the ACT commands issued over the last nFAW-1 cycles
+    struct c_ACTFAWTracker {
+        std::vector<unsigned> m_issued;
+        unsigned m_head;
+        unsigned m_numIssued;
+
+        void push(unsigned x_issued) {
+            if (m_issued.empty())
+                return;
+            m_numIssued = m_numIssued - m_issued[m_head] + x_issued;
+            m_issued[m_head] = x_issued;
+            m_head = (m_head + 1) % m_issued.size();
+        }
+    };
+    std::vector<c_ACTFAWTracker> m_cmdACTFAWtrackers;
     std::vector<bool> m_isACTIssued;
     bool m_issuedACT;
 
@@ -208,7 +227,7 @@ private:
     std::vector<c_BankGroup*> m_bankGroups;
     std::vector<c_Rank*> m_ranks;
     std::vector<c_Channel*> m_channel;
-    std::map<std::string, unsigned> m_bankParams;
+    c_TimingParams m_bankParams;
 
 
     int m_numChannels;
@@ -41,7 +41,7 @@
 using namespace SST;
 using namespace SST::CramSim;
 
-c_Rank::c_Rank(std::map<std::string, unsigned>* x_bankParams) {
+c_Rank::c_Rank(c_TimingParams* x_bankParams) {
     m_channelPtr = nullptr;
     m_bankParams = x_bankParams;
     m_allBankPtrs.clear();
@@ -109,7 +109,7 @@ void c_Rank::updateOtherBanksNextCommandCycles(c_BankGroup* x_initBankGroupPtr,
       case e_BankCommandType::ACT: {
     SimTime_t l_nextCycle = std::max(
                      l_bankPtr->getNextCommandCycle(e_BankCommandType::ACT),
-                     l_time + m_bankParams->at("nRRD_S"));
+                     l_time + m_bankParams->nRRD_S);
     l_bankPtr->setNextCommandCycle(e_BankCommandType::ACT,
                        l_nextCycle);
     break;
@@ -124,8 +124,8 @@ void c_Rank::updateOtherBanksNextCommandCycles(c_BankGroup* x_initBankGroupPtr,
                           l_bankPtr->getNextCommandCycle(
                                          e_BankCommandType::READA)),
                      l_time
-                     + std::max(m_bankParams->at("nCCD_S"),
-                            m_bankParams->at("nBL")));
+                     + std::max(m_bankParams->nCCD_S,
+                            m_bankParams->nBL));
 
     l_bankPtr->setNextCommandCycle(e_BankCommandType::READ,
                        l_nextCycle);
@@ -139,10 +139,10 @@ void c_Rank::updateOtherBanksNextCommandCycles(c_BankGroup* x_initBankGroupPtr,
                                        e_BankCommandType::WRITE),
                     l_bankPtr->getNextCommandCycle(
                                        e_BankCommandType::WRITEA)),
-                   l_time + m_bankParams->at("nCL")
-                   + m_bankParams->at("nBL")
-                   + m_bankParams->at("nRTW")
-                   - m_bankParams->at("nCWL"));
+                   l_time + m_bankParams->nCL
+                   + m_bankParams->nBL
+                   + m_bankParams->nRTW
+                   - m_bankParams->nCWL);
 
     l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITE,
                        l_nextCycle);
@@ -160,9 +160,9 @@ void c_Rank::updateOtherBanksNextCommandCycles(c_BankGroup* x_initBankGroupPtr,
                                          e_BankCommandType::READ),
                           l_bankPtr->getNextCommandCycle(
                                          e_BankCommandType::READA)),
-                     l_time + m_bankParams->at("nCWL")
-                     + m_bankParams->at("nBL")
-                     + m_bankParams->at("nWTR_S"));
+                     l_time + m_bankParams->nCWL
+                     + m_bankParams->nBL
+                     + m_bankParams->nWTR_S);
 
     l_bankPtr->setNextCommandCycle(e_BankCommandType::READ,
                        l_nextCycle);
@@ -177,8 +177,8 @@ void c_Rank::updateOtherBanksNextCommandCycles(c_BankGroup* x_initBankGroupPtr,
                     l_bankPtr->getNextCommandCycle(
                                        e_BankCommandType::WRITEA)),
                    l_time
-                   + std::max(m_bankParams->at("nCCD_S"),
-                      m_bankParams->at("nBL")));
+                   + std::max(m_bankParams->nCCD_S,
+                      m_bankParams->nBL));
     l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITE,
                        l_nextCycle);
     l_bankPtr->setNextCommandCycle(e_BankCommandType::WRITEA,
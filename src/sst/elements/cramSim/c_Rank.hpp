@@ -64,7 +64,7 @@ class c_BankCommand;
       return (x_stream);
     }
 
-    c_Rank(std::map<std::string, unsigned>* x_bankParams);
+    c_Rank(c_TimingParams* x_bankParams);
     virtual ~c_Rank();
 
     void acceptBankGroup(c_BankGroup* x_bankGroupPtr);
@@ -84,7 +84,7 @@ class c_BankCommand;
     c_Channel* m_channelPtr;
     std::vector<c_BankGroup*> m_bankGroupPtrs;
       std::vector<c_BankInfo*> m_allBankPtrs;
-    std::map<std::string, unsigned>* m_bankParams;
+    c_TimingParams* m_bankParams;
 
   };
 
@@ -0,0 +1,71 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Copyright 2016 IBM Corporation
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//   http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef C_TIMINGPARAMS_HPP
+#define C_TIMINGPARAMS_HPP
+
+namespace SST {
+namespace CramSim {
+
+// Device timing parameters in clock cycles, read once by c_DeviceDriver and
+// shared by the channels, ranks, bank groups and bank states
+struct c_TimingParams {
+    unsigned nRC;
+    unsigned nRRD;
+    unsigned nRRD_L;
+    unsigned nRRD_S;
+    unsigned nRCD;
+    unsigned nCCD;
+    unsigned nCCD_L;
+    unsigned nCCD_L_WR;
+    unsigned nCCD_S;
+    unsigned nAL;
+    unsigned nCL;
+    unsigned nCWL;
+    unsigned nWR;
+    unsigned nWTR;
+    unsigned nWTR_L;
+    unsigned nWTR_S;
+    unsigned nRTW;
+    unsigned nEWTR;
+    unsigned nERTW;
+    unsigned nEWTW;
+    unsigned nERTR;
+    unsigned nRAS;
+    unsigned nRTP;
+    unsigned nRP;
+    unsigned nRFC;
+    unsigned nREFI;
+    unsigned nFAW;
+    unsigned nBL;
+};
+
+}
+}
+
+#endif // C_TIMINGPARAMS_HPP
@@ -346,6 +346,17 @@ void c_TxnConverter::updateBankInfo(c_Transaction* x_txn)
 }
 
 
+// same as x_cycles calls to run() with no transactions
+void c_TxnConverter::skipCycles(SimTime_t x_cycles)
+{
+    if(k_bankPolicy==2) {
+        for (auto &it:m_bankInfo)
+            if(it->isRowOpen())
+                it->skipCycles(x_cycles);
+    }
+}
+
+
 c_BankInfo* c_TxnConverter::getBankInfo(unsigned x_bankId)
 {
     return m_bankInfo[x_bankId];
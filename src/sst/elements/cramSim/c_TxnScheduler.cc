@@ -292,6 +292,23 @@ bool c_TxnScheduler::isHit(c_Transaction* x_txn)
     return l_isHit;
 }
 
+bool c_TxnScheduler::isEmpty()
+{
+    for (auto &l_queue : m_txnQ)
+        if (!l_queue.empty())
+            return false;
+
+    for (auto &l_queue : m_txnReadQ)
+        if (!l_queue.empty())
+            return false;
+
+    for (auto &l_queue : m_txnWriteQ)
+        if (!l_queue.empty())
+            return false;
+
+    return true;
+}
+
 bool c_TxnScheduler::hasDependancy(c_Transaction *x_txn, int x_ch)
 {
     TxnQueue* l_queue= nullptr;
@@ -80,6 +80,7 @@ namespace SST {
             virtual void run(SimTime_t simCycle);
             virtual bool push(c_Transaction* newTxn);
             virtual bool isHit(c_Transaction* newTxn);
+            virtual bool isEmpty();
 
 
         private:
@@ -80,6 +80,12 @@ class testcase_cramSim_Component(SSTTestCase):
     def test_cramSim_6_W(self):
         self.cramSim_test_template("6_W")
 
+    def test_cramSim_skip_idle_1_RW(self):
+        self.cramSim_skip_idle_test_template("1_RW")
+
+    def test_cramSim_skip_idle_4_R(self):
+        self.cramSim_skip_idle_test_template("4_R")
+
 #####
 
     def cramSim_test_template(self, testcase):
@@ -137,6 +143,47 @@ class testcase_cramSim_Component(SSTTestCase):
         else:
             self.assertTrue(cmp_result, "Output file {0} does not match Reference File {1}".format(outfile, reffile))
 
+#####
+
+    # Runs the same trace with the controller clocked every cycle and with
+    # boolSkipIdleCycles set, command timing must not change so neither may
+    # anything the run reports
+    def cramSim_skip_idle_test_template(self, testcase):
+
+        # Get the path to the test files
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        self.testcramSimDir = "{0}/testcramSim".format(tmpdir)
+        self.testcramSimTestsDir = "{0}/tests".format(self.testcramSimDir)
+
+        testDataFileName="test_cramSim_skip_idle_{0}".format(testcase)
+
+        sdlfile    = "{0}/test_txntrace.py".format(self.testcramSimTestsDir)
+        tracefile  = "{0}/sst-CramSim-trace_verimem_{1}.trc".format(self.testcramSimTestsDir, testcase)
+        configfile = "{0}/ddr4_verimem.cfg".format(self.testcramSimDir)
+
+        outfiles = {}
+        for skip in [0, 1]:
+            outfile = "{0}/{1}_{2}.out".format(outdir, testDataFileName, skip)
+            errfile = "{0}/{1}_{2}.err".format(outdir, testDataFileName, skip)
+            mpioutfiles = "{0}/{1}_{2}.testfile".format(outdir, testDataFileName, skip)
+            otherargs = '--model-options=\"--configfile={0} --traceFile={1} boolSkipIdleCycles={2}\"'.format(configfile, tracefile, skip)
+
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("cramSim test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            cmd = 'grep -q "Simulation is complete" {0} '.format(outfile)
+            self.assertTrue(os.system(cmd) == 0, "Output file {0} does not contain a simulation complete message".format(outfile))
+            outfiles[skip] = outfile
+
+        # The only lines allowed to differ echo the override itself
+        cmp_result = testing_compare_filtered_diff(testDataFileName, outfiles[1], outfiles[0], filters=[StartsWithFilter("Override")])
+        self.assertTrue(cmp_result, "Output file {0} with idle cycles skipped does not match {1}".format(outfiles[1], outfiles[0]))
+
 #####
 
     def _setupcramSimTestFiles(self):
@@ -169,7 +169,7 @@ void Sieve::processEvent(SST::Event* ev, int link) {
     // Currently, Ariel does not care about the payload.  Therefore,
     // there is no need to construct the payload.
 
-    responseEvent->setDst(event->getSrc());
+    responseEvent->setDstID(event->getSrcID());
     SST::Link * ret = cpuLinks_[link];
     ret->send(responseEvent);
 
@@ -244,5 +244,7 @@ void Bus::init(unsigned int phase) {
             }
         }
     }
+
+    EndpointTable::get().shareNames();
 }
 
@@ -17,6 +17,9 @@
 #define CACHEARRAY_H
 
 #include <vector>
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
 
 #include <sst/core/output.h>
 
@@ -30,12 +33,52 @@ using namespace std;
 
 namespace SST { namespace MemHierarchy {
 
+/*
+ * Return the way in tags[0..ways) holding addr, or -1 if none does.
+ * Uses AVX2 or SSE4.1 compares when the build enables them and falls back
+ * to a scalar scan otherwise.
+ */
+inline int matchTag(const Addr* tags, unsigned int ways, Addr addr) {
+    unsigned int i = 0;
+#if defined(__AVX2__)
+    const __m256i key = _mm256_set1_epi64x((long long)addr);
+    for (; i + 4 <= ways; i += 4) {
+        __m256i cmp = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(tags + i)), key);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#elif defined(__SSE4_1__)
+    const __m128i key = _mm_set1_epi64x((long long)addr);
+    for (; i + 2 <= ways; i += 2) {
+        __m128i cmp = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i*)(tags + i)), key);
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(cmp));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < ways; i++) {
+        if (tags[i] == addr)
+            return i;
+    }
+    return -1;
+}
+
 /*
  * CacheArrays should  be templated on a line type
  * See the comment in lineTypes.h for the required API
+ *
+ * R is the replacement policy type. The default dispatches through the
+ * ReplacementPolicy interface so the policy can be chosen at runtime.
+ * Instantiating with a concrete (final) policy, e.g. CacheArray<L1CacheLine, TreePLRU>,
+ * selects the policy at compile time and lets the compiler call it directly.
+ *
+ * Line addresses are mirrored in tags_, contiguous per set, so lookup
+ * compares tags without touching the line objects. Line addresses may only
+ * be changed through replace() to keep the two in sync.
  */
 
-template <class T>
+template <class T, class R = ReplacementPolicy>
 class CacheArray {
     protected:
         Output*         dbg_;
@@ -44,17 +87,18 @@ class CacheArray {
         unsigned int    associativity_;
         unsigned int    lineOffset_;
         uint32_t        lineSize_;
-        ReplacementPolicy* replacementMgr_;
+        R*              replacementMgr_;
         HashFunction*   hash_;
         Addr            sliceSize_; // For cache slices
         Addr            sliceStep_; // For cache slices
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
+        vector<Addr>    tags_;  // Address of each line, indexed like lines_
         State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        std::vector<std::vector<ReplacementInfo*> > rInfo;   // Vector of replacementInfo for each set, indexed by set ID
     public:
 
-        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
+        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, R* replacementMgr, HashFunction* hash);
 
         /** Destructor - Delete all cache line objects */
         virtual ~CacheArray();
@@ -93,8 +137,8 @@ class CacheArray {
 
 /************* Function definitions *****************/
 
-template <class T>
-CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
+template <class T, class R>
+CacheArray<T, R>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, R* replacementMgr, HashFunction* hash) :
     dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash) {
 
     // Error check parameters
@@ -115,6 +159,7 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
 
     lineOffset_ = log2Of(lineSize_);
     lines_.resize(numLines_);
+    tags_.resize(numLines_);
 
     // Set later using setter functions
     sliceStep_ = 1;
@@ -123,24 +168,25 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
 
     for (unsigned int i = 0; i < numLines_; i++) {
         lines_[i] = new T(lineSize_, i);
+        tags_[i] = lines_[i]->getAddr();
     }
 
     // Construct rInfo
+    rInfo.resize(numSets_);
     for (unsigned int i = 0; i < numSets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
+        rInfo[i].reserve(associativity_);
         for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
+            rInfo[i].push_back(lines_[i*associativity + j]->getReplacementInfo());
     }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
+    ReplacementInfo * info = rInfo[0].front();
     if (!replacementMgr_->checkCompatibility(info))
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
 
     setStates = new State[associativity_];
 }
 
-template <class T>
-CacheArray<T>::~CacheArray() {
+template <class T, class R>
+CacheArray<T, R>::~CacheArray() {
     for (size_t i = 0; i < lines_.size(); i++)
         delete lines_[i];
     delete replacementMgr_;
@@ -148,33 +194,32 @@ CacheArray<T>::~CacheArray() {
     delete [] setStates;
 }
 
-template <class T>
-Addr CacheArray<T>::toLineAddr(Addr addr) {
+template <class T, class R>
+Addr CacheArray<T, R>::toLineAddr(Addr addr) {
     Addr shift = addr >> lineOffset_;
     Addr step = shift / sliceStep_;
     Addr offset = shift % sliceSize_;
     return step * sliceSize_ + offset;
 }
 
-template <class T>
-T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
+template <class T, class R>
+T* CacheArray<T, R>::lookup(const Addr addr, bool updateReplacement) {
     Addr laddr = toLineAddr(addr);
     int set = hash_->hash(0, laddr) % numSets_;
     int setBegin = set * associativity_;
-    int setEnd = setBegin + associativity_;
-
-    for (int i = setBegin; i < setEnd; i++) {
-        if (lines_[i]->getAddr() == addr) {
-            if (updateReplacement)
-                replacementMgr_->update(i, lines_[i]->getReplacementInfo());
-            return lines_[i];
-        }
-    }
-    return nullptr; // Not found
+
+    int way = matchTag(&tags_[setBegin], associativity_, addr);
+    if (way < 0)
+        return nullptr; // Not found
+
+    int i = setBegin + way;
+    if (updateReplacement)
+        replacementMgr_->update(i, lines_[i]->getReplacementInfo());
+    return lines_[i];
 }
 
-template <class T>
-T * CacheArray<T>::findReplacementCandidate(Addr addr) {
+template <class T, class R>
+T * CacheArray<T, R>::findReplacementCandidate(Addr addr) {
     Addr laddr = toLineAddr(addr);
     int set = hash_->hash(0, laddr) % numSets_;
 
@@ -183,37 +228,38 @@ T * CacheArray<T>::findReplacementCandidate(Addr addr) {
     return lines_[id];
 }
 
-template <class T>
-void CacheArray<T>::replace(Addr addr, T* candidate) {
+template <class T, class R>
+void CacheArray<T, R>::replace(Addr addr, T* candidate) {
     unsigned int index = candidate->getIndex();
     replacementMgr_->replaced(index);
     candidate->reset();
     candidate->setAddr(addr);
+    tags_[index] = addr;
     replacementMgr_->update(index, lines_[index]->getReplacementInfo());
 }
 
-template <class T>
-void CacheArray<T>::deallocate(T* candidate) {
+template <class T, class R>
+void CacheArray<T, R>::deallocate(T* candidate) {
     unsigned int index = candidate->getIndex();
     replacementMgr_->replaced(index);
     candidate->reset();
 }
 
-template <class T>
-void CacheArray<T>::setSliceAware(Addr size, Addr step) {
+template <class T, class R>
+void CacheArray<T, R>::setSliceAware(Addr size, Addr step) {
     sliceSize_ = size >> lineOffset_;
     sliceStep_ = step >> lineOffset_;
     if (sliceSize_ == 0) sliceSize_ = 1;
     if (sliceStep_ == 0) sliceStep_ = 1;
 }
 
-template <class T>
-void CacheArray<T>::setBanked(unsigned int numBanks) {
+template <class T, class R>
+void CacheArray<T, R>::setBanked(unsigned int numBanks) {
     banks_ = numBanks;
 }
 
-template <class T>
-void CacheArray<T>::printCacheArray(Output &out) {
+template <class T, class R>
+void CacheArray<T, R>::printCacheArray(Output &out) {
     for (unsigned int i = 0; i < numLines_; i++) {
         out.output("   %u %s\n", i, lines_[i]->getString().c_str());
     }
@@ -14,6 +14,7 @@
 // distribution.
 
 #include <sst_config.h>
+#include <algorithm>
 #include <sst/core/params.h>
 #include <sst/core/interfaces/stringEvent.h>
 #include <sst/core/timeLord.h>
@@ -57,6 +58,7 @@ void Cache::handleEvent(SST::Event * ev) {
     }
     
     eventBuffer_.push_back(event);
+    progressPossible_ = true;
 }
 
 /* 
@@ -87,6 +89,7 @@ void Cache::processPrefetchEvent(SST::Event * ev) {
     statPrefetchRequest->addData(1);
     statCacheRecv[(int)event->getCmd()]->addData(1);
     prefetchBuffer_.push(event);
+    progressPossible_ = true;
 }
 
 /**************************************************************************
@@ -100,34 +103,41 @@ bool Cache::clockTick(Cycle_t time) {
     // Drain any outgoing messages
     bool idle = coherenceMgr_->sendOutgoingEvents();
 
+    bool linksIdle = true;
     if (clockUpLink_) {
-        idle &= linkUp_->clock();
+        linksIdle &= linkUp_->clock();
     }
     if (clockDownLink_) {
-        idle &= linkDown_->clock();
+        linksIdle &= linkDown_->clock();
     }
+    idle &= linksIdle;
 
     // MSHR occupancy
     statMSHROccupancy->addData(mshr_->getSize());
 
-    // Clear bank status to prepare for event handling
-    for (unsigned int bank = 0; bank < bankStatus_.size(); bank++)
-        bankStatus_[bank] = false;
-
+    // Clear line access status to prepare for event handling. Banks are marked with the timestamp so need no reset.
     addrsThisCycle_.clear();
+    addrFilter_ = 0;
 
     // Handle events from each of the buffers
     // 1. Retry buffer      -> Events that need to be retried, e.g., were stalled due to a pending action that is now resolved
     // 2. Event buffer      -> Incoming (new) events
     // 3. Prefetch buffer   -> Drop any prefetch that can't be handled immediately
+    //
+    // In event-driven mode the retry and event buffers are only scanned if something
+    // has happened since the last scan that could let a buffered event be accepted:
+    // a new event arrived, an event was accepted, or an event lost arbitration.
 
     int accepted = 0;
-    size_t entries = retryBuffer_.size();
+    bool scan = !eventDriven_ || progressPossible_;
+    progressPossible_ = false;
 
     std::list<MemEventBase*>::iterator it = retryBuffer_.begin();
-    while (it != retryBuffer_.end()) {
-        if (accepted == maxRequestsPerCycle_)
+    while (scan && it != retryBuffer_.end()) {
+        if (accepted == maxRequestsPerCycle_) {
+            progressPossible_ = true;
             break;
+        }
         if (is_debug_event((*it))) {
             dbg_->debug(_L3_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Retry   (%s)\n",
                     getCurrentSimCycle(), timestamp_, getName().c_str(), (*it)->getVerboseString().c_str());
@@ -147,9 +157,11 @@ bool Cache::clockTick(Cycle_t time) {
     // 1. An event can be accepted, in which case a later response moves up the queue
     // 2. An event can be rejected, in which case we check the next one with no penalty (doesn't block a later response)
     it = eventBuffer_.begin();
-    while (it != eventBuffer_.end()) {
-        if (accepted == maxRequestsPerCycle_)
+    while (scan && it != eventBuffer_.end()) {
+        if (accepted == maxRequestsPerCycle_) {
+            progressPossible_ = true;
             break;
+        }
         Command cmd = (*it)->getCmd();
         if (is_debug_event((*it))) {
             dbg_->debug(_L3_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:New     (%s)\n",
@@ -181,7 +193,11 @@ bool Cache::clockTick(Cycle_t time) {
     }
 
     // Push any events that need to be retried next cycle onto the retry buffer
+    // Accepting an event changes cache state, which may unblock others
     std::vector<MemEventBase*>* rBuf = coherenceMgr_->getRetryBuffer();
+    if (accepted != 0 || !rBuf->empty())
+        progressPossible_ = true;
+
     std::copy( rBuf->begin(), rBuf->end(), std::back_inserter(retryBuffer_) );
     coherenceMgr_->clearRetryBuffer();
 
@@ -193,10 +209,27 @@ bool Cache::clockTick(Cycle_t time) {
         return true;
     }
 
+    // Event-driven: if no buffered event can make progress and nothing is due to be sent next cycle,
+    // turn the clock off. An arriving event turns it back on, otherwise wake up when the next outgoing event is due.
+    if (eventDriven_ && !progressPossible_ && linksIdle) {
+        uint64_t nextSend = coherenceMgr_->getNextSendTime();
+        if (nextSend > timestamp_ + 1) {
+            turnClockOff();
+            if (nextSend != UINT64_MAX)
+                wakeupSelfLink_->send(nextSend - timestamp_ - 1, nullptr);
+            return true;
+        }
+    }
+
     // Keep the clock on
     return false;
 }
 
+/* Wake up for an outgoing event that is due (event_driven) */
+void Cache::wakeup(SST::Event * ev) {
+    turnClockOn();
+}
+
 void Cache::turnClockOn() {
     if (clockIsOn_) return;
     Cycle_t time = reregisterClock(defaultTimeBase_, clockHandler_);
@@ -247,6 +280,7 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
 
     /* Arbitrate cache access - bank/link. Reject request on failure */
     if (!arbitrateAccess(addr)) { // Disallow multiple requests to same line and/or bank in a single cycle
+        progressPossible_ = true; // Can retry next cycle
         if (is_debug_addr(addr)) {
             std::stringstream id;
             id << "<" << event->getID().first << "," << event->getID().second << ">";
@@ -353,14 +387,13 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
 /* Arbitrate for access. Return whether successful */
 bool Cache::arbitrateAccess(Addr addr) {
     if (!banked_) {
-        if (addrsThisCycle_.find(addr) == addrsThisCycle_.end()) {
+        if (!(addrFilter_ & addrFilterBit(addr)))
             return true;
-        }
-        return false;
+        return std::find(addrsThisCycle_.begin(), addrsThisCycle_.end(), addr) == addrsThisCycle_.end();
     }
 
     Addr bank = coherenceMgr_->getBank(addr);
-    if (bankStatus_[bank]) {
+    if (bankBusyCycle_[bank] == timestamp_) {
         statBankConflicts->addData(1);
         return false;
     } else {
@@ -370,10 +403,11 @@ bool Cache::arbitrateAccess(Addr addr) {
 
 /* Block banks that have been accessed */
 void Cache::updateAccessStatus(Addr addr) {
-    addrsThisCycle_.insert(addr);
+    addrsThisCycle_.push_back(addr);
+    addrFilter_ |= addrFilterBit(addr);
     if (banked_) {
         Addr bank = coherenceMgr_->getBank(addr);
-        bankStatus_[bank] = true;
+        bankBusyCycle_[bank] = timestamp_;
     }
 }
 
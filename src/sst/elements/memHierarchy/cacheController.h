@@ -90,6 +90,7 @@ public:
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
+            {"event_driven",            "(bool) Only retry stalled events when something has changed that could let them proceed, and turn the clock off until the next event arrives or the next outgoing event is due. Simulated timing is unchanged; statistics that count repeated stalls of the same event will be lower. Options: 0[off], 1[on]", "false"},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
             {"network_bw",                  "MOVED - Now a member of the MemNIC subcomponent.", "80GiB/s"}, // Remove 9.0
@@ -240,6 +241,9 @@ private:
     void turnClockOn();
     void turnClockOff();
 
+    // Turn the clock back on after skipping ahead (event_driven)
+    void wakeup(SST::Event * ev);
+
     // Trigger timeouts if events sit in MSHR for too long
     void timeoutWakeup(SST::Event * ev);
     void checkTimeout();
@@ -247,6 +251,7 @@ private:
     // Arbitrate for bank and/or line access
     bool arbitrateAccess(Addr addr);
     void updateAccessStatus(Addr addr);
+    uint64_t addrFilterBit(Addr addr) { return 1ULL << ((addr / lineSize_) & 63); }
 
     // Process coherence initialization events
     void processInitCoherenceEvent(MemEventInitCoherence* event, bool src);
@@ -258,6 +263,7 @@ private:
     MemLinkBase* linkDown_;                 // link manager down (towards memory)
     Link* prefetchSelfLink_;                // link to delay prefetch request receive
     Link* timeoutSelfLink_;                 // link to check for timeouts (possible deadlock)
+    Link* wakeupSelfLink_;                  // link to turn the clock back on when the next outgoing event is due (event_driven)
     MSHR* mshr_;                            // MSHR
     CoherenceController* coherenceMgr_;     // Coherence protocol - where most of the event handling happens
 
@@ -272,6 +278,7 @@ private:
     SimTime_t           timeout_;
     uint64_t            maxOutstandingPrefetch_;
     bool                banked_;
+    bool                eventDriven_;
 
     /** Clocks *****************************************************************/
     Clock::Handler<Cache>*  clockHandler_;
@@ -284,8 +291,10 @@ private:
     /** Cache state ************************************************************/
     uint64_t                    timestamp_;
     int                         requestsThisCycle_;
-    std::vector<bool>           bankStatus_;
-    std::set<Addr>              addrsThisCycle_;
+    std::vector<uint64_t>       bankBusyCycle_;     // Timestamp at which each bank was last accessed
+    std::vector<Addr>           addrsThisCycle_;    // Lines accessed this cycle
+    uint64_t                    addrFilter_;        // One bit per hash of addrsThisCycle_, most non-conflicting lines skip the search
+    bool                        progressPossible_;  // Whether a buffered event may be accepted if retried (event_driven)
     std::list<MemEventBase*>    retryBuffer_;
     std::list<MemEventBase*>    eventBuffer_;
     std::queue<MemEventBase*>   prefetchBuffer_;
@@ -56,8 +56,9 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
 
     /* Banks */
     uint64_t banks = params.find<uint64_t>("banks", 0);
-    bankStatus_.resize(banks, false);
+    bankBusyCycle_.resize(banks, 0);
     banked_ = banks;
+    addrFilter_ = 0;
 
     /* Create clock, deadlock timeout, etc. */
     createClock(params);
@@ -728,6 +729,13 @@ void Cache::createClock(Params &params) {
     timestamp_ = 0;
     lastActiveClockCycle_ = 0;
 
+    // Event-driven mode
+    eventDriven_ = params.find<bool>("event_driven", false);
+    progressPossible_ = true;
+    wakeupSelfLink_ = nullptr;
+    if (eventDriven_)
+        wakeupSelfLink_ = configureSelfLink("wakeup", defaultTimeBase_, new Event::Handler<Cache>(this, &Cache::wakeup));
+
     // Deadlock timeout
     timeout_ = params.find<SimTime_t>("maxRequestDelay", 0);
     if (timeout_ > 0) {
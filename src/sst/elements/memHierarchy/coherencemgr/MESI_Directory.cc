@@ -1117,7 +1117,7 @@ void MESIDirectory::handleFlushLineResponse(MemEvent * ev) {
 
     MemEvent * me = reqEv->makeResponse();
     me->copyMetadata(reqEv);
-    me->setDst(reqEv->getSrc());
+    me->setDstID(reqEv->getSrcID());
     me->setSuccess(ev->success());
 
     profileResponseSent(me);
@@ -1304,7 +1304,7 @@ void MESIDirectory::sendInvalidate(int target, MemEvent * reqEv, DirEntry* entry
 void MESIDirectory::sendAckPut(MemEvent * event) {
     MemEvent * me = event->makeResponse(Command::AckPut);
     me->copyMetadata(event);
-    me->setDst(event->getSrc());
+    me->setDstID(event->getSrcID());
     me->setPayload(0, nullptr);
     me->setSize(cacheLineSize);
 
@@ -85,6 +85,7 @@ CoherenceController::CoherenceController(ComponentId_t id, Params &params, Param
 
     // Get parent component's name
     cachename_ = getParentComponentName();
+    cachenameID_ = EndpointTable::get().intern(cachename_);
 
     // Register statistics - only those that are common across all coherence managers
     // Give  all array entries a default statistic so we don't end up with segfaults during execution
@@ -150,8 +151,12 @@ ReplacementPolicy* CoherenceController::createReplacementPolicy(uint64_t lines,
     }
     if (policy == "random") return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.random", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
     if (policy == "nmru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.nmru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "plru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.plru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "srrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.srrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "brrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.brrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "drrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.drrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
 
-    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', and 'nmru'. You specified '%s'.\n", getName().c_str(), policy.c_str());
+    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', 'nmru', 'plru', 'srrip', 'brrip', and 'drrip'. You specified '%s'.\n", getName().c_str(), policy.c_str());
     return nullptr;
 }
 
@@ -394,6 +399,16 @@ bool CoherenceController::checkIdle() {
     return outgoingEventQueueDown_.empty() && outgoingEventQueueUp_.empty();
 }
 
+/* Queues are sent in order, so only the front of each queue matters */
+uint64_t CoherenceController::getNextSendTime() {
+    uint64_t next = UINT64_MAX;
+    if (!outgoingEventQueueDown_.empty())
+        next = outgoingEventQueueDown_.front().deliveryTime;
+    if (!outgoingEventQueueUp_.empty() && outgoingEventQueueUp_.front().deliveryTime < next)
+        next = outgoingEventQueueUp_.front().deliveryTime;
+    return next;
+}
+
 
 /* Forward an event using memory address to locate a destination. */
 void CoherenceController::forwardByAddress(MemEventBase * event) {
@@ -401,7 +416,7 @@ void CoherenceController::forwardByAddress(MemEventBase * event) {
 }
 
 void CoherenceController::forwardByAddress(MemEventBase * event, Cycle_t ts) {
-    event->setSrc(cachename_);
+    event->setSrcID(cachenameID_);
     std::string dst = linkDown_->findTargetDestination(event->getRoutingAddress());
     if (dst != "") { /* Common case */
         event->setDst(dst);
@@ -430,7 +445,7 @@ void CoherenceController::forwardByDestination(MemEventBase * event) {
 
 /* Forward an event to a specific destination */
 void CoherenceController::forwardByDestination(MemEventBase * event, Cycle_t ts) {
-    event->setSrc(cachename_);
+    event->setSrcID(cachenameID_);
     Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
     
     if (linkUp_->isReachable(event->getDst())) {
@@ -615,7 +630,7 @@ MemEventStatus CoherenceController::allocateMSHR(MemEvent * event, bool fwdReq,
     // Screen prefetches first to ensure limits are not exceeeded:
     //      - Maximum number of outstanding prefetches
     //      - MSHR too full to accept prefetches
-    if (event->isPrefetch() && event->getRqstr() == cachename_) {
+    if (event->isPrefetch() && event->getRqstrID() == cachenameID_) {
         if (dropPrefetchLevel_ <= mshr_->getSize()) {
             eventDI.action = "Reject";
             eventDI.reason = "Prefetch drop level";
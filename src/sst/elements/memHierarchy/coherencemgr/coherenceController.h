@@ -110,6 +110,9 @@ public:
     /* Check whether the event queues are empty/subcomponent is doing anything */
     bool checkIdle();
 
+    /* Timestamp at which the next outgoing event can be sent, UINT64_MAX if none are waiting */
+    uint64_t getNextSendTime();
+
     /* Get which bank an address maps to (call through to cache array) */
     virtual Addr getBank(Addr addr) = 0;
 
@@ -268,6 +271,7 @@ protected:
 
     /* Cache name - used for identifying where events came from/are going to */
     std::string cachename_;
+    EndpointID cachenameID_;    // cachename_ interned in the EndpointTable
 
     /* Output & debug */
     Output* output; // Output stream for warnings, notices, fatal, etc.
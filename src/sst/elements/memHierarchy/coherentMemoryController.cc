@@ -512,7 +512,7 @@ bool CoherentMemController::doShootdown(Addr addr, MemEventBase * ev) {
         Addr globalAddr = translateToGlobal(addr);
         MemEvent * inv = new MemEvent(getName(), globalAddr, globalAddr, Command::FetchInv, lineSize_);
         inv->copyMetadata(ev);
-        inv->setDst(ev->getSrc());
+        inv->setDstID(ev->getSrcID());
 
         msgQueue_.insert(std::make_pair(timestamp_, inv)); /* Send on next clock. TODO timing needed? */
         return true;
@@ -16,6 +16,7 @@
 #include <sst_config.h>
 #include "directoryController.h"
 
+#include <chrono>
 
 #include <sst/core/params.h>
 
@@ -293,6 +294,9 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     stat_dirEntryReads              = registerStatistic<uint64_t>("eventSent_read_directory_entry");
     stat_dirEntryWrites             = registerStatistic<uint64_t>("eventSent_write_directory_entry");
     stat_MSHROccupancy              = registerStatistic<uint64_t>("MSHR_occupancy");
+    stat_eventHostTime              = registerStatistic<uint64_t>("event_host_time");
+    stat_entryStorage               = registerStatistic<uint64_t>("directory_entry_storage");
+    timeEvents = !stat_eventHostTime->isNullStatistic();
 
     // Coherence part
 
@@ -304,6 +308,17 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     entryCacheSize = 0;
     entrySize = 4; // Bytes, TODO parameterize
 
+    std::string sharerTracking = params.find<std::string>("sharer_tracking", "fullmap");
+    if (sharerTracking == "fullmap") {
+        sharerPointers = 0;
+    } else if (sharerTracking == "pointer") {
+        sharerPointers = params.find<uint32_t>("sharer_pointers", 4);
+        if (sharerPointers == 0)
+            dbg.fatal(CALL_INFO, -1, "Invalid param(%s): sharer_pointers - must be at least 1 when sharer_tracking is 'pointer'. You specified: 0\n", getName().c_str());
+    } else {
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): sharer_tracking - must be 'fullmap' or 'pointer'. You specified: %s\n", getName().c_str(), sharerTracking.c_str());
+    }
+
     string protstr  = params.find<std::string>("coherence_protocol", "MESI");
     if (protstr == "mesi" || protstr == "MESI") protocol = CoherenceProtocol::MESI;
     else if (protstr == "msi" || protstr == "MSI") protocol = CoherenceProtocol::MSI;
@@ -389,7 +404,7 @@ bool DirectoryController::clock(SST::Cycle_t cycle){
                 getCurrentSimCycle(), timestamp, getName().c_str(), (*it)->getVerboseString(dlevel).c_str());
 #endif
         
-        if (processPacket(*it, true)) {
+        if (timedProcessPacket(*it, true)) {
             requestsThisCycle++;
             it = retryBuffer.erase(it);
         } else {
@@ -407,7 +422,7 @@ bool DirectoryController::clock(SST::Cycle_t cycle){
                 getCurrentSimCycle(), timestamp, getName().c_str(), (*it)->getVerboseString(dlevel).c_str());
 #endif
 
-        if (processPacket(*it, false)) {
+        if (timedProcessPacket(*it, false)) {
             requestsThisCycle++;
             it = eventBuffer.erase(it);
         } else {
@@ -427,6 +442,18 @@ bool DirectoryController::clock(SST::Cycle_t cycle){
 }
 
 
+/* Wrapper to record host time per event when the statistic is enabled */
+bool DirectoryController::timedProcessPacket(MemEvent * ev, bool replay) {
+    if (!timeEvents)
+        return processPacket(ev, replay);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool retval = processPacket(ev, replay);
+    stat_eventHostTime->addData(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    return retval;
+}
+
+
 bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
     bool dbgevent = false;
     if (is_debug_event(ev)) {
@@ -601,7 +628,7 @@ void DirectoryController::printStatus(Output &statusOut) {
 
     statusOut.output("  Directory entries:\n");
     for (std::unordered_map<Addr, DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
-        statusOut.output("    0x%" PRIx64 " %s\n", it->first, it->second->getString().c_str());
+        statusOut.output("    0x%" PRIx64 " %s\n", it->first, it->second->getString(globalIDs).c_str());
     }
     statusOut.output("End MemHierarchy::DirectoryController\n\n");
 }
@@ -707,6 +734,11 @@ void DirectoryController::init(unsigned int phase) {
 
 void DirectoryController::finish(void){
     cpuLink->finish();
+
+    uint64_t storage = 0;
+    for (std::unordered_map<Addr, DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++)
+        storage += it->second->getStorageBytes();
+    stat_entryStorage->addData(storage);
 }
 
 
@@ -716,6 +748,15 @@ void DirectoryController::setup(void){
     if (cpuLink != memLink)
         memLink->setup();
     //MemLinkBase * mem = memLink ? memLink : network;
+
+    /* Assign dense sharer IDs to the sources discovered during init, in name order.
+     * Requestors further away (e.g., behind a bus) are assigned IDs on first use. */
+    std::set<std::string> sourceNames;
+    std::set<MemLinkBase::EndpointInfo>* sources = cpuLink->getSources();
+    for (std::set<MemLinkBase::EndpointInfo>::iterator it = sources->begin(); it != sources->end(); it++)
+        sourceNames.insert(it->name);
+    for (std::set<std::string>::iterator it = sourceNames.begin(); it != sourceNames.end(); it++)
+        getEndpointID(EndpointTable::get().intern(*it));
 }
 
 
@@ -738,7 +779,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -759,12 +800,12 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                     } else if (protocol == CoherenceProtocol::MESI) {
                         entry->setState(M);
-                        entry->setOwner(event->getSrc());
+                        entry->setOwner(getEndpointID(event->getSrcID()));
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
                         mshr->clearData(addr);
                     } else {
                         entry->setState(S);
-                        entry->addSharer(event->getSrc());
+                        entry->addSharer(getEndpointID(event->getSrcID()));
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                     }
                     if (is_debug_event(event)) {
@@ -787,7 +828,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
         case S:
             if (mshr->hasData(addr)) { // saved from earlier request
                 if (incoherentSrc.find(event->getSrc()) == incoherentSrc.end()) {
-                    entry->addSharer(event->getSrc());
+                    entry->addSharer(getEndpointID(event->getSrcID()));
                 }
                 sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                 if (is_debug_event(event)) {
@@ -824,7 +865,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -850,7 +891,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -869,7 +910,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
                 } else {
                     if (incoherentSrc.find(event->getSrc()) == incoherentSrc.end()) {
                         entry->setState(M);
-                        entry->setOwner(event->getSrc());
+                        entry->setOwner(getEndpointID(event->getSrcID()));
                     }
                     sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
                     mshr->clearData(addr);
@@ -894,13 +935,13 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
             // Upgrade request and no other sharers -> respond & M
             // Upgrade request and other sharers -> invalidate other sharers & S_Inv
             // Otherwise need data & invalidate sharers -> invalidate other sharers, request data from Memory, SM_Inv
-            if (entry->isSharer(event->getSrc())) { // Don't need data
+            if (entry->isSharer(getEndpointID(event->getSrcID()))) { // Don't need data
                 if (entry->getSharerCount() == 1) { // Also don't need to invalidate
                     if (mshr->hasData(addr))
                         mshr->clearData(addr);
                     entry->setState(M);
-                    entry->removeSharer(event->getSrc());
-                    entry->setOwner(event->getSrc());
+                    entry->removeSharer(getEndpointID(event->getSrcID()));
+                    entry->setOwner(getEndpointID(event->getSrcID()));
                     sendResponse(event);
                     if (is_debug_event(event)) {
                         eventDI.reason = "hit";
@@ -953,7 +994,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     if (status == MemEventStatus::Reject)
@@ -978,7 +1019,7 @@ bool DirectoryController::handleWrite(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1043,7 +1084,7 @@ bool DirectoryController::handleWrite(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     if (status == MemEventStatus::Reject)
@@ -1066,7 +1107,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1092,7 +1133,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    entry->addSharer(event->getSrc());
+                    entry->addSharer(getEndpointID(event->getSrcID()));
                     mshr->setData(addr, event->getPayload(), event->getDirty());
                     event->setEvict(false);
                 } else if (entry->hasOwner()) {
@@ -1107,7 +1148,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_Inv:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
+                entry->addSharer(getEndpointID(event->getSrcID()));
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 event->setEvict(false);
                 entry->setState(S_Inv);
@@ -1116,11 +1157,11 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
+                entry->addSharer(getEndpointID(event->getSrcID()));
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 entry->setState(S);
                 mshr->decrementAcksNeeded(addr);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
             }
@@ -1134,7 +1175,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -1155,7 +1196,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1173,7 +1214,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case S:
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
-                    entry->removeSharer(event->getSrc());
+                    entry->removeSharer(getEndpointID(event->getSrcID()));
                     event->setEvict(false);
                 }
 
@@ -1205,7 +1246,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_D:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrcID()));
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(IS);
@@ -1213,7 +1254,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_B:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrcID()));
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(I);
@@ -1224,7 +1265,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
                 entry->removeOwner();
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
 
                 if (mshr->decrementAcksNeeded(addr)) {
@@ -1235,9 +1276,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SD_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrcID()));
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->hasSharers() ? entry->setState(S_D) : entry->setState(IS);
@@ -1247,9 +1288,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SM_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrcID()));
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->setState(IM);
@@ -1258,9 +1299,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrcID()));
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->hasSharers() ? entry->setState(S) : entry->setState(I);
@@ -1270,9 +1311,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case M_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrcID()));
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
+                responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->setState(I);
@@ -1290,7 +1331,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -1309,7 +1350,7 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1317,11 +1358,11 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
     if (!inMSHR)
         stat_cacheHits->addData(1);
 
-    entry->removeSharer(event->getSrc());
+    entry->removeSharer(getEndpointID(event->getSrcID()));
     sendAckPut(event);
 
-    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
-        responses.find(addr)->second.erase(event->getSrc());
+    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(getEndpointID(event->getSrcID())) != responses.find(addr)->second.end()) {
+        responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
         if (responses.find(addr)->second.empty()) responses.erase(addr);
     }
 
@@ -1368,7 +1409,7 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     if (update)
@@ -1391,7 +1432,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1400,7 +1441,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
         stat_cacheHits->addData(1);
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(getEndpointID(event->getSrcID()));
 
     sendAckPut(event);
 
@@ -1419,7 +1460,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
             break;
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
             if (responses.find(addr)->second.empty()) responses.erase(addr);
             mshr->setData(addr, event->getPayload(), event->getDirty());
             entry->setState(S);
@@ -1431,7 +1472,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     cleanUpAfterRequest(event, inMSHR);
@@ -1453,7 +1494,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1474,7 +1515,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
         case M_Inv:
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
             if (responses.find(addr)->second.empty()) responses.erase(addr);
             mshr->setData(addr, event->getPayload(), event->getDirty());
             entry->setState(I);
@@ -1486,7 +1527,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     cleanUpAfterRequest(event, inMSHR);
@@ -1508,7 +1549,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1530,7 +1571,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
         case M_Inv:
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
+            responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
             if (responses.find(addr)->second.empty()) responses.erase(addr);
             mshr->setData(addr, event->getPayload(), event->getDirty());
             entry->setState(I);
@@ -1542,7 +1583,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     cleanUpAfterRequest(event, inMSHR);
@@ -1566,7 +1607,7 @@ bool DirectoryController::handleFetchInv(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1656,7 +1697,7 @@ bool DirectoryController::handleFetchInv(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     if (status == MemEventStatus::Reject)
@@ -1680,7 +1721,7 @@ bool DirectoryController::handleForceInv(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(globalIDs);
         }
         return ret;
     }
@@ -1765,7 +1806,7 @@ bool DirectoryController::handleForceInv(MemEvent * event, bool inMSHR) {
         sendNACK(event);
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -1790,7 +1831,7 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
     }
     if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
         entry->setState(S);
-        entry->addSharer(reqEv->getSrc());
+        entry->addSharer(getEndpointID(reqEv->getSrcID()));
     } else if (state == IS) {
         entry->setState(I);
     } else {
@@ -1803,7 +1844,7 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -1827,14 +1868,14 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
                 break;
             } else if (protocol == CoherenceProtocol::MESI) {
                 entry->setState(M);
-                entry->setOwner(reqEv->getSrc());
+                entry->setOwner(getEndpointID(reqEv->getSrcID()));
                 sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
                 break;
             }
         case S_D:
             entry->setState(S);
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
-                entry->addSharer(reqEv->getSrc());
+                entry->addSharer(getEndpointID(reqEv->getSrcID()));
             }
             sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
             mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
@@ -1842,7 +1883,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
         case IM:
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
                 entry->setState(M);
-                entry->setOwner(reqEv->getSrc());
+                entry->setOwner(getEndpointID(reqEv->getSrcID()));
             } else {
                 entry->setState(I);
             }
@@ -1853,7 +1894,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
             mshr->setData(addr, event->getPayload(), false); // Save data for when the invalidations finish
             if (is_debug_addr(addr)) {
                 eventDI.newst = entry->getState();
-                eventDI.verboseline = entry->getString();
+                eventDI.verboseline = entry->getString(globalIDs);
             }
             delete event;
             return true;
@@ -1865,7 +1906,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
     cleanUpAfterResponse(event, inMSHR);
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -1893,7 +1934,7 @@ bool DirectoryController::handleWriteResp(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -1926,7 +1967,7 @@ bool DirectoryController::handleFlushLineResp(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     sendResponse(reqEv, event->getFlags(), event->getMemFlags());
@@ -1944,7 +1985,7 @@ bool DirectoryController::handleAckPut(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     cleanUpAfterResponse(event, inMSHR);
@@ -1960,13 +2001,13 @@ bool DirectoryController::handleAckInv(MemEvent* event, bool inMSHR) {
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::AckInv, false, addr, state);
 
-    if (entry->isSharer(event->getSrc()))
-        entry->removeSharer(event->getSrc());
+    if (entry->isSharer(getEndpointID(event->getSrcID())))
+        entry->removeSharer(getEndpointID(event->getSrcID()));
     else
         entry->removeOwner();
 
     bool done = mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
     if (!done) {
@@ -2002,7 +2043,7 @@ bool DirectoryController::handleAckInv(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -2021,13 +2062,13 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
                 getName().c_str(), StateString[state], event->getVerboseString(dlevel).c_str(), getCurrentSimTimeNano());
 
     mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
     mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(getEndpointID(event->getSrcID()));
     entry->setState(S);
     retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
 
@@ -2035,7 +2076,7 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -2056,7 +2097,7 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
     MemEvent * reqEv = static_cast<MemEvent*>(mshr->getFrontEvent(addr));
 
     mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
+    responses.find(addr)->second.erase(getEndpointID(event->getSrcID()));
     if (responses.find(addr)->second.empty())
         responses.erase(addr);
     mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
@@ -2072,7 +2113,7 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -2104,8 +2145,8 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
         case Command::ForceInv:
             // Only retry if we still need the response)
             if (responses.find(addr) != responses.end()
-                    && responses.find(addr)->second.find(nackedEvent->getDst()) != responses.find(addr)->second.end()
-                    && responses.find(addr)->second.find(nackedEvent->getDst())->second == nackedEvent->getID())
+                    && responses.find(addr)->second.find(getEndpointID(nackedEvent->getDstID())) != responses.find(addr)->second.end()
+                    && responses.find(addr)->second.find(getEndpointID(nackedEvent->getDstID()))->second == nackedEvent->getID())
                 break;
             delete nackedEvent;
             return true;
@@ -2118,7 +2159,7 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
 
     return true;
@@ -2157,7 +2198,7 @@ bool DirectoryController::handleDirEntryResponse(MemEvent* event) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(globalIDs);
     }
     return true;
 }
@@ -2170,7 +2211,7 @@ DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
     std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
 
     if (directory.end() == i) {
-        directory[addr] = new DirEntry(addr);
+        directory[addr] = new DirEntry(addr, sharerPointers);
         i = directory.find(addr);
         i->second->cacheIter = entryCache.end();
         i->second->setCached(true);
@@ -2360,10 +2401,10 @@ void DirectoryController::issueFlush(MemEvent* event) {
 void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command cmd) {
     Addr addr = event->getBaseAddr();
     MemEvent * fetch = new MemEvent(getName(), event->getAddr(), addr, cmd, lineSize);
-    fetch->setDst(entry->getOwner());
+    fetch->setDstID(getGlobalID(entry->getOwner()));
 
     if (responses.find(addr) == responses.end()) {
-        std::map<std::string,MemEvent::id_type> resp;
+        std::unordered_map<EndpointID,MemEvent::id_type> resp;
         resp.insert(std::make_pair(entry->getOwner(), fetch->getID()));
         responses.insert(std::make_pair(addr, resp));
     } else {
@@ -2376,15 +2417,15 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 }
 
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
-    std::string rqstr = (event->getSrc());
+    EndpointID rqstr = getEndpointID(event->getSrcID());
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
-        if (*it == rqstr) continue;
-        issueInvalidation(*it, event, entry, cmd);
-    }
+    entry->getSharers()->forEach([&](EndpointID id) {
+        if (id != rqstr)
+            issueInvalidation(id, event, entry, cmd);
+    });
 }
 
-void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd) {
+void DirectoryController::issueInvalidation(EndpointID dst, MemEvent* event, DirEntry* entry, Command cmd) {
     Addr addr = entry->getBaseAddr();
     MemEvent* inv = new MemEvent(getName(), addr, addr, cmd, lineSize);
     if (event) {
@@ -2392,12 +2433,12 @@ void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, Di
     } else {
         inv->setRqstr(getName());
     }
-    inv->setDst(dst);
+    inv->setDstID(getGlobalID(dst));
 
     mshr->incrementAcksNeeded(addr);
 
     if (responses.find(addr) == responses.end()) {
-        std::map<std::string,MemEvent::id_type> resp;
+        std::unordered_map<EndpointID,MemEvent::id_type> resp;
         resp.insert(std::make_pair(entry->getOwner(), inv->getID()));
         responses.insert(std::make_pair(addr, resp));
     } else {
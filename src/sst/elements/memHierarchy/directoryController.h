@@ -26,6 +26,7 @@
 #include <set>
 #include <list>
 #include <vector>
+#include <unordered_map>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -37,6 +38,7 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
 
 using namespace std;
 
@@ -68,6 +70,8 @@ public:
             {"interleave_size",         "Size of interleaved chunks. E.g., to interleave 8B chunks among 3 directories, set size=8B, step=24B", "0B"},
             {"interleave_step",         "Distance between interleaved chunks. E.g., to interleave 8B chunks among 3 directories, set size=8B, step=24B", "0B"},
             {"node",					"Node number in multinode environment"},
+            {"sharer_tracking",         "How sharers are tracked for each entry. Options: 'fullmap' (one bit per endpoint) or 'pointer' (limited pointers, overflowing to a full map)", "fullmap"},
+            {"sharer_pointers",         "For sharer_tracking='pointer', number of sharer pointers stored per entry before switching to a full map", "4"},
             /* Old parameters - deprecated or moved */
             {"network_num_vc",          "DEPRECATED. Number of virtual channels (VCs) on the on-chip network. memHierarchy only uses one VC.", "1"}, // Remove SST 9.0
             {"network_address",         "DEPRECATD - Now auto-detected by link control", ""},   // Remove SST 9.0
@@ -139,6 +143,8 @@ public:
             {"eventSent_FlushLineInv",  "Event sent: FlushLineInv", "count", 2},
             {"eventSent_FlushLineResp", "Event sent: FlushLineResp", "count", 2},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle",  "events",       1},
+            {"event_host_time",         "Host (wall-clock) time spent processing each event", "nanoseconds", 5},
+            {"directory_entry_storage", "Host memory used by directory entries, including sharer tracking, recorded at end of simulation", "bytes", 5},
             {"default_stat",            "Default statistic. If not 0 then a statistic is missing", "", 1})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -183,6 +189,9 @@ private:
     Statistic<uint64_t> * stat_dirEntryWrites;
 
     Statistic<uint64_t> * stat_MSHROccupancy;
+    Statistic<uint64_t> * stat_eventHostTime;
+    Statistic<uint64_t> * stat_entryStorage;
+    bool timeEvents;    // Only read the host clock if event_host_time is enabled
 
     /* Queue of packets to work on */
     std::list<MemEvent*> eventBuffer;
@@ -229,6 +238,7 @@ public:
     /** Handler that gets called by clock tick.
         Function redirects request according to their type. */
     bool processPacket(MemEvent *ev, bool replay);
+    bool timedProcessPacket(MemEvent *ev, bool replay);
 
     /** Clock handler */
     bool clock(SST::Cycle_t cycle);
@@ -296,10 +306,10 @@ private:
         Addr                addr;           // block address
         State               state;          // state
         std::list<DirEntry*>::iterator cacheIter;
-	std::set<std::string> sharers;      // set of sharers for block
-        std::string         owner;          // Owner of block
+        SharerSet           sharers;        // set of sharers for block, by endpoint ID
+        EndpointID          owner;          // Owner of block
 
-        DirEntry(Addr a) {
+        DirEntry(Addr a, uint32_t maxPointers) : sharers(maxPointers) {
             clearEntry();
             addr = a;
             state = I;
@@ -310,21 +320,22 @@ private:
             cached = true;
             addr = 0;
             sharers.clear();
-            owner = "";
+            owner = NO_ENDPOINT;
         }
 
-        std::string getString() {
+        std::string getString(const std::vector<EndpointID>& globalIDs) {
+            EndpointTable& names = EndpointTable::get();
             std::ostringstream str;
             str << "State: " << StateString[state];
             str << " Sharers: [";
             bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
+            sharers.forEach([&](EndpointID id) {
                 if (comma)
                     str << ",";
-                str << *it;
+                str << names.getName(globalIDs[id]);
                 comma = true;
-            }
-            str << "] Owner: " << owner;
+            });
+            str << "] Owner: " << (owner == NO_ENDPOINT ? "" : names.getName(globalIDs[owner]));
             str << " Cached: " << (cached ? "y" : "n");
             return str.str();
         }
@@ -339,29 +350,48 @@ private:
 
         void clearSharers() { sharers.clear(); }
 
-        void addSharer(std::string shr) { sharers.insert(shr); }
+        void addSharer(EndpointID shr) { sharers.insert(shr); }
 
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
+        bool isSharer(EndpointID shr) { return sharers.contains(shr); }
 
         bool hasSharers() { return !(sharers.empty()); }
 
-        std::set<std::string>* getSharers() { return &sharers; }
+        SharerSet* getSharers() { return &sharers; }
 
-        void removeSharer(std::string shr) { sharers.erase(shr); }
+        void removeSharer(EndpointID shr) { sharers.erase(shr); }
 
-        std::string getOwner() { return owner; }
+        EndpointID getOwner() { return owner; }
 
-        bool hasOwner() { return owner != ""; }
+        bool hasOwner() { return owner != NO_ENDPOINT; }
 
-        void removeOwner() { owner = ""; }
+        void removeOwner() { owner = NO_ENDPOINT; }
 
-        void setOwner(std::string own) { owner = own; }
+        void setOwner(EndpointID own) { owner = own; }
 
         void setState(State nState) { state = nState; }
 
         State getState() { return state; }
+
+        size_t getStorageBytes() { return sizeof(DirEntry) - sizeof(SharerSet) + sharers.getStorageBytes(); }
     };
 
+    /* Mapping between global endpoint IDs (see EndpointTable) and the dense local IDs used for sharer tracking */
+    std::vector<EndpointID> localIDs;   // Indexed by global ID
+    std::vector<EndpointID> globalIDs;  // Indexed by local ID
+    uint32_t sharerPointers;    // 0 = full map, otherwise limited pointer count before overflowing to a full map
+
+    EndpointID getEndpointID(EndpointID global) {
+        if (global >= localIDs.size())
+            localIDs.resize(global + 1, NO_ENDPOINT);
+        if (localIDs[global] == NO_ENDPOINT) {
+            localIDs[global] = globalIDs.size();
+            globalIDs.push_back(global);
+        }
+        return localIDs[global];
+    }
+
+    EndpointID getGlobalID(EndpointID local) { return globalIDs[local]; }
+
     int dlevel;
     void printDebugInfo();
 
@@ -380,7 +410,7 @@ private:
     void issueFlush(MemEvent* event);
     void issueFetch(MemEvent* event, DirEntry* entry, Command cmd);
     void issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd);
-    void issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd);
+    void issueInvalidation(EndpointID dst, MemEvent* event, DirEntry* entry, Command cmd);
     void sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags = 0);
     void sendResponse(MemEvent* event, uint32_t flags = 0, uint32_t memflags = 0);
     void writebackData(MemEvent* event);
@@ -420,7 +450,7 @@ private:
     uint64_t accessLatency;
     uint64_t mshrLatency;
 
-    std::map<Addr, std::map<std::string, MemEvent::id_type> > responses;
+    std::unordered_map<Addr, std::unordered_map<EndpointID, MemEvent::id_type> > responses;
     
     std::map<MemEvent::id_type, Addr> dirMemAccesses;
     
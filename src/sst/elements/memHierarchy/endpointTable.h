@@ -0,0 +1,190 @@
+// Copyright 2013-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_ENDPOINTTABLE_H
+#define MEMHIERARCHY_ENDPOINTTABLE_H
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sst/core/output.h>
+#include <sst/core/shared/sharedSet.h>
+
+namespace SST { namespace MemHierarchy {
+
+typedef uint32_t EndpointID;
+const EndpointID NO_ENDPOINT = UINT32_MAX;
+
+/*
+ * Process-wide table interning endpoint (component) names to dense 32-bit IDs
+ *
+ * Events carry source, destination and requestor as IDs and only turn them back into
+ * names for debug output and for code that still works in terms of names. Names are
+ * interned as components are constructed and initialized, so lookups during simulation
+ * normally hit existing entries.
+ *
+ * Dense IDs are only meaningful within a process. During init() the link interfaces share
+ * every interned name with the other ranks (shareNames()); once init() is over each rank
+ * numbers the full, sorted set of names the same way (finalize()) and events that cross
+ * ranks carry those wire IDs. Events sent during init(), and events naming an endpoint
+ * that was only interned after init(), carry the names instead.
+ *
+ * Entries are stored in fixed chunks that never move, so references returned by
+ * getName() remain valid and readers of an already published ID do not need the lock.
+ */
+class EndpointTable {
+public:
+    static const EndpointID NONE_ID = 0;    // ID of memTypes' NONE ("None"), always interned first
+
+    /* Single table per process, shared by every library that includes this header */
+    static EndpointTable& get() {
+        static EndpointTable table;
+        return table;
+    }
+
+    EndpointID intern(const std::string& name) {
+        {
+            std::shared_lock<std::shared_mutex> lock(lock_);
+            std::unordered_map<std::string, EndpointID>::const_iterator it = nameMap_.find(name);
+            if (it != nameMap_.end())
+                return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(lock_);
+        return insert(name);
+    }
+
+    const std::string& getName(EndpointID id) const {
+        // Pairs with the release in insert() so the entry is visible to threads that did not intern it
+        if (id >= count_.load(std::memory_order_acquire)) {
+            SST::Output::getDefaultObject().fatal(CALL_INFO, -1, "MemHierarchy EndpointTable, Error: unknown endpoint ID %" PRIu32 "\n", id);
+        }
+        return chunks_[id >> CHUNK_BITS][id & CHUNK_MASK].name;
+    }
+
+    /* Called from init(): offer the names interned so far on this rank to every other rank */
+    void shareNames() {
+        std::unique_lock<std::shared_mutex> lock(lock_);
+        if (finalized_.load(std::memory_order_relaxed))
+            return;
+        if (!sharing_) {
+            sharedNames_.initialize("memHierarchy.EndpointTable.names", SST::Shared::SharedObject::NO_VERIFY);
+            sharing_ = true;
+        }
+        EndpointID count = count_.load(std::memory_order_relaxed);
+        for (; shared_ < count; shared_++)
+            sharedNames_.insert(chunks_[shared_ >> CHUNK_BITS][shared_ & CHUNK_MASK].name);
+    }
+
+    /* Called once init() is over: number the names shared by all ranks in sorted order, which is the same on every rank */
+    void finalize() {
+        if (finalized_.load(std::memory_order_acquire))
+            return;
+        std::unique_lock<std::shared_mutex> lock(lock_);
+        if (finalized_.load(std::memory_order_relaxed))
+            return;
+        if (sharing_) {
+            for (auto it = sharedNames_.begin(); it != sharedNames_.end(); it++)
+                wireToLocal_.push_back(insert(*it));
+        }
+        localToWire_.assign(count_.load(std::memory_order_relaxed), NO_ENDPOINT);
+        for (size_t wire = 0; wire < wireToLocal_.size(); wire++)
+            localToWire_[wireToLocal_[wire]] = wire;
+        finalized_.store(true, std::memory_order_release);
+    }
+
+    /* Rank-independent ID for a local one, NO_ENDPOINT until finalize() or if the name was not shared */
+    EndpointID toWire(EndpointID id) const {
+        if (!finalized_.load(std::memory_order_acquire) || id >= localToWire_.size())
+            return NO_ENDPOINT;
+        return localToWire_[id];
+    }
+
+    EndpointID fromWire(EndpointID wire) {
+        finalize();
+        if (wire >= wireToLocal_.size()) {
+            SST::Output::getDefaultObject().fatal(CALL_INFO, -1, "MemHierarchy EndpointTable, Error: unknown wire endpoint ID %" PRIu32 " (%zu names shared)\n", wire, wireToLocal_.size());
+        }
+        return wireToLocal_[wire];
+    }
+
+    size_t size() const { return count_.load(std::memory_order_acquire); }
+
+private:
+    EndpointTable() : count_(0), shared_(0), sharing_(false), finalized_(false) {
+        for (size_t i = 0; i < MAX_CHUNKS; i++)
+            chunks_[i] = nullptr;
+        insert("None");
+    }
+
+    ~EndpointTable() {
+        for (size_t i = 0; i < MAX_CHUNKS; i++)
+            delete [] chunks_[i];
+    }
+
+    EndpointTable(const EndpointTable&) = delete;
+    EndpointTable& operator=(const EndpointTable&) = delete;
+
+    /* Caller holds the exclusive lock */
+    EndpointID insert(const std::string& name) {
+        std::unordered_map<std::string, EndpointID>::const_iterator it = nameMap_.find(name);
+        if (it != nameMap_.end())
+            return it->second;
+
+        EndpointID id = count_.load(std::memory_order_relaxed);
+        size_t chunk = id >> CHUNK_BITS;
+        if (chunk >= MAX_CHUNKS) {
+            SST::Output::getDefaultObject().fatal(CALL_INFO, -1, "MemHierarchy EndpointTable, Error: too many endpoint names (%zu)\n", (size_t)id);
+        }
+        if (chunks_[chunk] == nullptr)
+            chunks_[chunk] = new Entry[CHUNK_SIZE];
+        chunks_[chunk][id & CHUNK_MASK].name = name;
+
+        nameMap_.insert(std::make_pair(name, id));
+        count_.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    struct Entry {
+        std::string name;
+    };
+
+    static const size_t CHUNK_BITS = 10;
+    static const size_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static const size_t CHUNK_MASK = CHUNK_SIZE - 1;
+    static const size_t MAX_CHUNKS = 4096;  // 4M names
+
+    Entry* chunks_[MAX_CHUNKS];
+    std::atomic<EndpointID> count_;
+    std::unordered_map<std::string, EndpointID> nameMap_;
+    std::shared_mutex lock_;
+
+    /* Cross-rank numbering, fixed by finalize() */
+    SST::Shared::SharedSet<std::string> sharedNames_;
+    EndpointID shared_;                     // Names [0, shared_) have been offered to sharedNames_
+    bool sharing_;
+    std::atomic<bool> finalized_;
+    std::vector<EndpointID> wireToLocal_;
+    std::vector<EndpointID> localToWire_;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_ENDPOINTTABLE_H */
@@ -22,6 +22,7 @@
 
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/endpointTable.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -46,6 +47,12 @@ public:
 
     /** Creates a new MemEventBase */
     MemEventBase(std::string src, Command cmd) : SST::Event() {
+        setDefaults();
+        cmd_ = cmd;
+        src_ = EndpointTable::get().intern(src);
+    }
+
+    MemEventBase(EndpointID src, Command cmd) : SST::Event() {
         setDefaults();
         cmd_ = cmd;
         src_ = src;
@@ -54,9 +61,9 @@ public:
     virtual void setDefaults() {
         eventID_        = generateUniqueId();  // Defined in SST::Event
         responseToID_   = NO_ID;
-        dst_            = NONE;
-        src_            = NONE;
-        rqstr_          = NONE;
+        dst_            = EndpointTable::NONE_ID;
+        src_            = EndpointTable::NONE_ID;
+        rqstr_          = EndpointTable::NONE_ID;
         cmd_            = Command::NULLCMD;
         flags_          = 0;
         memFlags_       = 0;
@@ -98,19 +105,31 @@ public:
     void setCmd(Command newcmd) { cmd_ = newcmd; }
 
     /** @return the source string - who sent this MemEvent */
-    const std::string& getSrc(void) const { return src_; }
+    const std::string& getSrc(void) const { return EndpointTable::get().getName(src_); }
     /** Sets the source string - who sent this MemEvent */
-    void setSrc(const std::string& src) { src_ = src; }
+    void setSrc(const std::string& src) { src_ = EndpointTable::get().intern(src); }
+    /** @return the interned ID of the source */
+    EndpointID getSrcID(void) const { return src_; }
+    /** Sets the source by interned ID */
+    void setSrcID(EndpointID src) { src_ = src; }
 
     /** @return the destination string - who receives this MemEvent */
-    const std::string& getDst(void) const { return dst_; }
+    const std::string& getDst(void) const { return EndpointTable::get().getName(dst_); }
     /** Sets the destination string - who received this MemEvent */
-    void setDst(const std::string& dst) { dst_ = dst; }
+    void setDst(const std::string& dst) { dst_ = EndpointTable::get().intern(dst); }
+    /** @return the interned ID of the destination */
+    EndpointID getDstID(void) const { return dst_; }
+    /** Sets the destination by interned ID */
+    void setDstID(EndpointID dst) { dst_ = dst; }
 
     /** @return the requestor string - whose original request caused this MemEvent */
-    const std::string& getRqstr(void) const { return rqstr_; }
+    const std::string& getRqstr(void) const { return EndpointTable::get().getName(rqstr_); }
     /** Sets the requestor string - whose original request caused this MemEvent */
-    void setRqstr(const std::string& rqstr) { rqstr_ = rqstr; }
+    void setRqstr(const std::string& rqstr) { rqstr_ = EndpointTable::get().intern(rqstr); }
+    /** @return the interned ID of the requestor */
+    EndpointID getRqstrID(void) const { return rqstr_; }
+    /** Sets the requestor by interned ID */
+    void setRqstrID(EndpointID rqstr) { rqstr_ = rqstr; }
 
     /** @return the thread ID that originated the original request */
     [[deprecated("Use getThreadID() instead (with capital 'D')")]]
@@ -182,7 +201,7 @@ public:
         std::string cmdStr(CommandString[(int)cmd_]);
         std::ostringstream str;
         str << " Flags: " << getFlagString();
-        return idstring.str() + cmdStr + " Src: " + src_ + " Dst: " + dst_ + " Rq: " + rqstr_ + " Tid: " + std::to_string(tid_) + str.str();
+        return idstring.str() + cmdStr + " Src: " + getSrc() + " Dst: " + getDst() + " Rq: " + getRqstr() + " Tid: " + std::to_string(tid_) + str.str();
     }
 
     /** Get brief print of the event */
@@ -190,7 +209,7 @@ public:
         std::string cmdStr(CommandString[(int)cmd_]);
         std::ostringstream idstring;
         idstring << "<" << eventID_.first << "," << eventID_.second << "> ";
-        return idstring.str() + cmdStr + " Src: " + src_ + " Dst: " + dst_ + " Tid: " + std::to_string(tid_);
+        return idstring.str() + cmdStr + " Src: " + getSrc() + " Dst: " + getDst() + " Tid: " + std::to_string(tid_);
     }
     
     /** Get brief print of the event */
@@ -198,7 +217,7 @@ public:
         std::string cmdStr(CommandString[(int)cmd_]);
         std::ostringstream idstring;
         idstring << "<" << eventID_.first << "," << eventID_.second << "> ";
-        return idstring.str() + cmdStr + " Src: " + src_ + " Dst: " + dst_ + " Tid: " + std::to_string(tid_);
+        return idstring.str() + cmdStr + " Src: " + getSrc() + " Dst: " + getDst() + " Tid: " + std::to_string(tid_);
     }
 
     virtual bool doDebug(std::set<Addr> &UNUSED(addr)) {
@@ -220,9 +239,9 @@ public:
 protected:
     id_type         eventID_;           // Unique ID for this event
     id_type         responseToID_;      // For responses, holds the ID to which this event matches
-    string          src_;               // Source ID
-    string          dst_;               // Destination ID
-    string          rqstr_;             // Cache that originated this request
+    EndpointID      src_;               // Source ID
+    EndpointID      dst_;               // Destination ID
+    EndpointID      rqstr_;             // Cache that originated this request
     uint32_t        tid_;               // Thread ID that originated this request
     Command         cmd_;               // Command
     uint32_t        flags_;
@@ -235,9 +254,43 @@ public:
         Event::serialize_order(ser);
         ser & eventID_;
         ser & responseToID_;
-        ser & src_;
-        ser & dst_;
-        ser & rqstr_;
+        // Endpoint IDs are rank-local, send the IDs every rank agreed on after init()
+        // and fall back to the names during init() or for names that were not shared
+        EndpointTable& table = EndpointTable::get();
+        EndpointID src = NO_ENDPOINT, dst = NO_ENDPOINT, rqstr = NO_ENDPOINT;
+        bool wire = false;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK) {
+            src = table.toWire(src_);
+            dst = table.toWire(dst_);
+            rqstr = table.toWire(rqstr_);
+            wire = src != NO_ENDPOINT && dst != NO_ENDPOINT && rqstr != NO_ENDPOINT;
+        }
+        ser & wire;
+        if (wire) {
+            ser & src;
+            ser & dst;
+            ser & rqstr;
+            if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+                src_ = table.fromWire(src);
+                dst_ = table.fromWire(dst);
+                rqstr_ = table.fromWire(rqstr);
+            }
+        } else {
+            std::string srcName, dstName, rqstrName;
+            if (ser.mode() != SST::Core::Serialization::serializer::UNPACK) {
+                srcName = table.getName(src_);
+                dstName = table.getName(dst_);
+                rqstrName = table.getName(rqstr_);
+            }
+            ser & srcName;
+            ser & dstName;
+            ser & rqstrName;
+            if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+                src_ = table.intern(srcName);
+                dst_ = table.intern(dstName);
+                rqstr_ = table.intern(rqstrName);
+            }
+        }
         ser & tid_;
         ser & cmd_;
         ser & flags_;
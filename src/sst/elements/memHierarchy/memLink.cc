@@ -100,10 +100,13 @@ void MemLink::init(unsigned int phase) {
         }
     }
 
+    EndpointTable::get().shareNames();
 }
 
 
 void MemLink::setup() {
+    EndpointTable::get().finalize();
+
     dbg.debug(_L10_, "Routing information for %s\n", getName().c_str());
     for (auto it = remotes.begin(); it != remotes.end(); it++) {
         dbg.debug(_L10_, "    Remote: %s\n", it->toString().c_str()); 
@@ -310,7 +310,7 @@ class MemNICBase : public MemLinkBase {
                 InitMemRtrEvent * imre = dynamic_cast<InitMemRtrEvent*>(payload);
                 if (imre) {
                     // Record name->address map for all other endpoints
-                    networkAddressMap.insert(std::make_pair(imre->info.name, imre->info.addr));
+                    networkAddressMap.insert(std::make_pair(EndpointTable::get().intern(imre->info.name), imre->info.addr));
                     processInitMemRtrEvent(imre);
                     delete imre;
                 } else {
@@ -358,11 +358,15 @@ class MemNICBase : public MemLinkBase {
                 }
                 delete req;
             }
+
+            EndpointTable::get().shareNames();
         }
         
         // Setup
         // Clean up state generated during init() and perform some sanity checks
         virtual void setup() {
+            EndpointTable::get().finalize();
+
             /* Limit destinations to the memory regions reported by endpoint messages that came through them */
             
             std::set<std::string> names;
@@ -419,7 +423,7 @@ class MemNICBase : public MemLinkBase {
                         getName().c_str());
 
             for (auto it = networkAddressMap.begin(); it != networkAddressMap.end(); it++) {
-                dbg.debug(_L10_, "    Address: %s -> %" PRIu64 "\n", it->first.c_str(), it->second);
+                dbg.debug(_L10_, "    Address: %s -> %" PRIu64 "\n", EndpointTable::get().getName(it->first).c_str(), it->second);
             }
             for (auto it = sourceEndpointInfo.begin(); it != sourceEndpointInfo.end(); it++) {
                 dbg.debug(_L10_, "    Source: %s\n", it->toString().c_str()); 
@@ -438,14 +442,18 @@ class MemNICBase : public MemLinkBase {
         }
 
         // Lookup the network address for a given endpoint
-        virtual uint64_t lookupNetworkAddress(const std::string &dst) const {
-            std::unordered_map<std::string,uint64_t>::const_iterator it = networkAddressMap.find(dst);
+        virtual uint64_t lookupNetworkAddress(EndpointID dst) const {
+            std::unordered_map<EndpointID,uint64_t>::const_iterator it = networkAddressMap.find(dst);
             if (it == networkAddressMap.end()) {
-                dbg.fatal(CALL_INFO, -1, "%s (MemNICBase), Network address for destination '%s' not found in networkAddressMap.\n", getName().c_str(), dst.c_str());
+                dbg.fatal(CALL_INFO, -1, "%s (MemNICBase), Network address for destination '%s' not found in networkAddressMap.\n", getName().c_str(), EndpointTable::get().getName(dst).c_str());
             }
             return it->second;
         }
 
+        uint64_t lookupNetworkAddress(const std::string &dst) const {
+            return lookupNetworkAddress(EndpointTable::get().intern(dst));
+        }
+
         /*
          * Some helper functions to avoid needing to repeat code everywhere
          */
@@ -494,7 +502,7 @@ class MemNICBase : public MemLinkBase {
                     return mre;
                 } else {
                     InitMemRtrEvent * imre = static_cast<InitMemRtrEvent*>(mre);
-                    if (networkAddressMap.find(imre->info.name) == networkAddressMap.end()) {
+                    if (networkAddressMap.find(EndpointTable::get().intern(imre->info.name)) == networkAddressMap.end()) {
                         dbg.fatal(CALL_INFO, -1, "%s received information about previously unknown endpoint. This case is not handled. Endpoint name: %s\n",
                                 getName().c_str(), imre->info.name.c_str());
                     }
@@ -514,7 +522,7 @@ class MemNICBase : public MemLinkBase {
         bool initMsgSent;
 
         // Data structures
-        std::unordered_map<std::string,uint64_t> networkAddressMap; // Map of name -> address for each network endpoint
+        std::unordered_map<EndpointID,uint64_t> networkAddressMap; // Map of endpoint ID (see EndpointTable) -> address for each network endpoint
         std::set<EndpointInfo> sourceEndpointInfo;
         std::set<EndpointInfo> destEndpointInfo;
         std::set<EndpointInfo> endpointInfo;
@@ -19,26 +19,161 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <functional>
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
 namespace MemHierarchy {
 namespace Backend {
 
+/*
+ * Functional backing store for a memory.
+ *
+ * The bulk set/get calls copy a range with memcpy, one copy per contiguous
+ * piece of the underlying store. getPointer() returns a direct pointer into
+ * the store when the whole range is contiguous (e.g., it does not cross a
+ * page) so callers can skip the copy entirely; it returns nullptr otherwise.
+ *
+ * Every store can write its contents to an image file and read one back
+ * (dumpImage/loadImage). The image is a sparse list of (address, length, data)
+ * records so it can be loaded into any store type regardless of which one
+ * wrote it.
+ */
 class Backing {
 public:
     Backing( ) { }
     virtual ~Backing() { }
 
     virtual void set( Addr addr, uint8_t value ) = 0;
-    virtual void set( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void set( Addr addr, size_t size, const uint8_t* data ) = 0;
+    void set( Addr addr, size_t size, const std::vector<uint8_t>& data ) {
+        set(addr, size, data.data());
+    }
+
+    virtual uint8_t get( Addr addr ) = 0;
+    virtual void get( Addr addr, size_t size, uint8_t* data ) = 0;
+    void get( Addr addr, size_t size, std::vector<uint8_t>& data ) {
+        get(addr, size, data.data());
+    }
+
+    /* Direct pointer to [addr, addr + size) or nullptr if the range is not contiguous in the store */
+    virtual uint8_t* getPointer( Addr addr, size_t size ) = 0;
+
+    /* Write the store's contents to 'file'. Returns false if the file could not be written. */
+    bool dumpImage( const std::string& file ) {
+        FILE* fp = fopen(file.c_str(), "wb");
+        if (fp == NULL)
+            return false;
+
+        ImageHeader header;
+        memcpy(header.magic, imageMagic, sizeof(header.magic));
+        header.version = imageVersion;
+        header.reserved = 0;
+        bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+        forEachChunk([&](Addr addr, const uint8_t* data, size_t size) {
+            if (!ok) return;
+            ImageRecord record;
+            record.addr = addr;
+            record.size = size;
+            record.zero = 1;
+            for (size_t i = 0; i < size; i++) {
+                if (data[i] != 0) {
+                    record.zero = 0;
+                    break;
+                }
+            }
+            ok = fwrite(&record, sizeof(record), 1, fp) == 1;
+            if (ok && !record.zero)
+                ok = fwrite(data, 1, size, fp) == size;
+        });
 
-    virtual uint8_t get( Addr addr) = 0;
-    virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+        if (fclose(fp) != 0)
+            ok = false;
+        return ok;
+    }
+
+    /* Overlay the contents of an image written by dumpImage onto the store. Returns false if the file is missing or malformed
+     * or has a record outside of the store's address range. */
+    bool loadImage( const std::string& file ) {
+        FILE* fp = fopen(file.c_str(), "rb");
+        if (fp == NULL)
+            return false;
+
+        ImageHeader header;
+        if (fread(&header, sizeof(header), 1, fp) != 1 || memcmp(header.magic, imageMagic, sizeof(header.magic)) != 0 || header.version != imageVersion) {
+            fclose(fp);
+            return false;
+        }
+
+        std::vector<uint8_t> buffer;
+        ImageRecord record;
+        bool ok = true;
+        while (ok && fread(&record, sizeof(record), 1, fp) == 1) {
+            if (record.size > UINT64_MAX - record.addr || !contains(record.addr, record.size)) {
+                ok = false;
+                break;
+            }
+            if (record.zero) {
+                setZero(record.addr, record.size);
+                continue;
+            }
+            buffer.resize(std::min<uint64_t>(record.size, imageChunk));
+            for (uint64_t done = 0; ok && done < record.size; done += buffer.size()) {
+                size_t bytes = std::min<uint64_t>(record.size - done, buffer.size());
+                ok = fread(buffer.data(), 1, bytes, fp) == bytes;
+                if (ok)
+                    set(record.addr + done, bytes, buffer.data());
+            }
+        }
+        ok = ok && feof(fp);
+        fclose(fp);
+        return ok;
+    }
+
+protected:
+    /* Call 'func' on each populated, contiguous piece of the store in ascending address order */
+    virtual void forEachChunk( std::function<void(Addr, const uint8_t*, size_t)> func ) = 0;
+
+    /* Whether [addr, addr + size) can be written, stores that grow on demand accept any range */
+    virtual bool contains( Addr /*addr*/, uint64_t /*size*/ ) { return true; }
+
+    /* Clear [addr, addr + size), stores whose untouched memory already reads as zero only need to clear what was written */
+    virtual void setZero( Addr addr, uint64_t size ) {
+        std::vector<uint8_t> buffer(std::min<uint64_t>(size, imageChunk), 0);
+        for (uint64_t done = 0; done < size; done += buffer.size())
+            set(addr + done, std::min<uint64_t>(size - done, buffer.size()), buffer.data());
+    }
+
+    enum { imageChunk = 1 << 20 };   /* Largest record written, and largest piece copied at a time when loading */
+
+private:
+    static constexpr const char* imageMagic = "SSTMEMIM";
+    static constexpr uint32_t imageVersion = 1;
+
+    struct ImageHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    /* Followed by 'size' bytes of data unless 'zero' is set */
+    struct ImageRecord {
+        uint64_t addr;
+        uint64_t size;
+        uint64_t zero;
+    };
 };
 
 class BackingMMAP : public Backing {
 public:
+    using Backing::set;
+    using Backing::get;
+
     BackingMMAP(std::string memoryFile, size_t size, size_t offset = 0) : Backing(), m_fd(-1), m_size(size), m_offset(offset) {
         int flags = MAP_SHARED;
         if ( ! memoryFile.empty() ) {
@@ -63,34 +198,54 @@ public:
         }
     }
 
-    void set( Addr addr, uint8_t value ) {
+    void set( Addr addr, uint8_t value ) override {
         m_buffer[addr - m_offset ] = value;
     }
 
-    void set (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            m_buffer[addr + i] = data[i];
+    void set( Addr addr, size_t size, const uint8_t* data ) override {
+        memcpy(m_buffer + (addr - m_offset), data, size);
     }
 
-    uint8_t get( Addr addr ) {
+    uint8_t get( Addr addr ) override {
         return m_buffer[addr - m_offset];
     }
 
-    void get( Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            data[i] = m_buffer[addr + i];
+    void get( Addr addr, size_t size, uint8_t* data ) override {
+        memcpy(data, m_buffer + (addr - m_offset), size);
+    }
+
+    uint8_t* getPointer( Addr addr, size_t /*size*/ ) override {
+        return m_buffer + (addr - m_offset);
+    }
+
+protected:
+    void forEachChunk( std::function<void(Addr, const uint8_t*, size_t)> func ) override {
+        for (size_t pos = 0; pos < m_size; pos += imageChunk)
+            func(pos + m_offset, m_buffer + pos, std::min<size_t>(imageChunk, m_size - pos));
+    }
+
+    bool contains( Addr addr, uint64_t size ) override {
+        return addr >= m_offset && addr - m_offset <= m_size && size <= m_size - (addr - m_offset);
+    }
+
+    /* Which pages were written is not tracked, clear in place */
+    void setZero( Addr addr, uint64_t size ) override {
+        memset(m_buffer + (addr - m_offset), 0, size);
     }
 
 private:
     uint8_t* m_buffer;
     int m_fd;
-    int m_size;
+    size_t m_size;
     size_t m_offset;
 };
 
 class BackingMalloc : public Backing {
 public:
-    BackingMalloc(size_t size, bool init = false ) : m_init(init) {
+    using Backing::set;
+    using Backing::get;
+
+    BackingMalloc(size_t size, bool init = false ) : m_init(init), m_lastBAddr(0), m_lastData(nullptr) {
         m_allocUnit = size;
         /* Alloc unit needs to be pwr-2 */
         if (!isPowerOfTwo(m_allocUnit)) {
@@ -100,79 +255,291 @@ public:
         m_shift = log2Of(m_allocUnit);
     }
 
-    void set( Addr addr, uint8_t value ) {
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        m_buffer[bAddr][offset] = value;
+    ~BackingMalloc() {
+        for (auto it = m_buffer.begin(); it != m_buffer.end(); it++)
+            free(it->second);
     }
 
-    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
-        /* Account for size exceeding alloc unit size */
+    void set( Addr addr, uint8_t value ) override {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        size_t dataOffset = 0;
-
-        allocIfNeeded(bAddr);
+        getUnit(bAddr)[offset] = value;
+    }
 
-        while (dataOffset != size) {
-            m_buffer[bAddr][offset] = data[dataOffset];
-            offset++;
-            dataOffset++;
+    void set( Addr addr, size_t size, const uint8_t* data ) override {
+        /* Account for size exceeding alloc unit size */
+        while (size != 0) {
+            Addr bAddr = addr >> m_shift;
+            Addr offset = addr - (bAddr << m_shift);
+            size_t bytes = std::min(size, (size_t)(m_allocUnit - offset));
+            memcpy(getUnit(bAddr) + offset, data, bytes);
+            addr += bytes;
+            data += bytes;
+            size -= bytes;
+        }
+    }
 
-            if (offset == m_allocUnit) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
+    void get( Addr addr, size_t size, uint8_t* data ) override {
+        while (size != 0) {
+            Addr bAddr = addr >> m_shift;
+            Addr offset = addr - (bAddr << m_shift);
+            size_t bytes = std::min(size, (size_t)(m_allocUnit - offset));
+            memcpy(data, getUnit(bAddr) + offset, bytes);
+            addr += bytes;
+            data += bytes;
+            size -= bytes;
         }
     }
 
-    void get (Addr addr, size_t size, std::vector<uint8_t> &data) {
+    uint8_t get( Addr addr ) override {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        size_t dataOffset = 0;
-
-        allocIfNeeded(bAddr);
-
-        while (dataOffset != size) {
-            data[dataOffset] = m_buffer[bAddr][offset];
-            offset++;
-            dataOffset++;
-            if (offset == m_allocUnit) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
-        }
+        return getUnit(bAddr)[offset];
     }
 
-    uint8_t get( Addr addr ) {
+    uint8_t* getPointer( Addr addr, size_t size ) override {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        return m_buffer[bAddr][offset];
+        if (offset + size > m_allocUnit)
+            return nullptr;
+        return getUnit(bAddr) + offset;
+    }
+
+protected:
+    void forEachChunk( std::function<void(Addr, const uint8_t*, size_t)> func ) override {
+        std::vector<Addr> units;
+        units.reserve(m_buffer.size());
+        for (auto it = m_buffer.begin(); it != m_buffer.end(); it++)
+            units.push_back(it->first);
+        std::sort(units.begin(), units.end());
+        for (auto it = units.begin(); it != units.end(); it++)
+            func(*it << m_shift, m_buffer[*it], m_allocUnit);
+    }
+
+    /* With init set, units that were never touched read as zero so only existing units are cleared */
+    void setZero( Addr addr, uint64_t size ) override {
+        if (!m_init) {
+            Backing::setZero(addr, size);
+            return;
+        }
+        while (size != 0) {
+            Addr bAddr = addr >> m_shift;
+            Addr offset = addr - (bAddr << m_shift);
+            uint64_t bytes = std::min<uint64_t>(size, m_allocUnit - offset);
+            auto it = m_buffer.find(bAddr);
+            if (it != m_buffer.end())
+                memset(it->second + offset, 0, bytes);
+            addr += bytes;
+            size -= bytes;
+        }
     }
 
 private:
-    void allocIfNeeded(Addr bAddr) {
-        if (m_buffer.find(bAddr) == m_buffer.end()) {
+    /* Consecutive accesses usually hit the same unit, so remember the last one and skip the map lookup */
+    uint8_t* getUnit(Addr bAddr) {
+        if (m_lastData != nullptr && bAddr == m_lastBAddr)
+            return m_lastData;
+
+        auto it = m_buffer.find(bAddr);
+        if (it == m_buffer.end()) {
             uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
-            if ( m_init ) {
-                bzero( data, m_allocUnit );
-            }
             if (!data) {
                 Output out("", 1, 0, Output::STDOUT);
                 out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
             }
-            m_buffer[bAddr] = data;
+            if ( m_init ) {
+                memset( data, 0, m_allocUnit );
+            }
+            it = m_buffer.insert(std::make_pair(bAddr, data)).first;
         }
+        m_lastBAddr = bAddr;
+        m_lastData = it->second;
+        return m_lastData;
     }
 
     std::unordered_map<Addr,uint8_t*> m_buffer;
-    unsigned int m_allocUnit;
+    size_t m_allocUnit;
     unsigned int m_shift;
     bool m_init;
+    Addr m_lastBAddr;
+    uint8_t* m_lastData;
+};
+
+/*
+ * Sparse store for large memories. Pages are allocated on first touch and
+ * found through a two-level page table: a directory indexed by the upper
+ * address bits pointing to tables of 512 page pointers. Pages read before
+ * they are written read as zero.
+ *
+ * With hugePages set, the page size is rounded up to 2MiB and each page is
+ * mapped on a 2MiB boundary and advised as a transparent huge page, which
+ * cuts TLB misses on the host for large, densely used images.
+ */
+class BackingSparse : public Backing {
+public:
+    using Backing::set;
+    using Backing::get;
+
+    static constexpr size_t hugePageSize = 2 * 1024 * 1024;
+
+    BackingSparse(size_t memSize, size_t pageSize, bool hugePages = false) : m_hugePages(hugePages), m_lastPage(0), m_lastData(nullptr) {
+        if (!isPowerOfTwo(pageSize)) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - page size must be a power of two. Got: %zu\n", pageSize);
+        }
+        m_pageSize = (hugePages && pageSize < hugePageSize) ? hugePageSize : pageSize;
+        m_shift = log2Of(m_pageSize);
+
+        uint64_t tableSpan = (uint64_t)m_pageSize << tableBits;
+        m_directory.resize((memSize + tableSpan - 1) / tableSpan, nullptr);
+    }
+
+    ~BackingSparse() {
+        for (auto dir = m_directory.begin(); dir != m_directory.end(); dir++) {
+            if (*dir == nullptr)
+                continue;
+            for (size_t i = 0; i < tableSize; i++) {
+                if ((*dir)[i] == nullptr)
+                    continue;
+                if (m_hugePages)
+                    munmap((*dir)[i], m_pageSize);
+                else
+                    free((*dir)[i]);
+            }
+            delete [] *dir;
+        }
+    }
+
+    void set( Addr addr, uint8_t value ) override {
+        getPage(addr >> m_shift)[addr & (m_pageSize - 1)] = value;
+    }
+
+    void set( Addr addr, size_t size, const uint8_t* data ) override {
+        while (size != 0) {
+            Addr offset = addr & (m_pageSize - 1);
+            size_t bytes = std::min(size, (size_t)(m_pageSize - offset));
+            memcpy(getPage(addr >> m_shift) + offset, data, bytes);
+            addr += bytes;
+            data += bytes;
+            size -= bytes;
+        }
+    }
+
+    uint8_t get( Addr addr ) override {
+        return getPage(addr >> m_shift)[addr & (m_pageSize - 1)];
+    }
+
+    void get( Addr addr, size_t size, uint8_t* data ) override {
+        while (size != 0) {
+            Addr offset = addr & (m_pageSize - 1);
+            size_t bytes = std::min(size, (size_t)(m_pageSize - offset));
+            memcpy(data, getPage(addr >> m_shift) + offset, bytes);
+            addr += bytes;
+            data += bytes;
+            size -= bytes;
+        }
+    }
+
+    uint8_t* getPointer( Addr addr, size_t size ) override {
+        Addr offset = addr & (m_pageSize - 1);
+        if (offset + size > m_pageSize)
+            return nullptr;
+        return getPage(addr >> m_shift) + offset;
+    }
+
+    size_t getPageSize() { return m_pageSize; }
+
+protected:
+    void forEachChunk( std::function<void(Addr, const uint8_t*, size_t)> func ) override {
+        for (size_t d = 0; d < m_directory.size(); d++) {
+            if (m_directory[d] == nullptr)
+                continue;
+            for (size_t i = 0; i < tableSize; i++) {
+                if (m_directory[d][i] != nullptr)
+                    func((Addr)((d << tableBits) + i) << m_shift, m_directory[d][i], m_pageSize);
+            }
+        }
+    }
+
+    /* Pages that were never touched read as zero so only existing pages are cleared */
+    void setZero( Addr addr, uint64_t size ) override {
+        while (size != 0) {
+            Addr offset = addr & (m_pageSize - 1);
+            uint64_t bytes = std::min<uint64_t>(size, m_pageSize - offset);
+            uint8_t* data = findPage(addr >> m_shift);
+            if (data != nullptr)
+                memset(data + offset, 0, bytes);
+            addr += bytes;
+            size -= bytes;
+        }
+    }
+
+private:
+    static constexpr unsigned int tableBits = 9;
+    static constexpr size_t tableSize = (size_t)1 << tableBits;
+
+    uint8_t* getPage(Addr page) {
+        if (m_lastData != nullptr && page == m_lastPage)
+            return m_lastData;
+
+        Addr dir = page >> tableBits;
+        if (dir >= m_directory.size())
+            m_directory.resize(dir + 1, nullptr);
+        if (m_directory[dir] == nullptr)
+            m_directory[dir] = new uint8_t*[tableSize]();
+
+        uint8_t*& data = m_directory[dir][page & (tableSize - 1)];
+        if (data == nullptr)
+            data = allocPage();
+
+        m_lastPage = page;
+        m_lastData = data;
+        return data;
+    }
+
+    /* Like getPage but does not allocate, nullptr if the page was never touched */
+    uint8_t* findPage(Addr page) {
+        Addr dir = page >> tableBits;
+        if (dir >= m_directory.size() || m_directory[dir] == nullptr)
+            return nullptr;
+        return m_directory[dir][page & (tableSize - 1)];
+    }
+
+    uint8_t* allocPage() {
+        if (!m_hugePages) {
+            uint8_t* data = (uint8_t*) calloc(1, m_pageSize);
+            if (!data) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "BackingSparse: Error - malloc failed.\n");
+            }
+            return data;
+        }
+
+        /* Over-map by a huge page so the page can start on a huge page boundary, then trim */
+        size_t length = m_pageSize + hugePageSize;
+        void* raw = mmap(NULL, length, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+        if (raw == MAP_FAILED) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - mmap of a %zu byte page failed.\n", m_pageSize);
+        }
+        uintptr_t start = (uintptr_t)raw;
+        uintptr_t aligned = (start + hugePageSize - 1) & ~(uintptr_t)(hugePageSize - 1);
+        if (aligned != start)
+            munmap(raw, aligned - start);
+        if (aligned + m_pageSize != start + length)
+            munmap((void*)(aligned + m_pageSize), start + length - aligned - m_pageSize);
+#ifdef MADV_HUGEPAGE
+        madvise((void*)aligned, m_pageSize, MADV_HUGEPAGE);
+#endif
+        return (uint8_t*)aligned;
+    }
+
+    std::vector<uint8_t**> m_directory;
+    size_t m_pageSize;
+    unsigned int m_shift;
+    bool m_hugePages;
+    Addr m_lastPage;
+    uint8_t* m_lastData;
 };
 
 }
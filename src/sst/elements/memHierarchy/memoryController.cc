@@ -268,8 +268,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         if (oldBackVal) backingType = "none";
     }
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -311,6 +311,15 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         }
     } else if (backingType == "malloc") {
         backing_ = new Backend::BackingMalloc(sizeBytes,initBacking);
+    } else if (backingType == "sparse") {
+        bool hugePages = params.find<bool>("backing_huge_pages", false);
+        backing_ = new Backend::BackingSparse(memBackendConvertor_->getMemSize(), size_ua.getRoundedValue(), hugePages);
+    }
+
+    imageLoadFile_ = params.find<std::string>("memory_image_load", "");
+    imageDumpFile_ = params.find<std::string>("memory_image_dump", "");
+    if (!backing_ && (!imageLoadFile_.empty() || !imageDumpFile_.empty())) {
+        out.fatal(CALL_INFO, -1, "%s, Error - memory_image_load and memory_image_dump require a backing store but 'backing' is 'none'.\n", getName().c_str());
     }
 
     /* Custom command handler */
@@ -571,6 +580,13 @@ void MemController::init(unsigned int phase) {
 void MemController::setup(void) {
     memBackendConvertor_->setup();
     link_->setup();
+
+    /* Load after init so the image overrides any initial values written during init */
+    if (!imageLoadFile_.empty()) {
+        if (!backing_->loadImage(imageLoadFile_))
+            out.fatal(CALL_INFO, -1, "%s, Error - unable to load memory image '%s'. File is missing, is not a memory image or does not fit in this memory.\n", getName().c_str(), imageLoadFile_.c_str());
+        out.verbose(CALL_INFO, 1, 0, "%s, Loaded memory image '%s'\n", getName().c_str(), imageLoadFile_.c_str());
+    }
 }
 
 
@@ -579,6 +595,11 @@ void MemController::finish(void) {
     cycle--;
     memBackendConvertor_->finish(cycle);
     link_->finish();
+
+    /* Lines still dirty in caches are not part of the image, only what has been written back to this memory */
+    if (!imageDumpFile_.empty() && !backing_->dumpImage(imageDumpFile_)) {
+        out.output("%s, Warning - unable to write memory image to '%s'\n", getName().c_str(), imageDumpFile_.c_str());
+    }
 }
 
 void MemController::writeData(MemEvent* event) {
@@ -630,9 +651,7 @@ void MemController::readData(MemEvent* event) {
 void MemController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++) {
-        backing_->set(addr + i, data->at(i));
-    }
+    backing_->set(addr, data->size(), *data);
 
     if (is_debug_addr(addr))
         printDataValue(addr, data, true);
@@ -644,9 +663,8 @@ void MemController::readData(Addr addr, size_t bytes, std::vector<uint8_t> &data
 
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
-    
+    backing_->get(addr, bytes, data);
+
     if (is_debug_addr(addr))
         printDataValue(addr, &data, false);
 }
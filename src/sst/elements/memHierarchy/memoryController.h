@@ -50,9 +50,12 @@ public:
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},\
             {"listenercount",       "(uint) Counts the number of listeners attached to this controller, these are modules for tracing or components like prefetchers", "0"},\
             {"listener%(listenercount)d", "(string) Loads a listener module into the controller", ""},\
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
-            {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse' (page-table backed, for large memories)", "mmap"},\
+            {"backing_size_unit",   "(string) For 'malloc' and 'sparse' backing stores, allocation granularity", "1MiB"},\
+            {"backing_huge_pages",  "(bool) For 'sparse' backing stores, back pages with 2MiB transparent huge pages (raises backing_size_unit to 2MiB if smaller)", "false"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"memory_image_load",   "(string) Optional memory image, written by memory_image_dump, to load into the backing store at the end of init", ""},\
+            {"memory_image_dump",   "(string) Optional file to write the backing store contents to at the end of simulation. Load it with memory_image_load to skip warm-up on later runs. Caches are not flushed first, so lines still dirty in a cache are written with the value memory holds", ""},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
@@ -127,6 +130,8 @@ protected:
 
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
+    std::string             imageLoadFile_; // Memory image to load in setup(), if any
+    std::string             imageDumpFile_; // File to dump the memory image to in finish(), if any
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy
     bool clockLink_;            // Flag - should we call clock() on this link or not
@@ -22,7 +22,7 @@ using namespace SST;
 using namespace SST::MemHierarchy;
 
 MSHR::MSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std::set<Addr> debugAddr) :
-    ComponentExtension(cid)
+    ComponentExtension(cid), mshr_(maxSize > 0 ? 2 * maxSize : 64)
 {
     d_ = debug;
     maxSize_ = maxSize;
@@ -36,6 +36,23 @@ MSHR::MSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std:
     DEBUG_ADDR = debugAddr;
 }
 
+/* Register lookup for accessors that require the address to be present */
+MSHRRegister* MSHR::getRegister(Addr addr, const char* caller) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::%s(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), caller, addr);
+    }
+    return reg;
+}
+
+MSHRBlock::Index MSHR::getFrontIndex(Addr addr, const char* caller) {
+    MSHRRegister* reg = getRegister(addr, caller);
+    if (reg->head == MSHRBlock::NIL) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::%s(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), caller, addr);
+    }
+    return reg->head;
+}
+
 int MSHR::getMaxSize() {
     return maxSize_;
 }
@@ -45,164 +62,117 @@ int MSHR::getSize() {
 }
 
 unsigned int MSHR::getSize(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
-        return 0;
-    else
-        return mshr_.find(addr)->second.entries.size();
+    MSHRRegister* reg = mshr_.find(addr);
+    return reg ? reg->count : 0;
 }
 
 bool MSHR::exists(Addr addr) {
-    return mshr_.find(addr) != mshr_.end();
+    return mshr_.find(addr) != nullptr;
 }
 
 MSHREntry MSHR::getEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
-    }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, mshr_.find(addr)->second.entries.size());
+    MSHRRegister* reg = getRegister(addr, "getEntry");
+    if (reg->count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %u.\n", ownerName_.c_str(), addr, index, reg->count);
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-    std::advance(it, index);
-    return *it;
+    return mshr_.node(mshr_.at(reg, index)).entry;
 }
 
 MSHREntry MSHR::getFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-
-    if (mshr_.find(addr)->second.entries.empty()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
-    }
-    return mshr_.find(addr)->second.entries.front();
+    return mshr_.node(getFrontIndex(addr, "getFront")).entry;
 }
 
 void MSHR::removeEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
-    }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
-    if (reg->entries.size() <= index) {
+    MSHRRegister* reg = getRegister(addr, "removeEntry");
+    if (reg->count <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
 
-    std::list<MSHREntry>::iterator entry = reg->entries.begin();
-    std::advance(entry, index);
+    MSHRBlock::Index entry = mshr_.at(reg, index);
 
-    if (entry->getType() == MSHREntryType::Event)
+    if (mshr_.node(entry).entry.getType() == MSHREntryType::Event)
         size_--;
 
     if (is_debug_addr(addr))
-        printDebug(10, "Remove", addr, (*entry).getString().c_str());
+        printDebug(10, "Remove", addr, mshr_.node(entry).entry.getString().c_str());
 
-    reg->entries.erase(entry);
-    if (reg->entries.empty()) {
+    mshr_.unlink(reg, entry);
+    if (reg->count == 0) {
         if (is_debug_addr(addr))
             printDebug(10, "Erase", addr, "");
-            //d_->debug(_L10_, "M: %-41" PRIu64 " %-20s Erase        0x%-16" PRIx64 " %-10d\n",
-            //        getCurrentSimCycle(), ownerName_.c_str(), addr, size_);
-            //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
         mshr_.erase(addr);
     }
 }
 
 void MSHR::removeFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
-    if (reg->entries.empty()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
-    }
-
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::removeFront(0x%" PRIx64 ", %s)\n", addr, reg->entries.front().getString().c_str());
+    MSHRRegister* reg = getRegister(addr, "removeFront");
+    MSHRBlock::Index entry = getFrontIndex(addr, "removeFront");
 
-    if (getFrontType(addr) == MSHREntryType::Event)
+    if (mshr_.node(entry).entry.getType() == MSHREntryType::Event)
         size_--;
 
     if (is_debug_addr(addr))
-        printDebug(10, "RemFr", addr, (reg->entries.front()).getString().c_str());
+        printDebug(10, "RemFr", addr, mshr_.node(entry).entry.getString().c_str());
 
-    reg->entries.pop_front();
-    if (reg->entries.empty()) {
+    mshr_.unlink(reg, entry);
+    if (reg->count == 0) {
         if (is_debug_addr(addr))
             printDebug(10, "Erase", addr, "");
-            //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
         mshr_.erase(addr);
     }
 }
 
 MSHREntryType MSHR::getEntryType(Addr addr, size_t index) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getEntryType(0x%" PRIx64 ", %zu)\n", addr, index);
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
-    }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
+    MSHRRegister* reg = getRegister(addr, "getEntryType");
+    if (reg->count <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Entry list is shoerter than index.\n", ownerName_.c_str(), addr, index);
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-    std::advance(it, index);
-    return it->getType();
+    return mshr_.node(mshr_.at(reg, index)).entry.getType();
 }
 
 MSHREntryType MSHR::getFrontType(Addr addr) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getFrontType(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
-    }
-    return mshr_.find(addr)->second.entries.front().getType();
+    return mshr_.node(getFrontIndex(addr, "getFrontType")).entry.getType();
 }
 
 MemEventBase* MSHR::getEntryEvent(Addr addr, size_t index) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getEntryEvent(0x%" PRIx64 ", %zu)\n", addr, index);
-
-    if (mshr_.find(addr) == mshr_.end() || mshr_.find(addr)->second.entries.size() <= index)
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr || reg->count <= index)
         return nullptr;
 
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-    std::advance(it, index);
-    if (it->getType() != MSHREntryType::Event)
+    MSHREntry& entry = mshr_.node(mshr_.at(reg, index)).entry;
+    if (entry.getType() != MSHREntryType::Event)
         return nullptr;
-    return it->getEvent();
+    return entry.getEvent();
 }
 
 
 MemEventBase* MSHR::getFrontEvent(Addr addr) {
-    //if (is_debug_addr(addr))
-    //    d_->debug(_L20_, "    MSHR::getFrontEvent(0x%" PRIx64 ")\n", addr);
-    if (getFrontType(addr) != MSHREntryType::Event) {
+    MSHREntry& entry = mshr_.node(getFrontIndex(addr, "getFrontEvent")).entry;
+    if (entry.getType() != MSHREntryType::Event) {
         return nullptr;
     }
-    return mshr_.find(addr)->second.entries.front().getEvent();
+    return entry.getEvent();
 }
 
 MemEventBase* MSHR::getFirstEventEntry(Addr addr, Command cmd) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getFirstEventEntry(0x%" PRIx64 ", %s)\n", addr, CommandString[(int)cmd]);
-
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr)
         return nullptr;
 
-    for (std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin(); it != mshr_.find(addr)->second.entries.end(); it++) {
-        if (it->getType() == MSHREntryType::Event && it->getEvent()->getCmd() == cmd)
-            return it->getEvent();
+    for (MSHRBlock::Index it = reg->head; it != MSHRBlock::NIL; it = mshr_.node(it).next) {
+        MSHREntry& entry = mshr_.node(it).entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getCmd() == cmd)
+            return entry.getEvent();
     }
     return nullptr;
 }
 
-std::list<Addr>* MSHR::getEvictPointers(Addr addr) {
-    if (getFrontType(addr) != MSHREntryType::Evict)
+std::vector<Addr>* MSHR::getEvictPointers(Addr addr) {
+    MSHREntry& entry = mshr_.node(getFrontIndex(addr, "getEvictPointers")).entry;
+    if (entry.getType() != MSHREntryType::Evict)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEvictPointers(0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr);
 
-    return mshr_.find(addr)->second.entries.front().getPointers();
+    return entry.getPointers();
 }
 
 // Return whether we should retry a new event or not
@@ -217,20 +187,21 @@ bool MSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
     }
 
     // Sometimes we insert a WB before the Evict & then remove the Evict pointer, othertimes the Evict is front
+    MSHRRegister* reg = mshr_.find(addr);
     if (getFrontType(addr) == MSHREntryType::Evict) {
-        MSHREntry * entry = &(mshr_.find(addr)->second.entries.front());
-        entry->getPointers()->remove(addrPtr);
-        if (entry->getPointers()->empty()) {
+        std::vector<Addr>* ptrs = mshr_.node(reg->head).entry.getPointers();
+        ptrs->erase(std::remove(ptrs->begin(), ptrs->end(), addrPtr), ptrs->end());
+        if (ptrs->empty()) {
             removeFront(addr);
             return true;
         }
     } else {
-        std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-        it++;
-        if (it->getType() != MSHREntryType::Evict)
+        MSHRBlock::Index it = mshr_.node(reg->head).next;
+        if (it == MSHRBlock::NIL || mshr_.node(it).entry.getType() != MSHREntryType::Evict)
             d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr, addrPtr);
-        it->getPointers()->remove(addrPtr);
-        if (it->getPointers()->empty()) {
+        std::vector<Addr>* ptrs = mshr_.node(it).entry.getPointers();
+        ptrs->erase(std::remove(ptrs->begin(), ptrs->end(), addrPtr), ptrs->end());
+        if (ptrs->empty()) {
             removeEntry(addr, 1);
         }
     }
@@ -238,12 +209,13 @@ bool MSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
 }
 
 bool MSHR::pendingWriteback(Addr addr) {
-    return exists(addr) && getFrontType(addr) == MSHREntryType::Writeback;
+    MSHRRegister* reg = mshr_.find(addr);
+    return reg && reg->head != MSHRBlock::NIL && mshr_.node(reg->head).entry.getType() == MSHREntryType::Writeback;
 }
 
 bool MSHR::pendingWritebackIsDowngrade(Addr addr) {
     if (pendingWriteback(addr))
-        return mshr_.find(addr)->second.entries.front().getDowngrade();
+        return mshr_.node(mshr_.find(addr)->head).entry.getDowngrade();
     return false;
 }
 
@@ -260,40 +232,20 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
     // Success
     size_++;
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
-
-        mshr_.insert(std::make_pair(addr, reg));
-        if (is_debug_addr(addr)) {
-            stringstream reason;
-            reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=0";
-            printDebug(10, "InsEv", addr, reason.str());
-
-        }
-
-        return 0;
+    MSHRRegister* reg = mshr_.findOrInsert(addr);
+    if (pos == -1 || pos >= (int)reg->count) {
+        mshr_.pushBack(reg, MSHREntry(event, stallEvict, getCurrentSimCycle()));
+        pos = reg->count - 1;
     } else {
-        if (pos == -1 || pos > mshr_.find(addr)->second.entries.size()) {
-            mshr_.find(addr)->second.entries.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
-            if (is_debug_addr(addr)) {
-                stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries.size() - 1);
-                printDebug(10, "InsEv", addr, reason.str());
-            }
-            return (mshr_.find(addr)->second.entries.size() - 1);
-        } else {
-            std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
-            std::advance(it, pos);
-            mshr_.find(addr)->second.entries.insert(it, MSHREntry(event, stallEvict, getCurrentSimCycle()));
-            if (is_debug_addr(addr)) {
-                stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
-                printDebug(10, "InsEv", addr, reason.str());
-            }
-            return pos;
-        }
+        mshr_.insertAt(reg, pos, MSHREntry(event, stallEvict, getCurrentSimCycle()));
     }
+
+    if (is_debug_addr(addr)) {
+        stringstream reason;
+        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
+        printDebug(10, "InsEv", addr, reason.str());
+    }
+    return pos;
 }
 
 /*
@@ -304,9 +256,10 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
  *      -1 = conflict, not inserted
  */
 int MSHR::insertEventIfConflict(Addr addr, MemEventBase* event) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr)
         return 0;
-    
+
     if (size_ == maxSize_-1) { /* Assuming fwdEvent == false */
         if (is_debug_addr(addr)) {
             stringstream reason;
@@ -316,88 +269,71 @@ int MSHR::insertEventIfConflict(Addr addr, MemEventBase* event) {
         return -1;
     }
     size_++;
-    mshr_.find(addr)->second.entries.push_back(MSHREntry(event, false, getCurrentSimCycle()));
+    mshr_.pushBack(reg, MSHREntry(event, false, getCurrentSimCycle()));
     if (is_debug_addr(addr)) {
         stringstream reason;
-        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries.size() - 1);
+        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (reg->count - 1);
         printDebug(10, "InsEv", addr, reason.str());
     }
-    return (mshr_.find(addr)->second.entries.size() - 1);
+    return (reg->count - 1);
 }
 
 MemEventBase* MSHR::swapFrontEvent(Addr addr, MemEventBase* event) {
     if (is_debug_addr(addr))
         printDebug(10, "SwpEv", addr, "");
 
-    if (mshr_.find(addr)->second.entries.empty())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr || reg->head == MSHRBlock::NIL)
         return nullptr;
 
-    return  mshr_.find(addr)->second.entries.front().swapEvent(event, getCurrentSimCycle());
+    return mshr_.node(reg->head).entry.swapEvent(event, getCurrentSimCycle());
 }
 
 void MSHR::moveEntryToFront(Addr addr, unsigned int index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
-    if (reg->entries.size() <= index) {
+    if (reg->count <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
 
-    std::list<MSHREntry>::iterator entry = reg->entries.begin();
-    std::advance(entry, index);
-
-    MSHREntry tmpEntry = *entry;
+    MSHRBlock::Index entry = mshr_.at(reg, index);
 
     if (is_debug_addr(addr))
-        printDebug(10, "MvEnt", addr, entry->getString());
-    reg->entries.erase(entry);
-    reg->entries.push_front(tmpEntry);
+        printDebug(10, "MvEnt", addr, mshr_.node(entry).entry.getString());
+    mshr_.moveToFront(reg, entry);
 }
 
 bool MSHR::insertWriteback(Addr addr, bool downgrade) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::insertWriteback(0x%" PRIx64 ")\n", addr);
-
     if (is_debug_addr(addr)) {
         stringstream reason;
         reason << "Downgrade: " << (downgrade ? "T" : "F");
         printDebug(10, "InsWB", addr, reason.str());
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(downgrade, getCurrentSimCycle()));
-        mshr_.insert(std::make_pair(addr, reg));
-    } else {
-        mshr_.find(addr)->second.entries.push_front(MSHREntry(downgrade, getCurrentSimCycle()));
-    }
+    MSHRRegister* reg = mshr_.findOrInsert(addr);
+    mshr_.pushFront(reg, MSHREntry(downgrade, getCurrentSimCycle()));
 
     return true;
 }
 
 
 bool MSHR::insertEviction(Addr oldAddr, Addr newAddr) {
-//    if (is_debug_addr(oldAddr) || is_debug_addr(newAddr))
-//        d_->debug(_L10_, "    MSHR::insertEviction(0x%" PRIx64 ", 0x%" PRIx64 ")\n", oldAddr, newAddr);
-
     if (is_debug_addr(oldAddr) || is_debug_addr(newAddr)) {
         stringstream reason;
         reason << "to 0x" << std::hex << newAddr;
         printDebug(10, "InsPtr", oldAddr, reason.str());
     }
 
-    if (mshr_.find(oldAddr) == mshr_.end()) {  // No MSHR entry for oldAddr
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(newAddr, getCurrentSimCycle()));
-        mshr_.insert(std::make_pair(oldAddr, reg));
-    } else {
-        list<MSHREntry>* entries = &(mshr_.find(oldAddr)->second.entries);
-        if (!entries->empty() && entries->back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
-            entries->back().getPointers()->push_back(newAddr);
-        } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
-            entries->push_back(MSHREntry(newAddr, getCurrentSimCycle()));
-        }
+    MSHRRegister* reg = mshr_.findOrInsert(oldAddr);
+    if (reg->tail != MSHRBlock::NIL && mshr_.node(reg->tail).entry.getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
+        mshr_.node(reg->tail).ptrs.push_back(newAddr);
+    } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
+        MSHRBlock::Index entry = mshr_.pushBack(reg, MSHREntry(newAddr, getCurrentSimCycle()));
+        MSHRBlock::Node& node = mshr_.node(entry);
+        node.ptrs.push_back(newAddr);
+        node.entry.setPointers(&node.ptrs);
     }
     return true;
 }
@@ -406,53 +342,34 @@ void MSHR::addPendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "IncRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::addPendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    mshr_.find(addr)->second.addPendingRetry();
+    getRegister(addr, "addPendingRetry")->pendingRetries++;
 }
 
 void MSHR::removePendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "DecRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removePendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    mshr_.find(addr)->second.removePendingRetry();
+    getRegister(addr, "removePendingRetry")->pendingRetries--;
 }
 
 uint32_t MSHR::getPendingRetries(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
-        return 0;
-
-    return mshr_.find(addr)->second.getPendingRetries();
+    MSHRRegister* reg = mshr_.find(addr);
+    return reg ? reg->pendingRetries : 0;
 }
 
 
 void MSHR::setInProgress(Addr addr, bool value) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setInProgress(0x%" PRIx64 ")\n", addr);
     if (is_debug_addr(addr))
         printDebug(20, "InProg", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
-    }
-    mshr_.find(addr)->second.entries.front().setInProgress(value);
+    mshr_.node(getFrontIndex(addr, "setInProgress")).entry.setInProgress(value);
 }
 
 bool MSHR::getInProgress(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr || reg->head == MSHRBlock::NIL)
         return false;
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        return false;
-    }
-    return mshr_.find(addr)->second.entries.front().getInProgress();
+    return mshr_.node(reg->head).entry.getInProgress();
 }
 
 void MSHR::setStalledForEvict(Addr addr, bool set) {
@@ -463,58 +380,37 @@ void MSHR::setStalledForEvict(Addr addr, bool set) {
             printDebug(20, "Unstall", addr, "");
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
-    }
-    mshr_.find(addr)->second.entries.front().setStalledForEvict(set);
+    mshr_.node(getFrontIndex(addr, "setStalledForEvict")).entry.setStalledForEvict(set);
 }
 
 bool MSHR::getStalledForEvict(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
-        return false;
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr || reg->head == MSHRBlock::NIL)
         return false;
-    }
-    return mshr_.find(addr)->second.entries.front().getStalledForEvict();
+    return mshr_.node(reg->head).entry.getStalledForEvict();
 }
 
 void MSHR::setProfiled(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
-    }
-    mshr_.find(addr)->second.entries.front().setProfiled();
+    mshr_.node(getFrontIndex(addr, "setProfiled")).entry.setProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getProfiled(0x%" PRIx64 "\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
-    }
-    return mshr_.find(addr)->second.entries.front().getProfiled();
+    return mshr_.node(getFrontIndex(addr, "getProfiled")).entry.getProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr, SST::Event::id_type id) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
-    if (mshr_.find(addr)->second.entries.empty())
+    if (reg->head == MSHRBlock::NIL)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
-        if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
-            return jt->getProfiled();
+    for (MSHRBlock::Index jt = reg->head; jt != MSHRBlock::NIL; jt = mshr_.node(jt).next) {
+        MSHREntry& entry = mshr_.node(jt).entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getID() == id) {
+            return entry.getProfiled();
         }
     }
     return true; // default so we don't attempt to profile what isn't there
@@ -524,147 +420,105 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = mshr_.find(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->head == MSHRBlock::NIL) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
-        if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
-            jt->setProfiled();
+    for (MSHRBlock::Index jt = reg->head; jt != MSHRBlock::NIL; jt = mshr_.node(jt).next) {
+        MSHREntry& entry = mshr_.node(jt).entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getID() == id) {
+            entry.setProfiled();
             return;
         }
     }
 }
 
 MSHREntry* MSHR::getOldestEntry() {
-    bool first = false;
-    MSHREntry* entry = nullptr;
-    uint64_t time;
-
-    for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++) {
-        for (list<MSHREntry>::iterator jt = it->second.entries.begin(); jt != it->second.entries.end(); jt++) {
-            if (jt->getType() == MSHREntryType::Event) {
-                if (!first) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                } else if (jt->getStartTime() < time) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                }
-            }
+    MSHREntry* oldest = nullptr;
+
+    mshr_.forEach([&](MSHRRegister& reg) {
+        for (MSHRBlock::Index jt = reg.head; jt != MSHRBlock::NIL; jt = mshr_.node(jt).next) {
+            MSHREntry& entry = mshr_.node(jt).entry;
+            if (entry.getType() == MSHREntryType::Event && (oldest == nullptr || entry.getStartTime() < oldest->getStartTime()))
+                oldest = &entry;
         }
-    }
-    return entry;
+    });
+    return oldest;
 }
 
 void MSHR::incrementAcksNeeded(Addr addr) {
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::incrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        mshr_.insert(std::make_pair(addr, reg));
-    }
-    mshr_.find(addr)->second.acksNeeded++;
+    MSHRRegister* reg = mshr_.findOrInsert(addr);
+    reg->acksNeeded++;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "IncAck", addr, reason.str());
     }
 }
 
 /* Decrement acks needed and return if we're done waiting (acksNeeded == 0) */
 bool MSHR::decrementAcksNeeded(Addr addr) {
-   // if (is_debug_addr(addr))
-   //     d_->debug(_L10_, "    MSHR::decrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    if (mshr_.find(addr)->second.acksNeeded == 0) {
+    MSHRRegister* reg = getRegister(addr, "decrementAcksNeeded");
+    if (reg->acksNeeded == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). AcksNeeded is already 0.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.acksNeeded--;
+    reg->acksNeeded--;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "DecAck", addr, reason.str());
     }
 
-    return (mshr_.find(addr)->second.acksNeeded == 0);
+    return (reg->acksNeeded == 0);
 }
 
 uint32_t MSHR::getAcksNeeded(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        return 0;
-    }
-    return (mshr_.find(addr)->second.acksNeeded);
+    MSHRRegister* reg = mshr_.find(addr);
+    return reg ? reg->acksNeeded : 0;
 }
 
 void MSHR::setData(Addr addr, vector<uint8_t>& data, bool dirty) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
+    MSHRRegister* reg = getRegister(addr, "setData");
 
     if (is_debug_addr(addr))
         printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
 
-    mshr_.find(addr)->second.dataBuffer = data;
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataBuffer.assign(data.begin(), data.end()); // Reuses the register's buffer capacity
+    reg->dataDirty = dirty;
 }
 
 void MSHR::clearData(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::clearData(0x%" PRIx64 ")\n", addr);
     if (is_debug_addr(addr))
         printDebug(10, "ClrData", addr, "");
 
-    mshr_.find(addr)->second.dataBuffer.clear();
-    mshr_.find(addr)->second.dataDirty = false;
+    MSHRRegister* reg = mshr_.find(addr);
+    reg->dataBuffer.clear();
+    reg->dataDirty = false;
 }
 
 vector<uint8_t>& MSHR::getData(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    return mshr_.find(addr)->second.dataBuffer;
+    return getRegister(addr, "getData")->dataBuffer;
 }
 
 bool MSHR::hasData(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
-        return false;
-    return !(mshr_.find(addr)->second.dataBuffer.empty());
+    MSHRRegister* reg = mshr_.find(addr);
+    return reg && !(reg->dataBuffer.empty());
 }
 
 bool MSHR::getDataDirty(Addr addr) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L20_, "    MSHR::getDataDirty(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    return mshr_.find(addr)->second.dataDirty;
+    return getRegister(addr, "getDataDirty")->dataDirty;
 }
 
 void MSHR::setDataDirty(Addr addr, bool dirty) {
-//    if (is_debug_addr(addr))
-//        d_->debug(_L10_, "    MSHR::setDataDirty(0x%" PRIx64 ")\n", addr);
-
     if (is_debug_addr(addr))
         printDebug(20, "SetDirt", addr, (dirty ? "Dirty" : "Clean"));
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
-    }
-    mshr_.find(addr)->second.dataDirty = dirty;
-
+    getRegister(addr, "setDataDirty")->dataDirty = dirty;
 }
 
 // Easier to adjust format if we do this in one place!
@@ -689,10 +543,12 @@ void MSHR::printDebug(uint32_t lev, std::string action, Addr addr, std::string r
 // Print status. Called by cache controller on EmergencyShutdown and printStatus()
 void MSHR::printStatus(Output &out) {
     out.output("    MSHR Status for %s. Size: %u. Prefetches: %u\b", ownerName_.c_str(), size_, prefetchCount_);
-    for (std::map<Addr,MSHRRegister>::iterator it = mshr_.begin(); it != mshr_.end(); it++) {   // Iterate over addresses
+    std::map<Addr, MSHRRegister*> sorted;   // Print in address order
+    mshr_.forEach([&](MSHRRegister& reg) { sorted[reg.addr] = &reg; });
+    for (std::map<Addr,MSHRRegister*>::iterator it = sorted.begin(); it != sorted.end(); it++) {   // Iterate over addresses
         out.output("      Entry: Addr = 0x%" PRIx64 "\n", (it->first));
-        for (std::list<MSHREntry>::iterator it2 = it->second.entries.begin(); it2 != it->second.entries.end(); it2++) { // Iterate over entries for each address
-            out.output("        %s\n", it2->getString().c_str());
+        for (MSHRBlock::Index it2 = it->second->head; it2 != MSHRBlock::NIL; it2 = mshr_.node(it2).next) { // Iterate over entries for each address
+            out.output("        %s\n", mshr_.node(it2).entry.getString().c_str());
         }
     }
     out.output("    End MSHR Status for %s\n", ownerName_.c_str());
@@ -28,6 +28,7 @@
 
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/mshrTable.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -70,12 +71,11 @@ class MSHREntry {
             downgrade = downgr;
         }
 
-        // Evict entry
+        // Evict entry - the MSHR attaches pointer storage when the entry is inserted
     MSHREntry(Addr addr, SimTime_t curr_time) {
             type = MSHREntryType::Evict;
             event = nullptr;
-            evictPtrs = new std::list<Addr>;
-            evictPtrs->push_back(addr);
+            evictPtrs = nullptr;
             time = curr_time;
             inProgress = false;
             needEvict = false;
@@ -95,6 +95,8 @@ class MSHREntry {
             downgrade = entry.downgrade;
         }
 
+        MSHREntry& operator=(const MSHREntry& entry) = default;
+
         MSHREntryType getType() { return type; }
 
         bool getInProgress() { return inProgress; }
@@ -108,10 +110,14 @@ class MSHREntry {
 
         SimTime_t getStartTime() { return time; }
 
-        std::list<Addr>* getPointers() {
+        std::vector<Addr>* getPointers() {
             return evictPtrs;
         }
 
+        void setPointers(std::vector<Addr>* ptrs) {
+            evictPtrs = ptrs;
+        }
+
         MemEventBase * getEvent() {
             return event;
         }
@@ -142,7 +148,7 @@ class MSHREntry {
                 str << " Type: Event" << " (" << event->getBriefString() << ")";
             } else if (type == MSHREntryType::Evict) {
                 str << " Type: Evict (";
-                for (std::list<Addr>::iterator it = evictPtrs->begin(); it != evictPtrs->end(); it++) {
+                for (std::vector<Addr>::iterator it = evictPtrs->begin(); it != evictPtrs->end(); it++) {
                     str << " 0x" << std::hex << *it;
                 }
                 str << ")";
@@ -154,7 +160,7 @@ class MSHREntry {
 
     private:
         MSHREntryType type;
-        std::list<Addr> *evictPtrs; // Specific to Evict type
+        std::vector<Addr> *evictPtrs; // Specific to Evict type, owned by the MSHR
         MemEventBase* event;        // Specific to Event type
         SimTime_t time;
         bool needEvict;
@@ -163,20 +169,8 @@ class MSHREntry {
         bool downgrade;             // Specific to Writeback type
 };
 
-struct MSHRRegister {
-    MSHRRegister() : acksNeeded(0), dataDirty(false), pendingRetries(0) { }
-    list<MSHREntry> entries;
-    uint32_t acksNeeded;
-    vector<uint8_t> dataBuffer;
-    bool dataDirty;
-    uint32_t pendingRetries;
-
-    uint32_t getPendingRetries() { return pendingRetries; }
-    void addPendingRetry() { pendingRetries++; }
-    void removePendingRetry() { pendingRetries--; }
-};
-
-typedef map<Addr, MSHRRegister> MSHRBlock;
+typedef MSHRTable<MSHREntry, Addr> MSHRBlock;
+typedef MSHRBlock::Register MSHRRegister;
 
 /**
  *  Implements an MSHR with entries of type mshrEntry
@@ -199,7 +193,7 @@ public:
     MSHREntryType getFrontType(Addr addr);
 
     MemEventBase* getFrontEvent(Addr addr);
-    std::list<Addr>* getEvictPointers(Addr addr);
+    std::vector<Addr>* getEvictPointers(Addr addr);
     bool removeEvictPointer(Addr addr, Addr ptrAddr);
 
     // Special move accessor
@@ -258,6 +252,9 @@ private:
 
     void printDebug(uint32_t level, std::string action, Addr addr, std::string reason);
 
+    MSHRRegister* getRegister(Addr addr, const char* caller);
+    MSHRBlock::Index getFrontIndex(Addr addr, const char* caller);
+
     MSHRBlock mshr_;
     Output* d_;
     Output* d2_;
@@ -0,0 +1,304 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MSHRTABLE_H_
+#define _MSHRTABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Storage for the MSHR
+ *
+ * Registers (one per address with pending state) live in a pool and are
+ * located through an open-addressed, linearly probed hash table keyed by
+ * address. Entries queued at a register are pooled nodes linked into an
+ * intrusive doubly-linked list. Pools only grow; released registers and
+ * nodes go on a free list and are reused, so once the MSHR has warmed up
+ * a miss does not allocate, including for data buffers and evict pointer
+ * lists which keep their capacity across reuse.
+ *
+ * Pool storage is a deque so references to registers and nodes stay valid
+ * while they are in use. Hash table slots only hold the address and pool index,
+ * growing the table rehashes slots but never moves registers.
+ *
+ * This header has no SST dependencies so it can be exercised standalone
+ * (see tools/mshrbench).
+ */
+template<typename EntryT, typename AddrT = uint64_t>
+class MSHRTable {
+public:
+    typedef uint32_t Index;
+    static const Index NIL = UINT32_MAX;
+
+    struct Node {
+        Node(const EntryT& e) : entry(e), prev(NIL), next(NIL) { }
+        EntryT entry;
+        std::vector<AddrT> ptrs;    // Evict pointers, only used by Evict entries
+        Index prev;
+        Index next;
+    };
+
+    struct Register {
+        AddrT addr;
+        Index head;
+        Index tail;
+        uint32_t count;
+        uint32_t acksNeeded;
+        std::vector<uint8_t> dataBuffer;
+        bool dataDirty;
+        uint32_t pendingRetries;
+
+        void reset(AddrT a) {
+            addr = a;
+            head = tail = NIL;
+            count = 0;
+            acksNeeded = 0;
+            dataBuffer.clear();
+            dataDirty = false;
+            pendingRetries = 0;
+        }
+    };
+
+    /* expectedRegisters sizes the initial pools and table; both grow on demand */
+    MSHRTable(size_t expectedRegisters) : size_(0) {
+        if (expectedRegisters < 16)
+            expectedRegisters = 16;
+        size_t capacity = 1;
+        while (capacity < 2 * expectedRegisters)
+            capacity <<= 1;
+        slots_.assign(capacity, Slot());
+        mask_ = capacity - 1;
+
+        regs_.resize(expectedRegisters);
+        freeRegs_.reserve(expectedRegisters);
+        for (size_t i = expectedRegisters; i > 0; i--)
+            freeRegs_.push_back(i - 1);
+    }
+
+    size_t size() const { return size_; }
+
+    /* Lookup, nullptr if the address has no register */
+    Register* find(AddrT addr) {
+        size_t slot = hash(addr);
+        while (slots_[slot].reg != NIL) {
+            if (slots_[slot].addr == addr)
+                return &regs_[slots_[slot].reg];
+            slot = (slot + 1) & mask_;
+        }
+        return nullptr;
+    }
+
+    Register* findOrInsert(AddrT addr) {
+        size_t slot = hash(addr);
+        while (slots_[slot].reg != NIL) {
+            if (slots_[slot].addr == addr)
+                return &regs_[slots_[slot].reg];
+            slot = (slot + 1) & mask_;
+        }
+
+        Index reg;
+        if (freeRegs_.empty()) {
+            reg = regs_.size();
+            regs_.emplace_back();
+        } else {
+            reg = freeRegs_.back();
+            freeRegs_.pop_back();
+        }
+        regs_[reg].reset(addr);
+        slots_[slot].addr = addr;
+        slots_[slot].reg = reg;
+        size_++;
+
+        if (2 * size_ > slots_.size())
+            grow();
+        return &regs_[reg];
+    }
+
+    /* Release the register for addr and any nodes still linked to it */
+    void erase(AddrT addr) {
+        size_t slot = hash(addr);
+        while (slots_[slot].reg != NIL && slots_[slot].addr != addr)
+            slot = (slot + 1) & mask_;
+        if (slots_[slot].reg == NIL)
+            return;
+
+        Register& r = regs_[slots_[slot].reg];
+        while (r.head != NIL)
+            unlink(&r, r.head);
+        freeRegs_.push_back(slots_[slot].reg);
+        size_--;
+
+        /* Backward shift deletion keeps probe sequences intact without tombstones */
+        size_t hole = slot;
+        size_t next = (hole + 1) & mask_;
+        while (slots_[next].reg != NIL) {
+            size_t home = hash(slots_[next].addr);
+            if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+                slots_[hole] = slots_[next];
+                hole = next;
+            }
+            next = (next + 1) & mask_;
+        }
+        slots_[hole] = Slot();
+    }
+
+    Node& node(Index i) { return nodes_[i]; }
+
+    /* Node at position 'index' in the register's list, NIL if out of range */
+    Index at(Register* r, size_t index) {
+        if (index >= r->count)
+            return NIL;
+        Index i = r->head;
+        while (index-- > 0)
+            i = nodes_[i].next;
+        return i;
+    }
+
+    Index pushBack(Register* r, const EntryT& entry) {
+        Index i = allocNode(entry);
+        linkBefore(r, i, NIL);
+        return i;
+    }
+
+    Index pushFront(Register* r, const EntryT& entry) {
+        Index i = allocNode(entry);
+        linkBefore(r, i, r->head);
+        return i;
+    }
+
+    /* Insert so that the new node ends up at position 'index' (or at the back if index >= count) */
+    Index insertAt(Register* r, size_t index, const EntryT& entry) {
+        Index i = allocNode(entry);
+        linkBefore(r, i, at(r, index));
+        return i;
+    }
+
+    /* Unlink a node from its register and return it to the pool */
+    void unlink(Register* r, Index i) {
+        detach(r, i);
+        freeNodes_.push_back(i);
+    }
+
+    void moveToFront(Register* r, Index i) {
+        if (r->head == i)
+            return;
+        detach(r, i);
+        linkBefore(r, i, r->head);
+    }
+
+    /* Call f(Register&) for each register in use, in table order */
+    template<typename F>
+    void forEach(F f) {
+        for (size_t slot = 0; slot < slots_.size(); slot++) {
+            if (slots_[slot].reg != NIL)
+                f(regs_[slots_[slot].reg]);
+        }
+    }
+
+private:
+    struct Slot {
+        Slot() : addr(0), reg(NIL) { }
+        AddrT addr;
+        Index reg;
+    };
+
+    size_t hash(AddrT addr) const {
+        uint64_t h = (uint64_t)addr * 0x9E3779B97F4A7C15ULL;
+        return (size_t)(h ^ (h >> 32)) & mask_;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.assign(old.size() * 2, Slot());
+        mask_ = slots_.size() - 1;
+        for (size_t s = 0; s < old.size(); s++) {
+            if (old[s].reg == NIL)
+                continue;
+            size_t slot = hash(old[s].addr);
+            while (slots_[slot].reg != NIL)
+                slot = (slot + 1) & mask_;
+            slots_[slot] = old[s];
+        }
+    }
+
+    Index allocNode(const EntryT& entry) {
+        Index i;
+        if (freeNodes_.empty()) {
+            i = nodes_.size();
+            nodes_.emplace_back(entry);
+        } else {
+            i = freeNodes_.back();
+            freeNodes_.pop_back();
+            nodes_[i].entry = entry;
+            nodes_[i].ptrs.clear();
+        }
+        return i;
+    }
+
+    /* Link node i before node 'pos' (NIL = at the tail) */
+    void linkBefore(Register* r, Index i, Index pos) {
+        Node& n = nodes_[i];
+        n.next = pos;
+        if (pos == NIL) {
+            n.prev = r->tail;
+            if (r->tail != NIL)
+                nodes_[r->tail].next = i;
+            else
+                r->head = i;
+            r->tail = i;
+        } else {
+            n.prev = nodes_[pos].prev;
+            if (n.prev != NIL)
+                nodes_[n.prev].next = i;
+            else
+                r->head = i;
+            nodes_[pos].prev = i;
+        }
+        r->count++;
+    }
+
+    void detach(Register* r, Index i) {
+        Node& n = nodes_[i];
+        if (n.prev != NIL)
+            nodes_[n.prev].next = n.next;
+        else
+            r->head = n.next;
+        if (n.next != NIL)
+            nodes_[n.next].prev = n.prev;
+        else
+            r->tail = n.prev;
+        n.prev = n.next = NIL;
+        r->count--;
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+    size_t size_;
+
+    std::deque<Register> regs_;
+    std::vector<Index> freeRegs_;
+    std::deque<Node> nodes_;
+    std::vector<Index> freeNodes_;
+};
+
+}}
+
+#endif
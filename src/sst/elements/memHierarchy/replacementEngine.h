@@ -0,0 +1,398 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_REPLACEMENT_ENGINE_H
+#define MEMHIERARCHY_REPLACEMENT_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Replacement engines
+ *
+ * These hold the replacement state for an array of lines in flat, per-set
+ * contiguous arrays and implement the policy with non-virtual, inlinable
+ * calls. The ReplacementPolicy subcomponents in replacementManager.h wrap
+ * them; tools (see tools/replbench) can drive them directly.
+ *
+ * Lines are numbered like CacheArray numbers them: line 'id' is way
+ * (id % ways) of set (id / ways).
+ *
+ * Engine API:
+ *  - update(id)        line was accessed. On a fill, replaced(id) is always called first.
+ *  - replaced(id)      line was replaced or deallocated
+ *  - findVictim(setBegin, invalid)
+ *                      return the id of the line to replace in the set starting at
+ *                      setBegin. invalid(way) reports whether a way holds no valid
+ *                      data; invalid ways are always chosen first, lowest way first.
+ *
+ * Engines do no parameter checking, the subcomponents do that.
+ */
+
+/* Return the first invalid way in the set, or -1 */
+template<typename IsInvalid>
+inline int64_t findInvalidWay(uint64_t ways, IsInvalid& invalid) {
+    for (uint64_t i = 0; i < ways; i++) {
+        if (invalid(i))
+            return i;
+    }
+    return -1;
+}
+
+/* ------------------------------------------------------------------------------------------
+ *  LRU - global access timestamp per line, evict the oldest
+ * ------------------------------------------------------------------------------------------*/
+class LRUEngine {
+public:
+    LRUEngine(uint64_t lines, uint64_t associativity) : ways(associativity), timestamp(1), array(lines, 0) { }
+
+    void update(uint64_t id) { array[id] = timestamp++; }
+    void replaced(uint64_t id) { array[id] = 0; }
+
+    template<typename IsInvalid>
+    uint64_t findVictim(uint64_t setBegin, IsInvalid invalid) {
+        int64_t way = findInvalidWay(ways, invalid);
+        if (way >= 0)
+            return setBegin + way;
+
+        const uint64_t* ts = &array[setBegin];
+        uint64_t best = 0;
+        for (uint64_t i = 1; i < ways; i++) {
+            if (ts[i] < ts[best])
+                best = i;
+        }
+        return setBegin + best;
+    }
+
+private:
+    uint64_t ways;
+    uint64_t timestamp;
+    std::vector<uint64_t> array;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  MRU - global access timestamp per line, evict the youngest
+ * ------------------------------------------------------------------------------------------*/
+class MRUEngine {
+public:
+    MRUEngine(uint64_t lines, uint64_t associativity) : ways(associativity), timestamp(1), array(lines, 0) { }
+
+    void update(uint64_t id) { array[id] = timestamp++; }
+    void replaced(uint64_t id) { array[id] = 0; }
+
+    template<typename IsInvalid>
+    uint64_t findVictim(uint64_t setBegin, IsInvalid invalid) {
+        int64_t way = findInvalidWay(ways, invalid);
+        if (way >= 0)
+            return setBegin + way;
+
+        const uint64_t* ts = &array[setBegin];
+        uint64_t best = 0;
+        for (uint64_t i = 1; i < ways; i++) {
+            if (ts[i] > ts[best])
+                best = i;
+        }
+        return setBegin + best;
+    }
+
+private:
+    uint64_t ways;
+    uint64_t timestamp;
+    std::vector<uint64_t> array;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  LFU - access count and frequency-weighted timestamp per line
+ * ------------------------------------------------------------------------------------------*/
+class LFUEngine {
+public:
+    LFUEngine(uint64_t lines, uint64_t associativity) : ways(associativity), timestamp(1), ts(lines, 0), acc(lines, 0) { }
+
+    // timestamp = (total accesses * timestamp + timestamp) / (accesses + 1)
+    // timestamp increments by 1000 every time to make sure there's sufficient space between timestamps
+    void update(uint64_t id) {
+        ts[id] = (acc[id] * ts[id] + timestamp) / (acc[id] + 1);
+        acc[id]++;
+        timestamp += 1000;
+    }
+
+    void replaced(uint64_t id) { acc[id] = 0; }
+
+    template<typename IsInvalid>
+    uint64_t findVictim(uint64_t setBegin, IsInvalid invalid) {
+        int64_t way = findInvalidWay(ways, invalid);
+        if (way >= 0)
+            return setBegin + way;
+
+        uint64_t best = setBegin;
+        for (uint64_t i = setBegin + 1; i < setBegin + ways; i++) {
+            if (lessThan(i, best))
+                best = i;
+        }
+        return best;
+    }
+
+private:
+    /* Lower inverse frequency is better; lines never accessed are always worse */
+    bool lessThan(uint64_t a, uint64_t b) const {
+        if (acc[a] == 0) return true;
+        if (acc[b] == 0) return false;
+        return (timestamp - ts[a]) / acc[a] > (timestamp - ts[b]) / acc[b];
+    }
+
+    uint64_t ways;
+    uint64_t timestamp;
+    std::vector<uint64_t> ts;
+    std::vector<uint64_t> acc;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Random - RNG must provide generateNextUInt64()
+ * ------------------------------------------------------------------------------------------*/
+template<typename RNG>
+class RandomEngine {
+public:
+    RandomEngine(uint64_t lines, uint64_t associativity, RNG* rng) : ways(associativity), gen(rng) { }
+
+    void update(uint64_t id) { }
+    void replaced(uint64_t id) { }
+
+    template<typename IsInvalid>
+    uint64_t findVictim(uint64_t setBegin, IsInvalid invalid) {
+        int64_t way = findInvalidWay(ways, invalid);
+        if (way >= 0)
+            return setBegin + way;
+        return setBegin + (gen->generateNextUInt64() % ways);
+    }
+
+private:
+    uint64_t ways;
+    RNG* gen;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  NMRU - random among all but the most recently used way of the set
+ * ------------------------------------------------------------------------------------------*/
+template<typename RNG>
+class NMRUEngine {
+public:
+    NMRUEngine(uint64_t lines, uint64_t associativity, RNG* rng) : ways(associativity), mru(lines / associativity, 0), gen(rng) { }
+
+    void update(uint64_t id) { mru[id / ways] = id % ways; }
+    void replaced(uint64_t id) { }
+
+    template<typename IsInvalid>
+    uint64_t findVictim(uint64_t setBegin, IsInvalid invalid) {
+        int64_t way = findInvalidWay(ways, invalid);
+        if (way >= 0)
+            return setBegin + way;
+        if (ways == 1)
+            return setBegin;
+
+        uint64_t index = gen->generateNextUInt64() % (ways - 1);
+        if (index < mru[setBegin / ways])
+            return setBegin + index;
+        return setBegin + index + 1;
+    }
+
+private:
+    uint64_t ways;
+    std::vector<uint32_t> mru;
+    RNG* gen;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Tree pseudo-LRU
+ *  - One bit per internal node of a binary tree over the ways, packed in a
+ *    64-bit word per set, so associativity is limited to 64.
+ *  - Non power-of-two associativity uses the next larger tree and never
+ *    descends into subtrees that hold no ways.
+ * ------------------------------------------------------------------------------------------*/
+class TreePLRUEngine {
+public:
+    static const uint64_t maxWays = 64;
+
+    TreePLRUEngine(uint64_t lines, uint64_t associativity) : ways(associativity), bits(lines / associativity, 0) {
+        leaves = 1;
+        while (leaves < ways)
+            leaves <<= 1;
+    }
+
+    /* Point every node on the path to this way away from it */
+    void update(uint64_t id) {
+        uint64_t& tree = bits[id / ways];
+        uint64_t node = leaves + (id % ways);
+        while (node > 1) {
+            uint64_t parent = node >> 1;
+            if (node & 1)
+                tree &= ~(1ULL << parent);  // Accessed right, victim is left
+            else
+                tree |= (1ULL << parent);   // Accessed left, victim is right
+            node = parent;
+        }
+    }
+
+    void replaced(uint64_t id) { }
+
+    template<typename IsInvalid>
+    uint64_t findVictim(uint64_t setBegin, IsInvalid invalid) {
+        int64_t way = findInvalidWay(ways, invalid);
+        if (way >= 0)
+            return setBegin + way;
+
+        uint64_t tree = bits[setBegin / ways];
+        uint64_t node = 1;
+        while (node < leaves) {
+            uint64_t child = (node << 1) | ((tree >> node) & 1);
+            if (firstWay(child) >= ways)
+                child ^= 1;
+            node = child;
+        }
+        return setBegin + (node - leaves);
+    }
+
+private:
+    /* Lowest way under a tree node */
+    uint64_t firstWay(uint64_t node) const {
+        while (node < leaves)
+            node <<= 1;
+        return node - leaves;
+    }
+
+    uint64_t ways;
+    uint64_t leaves;
+    std::vector<uint64_t> bits;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  RRIP - re-reference interval prediction (Jaleel et al., ISCA 2010)
+ *  - An M-bit re-reference prediction value (RRPV) per line, one byte each
+ *  - Hits promote to RRPV 0 (hit priority)
+ *  - The victim is the first line with the maximum RRPV; if there is none
+ *    the set ages until there is
+ *  - Insertion depends on the mode:
+ *      SRRIP: insert at max-1
+ *      BRRIP: insert at max, except every 'throttle'-th fill which is inserted at max-1
+ *      DRRIP: set dueling between SRRIP and BRRIP leader sets with a saturating
+ *             policy selector; follower sets use whichever leader misses less
+ * ------------------------------------------------------------------------------------------*/
+enum class RRIPMode { SRRIP, BRRIP, DRRIP };
+
+class RRIPEngine {
+public:
+    RRIPEngine(uint64_t lines, uint64_t associativity, RRIPMode m, uint32_t rrpvBits = 2, uint32_t throttle = 32, uint32_t pselBits = 10) :
+        mode(m), ways(associativity), sets(lines / associativity), rrpv(lines, 0), fills(0) {
+        maxRRPV = (1 << rrpvBits) - 1;
+        brripThrottle = throttle ? throttle : 1;
+        pselMax = (1 << pselBits) - 1;
+        psel = pselMax / 2;
+
+        // Leader sets: one SRRIP and one BRRIP leader in each of (up to) 32 regions
+        leaderRegion = sets / 32;
+        if (leaderRegion < 2)
+            leaderRegion = 2;
+        for (uint64_t i = 0; i < lines; i++)
+            rrpv[i] = maxRRPV;
+    }
+
+    void update(uint64_t id) {
+        if (rrpv[id] != pending) {
+            rrpv[id] = 0;   // Hit
+            return;
+        }
+
+        uint64_t set = id / ways;
+        bool bimodal;
+        switch (mode) {
+            case RRIPMode::SRRIP:
+                bimodal = false;
+                break;
+            case RRIPMode::BRRIP:
+                bimodal = true;
+                break;
+            default:
+                if (set % leaderRegion == 0) {
+                    bimodal = false;
+                    if (psel < pselMax) psel++;     // Miss in a SRRIP leader
+                } else if (set % leaderRegion == 1) {
+                    bimodal = true;
+                    if (psel > 0) psel--;           // Miss in a BRRIP leader
+                } else {
+                    bimodal = psel > pselMax / 2;
+                }
+                break;
+        }
+
+        if (bimodal && (++fills % brripThrottle) != 0)
+            rrpv[id] = maxRRPV;
+        else
+            rrpv[id] = maxRRPV - 1;
+    }
+
+    /* The next update() to this line is a fill */
+    void replaced(uint64_t id) { rrpv[id] = pending; }
+
+    template<typename IsInvalid>
+    uint64_t findVictim(uint64_t setBegin, IsInvalid invalid) {
+        int64_t way = findInvalidWay(ways, invalid);
+        if (way >= 0)
+            return setBegin + way;
+
+        uint8_t* set = &rrpv[setBegin];
+        uint8_t oldest = 0;
+        for (uint64_t i = 0; i < ways; i++) {
+            if (set[i] >= maxRRPV)
+                return setBegin + i;
+            if (set[i] > oldest)
+                oldest = set[i];
+        }
+
+        // Age the set so the oldest lines reach max and take the first of them
+        uint8_t age = maxRRPV - oldest;
+        uint64_t victim = ways;
+        for (uint64_t i = 0; i < ways; i++) {
+            set[i] += age;
+            if (victim == ways && set[i] == maxRRPV)
+                victim = i;
+        }
+        return setBegin + victim;
+    }
+
+    uint32_t getPSEL() const { return psel; }
+
+private:
+    static const uint8_t pending = 0xFF;
+
+    RRIPMode mode;
+    uint64_t ways;
+    uint64_t sets;
+    std::vector<uint8_t> rrpv;
+    uint8_t maxRRPV;
+
+    uint32_t brripThrottle;
+    uint64_t fills;
+
+    uint64_t leaderRegion;
+    uint32_t psel;
+    uint32_t pselMax;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_REPLACEMENT_ENGINE_H */
@@ -20,6 +20,7 @@
 #include "sst/core/rng/marsaglia.h"
 
 #include "memEvent.h"
+#include "replacementEngine.h"
 
 using namespace std;
 
@@ -85,16 +86,13 @@ class ReplacementPolicy : public SubComponent{
 /* ------------------------------------------------------------------------------------------
  *  LRU
  * ------------------------------------------------------------------------------------------*/
-class LRU : public ReplacementPolicy {
+class LRU final : public ReplacementPolicy {
 public:
     SST_ELI_REGISTER_SUBCOMPONENT(LRU, "memHierarchy", "replacement.lru", SST_ELI_ELEMENT_VERSION(1,0,0),
             "least-recently-used replacement policy", SST::MemHierarchy::ReplacementPolicy);
 
 
-    LRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), timestamp(1), bestCandidate(0) {
-        ways = associativity;
-        array.resize(lines, 0);
-    }
+    LRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), engine(lines, associativity), bestCandidate(0) { }
 
     virtual ~LRU() {}
 
@@ -102,50 +100,29 @@ public:
     bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
 
     /* Record recently used line */
-    void update(uint64_t id, ReplacementInfo * rInfo) { array[id] = timestamp++; }
+    void update(uint64_t id, ReplacementInfo * rInfo) { engine.update(id); }
 
     /* Record replaced line */
-    void replaced(uint64_t id) { array[id] = 0; }
+    void replaced(uint64_t id) { engine.replaced(id); }
 
     /** Lines are selected for replacement according to the following criteria (and in this order):
      * 1. If invalid (alwasy replace these)
-     * 2. If owned, try to keep
-     * 3. If shared, try to keep
-     * 4. If timestamp is the oldest (smallest), then evict
+     * 2. If timestamp is the oldest (smallest), then evict
      */
     uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
-        bestCandidate = rInfo[0]->getIndex();
-        uint64_t bestTS = array[rInfo[0]->getIndex()];
-        if (rInfo[0]->getState() == I) {
-            return bestCandidate;
-        }
-        for (int i = 1; i < rInfo.size(); i++) {
-            if (rInfo[i]->getState() == I) {
-                bestCandidate = rInfo[i]->getIndex();
-                return bestCandidate;
-            }
-            uint64_t candTS = array[rInfo[i]->getIndex()];
-            if (candTS < bestTS) {
-                bestTS = candTS;
-                bestCandidate = rInfo[i]->getIndex();
-            }
-        }
+        bestCandidate = engine.findVictim(rInfo[0]->getIndex(), [&rInfo](uint64_t i) { return rInfo[i]->getState() == I; });
         return bestCandidate;
     }
 
     uint64_t getBestCandidate() { return bestCandidate; }
 
 private:
-    uint64_t timestamp;
+    LRUEngine engine;
     uint64_t bestCandidate;
-    uint64_t ways;
-
-    std::vector<uint64_t> array;
-
 };
 
 
-class LRUOpt : public ReplacementPolicy {
+class LRUOpt final : public ReplacementPolicy {
 public:
     SST_ELI_REGISTER_SUBCOMPONENT(LRUOpt, "memHierarchy", "replacement.lru-opt", SST_ELI_ELEMENT_VERSION(1,0,0),
             "least-recently-used replacement policy with consideration for coherence state", SST::MemHierarchy::ReplacementPolicy);
@@ -240,81 +217,35 @@ private:
 /* ------------------------------------------------------------------------------------------
  *  LFU
  * ------------------------------------------------------------------------------------------*/
-class LFU : public ReplacementPolicy {
+class LFU final : public ReplacementPolicy {
 public:
     SST_ELI_REGISTER_SUBCOMPONENT(LFU, "memHierarchy", "replacement.lfu", SST_ELI_ELEMENT_VERSION(1,0,0),
             "least-frequently-used replacement policy, recently used accesses are more heavily weighted", SST::MemHierarchy::ReplacementPolicy);
 
 
-    LFU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), timestamp(1), bestCandidate(0) {
-        ways = associativity;
-
-        array.resize(lines, (LFUInfo){0,0});
-    }
+    LFU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), engine(lines, associativity), bestCandidate(0) { }
 
     virtual ~LFU() { }
 
     /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
     bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
 
-    // timestamp = (total accesses * timestamp + timestamp) / (accesses + 1)
-    // timestamp increments by 1000 every time to make sure there's sufficient space between timestamps
-    void update(uint64_t id, ReplacementInfo * rInfo) {
-        array[id].ts = (array[id].acc*array[id].ts + timestamp)/(array[id].acc + 1);
-        array[id].acc++;
-        timestamp += 1000;
-    }
+    void update(uint64_t id, ReplacementInfo * rInfo) { engine.update(id); }
 
     uint64_t findBestCandidate(vector<ReplacementInfo*> &rInfo) {
-        bestCandidate = rInfo[0]->getIndex();
-        LFUInfo bestLFU = array[rInfo[0]->getIndex()];
-
-        if (rInfo[0]->getState() == I) { return bestCandidate; }
-
-        for (int i = 1; i < rInfo.size(); i++) {
-            if (rInfo[i]->getState() == I)  {
-                bestCandidate = rInfo[i]->getIndex();
-                return bestCandidate;
-            }
-            LFUInfo candLFU = array[rInfo[i]->getIndex()];
-
-            if (candLFU.lessThan(bestLFU, timestamp)) {
-                bestLFU = candLFU;
-                bestCandidate = rInfo[i]->getIndex();
-            }
-        }
+        bestCandidate = engine.findVictim(rInfo[0]->getIndex(), [&rInfo](uint64_t i) { return rInfo[i]->getState() == I; });
         return bestCandidate;
     }
 
     uint64_t getBestCandidate() { return bestCandidate; }
 
-    //void replaced(uint64_t id) { array[id].acc = 0; }
-    void replaced(uint64_t id) { array[id].acc = 0; }
+    void replaced(uint64_t id) { engine.replaced(id); }
 private:
-
-    struct LFUInfo {
-        uint64_t ts;    // timestamp, function of accesses with more recent ones being more heavily weighted
-        uint64_t acc;   // accesses
-
-        inline bool lessThan(LFUInfo& other, const uint64_t curTs) {
-            if (acc == 0) return true;
-            if (other.acc == 0) return false;
-            uint64_t ownInvFreq = (curTs - ts)/acc; //inverse frequency, lower is better
-            uint64_t otherInvFreq = (curTs - other.ts)/other.acc;
-            return ownInvFreq > otherInvFreq;
-            return false;
-        }
-    };
-
-    std::vector<LFUInfo> array;
-    uint64_t ways;
-
-    uint64_t timestamp;
+    LFUEngine engine;
     uint64_t bestCandidate;
-
 };
 
-class LFUOpt : public ReplacementPolicy {
+class LFUOpt final : public ReplacementPolicy {
 public:
     SST_ELI_REGISTER_SUBCOMPONENT(LFUOpt, "memHierarchy", "replacement.lfu-opt", SST_ELI_ELEMENT_VERSION(1,0,0),
             "least-frequently-used replacement policy, recently used accesses are more heavily weighted. Also considers coherence state in replacement decision", SST::MemHierarchy::ReplacementPolicy);
@@ -426,68 +357,29 @@ private:
 /* ------------------------------------------------------------------------------------------
  *  MRU
  * ------------------------------------------------------------------------------------------*/
-class MRU : public ReplacementPolicy {
+class MRU final : public ReplacementPolicy {
 private:
-    uint64_t                timestamp;
-    int32_t                 bestCandidate;
-    std::vector<uint64_t>   array;
-    uint64_t                ways;
-
-    struct Rank {
-        uint64_t  timestamp;
-        State     state;
-
-        void reset() {
-            state       = I;
-            timestamp   = 0;
-        }
-
-        inline bool biggerThan(const Rank& other) const {
-            if (state == I)
-                return true;
-            else
-                return timestamp > other.timestamp;
-        }
-    };
+    MRUEngine               engine;
+    uint64_t                bestCandidate;
 
 public:
     SST_ELI_REGISTER_SUBCOMPONENT(MRU, "memHierarchy", "replacement.mru", SST_ELI_ELEMENT_VERSION(1,0,0),
             "most-recently-used replacement policy", SST::MemHierarchy::ReplacementPolicy);
 
 
-    MRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), timestamp(1), bestCandidate(0) {
-        ways = associativity;
-
-        array.resize(lines, 0);
-    }
+    MRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), engine(lines, associativity), bestCandidate(0) { }
 
     virtual ~MRU() { }
 
     /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
     bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
 
-    void update(uint64_t id, ReplacementInfo * rInfo) { array[id] = timestamp++; }
+    void update(uint64_t id, ReplacementInfo * rInfo) { engine.update(id); }
 
-    //void replaced(uint64_t id) { array[id] = 0; }
-    void replaced(uint64_t id) { array[id] = 0; }
+    void replaced(uint64_t id) { engine.replaced(id); }
 
     uint64_t findBestCandidate(vector<ReplacementInfo*> &rInfo) {
-        bestCandidate = rInfo[0]->getIndex();
-        Rank bestRank = {array[rInfo[0]->getIndex()], rInfo[0]->getState() };
-        if (rInfo[0]->getState() == I)
-            return bestCandidate;
-
-        for (int i = 1; i < rInfo.size(); i++) {
-            if (rInfo[i]->getState() == I) {
-                bestCandidate = rInfo[i]->getIndex();
-                return bestCandidate;
-            }
-            Rank candRank = {array[rInfo[i]->getIndex()], rInfo[i]->getState() };
-            if (candRank.biggerThan(bestRank)) {
-                bestRank = candRank;
-                bestCandidate = rInfo[i]->getIndex();
-            }
-        }
+        bestCandidate = engine.findVictim(rInfo[0]->getIndex(), [&rInfo](uint64_t i) { return rInfo[i]->getState() == I; });
         return bestCandidate;
     }
 
@@ -496,7 +388,7 @@ public:
 };
 
 
-class MRUOpt : public ReplacementPolicy {
+class MRUOpt final : public ReplacementPolicy {
 private:
     uint64_t                timestamp;
     int32_t                 bestCandidate;
@@ -588,7 +480,7 @@ public:
 /* ------------------------------------------------------------------------------------------
  *  Random
  * ------------------------------------------------------------------------------------------*/
-class Random : public ReplacementPolicy {
+class Random final : public ReplacementPolicy {
 public:
     SST_ELI_REGISTER_SUBCOMPONENT(Random, "memHierarchy", "replacement.random", SST_ELI_ELEMENT_VERSION(1,0,0),
             "random replacement policy", SST::MemHierarchy::ReplacementPolicy);
@@ -598,16 +490,10 @@ public:
             {"seed_b",  "Seed for random number generator", "1"} )
 
 
-    Random(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
-        ways = associativity;
-        uint64_t seeda = params.find<uint64_t>("seed_a", 1);
-        uint64_t seedb = params.find<uint64_t>("seed_b", 1);
-        gen = new SST::RNG::MarsagliaRNG(seeda, seedb);
-    }
+    Random(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity),
+        gen(params.find<uint64_t>("seed_a", 1), params.find<uint64_t>("seed_b", 1)), engine(lines, associativity, &gen), bestCandidate(0) { }
 
-    virtual ~Random() {
-        delete gen;
-    }
+    virtual ~Random() { }
 
     /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
     bool checkCompatibility(ReplacementInfo * rInfo) {
@@ -620,23 +506,16 @@ public:
 
     // Return an empty slot if one exists, otherwise return a random candidate
     uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
-        // Check for empty line
-        for (uint64_t i = 0; i < rInfo.size(); i++) {
-            if (rInfo[i]->getState() == I) {
-                bestCandidate = rInfo[i]->getIndex();
-                return bestCandidate;
-            }
-        }
-        bestCandidate = rInfo[(gen->generateNextUInt64() % ways)]->getIndex();
+        bestCandidate = engine.findVictim(rInfo[0]->getIndex(), [&rInfo](uint64_t i) { return rInfo[i]->getState() == I; });
         return bestCandidate;
     }
 
     uint64_t getBestCandidate() { return bestCandidate; }
 
 private:
+    SST::RNG::MarsagliaRNG gen;
+    RandomEngine<SST::RNG::MarsagliaRNG> engine;
     uint64_t bestCandidate;
-    uint64_t ways;
-    SST::RNG::MarsagliaRNG* gen;
 };
 
 /* ------------------------------------------------------------------------------------------
@@ -644,12 +523,11 @@ private:
  *  - Replacement algorithm assumes indices are contiguous for the set
  * ------------------------------------------------------------------------------------------*/
 
-class NMRU : public ReplacementPolicy {
+class NMRU final : public ReplacementPolicy {
 private:
+    SST::RNG::MarsagliaRNG gen;
+    NMRUEngine<SST::RNG::MarsagliaRNG> engine;
     uint64_t              bestCandidate;
-    std::vector<uint64_t> array;
-    uint64_t              ways;
-    SST::RNG::MarsagliaRNG* gen;
 
 public:
     SST_ELI_REGISTER_SUBCOMPONENT(NMRU, "memHierarchy", "replacement.nmru", SST_ELI_ELEMENT_VERSION(1,0,0),
@@ -660,50 +538,145 @@ public:
             {"seed_b",  "Seed for random number generator", "1"} )
 
 
-    NMRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
-        ways = associativity;
-        uint64_t sets = lines/associativity;
-        array.resize(sets, 0);
-
-        uint64_t seeda = params.find<uint64_t>("seed_a", 1);
-        uint64_t seedb = params.find<uint64_t>("seed_b", 1);
-        gen = new SST::RNG::MarsagliaRNG(seeda, seedb);
-    }
+    NMRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity),
+        gen(params.find<uint64_t>("seed_a", 1), params.find<uint64_t>("seed_b", 1)), engine(lines, associativity, &gen), bestCandidate(0) { }
 
-    virtual ~NMRU() {
-        delete gen;
-    }
+    virtual ~NMRU() { }
 
     /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
     bool checkCompatibility(ReplacementInfo * rInfo) {
         return true; // No cast
     }
 
-    void update(uint64_t id, ReplacementInfo * rInfo) { array[id/ways] = id % ways; }
-    //void replaced(uint64_t id) {}
+    void update(uint64_t id, ReplacementInfo * rInfo) { engine.update(id); }
     void replaced(uint64_t id) { }
 
     // Return an empty slot if one exists, otherwise return any slot that is not the most-recently used in the set
     uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
-        for (uint64_t i = 0; i < ways; i++) {
-            if (rInfo[i]->getState() == I) {
-                bestCandidate = rInfo[i]->getIndex();
-                return bestCandidate;
-            }
+        bestCandidate = engine.findVictim(rInfo[0]->getIndex(), [&rInfo](uint64_t i) { return rInfo[i]->getState() == I; });
+        return bestCandidate;
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Tree pseudo-LRU
+ * ------------------------------------------------------------------------------------------*/
+class TreePLRU final : public ReplacementPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(TreePLRU, "memHierarchy", "replacement.plru", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "tree pseudo-least-recently-used replacement policy, one bit per tree node. Associativity must be 64 or less.", SST::MemHierarchy::ReplacementPolicy);
+
+    TreePLRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), engine(lines, associativity), bestCandidate(0) {
+        if (associativity > TreePLRUEngine::maxWays) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: replacement.plru supports at most %" PRIu64 " ways. Associativity is %" PRIu64 ".\n", getName().c_str(), TreePLRUEngine::maxWays, associativity);
         }
-        uint64_t setBegin = rInfo[0]->getIndex();
-        uint64_t index = gen->generateNextUInt64() % (ways-1);
-        if (index < array[setBegin/ways])
-            bestCandidate = setBegin + index;
-        else
-            bestCandidate = setBegin + index + 1;
+    }
+
+    virtual ~TreePLRU() { }
 
+    /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    void update(uint64_t id, ReplacementInfo * rInfo) { engine.update(id); }
+    void replaced(uint64_t id) { }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        bestCandidate = engine.findVictim(rInfo[0]->getIndex(), [&rInfo](uint64_t i) { return rInfo[i]->getState() == I; });
         return bestCandidate;
     }
 
     uint64_t getBestCandidate() { return bestCandidate; }
+
+private:
+    TreePLRUEngine engine;
+    uint64_t bestCandidate;
 };
 
+/* ------------------------------------------------------------------------------------------
+ *  RRIP family: SRRIP, BRRIP, DRRIP
+ *  - See RRIPEngine for the policy details
+ * ------------------------------------------------------------------------------------------*/
+class RRIPPolicy : public ReplacementPolicy {
+public:
+    RRIPPolicy(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity, RRIPMode mode) : ReplacementPolicy(id, params, lines, associativity),
+        engine(lines, associativity, mode, checkRRPVBits(params), params.find<uint32_t>("brrip_throttle", 32), checkPselBits(params)), bestCandidate(0) { }
+
+    virtual ~RRIPPolicy() { }
+
+    /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; } // No cast
+
+    void update(uint64_t id, ReplacementInfo * rInfo) { engine.update(id); }
+    void replaced(uint64_t id) { engine.replaced(id); }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        bestCandidate = engine.findVictim(rInfo[0]->getIndex(), [&rInfo](uint64_t i) { return rInfo[i]->getState() == I; });
+        return bestCandidate;
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+private:
+    static uint32_t checkRRPVBits(Params& params) {
+        uint32_t bits = params.find<uint32_t>("rrpv_bits", 2);
+        if (bits == 0 || bits > 7) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "Invalid param: rrpv_bits - must be between 1 and 7. You specified %" PRIu32 ".\n", bits);
+        }
+        return bits;
+    }
+
+    static uint32_t checkPselBits(Params& params) {
+        uint32_t bits = params.find<uint32_t>("psel_bits", 10);
+        if (bits == 0 || bits > 30) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "Invalid param: psel_bits - must be between 1 and 30. You specified %" PRIu32 ".\n", bits);
+        }
+        return bits;
+    }
+
+    RRIPEngine engine;
+    uint64_t bestCandidate;
+};
+
+class SRRIP final : public RRIPPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(SRRIP, "memHierarchy", "replacement.srrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "static re-reference interval prediction replacement policy", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",   "Bits in each line's re-reference prediction value", "2"} )
+
+    SRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPPolicy(id, params, lines, associativity, RRIPMode::SRRIP) { }
+};
+
+class BRRIP final : public RRIPPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(BRRIP, "memHierarchy", "replacement.brrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "bimodal re-reference interval prediction replacement policy", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",       "Bits in each line's re-reference prediction value", "2"},
+            {"brrip_throttle",  "One in this many fills is inserted with a long rather than distant re-reference prediction", "32"} )
+
+    BRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPPolicy(id, params, lines, associativity, RRIPMode::BRRIP) { }
+};
+
+class DRRIP final : public RRIPPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(DRRIP, "memHierarchy", "replacement.drrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "dynamic re-reference interval prediction replacement policy, set dueling between SRRIP and BRRIP", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",       "Bits in each line's re-reference prediction value", "2"},
+            {"brrip_throttle",  "One in this many BRRIP fills is inserted with a long rather than distant re-reference prediction", "32"},
+            {"psel_bits",       "Bits in the policy selection counter, between 1 and 30", "10"} )
+
+    DRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPPolicy(id, params, lines, associativity, RRIPMode::DRRIP) { }
+};
 
 }}
 
@@ -0,0 +1,158 @@
+// Copyright 2013-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SHARERSET_H
+#define MEMHIERARCHY_SHARERSET_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "sst/elements/memHierarchy/endpointTable.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Compact sharer tracking for directories
+ *
+ * Sharers are identified by dense integer endpoint IDs that the owning
+ * component assigns to endpoint names. Two encodings are supported:
+ *  - Full map: one bit per endpoint. The bitvector grows to the highest ID seen.
+ *  - Limited pointer: up to 'maxPointers' IDs are stored directly in a sorted
+ *    array. When that overflows, the set switches to a full map until it is
+ *    emptied again.
+ * Both encodings are exact and iterate sharers in ascending ID order.
+ */
+class SharerSet {
+public:
+    /* maxPointers == 0 selects the full map encoding */
+    SharerSet(uint32_t maxPointers = 0) : count_(0), maxPointers_(maxPointers) { }
+
+    size_t size() const { return count_; }
+
+    bool empty() const { return count_ == 0; }
+
+    bool contains(EndpointID id) const {
+        if (usingBits()) {
+            size_t word = id >> 6;
+            return word < bits_.size() && (bits_[word] & (1ULL << (id & 63)));
+        }
+        return std::binary_search(ptrs_.begin(), ptrs_.end(), id);
+    }
+
+    void insert(EndpointID id) {
+        if (usingBits()) {
+            size_t word = id >> 6;
+            if (word >= bits_.size())
+                bits_.resize(word + 1, 0);
+            uint64_t mask = 1ULL << (id & 63);
+            if (!(bits_[word] & mask)) {
+                bits_[word] |= mask;
+                count_++;
+            }
+            return;
+        }
+
+        std::vector<EndpointID>::iterator it = std::lower_bound(ptrs_.begin(), ptrs_.end(), id);
+        if (it != ptrs_.end() && *it == id)
+            return;
+
+        if (ptrs_.size() < maxPointers_) {
+            ptrs_.insert(it, id);
+            count_++;
+            return;
+        }
+
+        /* Pointer overflow, switch to a full map */
+        for (std::vector<EndpointID>::iterator pt = ptrs_.begin(); pt != ptrs_.end(); pt++)
+            setBit(*pt);
+        setBit(id);
+        count_++;
+        std::vector<EndpointID>().swap(ptrs_);
+    }
+
+    void erase(EndpointID id) {
+        if (usingBits()) {
+            size_t word = id >> 6;
+            if (word >= bits_.size())
+                return;
+            uint64_t mask = 1ULL << (id & 63);
+            if (bits_[word] & mask) {
+                bits_[word] &= ~mask;
+                count_--;
+                if (count_ == 0)
+                    clear();
+            }
+            return;
+        }
+
+        std::vector<EndpointID>::iterator it = std::lower_bound(ptrs_.begin(), ptrs_.end(), id);
+        if (it != ptrs_.end() && *it == id) {
+            ptrs_.erase(it);
+            count_--;
+        }
+    }
+
+    void clear() {
+        count_ = 0;
+        ptrs_.clear();
+        if (maxPointers_ == 0)
+            std::fill(bits_.begin(), bits_.end(), 0);   // Keep storage, full maps are reused
+        else
+            std::vector<uint64_t>().swap(bits_);        // Return to pointer encoding
+    }
+
+    /* Call f(EndpointID) for each sharer in ascending ID order */
+    template<typename F>
+    void forEach(F f) const {
+        if (usingBits()) {
+            for (size_t word = 0; word < bits_.size(); word++) {
+                uint64_t w = bits_[word];
+                while (w) {
+                    unsigned bit = __builtin_ctzll(w);
+                    f((EndpointID)((word << 6) + bit));
+                    w &= w - 1;
+                }
+            }
+        } else {
+            for (std::vector<EndpointID>::const_iterator it = ptrs_.begin(); it != ptrs_.end(); it++)
+                f(*it);
+        }
+    }
+
+    /* Host bytes used to store the sharer set, for statistics */
+    size_t getStorageBytes() const {
+        return sizeof(SharerSet) + bits_.capacity() * sizeof(uint64_t) + ptrs_.capacity() * sizeof(EndpointID);
+    }
+
+private:
+    bool usingBits() const { return maxPointers_ == 0 || !bits_.empty(); }
+
+    void setBit(EndpointID id) {
+        size_t word = id >> 6;
+        if (word >= bits_.size())
+            bits_.resize(word + 1, 0);
+        bits_[word] |= 1ULL << (id & 63);
+    }
+
+    std::vector<uint64_t> bits_;
+    std::vector<EndpointID> ptrs_;
+    uint32_t count_;
+    uint32_t maxPointers_;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_SHARERSET_H */
@@ -1,5 +1,13 @@
 import sst
 from mhlib import componentlist
+import sys,getopt
+
+# --event_driven runs the caches in event-driven mode, results must not change
+event_driven = False
+opts, args = getopt.getopt(sys.argv[1:], "", ["event_driven"])
+for o, a in opts:
+    if o == "--event_driven":
+        event_driven = True
 
 # Define the simulation components
 verbose = 2
@@ -56,6 +64,9 @@ memory.addParams({
     "mem_size" : "512MiB"
 })
 
+if event_driven:
+    l1cache.addParam("event_driven", 1)
+
 # Enable statistics
 sst.setStatisticLoadLevel(7)
 sst.setStatisticOutput("sst.statOutputConsole")
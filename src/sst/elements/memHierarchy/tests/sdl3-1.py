@@ -1,5 +1,13 @@
 import sst
 from mhlib import componentlist
+import sys,getopt
+
+# --event_driven runs the caches in event-driven mode, results must not change
+event_driven = False
+opts, args = getopt.getopt(sys.argv[1:], "", ["event_driven"])
+for o, a in opts:
+    if o == "--event_driven":
+        event_driven = True
 
 DEBUG_L1 = 0
 DEBUG_L2 = 0
@@ -99,6 +107,10 @@ memory.addParams({
       "access_time" : "100 ns",
 })
 
+if event_driven:
+    for cache in (c0_l1cache, c1_l1cache, l2cache):
+        cache.addParam("event_driven", 1)
+
 # Enable statistics
 sst.setStatisticLoadLevel(7)
 sst.setStatisticOutput("sst.statOutputConsole")
@@ -50,6 +50,10 @@ class testcase_memHierarchy_sdl(SSTTestCase):
         #  sdl-1   Simple CPU + 1 level cache + Memory
         self.memHierarchy_Template("sdl-1")
 
+    def test_memHierarchy_sdl_1_event_driven(self):
+        #  sdl-1 with the cache clock event-driven, must match the sdl-1 reference
+        self.memHierarchy_Template("sdl-1", event_driven=True)
+
     def test_memHierarchy_sdl_2(self):
         #  sdl-2  Simple CPU + 1 level cache + DRAMSim Memory
         self.memHierarchy_Template("sdl-2")
@@ -66,6 +70,10 @@ class testcase_memHierarchy_sdl(SSTTestCase):
         #  sdl3-1  2 Simple CPUs + 2 levels cache + Memory
         self.memHierarchy_Template("sdl3-1")
 
+    def test_memHierarchy_sdl3_1_event_driven(self):
+        #  sdl3-1 with the cache clocks event-driven, must match the sdl3-1 reference
+        self.memHierarchy_Template("sdl3-1", event_driven=True)
+
     def test_memHierarchy_sdl3_2(self):
         #  sdl3-2  2 Simple CPUs + 2 levels cache + DRAMSim Memory
         self.memHierarchy_Template("sdl3-2")
@@ -107,7 +115,7 @@ class testcase_memHierarchy_sdl(SSTTestCase):
 
 #####
 
-    def memHierarchy_Template(self, testcase, ignore_err_file=False):
+    def memHierarchy_Template(self, testcase, ignore_err_file=False, event_driven=False):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -121,6 +129,11 @@ class testcase_memHierarchy_sdl(SSTTestCase):
         testDataFileName=("test_memHierarchy_{0}".format(testcasename_out))
         sdlfile = "{0}/{1}.py".format(test_path, testcasename_sdl)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        otherargs = ""
+        if event_driven:
+            # Event-driven caches must reproduce the reference output of the clocked run
+            testDataFileName += "_event_driven"
+            otherargs = '--model-options="--event_driven"'
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
@@ -130,7 +143,7 @@ class testcase_memHierarchy_sdl(SSTTestCase):
         log_debug("ref file = {0}".format(reffile))
 
         # Run SST in the tests directory
-        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, mpi_out_files=mpioutfiles)
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, mpi_out_files=mpioutfiles, other_args=otherargs)
 
         # Lines to ignore
         # These are generated by DRAMSim
@@ -0,0 +1,182 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Memory image round trip check
+ *
+ * Fills each backing store type with a sparse random pattern, dumps it with
+ * dumpImage, loads the image into a fresh store of every type and compares
+ * the contents. Also checks that an image with records outside of an mmap
+ * store's range is rejected instead of written past the end of the store,
+ * and that an all-zero record clears data already in the store it is loaded into.
+ *
+ * usage: imagecheck [-d dir] [-n writes]
+ * Exits non-zero if any check fails.
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "membackend/backing.h"
+
+using namespace SST::MemHierarchy;
+using namespace SST::MemHierarchy::Backend;
+
+static const size_t memSize = 64 * 1024 * 1024;
+static const Addr memOffset = 0x10000000;   /* Base address of the mmap stores */
+
+/* xorshift64* */
+class CheckRNG {
+public:
+    CheckRNG(uint64_t seed) : state(seed ? seed : 1) { }
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+private:
+    uint64_t state;
+};
+
+struct Write {
+    Addr addr;
+    std::vector<uint8_t> data;
+};
+
+enum StoreType { MMAP, MALLOC, SPARSE, NUM_TYPES };
+static const char* typeName[NUM_TYPES] = { "mmap", "malloc", "sparse" };
+
+static Backing* makeStore(StoreType type) {
+    switch (type) {
+        case MMAP:   return new BackingMMAP("", memSize, memOffset);
+        case MALLOC: return new BackingMalloc(4096, true);
+        default:     return new BackingSparse(memOffset + memSize, 4096);
+    }
+}
+
+/* Runs of 1 to 256 bytes scattered over [memOffset, memOffset + memSize) */
+static void generate(std::vector<Write>& writes, size_t count) {
+    CheckRNG rng(7);
+    writes.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        size_t size = 1 + rng.next() % 256;
+        writes[i].addr = memOffset + rng.next() % (memSize - size);
+        writes[i].data.resize(size);
+        for (size_t j = 0; j < size; j++)
+            writes[i].data[j] = rng.next() >> 56;
+    }
+}
+
+/* Replays the writes into an expected map and compares every written byte */
+static bool matches(Backing* store, const std::vector<Write>& writes) {
+    std::vector<uint8_t> expect(memSize, 0);
+    for (size_t i = 0; i < writes.size(); i++)
+        memcpy(&expect[writes[i].addr - memOffset], writes[i].data.data(), writes[i].data.size());
+
+    std::vector<uint8_t> got;
+    for (size_t i = 0; i < writes.size(); i++) {
+        got.resize(writes[i].data.size());
+        store->get(writes[i].addr, got.size(), got);
+        if (memcmp(got.data(), &expect[writes[i].addr - memOffset], got.size()) != 0)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string dir = "/tmp";
+    size_t count = 100000;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-d") == 0) {
+            dir = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            count = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: imagecheck [-d dir] [-n writes]\n");
+            exit(1);
+        }
+    }
+
+    std::vector<Write> writes;
+    generate(writes, count);
+
+    int failures = 0;
+    for (int from = 0; from < NUM_TYPES; from++) {
+        std::string file = dir + "/imagecheck-" + typeName[from] + ".img";
+
+        std::unique_ptr<Backing> source(makeStore((StoreType)from));
+        for (size_t i = 0; i < writes.size(); i++)
+            source->set(writes[i].addr, writes[i].data.size(), writes[i].data);
+        if (!source->dumpImage(file)) {
+            printf("FAIL: unable to write %s\n", file.c_str());
+            failures++;
+            continue;
+        }
+
+        for (int to = 0; to < NUM_TYPES; to++) {
+            std::unique_ptr<Backing> dest(makeStore((StoreType)to));
+            bool ok = dest->loadImage(file) && matches(dest.get(), writes);
+            printf("%s: %s -> %s\n", ok ? "PASS" : "FAIL", typeName[from], typeName[to]);
+            failures += ok ? 0 : 1;
+        }
+        remove(file.c_str());
+    }
+
+    /* A sparse store can hold data anywhere, an mmap store must refuse what lies outside of it */
+    Addr outside[] = { memOffset - 64, memOffset + memSize - 32, memOffset + 2 * memSize };
+    for (size_t i = 0; i < sizeof(outside) / sizeof(outside[0]); i++) {
+        std::string file = dir + "/imagecheck-range.img";
+        std::unique_ptr<Backing> source(makeStore(SPARSE));
+        source->set(outside[i], 64, std::vector<uint8_t>(64, 0xa5));
+        bool ok = source->dumpImage(file);
+
+        std::unique_ptr<Backing> dest(makeStore(MMAP));
+        ok = ok && !dest->loadImage(file);
+        printf("%s: record at 0x%" PRIx64 " rejected by a store at [0x%" PRIx64 ", 0x%" PRIx64 ")\n",
+                ok ? "PASS" : "FAIL", outside[i], (uint64_t)memOffset, (uint64_t)(memOffset + memSize));
+        failures += ok ? 0 : 1;
+        remove(file.c_str());
+    }
+
+    /* Stores may skip zero records where nothing was written, but must clear what was */
+    {
+        std::string file = dir + "/imagecheck-zero.img";
+        std::unique_ptr<Backing> source(makeStore(SPARSE));
+        source->set(memOffset, 4096, std::vector<uint8_t>(4096, 0));
+        bool dumped = source->dumpImage(file);
+
+        for (int to = 0; to < NUM_TYPES; to++) {
+            std::unique_ptr<Backing> dest(makeStore((StoreType)to));
+            dest->set(memOffset + 100, 200, std::vector<uint8_t>(200, 0x5a));
+            bool ok = dumped && dest->loadImage(file);
+            std::vector<uint8_t> got(4096);
+            dest->get(memOffset, got.size(), got);
+            ok = ok && std::count(got.begin(), got.end(), 0) == (long)got.size();
+            printf("%s: zero record clears %s\n", ok ? "PASS" : "FAIL", typeName[to]);
+            failures += ok ? 0 : 1;
+        }
+        remove(file.c_str());
+    }
+
+    return failures == 0 ? 0 : 1;
+}
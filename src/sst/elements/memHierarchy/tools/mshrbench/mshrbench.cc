@@ -0,0 +1,350 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * MSHR microbenchmark
+ *
+ * Replays an L1 miss stream against the previous MSHR storage (std::map of
+ * registers holding a std::list of entries, heap allocated evict pointer lists)
+ * and the MSHRTable storage the MSHR now uses. Each miss goes through the same
+ * sequence of calls a cache makes on the miss path: exists, insertEvent,
+ * getFront on the response, setData and removeFront until the address drains.
+ * A fraction of misses also records an eviction of a victim line.
+ *
+ * Trace format, one miss per line, '#' starts a comment:
+ *      <cycle> <R|W> <address>
+ * Cycle and address may be decimal or 0x-prefixed hex. Without a trace file a
+ * synthetic stream is generated.
+ *
+ * usage: mshrbench [-t trace] [-m mshr_size] [-l latency] [-n synthetic_misses] [-r repeat]
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "mshrTable.h"
+
+typedef uint64_t Addr;
+
+struct Miss {
+    uint64_t cycle;
+    Addr addr;
+    bool write;
+};
+
+/* Minimal stand-in for MSHREntry, sized like the real one */
+struct BenchEntry {
+    BenchEntry() : event(0), ptrs(nullptr), time(0), isEvict(false), inProgress(false) { }
+    BenchEntry(uint64_t ev, uint64_t t) : event(ev), ptrs(nullptr), time(t), isEvict(false), inProgress(false) { }
+    uint64_t event;
+    std::vector<Addr>* ptrs;
+    uint64_t time;
+    bool isEvict;
+    bool inProgress;
+};
+
+/* The MSHR storage as it was: map<Addr, register{list<entry>, data}> */
+class OldMSHR {
+public:
+    struct OldEntry {
+        BenchEntry e;
+        std::list<Addr>* ptrs;
+    };
+    struct OldRegister {
+        OldRegister() : acksNeeded(0), dataDirty(false) { }
+        std::list<OldEntry> entries;
+        uint32_t acksNeeded;
+        std::vector<uint8_t> dataBuffer;
+        bool dataDirty;
+    };
+
+    OldMSHR(size_t) { }
+
+    bool exists(Addr addr) { return mshr_.find(addr) != mshr_.end(); }
+
+    void insertEvent(Addr addr, uint64_t ev, uint64_t t) {
+        OldEntry entry;
+        entry.e = BenchEntry(ev, t);
+        entry.ptrs = nullptr;
+        if (mshr_.find(addr) == mshr_.end()) {
+            OldRegister reg;
+            reg.entries.push_back(entry);
+            mshr_.insert(std::make_pair(addr, reg));
+        } else {
+            mshr_.find(addr)->second.entries.push_back(entry);
+        }
+    }
+
+    void insertEviction(Addr oldAddr, Addr newAddr, uint64_t t) {
+        OldEntry entry;
+        entry.e = BenchEntry(0, t);
+        entry.e.isEvict = true;
+        entry.ptrs = new std::list<Addr>;
+        entry.ptrs->push_back(newAddr);
+        if (mshr_.find(oldAddr) == mshr_.end()) {
+            OldRegister reg;
+            reg.entries.push_back(entry);
+            mshr_.insert(std::make_pair(oldAddr, reg));
+        } else {
+            mshr_.find(oldAddr)->second.entries.push_back(entry);
+        }
+    }
+
+    uint64_t getFront(Addr addr) { return mshr_.find(addr)->second.entries.front().e.event; }
+
+    void setData(Addr addr, std::vector<uint8_t>& data) {
+        mshr_.find(addr)->second.dataBuffer = data;
+        mshr_.find(addr)->second.dataDirty = false;
+    }
+
+    void removeFront(Addr addr) {
+        OldRegister* reg = &(mshr_.find(addr)->second);
+        delete reg->entries.front().ptrs;
+        reg->entries.pop_front();
+        if (reg->entries.empty())
+            mshr_.erase(addr);
+    }
+
+private:
+    std::map<Addr, OldRegister> mshr_;
+};
+
+/* The MSHR storage as it is now */
+class NewMSHR {
+public:
+    typedef SST::MemHierarchy::MSHRTable<BenchEntry, Addr> Table;
+
+    NewMSHR(size_t maxSize) : mshr_(maxSize) { }
+
+    bool exists(Addr addr) { return mshr_.find(addr) != nullptr; }
+
+    void insertEvent(Addr addr, uint64_t ev, uint64_t t) {
+        mshr_.pushBack(mshr_.findOrInsert(addr), BenchEntry(ev, t));
+    }
+
+    void insertEviction(Addr oldAddr, Addr newAddr, uint64_t t) {
+        Table::Register* reg = mshr_.findOrInsert(oldAddr);
+        BenchEntry entry(0, t);
+        entry.isEvict = true;
+        Table::Node& node = mshr_.node(mshr_.pushBack(reg, entry));
+        node.ptrs.push_back(newAddr);
+        node.entry.ptrs = &node.ptrs;
+    }
+
+    uint64_t getFront(Addr addr) { return mshr_.node(mshr_.find(addr)->head).entry.event; }
+
+    void setData(Addr addr, std::vector<uint8_t>& data) {
+        Table::Register* reg = mshr_.find(addr);
+        reg->dataBuffer.assign(data.begin(), data.end());
+        reg->dataDirty = false;
+    }
+
+    void removeFront(Addr addr) {
+        Table::Register* reg = mshr_.find(addr);
+        mshr_.unlink(reg, reg->head);
+        if (reg->count == 0)
+            mshr_.erase(addr);
+    }
+
+private:
+    Table mshr_;
+};
+
+struct Response {
+    uint64_t cycle;
+    Addr addr;
+};
+
+/*
+ * Replay the stream. Misses to a line already in the MSHR queue behind it,
+ * new lines issue and get a response 'latency' cycles later. Misses stall
+ * while the MSHR is full. Returns a checksum so the work can't be elided
+ * and the two implementations can be compared.
+ */
+template<typename M>
+uint64_t replay(const std::vector<Miss>& stream, size_t maxSize, uint64_t latency) {
+    M mshr(maxSize);
+    std::deque<Response> responses;
+    std::vector<uint8_t> data(64, 0xA5);
+    size_t outstanding = 0;
+    uint64_t checksum = 0;
+    uint64_t now = 0;
+    uint64_t id = 0;
+
+    auto drain = [&](uint64_t until) {
+        while (!responses.empty() && responses.front().cycle <= until) {
+            Addr addr = responses.front().addr;
+            now = responses.front().cycle;
+            responses.pop_front();
+            mshr.setData(addr, data);
+            while (mshr.exists(addr)) {
+                checksum += mshr.getFront(addr);
+                mshr.removeFront(addr);
+                outstanding--;
+            }
+        }
+    };
+
+    for (size_t i = 0; i < stream.size(); i++) {
+        const Miss& miss = stream[i];
+        drain(miss.cycle > now ? miss.cycle : now);
+        while (outstanding >= maxSize)
+            drain(responses.front().cycle);
+        if (miss.cycle > now)
+            now = miss.cycle;
+
+        Addr line = miss.addr & ~(Addr)63;
+        id++;
+        if (mshr.exists(line)) {
+            mshr.insertEvent(line, id, now);
+        } else {
+            mshr.insertEvent(line, id, now);
+            responses.push_back({now + latency, line});
+            if (miss.write) {
+                /* Record an eviction on a victim line; it drains with the new line's response */
+                Addr victim = line ^ ((Addr)1 << 20);
+                if (!mshr.exists(victim)) {
+                    mshr.insertEviction(victim, line, now);
+                    responses.push_back({now + latency, victim});
+                    outstanding++;
+                }
+            }
+        }
+        outstanding++;
+    }
+    drain(UINT64_MAX);
+    return checksum;
+}
+
+static bool readTrace(const char* path, std::vector<Miss>& stream) {
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL)
+        return false;
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char* comment = strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+        char op;
+        char cycle[64], addr[64];
+        if (sscanf(line, "%63s %c %63s", cycle, &op, addr) != 3)
+            continue;
+        Miss miss;
+        miss.cycle = strtoull(cycle, NULL, 0);
+        miss.addr = strtoull(addr, NULL, 0);
+        miss.write = (op == 'W' || op == 'w');
+        stream.push_back(miss);
+    }
+    fclose(fp);
+    return true;
+}
+
+/* Mostly streaming with some reuse of recently missed lines, roughly what an L1 sees */
+static void synthesize(size_t count, std::vector<Miss>& stream) {
+    std::mt19937_64 rng(42);
+    Addr next = 0x10000000;
+    uint64_t cycle = 0;
+    for (size_t i = 0; i < count; i++) {
+        Miss miss;
+        cycle += 1 + (rng() % 4);
+        if (i > 16 && (rng() % 4) == 0) {
+            miss.addr = stream[i - 1 - (rng() % 16)].addr;
+        } else {
+            miss.addr = next;
+            next += 64;
+        }
+        miss.cycle = cycle;
+        miss.write = (rng() % 3) == 0;
+        stream.push_back(miss);
+    }
+}
+
+template<typename M>
+static double timeReplay(const char* name, const std::vector<Miss>& stream, size_t maxSize, uint64_t latency, int repeat, uint64_t& checksum) {
+    double best = 0.;
+    for (int r = 0; r < repeat; r++) {
+        auto start = std::chrono::steady_clock::now();
+        checksum = replay<M>(stream, maxSize, latency);
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        if (r == 0 || elapsed.count() < best)
+            best = elapsed.count();
+    }
+    printf("%-12s %12.1f ns total %8.2f ns/miss  checksum %" PRIu64 "\n", name, best, best / stream.size(), checksum);
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    const char* trace = NULL;
+    size_t maxSize = 16;
+    uint64_t latency = 100;
+    size_t synthetic = 1000000;
+    int repeat = 5;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-t") == 0) {
+            trace = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "-m") == 0) {
+            maxSize = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-l") == 0) {
+            latency = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            synthetic = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-r") == 0) {
+            repeat = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: mshrbench [-t trace] [-m mshr_size] [-l latency] [-n synthetic_misses] [-r repeat]\n");
+            exit(1);
+        }
+    }
+    if (maxSize == 0 || repeat < 1) {
+        fprintf(stderr, "mshrbench: mshr_size and repeat must be at least 1\n");
+        exit(1);
+    }
+
+    std::vector<Miss> stream;
+    if (trace) {
+        if (!readTrace(trace, stream)) {
+            fprintf(stderr, "mshrbench: unable to open trace %s\n", trace);
+            exit(1);
+        }
+    } else {
+        synthesize(synthetic, stream);
+    }
+    if (stream.empty()) {
+        fprintf(stderr, "mshrbench: miss stream is empty\n");
+        exit(1);
+    }
+
+    printf("Replaying %zu misses, MSHR size %zu, latency %" PRIu64 " cycles, best of %d\n", stream.size(), maxSize, latency, repeat);
+    uint64_t oldSum, newSum;
+    double oldTime = timeReplay<OldMSHR>("map+list", stream, maxSize, latency, repeat, oldSum);
+    double newTime = timeReplay<NewMSHR>("MSHRTable", stream, maxSize, latency, repeat, newSum);
+    printf("Speedup %.2fx\n", oldTime / newTime);
+
+    if (oldSum != newSum) {
+        fprintf(stderr, "mshrbench: checksum mismatch between implementations\n");
+        return 1;
+    }
+    return 0;
+}
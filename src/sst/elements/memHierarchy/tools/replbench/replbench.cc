@@ -0,0 +1,218 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Replacement policy benchmark
+ *
+ * Runs the same access stream through a set-associative tag array once per
+ * replacement engine and reports simulated accesses per second of host time
+ * and the miss rate. Each engine runs twice: called directly (how
+ * CacheArray<T, Policy> uses it) and through a virtual interface (how
+ * CacheArray<T> uses a ReplacementPolicy chosen at runtime).
+ *
+ * The stream mixes a hot working set that fits in the cache, a cold working
+ * set that does not, and a streaming scan, which is enough to separate
+ * recency- and re-reference-based policies.
+ *
+ * usage: replbench [-s sets] [-w ways] [-n accesses] [-r repeat]
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "replacementEngine.h"
+
+using namespace SST::MemHierarchy;
+
+typedef uint64_t Addr;
+
+/* xorshift64*, stands in for MarsagliaRNG */
+class BenchRNG {
+public:
+    BenchRNG(uint64_t seed) : state(seed ? seed : 1) { }
+    uint64_t generateNextUInt64() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+private:
+    uint64_t state;
+};
+
+/* Runtime-selected engine, mirrors the ReplacementPolicy virtual interface */
+class VirtualEngine {
+public:
+    virtual ~VirtualEngine() { }
+    virtual void update(uint64_t id) = 0;
+    virtual void replaced(uint64_t id) = 0;
+    virtual uint64_t findVictim(uint64_t setBegin, const std::vector<bool>& valid) = 0;
+};
+
+template<typename E>
+class VirtualAdapter : public VirtualEngine {
+public:
+    VirtualAdapter(E* e) : engine(e) { }
+    void update(uint64_t id) override { engine->update(id); }
+    void replaced(uint64_t id) override { engine->replaced(id); }
+    uint64_t findVictim(uint64_t setBegin, const std::vector<bool>& valid) override {
+        return engine->findVictim(setBegin, [&](uint64_t i) { return !valid[setBegin + i]; });
+    }
+private:
+    E* engine;
+};
+
+/* Direct calls, E is known at compile time */
+template<typename E>
+class DirectEngine {
+public:
+    DirectEngine(E* e) : engine(e) { }
+    void update(uint64_t id) { engine->update(id); }
+    void replaced(uint64_t id) { engine->replaced(id); }
+    uint64_t findVictim(uint64_t setBegin, const std::vector<bool>& valid) {
+        return engine->findVictim(setBegin, [&](uint64_t i) { return !valid[setBegin + i]; });
+    }
+private:
+    E* engine;
+};
+
+struct Result {
+    double seconds;
+    uint64_t misses;
+};
+
+/* Lookup, update on hit, find victim/replace/update on miss; same sequence as CacheArray */
+template<typename P>
+Result run(P& policy, const std::vector<Addr>& stream, uint64_t sets, uint64_t ways) {
+    std::vector<Addr> tags(sets * ways, ~(Addr)0);
+    std::vector<bool> valid(sets * ways, false);
+    uint64_t misses = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < stream.size(); i++) {
+        Addr line = stream[i];
+        uint64_t setBegin = (line % sets) * ways;
+        uint64_t hit = ways;
+        for (uint64_t w = 0; w < ways; w++) {
+            if (tags[setBegin + w] == line) {
+                hit = w;
+                break;
+            }
+        }
+        if (hit != ways) {
+            policy.update(setBegin + hit);
+            continue;
+        }
+        misses++;
+        uint64_t victim = policy.findVictim(setBegin, valid);
+        policy.replaced(victim);
+        tags[victim] = line;
+        valid[victim] = true;
+        policy.update(victim);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count(), misses};
+}
+
+static void generate(std::vector<Addr>& stream, size_t count, uint64_t lines) {
+    BenchRNG rng(12345);
+    uint64_t hot = lines / 2;           // Fits
+    uint64_t cold = lines * 4;          // Does not fit
+    Addr scan = 1ULL << 32;
+    stream.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t r = rng.generateNextUInt64() % 100;
+        if (r < 60)
+            stream.push_back(rng.generateNextUInt64() % hot);
+        else if (r < 80)
+            stream.push_back(hot + rng.generateNextUInt64() % cold);
+        else
+            stream.push_back(scan++);
+    }
+}
+
+template<typename E>
+static void bench(const char* name, E& directEngine, E& virtualEngine, const std::vector<Addr>& stream, uint64_t sets, uint64_t ways, int repeat) {
+    /* Each run gets fresh engine state by copy so direct and virtual runs see the same starting point */
+    double bestDirect = 0., bestVirtual = 0.;
+    uint64_t missesDirect = 0, missesVirtual = 0;
+    for (int r = 0; r < repeat; r++) {
+        E d(directEngine);
+        DirectEngine<E> direct(&d);
+        Result res = run(direct, stream, sets, ways);
+        if (r == 0 || res.seconds < bestDirect)
+            bestDirect = res.seconds;
+        missesDirect = res.misses;
+
+        E v(virtualEngine);
+        std::unique_ptr<VirtualEngine> virt(new VirtualAdapter<E>(&v));
+        res = run(*virt, stream, sets, ways);
+        if (r == 0 || res.seconds < bestVirtual)
+            bestVirtual = res.seconds;
+        missesVirtual = res.misses;
+    }
+    printf("%-8s %14.0f %14.0f %10.2f%%%s\n", name, stream.size() / bestDirect, stream.size() / bestVirtual,
+            100.0 * missesDirect / stream.size(), missesDirect == missesVirtual ? "" : "  (direct/virtual miss count differs)");
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t sets = 2048;
+    uint64_t ways = 16;
+    size_t accesses = 10000000;
+    int repeat = 3;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-s") == 0) {
+            sets = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-w") == 0) {
+            ways = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            accesses = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-r") == 0) {
+            repeat = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: replbench [-s sets] [-w ways] [-n accesses] [-r repeat]\n");
+            exit(1);
+        }
+    }
+    if (sets == 0 || ways == 0 || ways > TreePLRUEngine::maxWays || accesses == 0 || repeat < 1) {
+        fprintf(stderr, "replbench: sets, accesses and repeat must be at least 1 and ways between 1 and %" PRIu64 "\n", TreePLRUEngine::maxWays);
+        exit(1);
+    }
+
+    uint64_t lines = sets * ways;
+    std::vector<Addr> stream;
+    generate(stream, accesses, lines);
+
+    printf("%" PRIu64 " sets x %" PRIu64 " ways, %zu accesses, best of %d\n", sets, ways, stream.size(), repeat);
+    printf("%-8s %14s %14s %11s\n", "policy", "direct acc/s", "virtual acc/s", "miss rate");
+
+    BenchRNG rngD(1), rngV(1);
+    { LRUEngine d(lines, ways), v(lines, ways); bench("lru", d, v, stream, sets, ways, repeat); }
+    { LFUEngine d(lines, ways), v(lines, ways); bench("lfu", d, v, stream, sets, ways, repeat); }
+    { MRUEngine d(lines, ways), v(lines, ways); bench("mru", d, v, stream, sets, ways, repeat); }
+    { RandomEngine<BenchRNG> d(lines, ways, &rngD), v(lines, ways, &rngV); bench("random", d, v, stream, sets, ways, repeat); }
+    { NMRUEngine<BenchRNG> d(lines, ways, &rngD), v(lines, ways, &rngV); bench("nmru", d, v, stream, sets, ways, repeat); }
+    { TreePLRUEngine d(lines, ways), v(lines, ways); bench("plru", d, v, stream, sets, ways, repeat); }
+    { RRIPEngine d(lines, ways, RRIPMode::SRRIP), v(lines, ways, RRIPMode::SRRIP); bench("srrip", d, v, stream, sets, ways, repeat); }
+    { RRIPEngine d(lines, ways, RRIPMode::BRRIP), v(lines, ways, RRIPMode::BRRIP); bench("brrip", d, v, stream, sets, ways, repeat); }
+    { RRIPEngine d(lines, ways, RRIPMode::DRRIP), v(lines, ways, RRIPMode::DRRIP); bench("drrip", d, v, stream, sets, ways, repeat); }
+    return 0;
+}
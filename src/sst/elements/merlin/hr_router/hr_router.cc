@@ -307,6 +307,21 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
         xbar_stalls[i] = registerStatistic<uint64_t>("xbar_stalls",port_name);
     }
 
+    // Fast forwarding lets a packet arriving at an idle router cross
+    // the xbar without waking the clock.
+    fast_forward = params.find<bool>("fast_forward", false);
+#if VERIFY_DECLOCKING
+    fast_forward = false;
+#endif
+    ff_pending = false;
+    ff_cancelled = 0;
+    fast_forward_timing = NULL;
+    if ( fast_forward ) {
+        fast_forward_timing = configureSelfLink("fast_forward_timing", getCoreTimeBase().toString(),
+                                                new Event::Handler<hr_router>(this,&hr_router::handle_fast_forward));
+    }
+    fast_forward_count = registerStatistic<uint64_t>("fast_forward");
+
     init_vcs();
 }
 
@@ -323,6 +338,117 @@ hr_router::notifyEvent()
     Cycle_t next_cycle = reregisterClock( xbar_tc, my_clock_handler);
 #endif
 
+    skip_idle_cycles(next_cycle);
+}
+
+void
+hr_router::notifyEvent(int port, int vc)
+{
+    if ( fast_forward ) {
+        if ( !ff_pending ) {
+            if ( try_fast_forward(port, vc) ) return;
+        }
+        else {
+            // A second packet showed up before the pending one
+            // crossed the xbar.  If the pending move is due now, the
+            // clock would already have made it this cycle, so finish
+            // it here.  Otherwise, hand it back to the arbiter, which
+            // will see the same state on the same cycle.
+            ff_cancelled++;
+            ff_pending = false;
+            if ( getCurrentSimCycle() >= xbar_tc->convertToCoreTime(ff_cycle) ) {
+                fast_forward_move();
+            }
+        }
+    }
+    notifyEvent();
+}
+
+bool
+hr_router::try_fast_forward(int port, int vc)
+{
+    // Only bypass the arbiter when this packet is the only thing in
+    // the router.  It is then the only requester on the next clock
+    // edge, so any arbiter would grant it as long as the xbar ports
+    // are free and there are credits in the output buffer.
+    if ( get_vcs_with_data() != 1 ) return false;
+
+    internal_router_event* ev = ports[port]->getVCHeads()[vc];
+    int next_port = ev->getNextPort();
+
+    Cycle_t next_cycle = getNextClockCycle(xbar_tc);
+    int64_t elapsed_cycles = next_cycle - unclocked_cycle;
+
+    if ( in_port_busy[port] - elapsed_cycles > 0 ) return false;
+    if ( out_port_busy[next_port] - elapsed_cycles > 0 ) return false;
+    if ( !ports[next_port]->spaceToSend(ev->getVC(), ev->getFlitCount()) ) return false;
+
+    // Nothing else can change the busy counts or use up output
+    // credits before the next edge (a new arrival cancels the move),
+    // so schedule the move for the time the arbiter would have made
+    // it.
+    SimTime_t delay = xbar_tc->convertToCoreTime(next_cycle) - getCurrentSimCycle();
+    if ( delay == 0 ) return false;
+
+    ff_port = port;
+    ff_vc = vc;
+    ff_cycle = next_cycle;
+    ff_pending = true;
+    fast_forward_timing->send(delay, NULL);
+    return true;
+}
+
+void
+hr_router::handle_fast_forward(Event* ev)
+{
+    // Moves that were handed back to the arbiter (or already made)
+    // still deliver their timing event.  These always arrive before
+    // any move scheduled after them.
+    if ( ff_cancelled > 0 ) {
+        ff_cancelled--;
+        return;
+    }
+    ff_pending = false;
+    fast_forward_move();
+}
+
+void
+hr_router::fast_forward_move()
+{
+    // Account for the cycles the clock didn't run, including the one
+    // the move happens in.  The busy counts set below are then
+    // relative to that cycle, just as they are after arbitration.
+    skip_idle_cycles(ff_cycle);
+    unclocked_cycle = ff_cycle;
+    arb->reportBypass(ff_port, ff_vc, in_port_busy);
+
+    internal_router_event* ev = ports[ff_port]->recv(ff_vc);
+    int next_port = ev->getNextPort();
+    in_port_busy[ff_port] = ev->getFlitCount();
+    out_port_busy[next_port] = ev->getFlitCount();
+    ports[next_port]->send(ev,ev->getVC());
+    fast_forward_count->addData(1);
+
+    if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Fast forwarding event (src = %d, dest = %d) "
+                      "over crossbar in router %d (%s) from port %d, VC %d to port"
+                      " %d, VC %d.\n",
+                      ev->getTraceID(),
+                      getCurrentSimTimeNano(),
+                      ev->getSrc(),
+                      ev->getDest(),
+                      id,
+                      getName().c_str(),
+                      ff_port,
+                      ff_vc,
+                      next_port,
+                      ev->getVC());
+    }
+}
+
+void
+hr_router::skip_idle_cycles(Cycle_t next_cycle)
+{
     int64_t elapsed_cycles = next_cycle - unclocked_cycle;
 
 
@@ -413,6 +539,7 @@ hr_router::clock_handler(Cycle_t cycle)
         if ( progress_vcs[i] > -1 ) {
             internal_router_event* ev = ports[i]->recv(progress_vcs[i]);
             ports[ev->getNextPort()]->send(ev,ev->getVC());
+            if ( fast_forward ) fast_forward_count->addData(0);
 
             if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
                 output.output("TRACE(%d): %" PRIu64 " ns: Copying event (src = %d, dest = %d) "
@@ -68,7 +68,8 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
-        {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
+        {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"},
+        {"fast_forward",       "Let a packet that arrives at an otherwise empty router cross the crossbar without waking the clock, as long as its crossbar ports are free and the output buffer has room.  Falls back to cycle by cycle arbitration as soon as a second packet arrives.", "false"}
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -77,11 +78,13 @@ public:
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
         { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
-        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1}
+        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1},
+        { "credit_event_count", "Number of credit events sent on link (see portcontrol.credit_batch_window)", "events", 1},
+        { "fast_forward",       "1 for each packet fast forwarded across the crossbar, 0 for each packet that went through arbitration (mean is the fast forwarded fraction).  Only collected when fast_forward is on", "packets", 1}
     )
 
     SST_ELI_DOCUMENT_PORTS(
-        {"port%(num_ports)d",  "Ports which connect to endpoints or other routers.", { "merlin.RtrEvent", "merlin.internal_router_event", "merlin.topologyevent", "merlin.credit_event" } }
+        {"port%(num_ports)d",  "Ports which connect to endpoints or other routers.", { "merlin.RtrEvent", "merlin.internal_router_event", "merlin.topologyevent", "merlin.credit_event", "merlin.credit_batch_event" } }
     )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -133,6 +136,23 @@ private:
     void init_vcs();
     Statistic<uint64_t>** xbar_stalls;
 
+    // Fast forward state.  At most one packet is pending at a time.
+    // It stays in its input queue until ff_cycle, when it is moved
+    // exactly as the arbiter would have moved it.
+    bool fast_forward;
+    bool ff_pending;
+    int ff_cancelled;
+    int ff_port;
+    int ff_vc;
+    Cycle_t ff_cycle;
+    Link* fast_forward_timing;
+    Statistic<uint64_t>* fast_forward_count;
+
+    bool try_fast_forward(int port, int vc);
+    void handle_fast_forward(Event* ev);
+    void fast_forward_move();
+    void skip_idle_cycles(Cycle_t next_cycle);
+
     Output& output;
 
     Shared::SharedArray<int> shared_array;
@@ -147,6 +167,7 @@ public:
     void finish();
 
     void notifyEvent();
+    void notifyEvent(int port, int vc);
     int const* getOutputBufferCredits() {return xbar_in_credits;}
     int const* getOutputQueueLengths() {return output_queue_lengths;}
 
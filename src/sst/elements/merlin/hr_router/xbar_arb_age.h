@@ -238,6 +238,10 @@ public:
     void reportSkippedCycles(Cycle_t cycles) {
     }
 
+    void reportBypass(int port, int vc, int* in_port_busy) {
+        // Priority only depends on the waiting events, nothing to update
+    }
+
     void dumpState(std::ostream& stream) {
         /* stream << "Current round robin port: " << rr_port << std::endl; */
         /* stream << "  Current round robin VC by port:" << std::endl; */
@@ -197,6 +197,16 @@ public:
     void reportSkippedCycles(Cycle_t cycles) {
     }
 
+    void reportBypass(int port, int vc, int* in_port_busy) {
+        // Same as a cycle with (port, vc) as the only winner: it goes
+        // to the bottom of the list and everything else keeps its
+        // order.
+        int index = 0;
+        while ( cur_list[index].first != port || cur_list[index].second != vc ) index++;
+        for ( ; index < total_entries - 1; index++ ) cur_list[index] = cur_list[index+1];
+        cur_list[total_entries-1] = priority_entry_t(port,vc);
+    }
+
     void dumpState(std::ostream& stream) {
         /* stream << "Current round robin port: " << rr_port << std::endl; */
         /* stream << "  Current round robin VC by port:" << std::endl; */
@@ -231,6 +231,12 @@ public:
     void reportSkippedCycles(Cycle_t cycles) {
     }
 
+    void reportBypass(int port, int vc, int* in_port_busy) {
+        // arbitrate() would have drawn a priority for the one waiting
+        // event, keep the random stream in step.
+        rng->nextUniform();
+    }
+
     void dumpState(std::ostream& stream) {
         /* stream << "Current round robin port: " << rr_port << std::endl; */
         /* stream << "  Current round robin VC by port:" << std::endl; */
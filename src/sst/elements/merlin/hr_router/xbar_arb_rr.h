@@ -166,6 +166,16 @@ public:
 #endif
     }
 
+    void reportBypass(int port, int vc, int* in_port_busy) {
+        // arbitrate() moves on to the next VC of every port whose
+        // input wasn't busy, whether or not it had anything to send.
+        // rr_port was already advanced for this cycle.
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( in_port_busy[i] > 0 ) continue;
+            rr_vcs[i] = (rr_vcs[i] + 1) % num_vcs;
+        }
+    }
+
     void dumpState(std::ostream& stream) {
         stream << "Current round robin port: " << rr_port << std::endl;
         stream << "  Current round robin VC by port:" << std::endl;
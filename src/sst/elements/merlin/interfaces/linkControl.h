@@ -81,7 +81,7 @@ public:
     )
 
     SST_ELI_DOCUMENT_PORTS(
-        {"rtr_port", "Port that connects to router", { "merlin.RtrEvent", "merlin.credit_event", "" } },
+        {"rtr_port", "Port that connects to router", { "merlin.RtrEvent", "merlin.credit_event", "merlin.credit_batch_event", "" } },
     )
 
 
@@ -136,8 +136,25 @@ PortControl::recv(int vc)
 	// For now, we're just going to send the credits back to the
 	// other side.  The required BW to do this will not be taken
 	// into account.
-	port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return]));
-	port_ret_credits[vc_return] = 0;
+    if ( credit_timing == NULL ) {
+        port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return]));
+        port_ret_credits[vc_return] = 0;
+        credit_event_count->addData(1);
+    }
+    else {
+        // Hold the credits until there are enough of them or the
+        // window runs out.  The timer bounds how long any credit
+        // waits, so the sender can't be starved even when the
+        // buffers are too small to ever reach the threshold.
+        credit_batch_pending += event->getFlitCount();
+        if ( credit_batch_pending >= credit_batch_threshold ) {
+            sendCredits();
+        }
+        else if ( !credit_timer_active ) {
+            credit_timing->send(1,NULL);
+            credit_timer_active = true;
+        }
+    }
 
 #if TRACK
     if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
@@ -147,6 +164,46 @@ PortControl::recv(int vc)
     return event;
 }
 
+void
+PortControl::sendCredits()
+{
+    // Send a plain credit_event when only one VC has credits, which
+    // is the common case under light load
+    int count = 0;
+    int last = -1;
+    for ( int i = 0; i < num_vcs; i++ ) {
+        if ( port_ret_credits[i] != 0 ) {
+            count++;
+            last = i;
+        }
+    }
+    credit_batch_pending = 0;
+    if ( count == 0 ) return;
+
+    if ( count == 1 ) {
+        port_link->send(1,new credit_event(last,port_ret_credits[last]));
+        port_ret_credits[last] = 0;
+    }
+    else {
+        credit_batch_event* cb = new credit_batch_event();
+        cb->credits.assign(port_ret_credits, port_ret_credits + last + 1);
+        for ( int i = 0; i <= last; i++ ) port_ret_credits[i] = 0;
+        port_link->send(1,cb);
+    }
+    credit_event_count->addData(1);
+}
+
+void
+PortControl::handle_credit_timer(Event* ev)
+{
+    // Credits sent early because of the threshold leave the timer
+    // running, so this can fire with little or nothing held.
+    // Sending what's there early never delays a credit past the
+    // window.
+    credit_timer_active = false;
+    sendCredits();
+}
+
 void
 PortControl::reportIncomingEvent(internal_router_event* ev)
 {
@@ -333,6 +390,9 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
 	disable_timing = configureSelfLink(link_port_name + "_disable_timing", "1us",
                                        new Event::Handler<PortControl>(this,&PortControl::reenablePort));
     connected = true;
+    credit_timing = NULL;
+    credit_batch_pending = 0;
+    credit_timer_active = false;
 
     if ( port_link == NULL ) {
         connected = false;
@@ -363,6 +423,29 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
         output_buf_size *= UnitAlgebra("8b/B");
     }
 
+    // Credit batching
+    UnitAlgebra credit_batch_window = params.find<UnitAlgebra>("credit_batch_window","0ns");
+    if ( !credit_batch_window.hasUnits("s") ) {
+        merlin_abort.fatal(CALL_INFO,-1,"PortControl: credit_batch_window must be specified in "
+                           "seconds (s): %s\n",credit_batch_window.toStringBestSI().c_str());
+    }
+    if ( credit_batch_window > UnitAlgebra("0s") ) {
+        credit_timing = configureSelfLink(link_port_name + "_credit_timing", credit_batch_window.toString(),
+                                          new Event::Handler<PortControl>(this,&PortControl::handle_credit_timer));
+
+        UnitAlgebra batch_size = params.find<UnitAlgebra>("credit_batch_threshold", input_buf_size / 2);
+        if ( !batch_size.hasUnits("b") && !batch_size.hasUnits("B") ) {
+            merlin_abort.fatal(CALL_INFO,-1,"PortControl: credit_batch_threshold must be specified in either "
+                               "bits (b) or bytes (B): %s\n",batch_size.toStringBestSI().c_str());
+        }
+        if ( batch_size.hasUnits("B") ) {
+            batch_size *= UnitAlgebra("8b/B");
+        }
+        if ( batch_size > input_buf_size ) batch_size = input_buf_size;
+        credit_batch_threshold = (batch_size / flit_size).getRoundedValue();
+        if ( credit_batch_threshold < 1 ) credit_batch_threshold = 1;
+    }
+
     std::string input_latency_timebase = params.find<std::string>("input_latency",found);
     if ( port_link && found ) {
         port_link->addRecvLatency(1,input_latency_timebase);
@@ -409,6 +492,7 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     output_port_stalls = registerStatistic<uint64_t>("output_port_stalls", port_name);
     idle_time = registerStatistic<uint64_t>("idle_time", port_name);
     width_adj_count = registerStatistic<uint64_t>("width_adj_count", port_name);
+    credit_event_count = registerStatistic<uint64_t>("credit_event_count", port_name);
 
 	// set the SAI metrics to 0
 	stalled = 0;
@@ -940,6 +1024,39 @@ PortControl::handle_input_n2r(Event* ev)
 	    }
 	}
     break;
+	case BaseRtrEvent::CREDIT_BATCH:
+    {
+	    credit_batch_event* cb = static_cast<credit_batch_event*>(ev);
+        for ( size_t i = 0; i < cb->credits.size(); i++ ) {
+            port_out_credits[i] += cb->credits[i];
+
+            if ( oql_track_remote ) {
+                if ( oql_track_port ) {
+                    for ( int j = 0; j < num_vcs; ++j ) {
+                        output_queue_lengths[j] -= cb->credits[i];
+                    }
+                }
+                else {
+                    output_queue_lengths[i] -= cb->credits[i];
+                }
+            }
+        }
+
+        delete cb;
+
+	    // If we're waiting, we need to send a wakeup event to the
+	    // output queues
+	    if ( waiting ) {
+            output_timing->send(1,NULL);
+            waiting = false;
+            // If we were stalled waiting for credits and we had
+            // packets, we need to add stall time
+            if ( have_packets) {
+                output_port_stalls->addData(getCurrentSimCycle() - start_block);
+            }
+	    }
+	}
+    break;
 	case BaseRtrEvent::PACKET:
 	{
 	    RtrEvent* event = static_cast<RtrEvent*>(ev);
@@ -976,7 +1093,7 @@ PortControl::handle_input_n2r(Event* ev)
                           event->getDest());
 	    }
 
-	    if ( parent->getRequestNotifyOnEvent() ) parent->notifyEvent();
+	    if ( parent->getRequestNotifyOnEvent() ) parent->notifyEvent(port_number, curr_vc);
 	}
     break;
 	case BaseRtrEvent::INTERNAL:
@@ -1023,6 +1140,27 @@ PortControl::handle_input_r2r(Event* ev)
 	    }
 	}
     break;
+	case BaseRtrEvent::CREDIT_BATCH:
+	{
+	    credit_batch_event* cb = static_cast<credit_batch_event*>(ev);
+        for ( size_t i = 0; i < cb->credits.size(); i++ ) {
+            port_out_credits[i] += cb->credits[i];
+        }
+	    delete cb;
+
+	    // If we're waiting, we need to send a wakeup event to the
+	    // output queues
+	    if ( waiting ) {
+            output_timing->send(1,NULL);
+            waiting = false;
+            // If we were stalled waiting for credits and we had
+            // packets, we need to add stall time
+            if ( have_packets) {
+                output_port_stalls->addData(getCurrentSimCycle() - start_block);
+            }
+	    }
+	}
+    break;
 	case BaseRtrEvent::PACKET:
 	    // This shouldn't happen
 	    break;
@@ -1059,7 +1197,7 @@ PortControl::handle_input_r2r(Event* ev)
                           event->getDest());
 	    }
 
-	    if ( parent->getRequestNotifyOnEvent() ) parent->notifyEvent();
+	    if ( parent->getRequestNotifyOnEvent() ) parent->notifyEvent(port_number, curr_vc);
 	}
     break;
 	case BaseRtrEvent::CTRL:
@@ -74,7 +74,9 @@ public:
         {"enable_congestion_management", "Turn on congestion management","false"},
         {"cm_outstanding_threshold", "Threshold for the amount of data outstanding to a host before congestion management can trigger","2*output_buf_size"},
         {"cm_pktsize_threshold", "Minimum size of a packet to be considered part of a stream with regards to congestion management","128B"},
-        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"}
+        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"},
+        {"credit_batch_window", "Longest time returned credits are held so they can be sent to the other side of the link in a single event.  0 sends one credit event per packet.","0ns"},
+        {"credit_batch_threshold", "Amount of held credits (in b or B) that causes them to be sent before credit_batch_window expires.  Capped at input_buf_size.","input_buf_size/2"}
     )
 
     // SST_ELI_DOCUMENT_STATISTICS(
@@ -186,6 +188,15 @@ private:
     int* port_ret_credits;
     int* port_out_credits;
 
+    // Credit batching.  Returned credits collect in port_ret_credits
+    // until credit_batch_pending reaches credit_batch_threshold or
+    // credit_timing fires, so they are never held longer than the
+    // batch window.  credit_timing is NULL when batching is off.
+    Link* credit_timing;
+    int credit_batch_threshold;
+    int credit_batch_pending;
+    bool credit_timer_active;
+
     // Represents the start of when a port was idle
     // If the buffer was empty we instantiate this to the current time
     SimTime_t idle_start;
@@ -217,6 +228,7 @@ private:
     Statistic<uint64_t>* output_port_stalls;
     Statistic<uint64_t>* idle_time;
     Statistic<uint64_t>* width_adj_count;
+    Statistic<uint64_t>* credit_event_count;
 
 	// SAI Metrics (S+A+I=1) corresponds to
 	// sai_win_start to (sai_win_start + sai_win_length)
@@ -355,6 +367,8 @@ private:
     void handle_input_r2r(Event* ev);
     void handle_output(Event* ev);
     void handle_failed(Event* ev);
+    void handle_credit_timer(Event* ev);
+    void sendCredits();
     void handleSAIWindow(Event* ev);
     void reenablePort(Event* ev);
 
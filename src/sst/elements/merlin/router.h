@@ -28,6 +28,7 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Merlin {
@@ -65,6 +66,9 @@ public:
     inline bool getRequestNotifyOnEvent() { return requestNotifyOnEvent; }
 
     virtual void notifyEvent() {}
+    // Same as above, but also identifies the input VC that just
+    // received a packet
+    virtual void notifyEvent(int port, int vc) { notifyEvent(); }
 
     inline void inc_vcs_with_data() { vcs_with_data++; }
     inline void dec_vcs_with_data() { vcs_with_data--; }
@@ -84,7 +88,7 @@ public:
 class BaseRtrEvent : public Event {
 
 public:
-    enum RtrEventType {CREDIT, PACKET, INTERNAL, INITIALIZATION, CTRL};
+    enum RtrEventType {CREDIT, PACKET, INTERNAL, INITIALIZATION, CTRL, CREDIT_BATCH};
 
     inline RtrEventType getType() const { return type; }
 
@@ -372,6 +376,33 @@ private:
 
 };
 
+// Credits for several VCs returned in a single event.  Used by
+// PortControl when credit batching is turned on.
+class credit_batch_event : public BaseRtrEvent {
+public:
+    // Indexed by VC.  Trailing VCs with no credits are left off.
+    std::vector<int> credits;
+
+    credit_batch_event() :
+	BaseRtrEvent(BaseRtrEvent::CREDIT_BATCH)
+    {}
+
+    virtual void print(const std::string& header, Output &out) const  override {
+        out.output("%s credit_batch_event for %zu VCs to be delivered at %" PRIu64 " with priority %d\n",
+                header.c_str(), credits.size(), getDeliveryTime(), getPriority());
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser)  override {
+        BaseRtrEvent::serialize_order(ser);
+        ser & credits;
+    }
+
+private:
+
+    ImplementSerializable(SST::Merlin::credit_batch_event)
+
+};
+
 class RtrInitEvent : public BaseRtrEvent {
 public:
 
@@ -645,6 +676,13 @@ public:
     virtual void setPorts(int num_ports, int num_vcs) = 0;
     virtual bool isOkayToPauseClock() { return true; }
     virtual void reportSkippedCycles(Cycle_t cycles) {};
+    // Called when the router moved the head of (port, vc) across the
+    // xbar on its own, as the only requester on that cycle.  The
+    // cycle itself is reported through reportSkippedCycles().
+    // in_port_busy is the state arbitrate() would have seen.  Must
+    // leave the arbiter as that arbitrate() call would have, which
+    // for an arbiter that keeps no state between cycles is nothing.
+    virtual void reportBypass(int port, int vc, int* in_port_busy) {};
     virtual void dumpState(std::ostream& stream) {};
 
 };
@@ -12,6 +12,7 @@
 # distribution.
 
 import sst
+import sys,getopt
 from sst.merlin.base import *
 from sst.merlin.endpoint import *
 from sst.merlin.interface import *
@@ -19,6 +20,12 @@ from sst.merlin.topology import *
 
 if __name__ == "__main__":
 
+    # --precompute_routes caches the global route lookups, results must not change
+    precompute_routes = False
+    opts, args = getopt.getopt(sys.argv[1:], "", ["precompute_routes"])
+    for o, a in opts:
+        if o == "--precompute_routes":
+            precompute_routes = True
 
     ### Setup the topology
     topo = topoDragonFly()
@@ -27,6 +34,7 @@ if __name__ == "__main__":
     topo.intergroup_links = 4
     topo.num_groups = 5
     topo.algorithm = ["minimal","ugal"]
+    topo.precompute_routes = precompute_routes
 
     group_size = topo.hosts_per_router * topo.routers_per_group
     
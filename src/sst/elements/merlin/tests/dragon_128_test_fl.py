@@ -12,6 +12,7 @@
 # distribution.
 
 import sst
+import sys,getopt
 from sst.merlin.base import *
 from sst.merlin.endpoint import *
 from sst.merlin.interface import *
@@ -19,6 +20,12 @@ from sst.merlin.topology import *
 
 if __name__ == "__main__":
 
+    # --precompute_routes caches the global route lookups, results must not change
+    precompute_routes = False
+    opts, args = getopt.getopt(sys.argv[1:], "", ["precompute_routes"])
+    for o, a in opts:
+        if o == "--precompute_routes":
+            precompute_routes = True
 
     ### Setup the topology
     topo = topoDragonFly()
@@ -31,6 +38,7 @@ if __name__ == "__main__":
 
     topo.config_failed_links = True
     topo.failed_links = [ "2:3:0", "2:3:2", "2:3:1", "2:3:3" ]
+    topo.precompute_routes = precompute_routes
     
     # Set up the routers
     router = hr_router()
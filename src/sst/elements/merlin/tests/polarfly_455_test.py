@@ -11,13 +11,20 @@ from sst.merlin.endpoint import *
 from sst.merlin.interface import *
 from sst.merlin.topology import *
 
-import sys
+import sys,getopt
 
 
 if __name__ == "__main__":
 
 
     ### Configuration
+    # --shared_route_table shares the next-hop tables between routers, results must not change
+    shared_route_table = False
+    opts, args = getopt.getopt(sys.argv[1:], "", ["shared_route_table"])
+    for o, a in opts:
+        if o == "--shared_route_table":
+            shared_route_table = True
+
     specified_q=9
     specified_k=5
     specified_algo='UGAL_PF'
@@ -26,6 +33,7 @@ if __name__ == "__main__":
     topo                        = topoPolarFly(q=specified_q)
     topo.algorithm              = specified_algo
     topo.hosts_per_router       = specified_k
+    topo.shared_route_table     = shared_route_table
 
 
     # Set up the routers
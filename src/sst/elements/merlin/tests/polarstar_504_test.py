@@ -10,10 +10,18 @@ from sst.merlin.base import *
 from sst.merlin.endpoint import *
 from sst.merlin.interface import *
 from sst.merlin.topology import *
+import sys,getopt
 
 
 if __name__=="__main__":
     ### Configuration
+    # --shared_route_table shares the next-hop tables between routers, results must not change
+    shared_route_table = False
+    opts, args = getopt.getopt(sys.argv[1:], "", ["shared_route_table"])
+    for o, a in opts:
+        if o == "--shared_route_table":
+            shared_route_table = True
+
     specified_d=8
     specified_algo='UGAL'  
     specified_k=3
@@ -22,6 +30,7 @@ if __name__=="__main__":
     topo                        = topoPolarStar(d=specified_d)
     topo.algorithm              = specified_algo
     topo.hosts_per_router       = specified_k
+    topo.shared_route_table     = shared_route_table
 
     # Set up the routers
     router                      = hr_router()
@@ -2,6 +2,7 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import re
 
 try:
     from sympy.polys.domains import ZZ
@@ -56,6 +57,9 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_dragon_128(self):
         self.merlin_test_template("dragon_128_test")
 
+    def test_merlin_dragon_128_precompute(self):
+        self.merlin_test_template("dragon_128_test", reftest="dragon_128_test", otherargs='--model-options="--precompute_routes"')
+
     def test_merlin_dragon_72(self):
         self.merlin_test_template("dragon_72_test")
 
@@ -74,6 +78,24 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_torus_64(self):
          self.merlin_test_template("torus_64_test")
 
+    def test_merlin_torus_64_ff(self):
+         self.merlin_test_template("torus_64_ff_test", reftest="torus_64_test")
+
+    def test_merlin_torus_64_ff_rr(self):
+         self.merlin_ff_compare_template("torus_64_ff_test", "merlin.xbar_arb_rr")
+
+    def test_merlin_torus_64_ff_rand(self):
+         self.merlin_ff_compare_template("torus_64_ff_test", "merlin.xbar_arb_rand")
+
+    def test_merlin_torus_64_credit_batch_min_buf(self):
+         self.merlin_credit_batch_template("torus_64_credit_batch_test", "8B")
+
+    def test_merlin_torus_64_credit_batch(self):
+         self.merlin_credit_batch_template("torus_64_credit_batch_test", "64B")
+
+    def test_merlin_torus_64_ff_stat(self):
+         self.merlin_ff_stat_template("torus_64_ff_test")
+
     def test_merlin_hyperx_128(self):
          self.merlin_test_template("hyperx_128_test")
 
@@ -86,19 +108,30 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_dragon_128_fl(self):
         self.merlin_test_template("dragon_128_test_fl")
 
+    def test_merlin_dragon_128_fl_precompute(self):
+        self.merlin_test_template("dragon_128_test_fl", reftest="dragon_128_test_fl", otherargs='--model-options="--precompute_routes"')
+
 
     @unittest.skipIf(not(('sympy.polys.galoistools' in sys.modules) and ('sympy.polys.domains' in sys.modules)), "Polarfly construction requires sympy")
     def test_merlin_polarfly_455(self):
         self.merlin_test_template("polarfly_455_test")
 
+    @unittest.skipIf(not(('sympy.polys.galoistools' in sys.modules) and ('sympy.polys.domains' in sys.modules)), "Polarfly construction requires sympy")
+    def test_merlin_polarfly_455_shared_table(self):
+        self.merlin_test_template("polarfly_455_test", reftest="polarfly_455_test", otherargs='--model-options="--shared_route_table"')
+
     @unittest.skipIf(not(('sympy.polys.galoistools' in sys.modules) and ('sympy.polys.domains' in sys.modules)), "Polarstar construction requires sympy")
     def test_merlin_polarstar_504(self):
         self.merlin_test_template("polarstar_504_test")
 
+    @unittest.skipIf(not(('sympy.polys.galoistools' in sys.modules) and ('sympy.polys.domains' in sys.modules)), "Polarstar construction requires sympy")
+    def test_merlin_polarstar_504_shared_table(self):
+        self.merlin_test_template("polarstar_504_test", reftest="polarstar_504_test", otherargs='--model-options="--shared_route_table"')
+
 
 #####
 
-    def merlin_test_template(self, testcase, cwd=False):
+    def merlin_test_template(self, testcase, cwd=False, reftest=None, otherargs=""):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -106,17 +139,21 @@ class testcase_merlin_Component(SSTTestCase):
 
         # Set the various file paths
         testDataFileName="test_merlin_{0}".format(testcase)
+        # Variants of a test get their own output files
+        if otherargs:
+            testDataFileName += "_" + re.sub(r"\W+", "_", otherargs.split("=",1)[1]).strip("_")
 
         sdlfile = "{0}/{1}.py".format(test_path, testcase)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        # Tests that must reproduce another test's results share its reference file
+        reffile = "{0}/refFiles/test_merlin_{1}.out".format(test_path, reftest if reftest else testcase)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
 
         if cwd:
-            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=test_path)
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles, set_cwd=test_path)
         else:
-            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
 
         # NOTE: THE PASS / FAIL EVALUATIONS ARE PORTED FROM THE SQE BAMBOO
         #       BASED testSuite_XXX.sh THESE SHOULD BE RE-EVALUATED BY THE
@@ -132,3 +169,106 @@ class testcase_merlin_Component(SSTTestCase):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+    def merlin_ff_compare_template(self, testcase, arb):
+        # Run the same network cycle by cycle and with fast forwarding,
+        # the two runs must produce the same output
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        arbname = arb.split(".")[-1]
+        testDataFileName="test_merlin_{0}_{1}".format(testcase, arbname)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = {}
+        for ff in ["false", "true"]:
+            outfile[ff] = "{0}/{1}_ff_{2}.out".format(outdir, testDataFileName, ff)
+            errfile = "{0}/{1}_ff_{2}.err".format(outdir, testDataFileName, ff)
+            mpioutfiles = "{0}/{1}_ff_{2}.testfile".format(outdir, testDataFileName, ff)
+            otherargs = '--model-options="--arb={0} --fast_forward={1}"'.format(arb, ff)
+
+            self.run_sst(sdlfile, outfile[ff], errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        cmp_result = testing_compare_sorted_diff(testcase, outfile["true"], outfile["false"])
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testcase)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted cycle by cycle output {1}".format(outfile["true"], outfile["false"]))
+
+    def merlin_credit_batch_template(self, testcase, buf_size):
+        # Run the same network with and without credit batching, both runs
+        # must deliver every packet and batching must not send more credit
+        # events.  Buffers holding several packets must send fewer.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}_{1}".format(testcase, buf_size)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = {}
+        credit_events = {}
+        for window in ["0ns", "20ns"]:
+            outfile[window] = "{0}/{1}_window_{2}.out".format(outdir, testDataFileName, window)
+            errfile = "{0}/{1}_window_{2}.err".format(outdir, testDataFileName, window)
+            mpioutfiles = "{0}/{1}_window_{2}.testfile".format(outdir, testDataFileName, window)
+            otherargs = '--model-options="--credit_batch_window={0} --buf_size={1}"'.format(window, buf_size)
+
+            self.run_sst(sdlfile, outfile[window], errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            received = 0
+            credit_events[window] = 0
+            with open(outfile[window], 'r') as f:
+                for line in f:
+                    if "received all packets" in line:
+                        received += 1
+                    elif "credit_event_count" in line:
+                        credit_events[window] += int(re.search(r"Sum\.u64 = (\d+)", line).group(1))
+
+            self.assertTrue(received == 64, "Only {0} of 64 NICs received all packets in {1}".format(received, outfile[window]))
+
+        log_debug("credit events {0} unbatched, {1} batched".format(credit_events["0ns"], credit_events["20ns"]))
+        self.assertTrue(credit_events["0ns"] > 0, "No credit events counted in {0}".format(outfile["0ns"]))
+        if buf_size == "8B":
+            self.assertTrue(credit_events["20ns"] <= credit_events["0ns"], "Credit batching sent {0} credit events, more than the {1} sent without it".format(credit_events["20ns"], credit_events["0ns"]))
+        else:
+            self.assertTrue(credit_events["20ns"] < credit_events["0ns"], "Credit batching sent {0} credit events, no fewer than the {1} sent without it".format(credit_events["20ns"], credit_events["0ns"]))
+
+    def merlin_ff_stat_template(self, testcase):
+        # The fast_forward statistic must show that some, but not all,
+        # packets crossed a crossbar without arbitration
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}_stat".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        otherargs = '--model-options="--stats"'
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        received = 0
+        fast_forwarded = 0
+        crossings = 0
+        with open(outfile, 'r') as f:
+            for line in f:
+                if "received all packets" in line:
+                    received += 1
+                elif ".fast_forward " in line:
+                    fast_forwarded += int(re.search(r"Sum\.u64 = (\d+)", line).group(1))
+                    crossings += int(re.search(r"Count\.u64 = (\d+)", line).group(1))
+
+        self.assertTrue(received == 64, "Only {0} of 64 NICs received all packets in {1}".format(received, outfile))
+        self.assertTrue(crossings > 0, "No fast_forward statistics reported in {0}".format(outfile))
+        self.assertTrue(0 < fast_forwarded and fast_forwarded < crossings, "{0} of {1} crossbar crossings were fast forwarded in {2}".format(fast_forwarded, crossings, outfile))
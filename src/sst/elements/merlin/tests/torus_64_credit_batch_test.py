@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2023 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2023, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+import sys,getopt
+from sst.merlin import *
+
+if __name__ == "__main__":
+
+    # --credit_batch_window=0ns gives the unbatched run the batched one is
+    # compared against, --buf_size sets both router buffers
+    credit_batch_window = "20ns"
+    buf_size = "8B"
+    opts, args = getopt.getopt(sys.argv[1:], "", ["credit_batch_window=","buf_size="])
+    for o, a in opts:
+        if o == "--credit_batch_window":
+            credit_batch_window = a
+        elif o == "--buf_size":
+            buf_size = a
+    topo = topoTorus()
+    endPoint = TestEndPoint()
+
+
+    sst.merlin._params["torus.shape"] = "4x4x4"
+    sst.merlin._params["torus.width"] = "1x1x1"
+    sst.merlin._params["torus.local_ports"] = "1"
+    sst.merlin._params["num_dims"] = "3"
+
+
+    sst.merlin._params["link_bw"] = "4GB/s"
+    sst.merlin._params["link_lat"] = "20ns"
+    sst.merlin._params["flit_size"] = "8B"
+    sst.merlin._params["xbar_bw"] = "4GB/s"
+    sst.merlin._params["input_latency"] = "20ns"
+    sst.merlin._params["output_latency"] = "20ns"
+    # 8B is a single flit (and a single test packet), the smallest
+    # buffer credits can be held against
+    sst.merlin._params["input_buf_size"] = buf_size
+    sst.merlin._params["output_buf_size"] = buf_size
+
+    sst.merlin._params["xbar_arb"] = "merlin.xbar_arb_lru"
+
+    sst.merlin._params["portcontrol.credit_batch_window"] = credit_batch_window
+
+    topo.prepParams()
+    endPoint.prepParams()
+    topo.setEndPoint(endPoint)
+    topo.build()
+
+    sst.setStatisticLoadLevel(1)
+    sst.setStatisticOutput("sst.statOutputConsole")
+    sst.enableStatisticForComponentType("merlin.hr_router", "credit_event_count", {"type":"sst.AccumulatorStatistic","rate":"0ns"})
@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2023 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2023, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+import sys,getopt
+from sst.merlin import *
+
+if __name__ == "__main__":
+
+    # --arb picks the crossbar arbiter, --fast_forward=false gives the
+    # cycle by cycle run the fast forwarded one is compared against,
+    # --stats reports the routers' fast_forward statistic
+    arb = "merlin.xbar_arb_lru"
+    fast_forward = "true"
+    stats = False
+    opts, args = getopt.getopt(sys.argv[1:], "", ["arb=","fast_forward=","stats"])
+    for o, a in opts:
+        if o == "--arb":
+            arb = a
+        elif o == "--fast_forward":
+            fast_forward = a
+        elif o == "--stats":
+            stats = True
+    topo = topoTorus()
+    endPoint = TestEndPoint()
+
+
+    sst.merlin._params["torus.shape"] = "4x4x4"
+    sst.merlin._params["torus.width"] = "1x1x1"
+    sst.merlin._params["torus.local_ports"] = "1"
+    sst.merlin._params["num_dims"] = "3"
+
+
+    sst.merlin._params["link_bw"] = "4GB/s"
+    sst.merlin._params["link_lat"] = "20ns"
+    sst.merlin._params["flit_size"] = "8B"
+    sst.merlin._params["xbar_bw"] = "4GB/s"
+    sst.merlin._params["input_latency"] = "20ns"
+    sst.merlin._params["output_latency"] = "20ns"
+    sst.merlin._params["input_buf_size"] = "4kB"
+    sst.merlin._params["output_buf_size"] = "4kB"
+
+    #sst.merlin._params["checkerboard"] = "1"
+    sst.merlin._params["xbar_arb"] = arb
+
+    # Same network as torus_64_test, but with crossbar fast forwarding
+    # turned on.  Output must match the cycle by cycle reference.
+    sst.merlin._params["fast_forward"] = fast_forward
+
+    topo.prepParams()
+    endPoint.prepParams()
+    topo.setEndPoint(endPoint)
+    topo.build()
+
+    if stats:
+        sst.setStatisticLoadLevel(1)
+        sst.setStatisticOutput("sst.statOutputConsole")
+        sst.enableStatisticForComponentType("merlin.hr_router", "fast_forward", {"type":"sst.AccumulatorStatistic","rate":"0ns"})
+
+    #sst.setStatisticLoadLevel(9)
+
+    #sst.setStatisticOutput("sst.statOutputCSV");
+    #sst.setStatisticOutputOptions({
+    #    "filepath" : "stats.csv",
+    #    "separator" : ", "
+    #})
+
+    #endPoint.enableAllStatistics("0ns")
+
+    #sst.enableAllStatisticsForComponentType("merlin.hr_router", {"type":"sst.AccumulatorStatistic","rate":"0ns"})
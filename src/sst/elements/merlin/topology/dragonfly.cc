@@ -269,6 +269,8 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
 
     bool config_failed_links = p.find<bool>("config_failed_links","false");
 
+    precompute_routes = p.find<bool>("precompute_routes","false");
+
     // Set up the RouteToGroup object
 
     if ( rtr_id == 0 ) {
@@ -1123,6 +1125,12 @@ int32_t topo_dragonfly::router_to_group(uint32_t group)
 
 int32_t topo_dragonfly::hops_to_router(uint32_t group, uint32_t router, uint32_t slice)
 {
+    if ( precompute_routes ) {
+        if ( group_routes.empty() ) build_group_routes();
+        const GroupRoute& route = group_routes[group * params.n + slice];
+        return 1 + (route.local ? 0 : 1) + (route.remote_router != router ? 1 : 0);
+    }
+
     int hops = 1;
     const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,slice);
     if ( pair.router != router_id ) hops++;
@@ -1133,6 +1141,32 @@ int32_t topo_dragonfly::hops_to_router(uint32_t group, uint32_t router, uint32_t
 
 /* returns local router port if group can't be reached from this router */
 int32_t topo_dragonfly::port_for_group(uint32_t group, uint32_t global_slice, uint32_t local_slice)
+{
+    if ( !precompute_routes ) return port_for_group_lookup(group, global_slice, local_slice);
+
+    if ( group_routes.empty() ) build_group_routes();
+    const GroupRoute& route = group_routes[group * params.n + global_slice];
+    if ( route.port == -1 || route.local ) return route.port;
+    return route.port + local_slice;
+}
+
+void topo_dragonfly::build_group_routes()
+{
+    group_routes.resize(params.g * params.n, GroupRoute{-1, false, 0});
+    for ( uint32_t group = 0; group < params.g; group++ ) {
+        // No global links to our own group
+        if ( group == group_id ) continue;
+        for ( uint32_t slice = 0; slice < params.n; slice++ ) {
+            GroupRoute& route = group_routes[group * params.n + slice];
+            const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,slice);
+            route.port = port_for_group_lookup(group, slice, 0);
+            route.local = (pair.router == router_id);
+            route.remote_router = group_to_global_port.getRouterPortPairForGroup(group, group_id, slice).router;
+        }
+    }
+}
+
+int32_t topo_dragonfly::port_for_group_lookup(uint32_t group, uint32_t global_slice, uint32_t local_slice)
 {
     const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,global_slice);
     if ( group_to_global_port.isFailedPort(pair) ) {
@@ -212,6 +212,7 @@ public:
         {"global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
         {"config_failed_links",   "Controls whether or not failed links are considered","False"},
         {"failed_links",          "List of global links to mark as failed.  Only needs to be passed to router 0. Format is \"group1:group2:slice\"",""},
+        {"precompute_routes",     "Cache the port and landing router for every (group, global slice) pair on first use instead of looking them up per packet","False"},
     )
 
     enum RouteAlgo {
@@ -244,6 +245,17 @@ public:
 
     global_route_mode_t global_route_mode;
 
+    // Per-router cache of port_for_group() and hops_to_router()
+    // lookups, indexed by group * params.n + global_slice.  Built on
+    // first use so that failed links are known.
+    struct GroupRoute {
+        int32_t port;           // -1 if the link is failed
+        bool local;             // global link is on this router, port is not a local router port
+        uint32_t remote_router; // router the global link lands on in the other group
+    };
+    bool precompute_routes;
+    std::vector<GroupRoute> group_routes;
+
 public:
     struct dgnflyAddr {
         uint32_t group;
@@ -284,6 +296,8 @@ private:
     int32_t router_to_group(uint32_t group);
     int32_t port_for_router(uint32_t router, int local_slice);
     int32_t port_for_group(uint32_t group, uint32_t global_slice, uint32_t local_slice);
+    int32_t port_for_group_lookup(uint32_t group, uint32_t global_slice, uint32_t local_slice);
+    void build_group_routes();
     int32_t port_for_group_init(uint32_t group, uint32_t global_slice);
     int32_t hops_to_router(uint32_t group, uint32_t router, uint32_t slice);
 
@@ -56,12 +56,29 @@ topo_polarfly::topo_polarfly(ComponentId_t cid, Params& params, int num_ports, i
         output.fatal(CALL_INFO, -1, "Number of ports should be at least %d for this configuration\n", total_radix);
     }
 
-    /* first generate the polar graph, so that we can get the number of
-     nodes and links to set the globals */
-    initPolarGraph();
+    shared_tables       = params.find<bool>("shared_route_table", false);
+
+    if (shared_tables) {
+        /* Router 0 reads the graph and builds the tables for every router,
+         the rest attach to them once construction is complete */
+        if (router_id == 0) {
+            initPolarGraph();
+            shared_routes.init_write("polarfly_", polar);
+            std::vector<std::vector<int>> tmp;
+            polar.swap(tmp);
+        }
+        else {
+            shared_routes.init("polarfly_", total_routers);
+        }
+    }
+    else {
+        /* first generate the polar graph, so that we can get the number of
+         nodes and links to set the globals */
+        initPolarGraph();
 
-    /* Initialize the routing table*/
-    initRouteTable();
+        /* Initialize the routing table*/
+        initRouteTable();
+    }
 
     /* Initialize the hopcount_map statistic
      * For now, doing it in a dumb way, should figure out an error-free way to create a vector array of statistics*/
@@ -92,14 +109,10 @@ topo_polarfly::setOutputQueueLengthsArray(int const* array, int vcs)
     assert(vcs==num_vcs);
 }
 
+//node is adjacent iff the first hop of the minimal path to it is node itself
 bool topo_polarfly::isNeighbor(int node)
 {
-    for (int i=0; i<node_links; i++)
-    {
-        if (neighbor_list[i]==node)
-            return true;
-    }
-    return false;
+    return neighbor(minimalPort(node)) == node;
 }
 
 void topo_polarfly::route_packet(int port, int vc, internal_router_event* ev){
@@ -130,7 +143,7 @@ void topo_polarfly::routeMinimal(int port, int vc, internal_router_event* ev){
         tt_ev->setVC(0);
     }
     else{
-        out_channel = route_table[dest_node] + hosts_per_router;
+        out_channel = minimalPort(dest_node) + hosts_per_router;
 
         if (tt_ev->hop_count == 0)
             tt_ev->setVC(0);
@@ -174,7 +187,7 @@ void topo_polarfly::routeValiant(int port, int vc, internal_router_event* ev){
         //First check if the packet originated here and //If yes, take the valiant path
         if ((source_node == router_id) && (tt_ev->hop_count == 0) )
         {
-            minimal_channel = route_table[dest_node];
+            minimal_channel = minimalPort(dest_node);
 
             int valiant;
             //Randomly select one neighbor from the neighborhood
@@ -187,7 +200,7 @@ void topo_polarfly::routeValiant(int port, int vc, internal_router_event* ev){
             tt_ev->valiant      = valiant;
             tt_ev->non_minimal  = true;
 
-            out_channel         = route_table[valiant] + hosts_per_router;
+            out_channel         = minimalPort(valiant) + hosts_per_router;
 
             tt_ev->setNextPort(out_channel);
             tt_ev->setVC(0);
@@ -196,7 +209,7 @@ void topo_polarfly::routeValiant(int port, int vc, internal_router_event* ev){
         //if you've reached the intermediate valiant node, proceed to destination along the shortest path
         else if (tt_ev->valiant==router_id || (!tt_ev->non_minimal))
         {
-            minimal_channel     = route_table[dest_node];
+            minimal_channel     = minimalPort(dest_node);
             tt_ev->non_minimal  = false;
             out_channel         = minimal_channel + hosts_per_router;
 
@@ -208,7 +221,7 @@ void topo_polarfly::routeValiant(int port, int vc, internal_router_event* ev){
         //If the current router is not where the packet started, first check the minimal path
         else 
         {
-            minimal_channel     = route_table[tt_ev->valiant];
+            minimal_channel     = minimalPort(tt_ev->valiant);
             out_channel         = minimal_channel + hosts_per_router;
 
             tt_ev->setNextPort(out_channel);
@@ -380,10 +393,10 @@ void topo_polarfly::routeUntimedData(int port, internal_router_event* ev, std::v
             }
 
             // Also send to the adjacent neighbors
-            for (int j=0; j < node_links; j++)
+            for (int j=0; j < neighborCount(); j++)
             {
                 outPorts.push_back(j + hosts_per_router);
-                tt_ev->covered[neighbor_list[j]]   = 1;
+                tt_ev->covered[neighbor(j)]   = 1;
             }
 
             //Increment the phase value
@@ -392,13 +405,13 @@ void topo_polarfly::routeUntimedData(int port, internal_router_event* ev, std::v
         else if (tt_ev->phase < 2)
         {
             // ensure that broadcast reaches all the endpoints only once
-            for (int j=0; j<node_links; j++)
+            for (int j=0; j<neighborCount(); j++)
             {
-                int neighbor    = neighbor_list[j];
-                if (tt_ev->covered[neighbor]==0)
+                int nbr         = neighbor(j);
+                if (tt_ev->covered[nbr]==0)
                 {
                     outPorts.push_back(j + hosts_per_router);
-                    tt_ev->covered[neighbor]    = 1;
+                    tt_ev->covered[nbr]    = 1;
                 }
             }
             tt_ev->phase    += 1;
@@ -535,7 +548,7 @@ void topo_polarfly::routeUgal(int port, int vc, internal_router_event* ev){
     else if (port < hosts_per_router)
     {
         //minpath details
-        int min_channel = route_table[dest_node] + hosts_per_router;
+        int min_channel = minimalPort(dest_node) + hosts_per_router;
         int min_queue   = output_queue_lengths[min_channel*num_vcs + out_vc];
 
         //find valiant intermediate node
@@ -549,7 +562,7 @@ void topo_polarfly::routeUgal(int port, int vc, internal_router_event* ev){
             {
                 candidate   = rng->generateNextUInt32() % total_routers;
             } while(candidate == router_id);
-            int candidate_channel   = route_table[candidate] + hosts_per_router;
+            int candidate_channel   = minimalPort(candidate) + hosts_per_router;
             int candidate_queue     = output_queue_lengths[candidate_channel*num_vcs + out_vc];
             if (val_queue > candidate_queue)
             {
@@ -575,14 +588,14 @@ void topo_polarfly::routeUgal(int port, int vc, internal_router_event* ev){
     }
     else if ((tt_ev->valiant == router_id && tt_ev->non_minimal) || (!tt_ev->non_minimal))
     {
-        out_channel         = route_table[dest_node] + hosts_per_router;
+        out_channel         = minimalPort(dest_node) + hosts_per_router;
         out_vc              = vc + 1;
         tt_ev->non_minimal  = false;
         assert(tt_ev->hop_count < 4);
     }
     else
     {
-        out_channel         = route_table[tt_ev->valiant] + hosts_per_router;
+        out_channel         = minimalPort(tt_ev->valiant) + hosts_per_router;
         out_vc              = vc + 1;
         assert(tt_ev->hop_count < 3);
     }
@@ -621,7 +634,7 @@ void topo_polarfly::routeUgalpf(int port, int vc, internal_router_event* ev){
         bool adj_dst    = isNeighbor(dest_node);
 
         //minpath details
-        int min_channel = route_table[dest_node] + hosts_per_router;
+        int min_channel = minimalPort(dest_node) + hosts_per_router;
         int min_queue   = output_queue_lengths[min_channel*num_vcs + out_vc];
 
         //find valiant intermediate node
@@ -638,9 +651,9 @@ void topo_polarfly::routeUgalpf(int port, int vc, internal_router_event* ev){
                     candidate   = rng->generateNextUInt32() % total_routers;
                 //choose a valiant from your neighborhood
                 else
-                    candidate   = neighbor_list[rng->generateNextUInt32() % node_links];
+                    candidate   = neighbor(rng->generateNextUInt32() % neighborCount());
             } while(candidate == router_id);
-            int candidate_channel   = route_table[candidate] + hosts_per_router;
+            int candidate_channel   = minimalPort(candidate) + hosts_per_router;
             int candidate_queue     = output_queue_lengths[candidate_channel*num_vcs + out_vc];
             if (val_queue > candidate_queue)
             {
@@ -666,14 +679,14 @@ void topo_polarfly::routeUgalpf(int port, int vc, internal_router_event* ev){
     }
     else if ((tt_ev->valiant == router_id && tt_ev->non_minimal) || (!tt_ev->non_minimal))
     {
-        out_channel         = route_table[dest_node] + hosts_per_router;
+        out_channel         = minimalPort(dest_node) + hosts_per_router;
         out_vc              = vc + 1;
         tt_ev->non_minimal  = false;
         assert(tt_ev->hop_count < 4);
     }
     else
     {
-        out_channel         = route_table[tt_ev->valiant] + hosts_per_router;
+        out_channel         = minimalPort(tt_ev->valiant) + hosts_per_router;
         out_vc              = vc + 1;
         assert(tt_ev->hop_count < 3);
     }
@@ -24,6 +24,7 @@
 #include <sstream>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/routeTable.h"
 
 
 namespace SST {
@@ -122,6 +123,7 @@ public:
         {"total_radix", "Radix of the router."},
         {"total_routers", "Number of total routers in the network."},
         {"total_endnodes", "Number of total endpoints in the network."},
+        {"shared_route_table", "Build the next-hop tables once per rank and share them read-only between routers instead of once per router.", "false"},
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -152,6 +154,9 @@ public:
     std::vector<int> route_table; //output port for each destination
     std::vector<int> neighbor_list; //all neighbors of current router
 
+    bool shared_tables; //route with the per-rank shared tables instead of route_table/neighbor_list
+    SharedRouteTable shared_routes;
+
     int num_vns;
     int num_vcs;
     RNG::Random* rng;
@@ -208,6 +213,16 @@ private:
    void initPolarGraph();
    void initRouteTable();
 
+   inline int minimalPort(int dest) const {
+       return shared_tables ? shared_routes.getNextHop(router_id, dest) : route_table[dest];
+   }
+   inline int neighborCount() const {
+       return shared_tables ? shared_routes.getNeighborCount(router_id) : node_links;
+   }
+   inline int neighbor(int index) const {
+       return shared_tables ? shared_routes.getNeighbor(router_id, index) : neighbor_list[index];
+   }
+
    int getRouterID(int endpoint);
    int getDestLocalPort(int node);
    void dumpHopCount(topo_polarfly_event* ev);
@@ -62,14 +62,32 @@ topo_polarstar::topo_polarstar(ComponentId_t cid, Params& params, int num_ports,
         output.fatal(CALL_INFO, -1, "Number of ports should be at least %d for this configuration\n", total_radix);
     }
 
-    /* first generate the polar graph, so that we can get the number of
-     nodes and links to set the globals */
-    initPolarGraph();
-    
-    assert(total_routers == polar.size());
+    shared_tables       = params.find<bool>("shared_route_table", false);
+
+    if (shared_tables) {
+        /* Router 0 reads the graph and builds the tables for every router,
+         the rest attach to them once construction is complete */
+        if (router_id == 0) {
+            initPolarGraph();
+            assert(total_routers == polar.size());
+            shared_routes.init_write("polarstar_", polar);
+            std::vector<std::vector<int>> tmp;
+            polar.swap(tmp);
+        }
+        else {
+            shared_routes.init("polarstar_", total_routers);
+        }
+    }
+    else {
+        /* first generate the polar graph, so that we can get the number of
+         nodes and links to set the globals */
+        initPolarGraph();
 
-    /* Initialize the routing table*/
-    initRouteTable();
+        assert(total_routers == polar.size());
+
+        /* Initialize the routing table*/
+        initRouteTable();
+    }
 
     /* Initialize the hopcount_map statistic
      * For now, doing it in a dumb way, should figure out an error-free way to create a vector array of statistics*/
@@ -116,7 +134,7 @@ void topo_polarstar::routeMinimal(int port, int vc, internal_router_event* ev){
         tt_ev->setVC(0);
     }
     else{
-        out_channel = route_table[dest_node] + hosts_per_router;
+        out_channel = minimalPort(dest_node) + hosts_per_router;
 
         tt_ev->setNextPort(out_channel);
 
@@ -166,7 +184,7 @@ void topo_polarstar::routeValiant(int port, int vc, internal_router_event* ev){
             tt_ev->valiant      = valiant;
             tt_ev->non_minimal  = true;
 
-            out_channel = route_table[valiant] + hosts_per_router;
+            out_channel = minimalPort(valiant) + hosts_per_router;
 
             tt_ev->setNextPort(out_channel);
             assert(tt_ev->hop_count < 1);
@@ -175,7 +193,7 @@ void topo_polarstar::routeValiant(int port, int vc, internal_router_event* ev){
         //if you've reached the intermediate valiant node, proceed to destination along the shortest path
         else if (tt_ev->valiant==router_id || (!tt_ev->non_minimal))
         {
-            minimal_channel     = route_table[dest_node];
+            minimal_channel     = minimalPort(dest_node);
             tt_ev->non_minimal  = false;
             out_channel         = minimal_channel + hosts_per_router;
             tt_ev->setNextPort(out_channel); 
@@ -186,7 +204,7 @@ void topo_polarstar::routeValiant(int port, int vc, internal_router_event* ev){
         //If the current router is not where the packet started, first check the minimal path
         else {
 
-            minimal_channel     = route_table[tt_ev->valiant];
+            minimal_channel     = minimalPort(tt_ev->valiant);
             out_channel         = minimal_channel + hosts_per_router;
 
             tt_ev->setNextPort(out_channel);
@@ -225,7 +243,7 @@ void topo_polarstar::routeUgal(int port, int vc, internal_router_event* ev){
     else if (port < hosts_per_router)
     {
         //minpath details
-        int min_channel = route_table[dest_node] + hosts_per_router;
+        int min_channel = minimalPort(dest_node) + hosts_per_router;
         int min_queue   = output_queue_lengths[min_channel*num_vcs + out_vc];
 
         //find valiant intermediate node
@@ -238,7 +256,7 @@ void topo_polarstar::routeUgal(int port, int vc, internal_router_event* ev){
             do
             {
                 candidate   = rng->generateNextUInt32() % total_routers;
-                candidate_channel   = route_table[candidate] + hosts_per_router;
+                candidate_channel   = minimalPort(candidate) + hosts_per_router;
             } while((candidate == router_id) || (candidate_channel == min_channel));
             int candidate_queue     = output_queue_lengths[candidate_channel*num_vcs + out_vc];
             if (val_queue > candidate_queue)
@@ -266,13 +284,13 @@ void topo_polarstar::routeUgal(int port, int vc, internal_router_event* ev){
     }
     else if ((tt_ev->valiant == router_id && tt_ev->non_minimal) || (!tt_ev->non_minimal))
     {
-        out_channel         = route_table[dest_node] + hosts_per_router;
+        out_channel         = minimalPort(dest_node) + hosts_per_router;
         tt_ev->non_minimal  = false;
         assert(tt_ev->hop_count < 6);
     }
     else
     {
-        out_channel         = route_table[tt_ev->valiant] + hosts_per_router;
+        out_channel         = minimalPort(tt_ev->valiant) + hosts_per_router;
         assert(tt_ev->hop_count < 3);
     }
 
@@ -394,7 +412,8 @@ void topo_polarstar::initRouteTable() {
 Topology::PortState topo_polarstar::getPortState(int port) const
 {
     if (port < hosts_per_router) return R2N;
-    else if (port >= hosts_per_router && port <= hosts_per_router + node_links) return R2R;
+    //shared tables are not readable until construction completes, so fall back on the configured radix
+    else if (port >= hosts_per_router && port <= hosts_per_router + (shared_tables ? network_radix : node_links)) return R2R;
     else return UNCONNECTED; 
 }
 
@@ -512,10 +531,10 @@ void topo_polarstar::routeUntimedData(int port, internal_router_event* ev, std::
             }
 
             // Also send to the adjacent neighbors
-            for (int j=0; j < node_links; j++) {
+            for (int j=0; j < neighborCount(); j++) {
 
                 outPorts.push_back(j+hosts_per_router);
-                tt_ev->covered[neighbor_list[j]]    = 1; 
+                tt_ev->covered[neighbor(j)]    = 1; 
             }
 
             //Increment the phase value
@@ -524,12 +543,12 @@ void topo_polarstar::routeUntimedData(int port, internal_router_event* ev, std::
 
         else if (tt_ev->phase < 3) {
             //Send to all the adjacent routers that have not received
-            for (int j=0; j < node_links; j++) {
-                int neighbor    = neighbor_list[j];
-                if (tt_ev->covered[neighbor]==0)
+            for (int j=0; j < neighborCount(); j++) {
+                int nbr         = neighbor(j);
+                if (tt_ev->covered[nbr]==0)
                 {
                     outPorts.push_back(j+hosts_per_router);
-                    tt_ev->covered[neighbor]    = 1;
+                    tt_ev->covered[nbr]    = 1;
                 }
             }
             tt_ev->phase    += 1;
@@ -23,6 +23,7 @@
 #include <sstream>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/routeTable.h"
 
 namespace SST {
 namespace Merlin {
@@ -122,6 +123,7 @@ public:
         {"total_radix", "Radix of the router."},
         {"total_routers", "Number of total routers in the network."},
         {"total_endnodes", "Number of total endpoints in the network."},
+        {"shared_route_table", "Build the next-hop tables once per rank and share them read-only between routers instead of once per router.", "false"},
     )
     SST_ELI_DOCUMENT_STATISTICS(
         { "hopcount1",     "Number of packets with 1 switch hopcount", "hops", 0},
@@ -155,6 +157,9 @@ public:
     std::vector<int> route_table;
     std::vector<int> neighbor_list;
 
+    bool shared_tables; //route with the per-rank shared tables instead of route_table/neighbor_list
+    SharedRouteTable shared_routes;
+
     int num_vns;
     int num_vcs;
     RNG::Random* rng;
@@ -214,6 +219,16 @@ private:
    void initPolarGraph();
    void initRouteTable();
 
+   inline int minimalPort(int dest) const {
+       return shared_tables ? shared_routes.getNextHop(router_id, dest) : route_table[dest];
+   }
+   inline int neighborCount() const {
+       return shared_tables ? shared_routes.getNeighborCount(router_id) : node_links;
+   }
+   inline int neighbor(int index) const {
+       return shared_tables ? shared_routes.getNeighbor(router_id, index) : neighbor_list[index];
+   }
+
    int getRouterID(int endpoint);
    int getDestLocalPort(int node);
    void dumpHopCount(topo_polarstar_event* ev);
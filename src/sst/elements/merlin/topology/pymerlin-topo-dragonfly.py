@@ -26,7 +26,7 @@ class topoDragonFly(Topology):
         self._declareClassVariables(["link_latency","host_link_latency","global_link_map"])
         self._declareParams("main",["hosts_per_router","routers_per_group","intergroup_links","intragroup_links",
                                     "num_groups","algorithm","adaptive_threshold","global_routes",
-                                    "config_failed_links","failed_links"])
+                                    "config_failed_links","failed_links","precompute_routes"])
         self.global_routes = "absolute"
         self._subscribeToPlatformParamSet("topology")
         self.intragroup_links = 1
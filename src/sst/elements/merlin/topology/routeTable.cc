@@ -0,0 +1,108 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#include <sst_config.h>
+
+#include "merlin.h"
+#include "routeTable.h"
+
+using namespace SST::Merlin;
+
+const uint16_t SharedRouteTable::NO_ROUTE;
+
+void
+SharedRouteTable::init_write(const std::string& basename, const std::vector<std::vector<int> >& graph)
+{
+    routers = graph.size();
+
+    // Adjacency lists
+    size_t total_links = 0;
+    for ( size_t i = 0; i < routers; i++ ) total_links += graph[i].size();
+
+    offsets.initialize(basename + "neighbor_offsets", routers + 1, 0, Shared::SharedObject::NO_VERIFY);
+    neighbors.initialize(basename + "neighbors", total_links, -1, Shared::SharedObject::NO_VERIFY);
+
+    int index = 0;
+    for ( size_t i = 0; i < routers; i++ ) {
+        if ( graph[i].size() >= NO_ROUTE ) {
+            merlin_abort.fatal(CALL_INFO, 1, "Router %zu has %zu links, route table supports at most %d\n",
+                               i, graph[i].size(), NO_ROUTE - 1);
+        }
+        offsets.write(i, index);
+        for ( size_t j = 0; j < graph[i].size(); j++ ) {
+            neighbors.write(index++, graph[i][j]);
+        }
+    }
+    offsets.write(routers, index);
+
+    // Breadth first search from every router.  The first hop of each
+    // path is inherited from the node it was discovered through.
+    next_hop.initialize(basename + "next_hop", routers * routers, NO_ROUTE, Shared::SharedObject::NO_VERIFY);
+
+    std::vector<uint16_t> row(routers);
+    std::vector<int> frontier;
+    std::vector<int> next;
+    for ( size_t src = 0; src < routers; src++ ) {
+        std::fill(row.begin(), row.end(), NO_ROUTE);
+        frontier.clear();
+
+        for ( size_t j = 0; j < graph[src].size(); j++ ) {
+            int neighbor = graph[src][j];
+            if ( row[neighbor] == NO_ROUTE && neighbor != (int)src ) {
+                row[neighbor] = j;
+                frontier.push_back(neighbor);
+            }
+        }
+        while ( !frontier.empty() ) {
+            for ( size_t i = 0; i < frontier.size(); i++ ) {
+                int v = frontier[i];
+                for ( size_t j = 0; j < graph[v].size(); j++ ) {
+                    int neighbor = graph[v][j];
+                    if ( row[neighbor] == NO_ROUTE && neighbor != (int)src ) {
+                        row[neighbor] = row[v];
+                        next.push_back(neighbor);
+                    }
+                }
+            }
+            frontier.swap(next);
+            next.clear();
+        }
+
+        for ( size_t dest = 0; dest < routers; dest++ ) {
+            if ( dest != src && row[dest] == NO_ROUTE ) {
+                merlin_abort.fatal(CALL_INFO, 1, "Router graph is not connected: no route from router %zu to router %zu\n", src, dest);
+            }
+            next_hop.write(src * routers + dest, row[dest]);
+        }
+    }
+
+    offsets.publish();
+    neighbors.publish();
+    next_hop.publish();
+}
+
+void
+SharedRouteTable::init(const std::string& basename, size_t num_routers)
+{
+    routers = num_routers;
+
+    offsets.initialize(basename + "neighbor_offsets");
+    offsets.publish();
+    neighbors.initialize(basename + "neighbors");
+    neighbors.publish();
+    next_hop.initialize(basename + "next_hop");
+    next_hop.publish();
+}
@@ -0,0 +1,83 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
+#define COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
+
+#include <sst/core/shared/sharedArray.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+// Next-hop table for topologies built from an arbitrary router graph
+// (polarfly, polarstar).  One router on each rank computes shortest
+// path next hops between every pair of routers and publishes them,
+// along with the adjacency lists, through SharedArrays.  The other
+// routers attach to the same arrays read-only, so the graph is read
+// and searched once per rank instead of once per router.
+//
+// Next hops are stored as the index of the neighbor in the source
+// router's adjacency list, which is also the network port offset.
+// Ties are broken the same way the per-router tables did: in BFS
+// order starting from the lowest numbered neighbor.
+//
+// The arrays are only guaranteed to be filled in once construction
+// is complete, so they must not be read from a constructor.
+class SharedRouteTable {
+private:
+    Shared::SharedArray<uint16_t> next_hop;   // routers x routers
+    Shared::SharedArray<int> offsets;         // routers + 1, start of each router's neighbors
+    Shared::SharedArray<int> neighbors;       // concatenated adjacency lists
+    size_t routers;
+
+public:
+    static const uint16_t NO_ROUTE = 0xffff;
+
+    SharedRouteTable() : routers(0) {}
+
+    // Called by exactly one router per rank
+    void init_write(const std::string& basename, const std::vector<std::vector<int> >& graph);
+    // Called by all other routers
+    void init(const std::string& basename, size_t num_routers);
+
+    inline int getNextHop(int src, int dest) const {
+        return next_hop[(size_t)src * routers + dest];
+    }
+
+    inline int getNeighborCount(int src) const {
+        return offsets[src + 1] - offsets[src];
+    }
+
+    inline int getNeighbor(int src, int index) const {
+        return neighbors[offsets[src] + index];
+    }
+
+    // dest is one hop away if the first hop towards it is dest itself
+    inline bool isNeighbor(int src, int dest) const {
+        int hop = getNextHop(src, dest);
+        return hop != NO_ROUTE && getNeighbor(src, hop) == dest;
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
@@ -39,6 +39,7 @@ MMU::MMU(SST::ComponentId_t id, SST::Params& params) : SubComponent(id), m_nicTl
         m_dbg.fatal(CALL_INFO, -1, "Error: %s, page_size is zero\n",getName().c_str());
     }
     m_pageShift = log2( pageSize );
+    m_nsTimeConverter = getTimeConverter("1ns");
 
     auto useNicTlb = params.find<bool>("useNicTlb",false);
 
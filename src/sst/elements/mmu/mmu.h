@@ -64,14 +64,15 @@ class MMU : public SubComponent {
 
   protected:
 
-    void sendEvent( int link, Event* ev ) {
+    // delay is in ns
+    void sendEvent( int link, Event* ev, SimTime_t delay = 0 ) {
         if ( -1 == link ) {
             assert( m_nicTlbLink );
-            m_nicTlbLink->send(0,ev);
+            m_nicTlbLink->send(delay,m_nsTimeConverter,ev);
         } else if ( 0 == link % 2 ) {
-            m_coreLinks[link/2]->dtlb->send(0,ev);
+            m_coreLinks[link/2]->dtlb->send(delay,m_nsTimeConverter,ev);
         } else if ( 1 == link % 2 ) {
-            m_coreLinks[link/2]->itlb->send(0,ev);
+            m_coreLinks[link/2]->itlb->send(delay,m_nsTimeConverter,ev);
         } else {
             assert(0);
         }
@@ -119,6 +120,7 @@ class MMU : public SubComponent {
     };
     std::vector<CoreTlbLinks*> m_coreLinks;
     Link*   m_nicTlbLink;
+    TimeConverter* m_nsTimeConverter;
     Callback m_permissionsCallback;
 };
 
@@ -0,0 +1,122 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef PAGE_TABLE_H
+#define PAGE_TABLE_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "mmuTypes.h"
+
+namespace SST {
+
+namespace MMU_Lib {
+
+// Open addressed hash of vpn to PTE, kept in flat arrays so a dup() is a straight copy.
+// Erase shifts the following entries of the probe run back instead of leaving tombstones.
+class PageTable {
+  public:
+    PageTable() : m_count(0), m_slots(64) {}
+
+    void add( uint32_t vpn, PTE pte ) { 
+        if ( ( m_count + 1 ) * 4 > m_slots.size() * 3 ) {
+            grow();
+        }
+        Slot& slot = m_slots[ findSlot( vpn ) ];
+        if ( ! slot.used ) {
+            slot.used = true;
+            slot.vpn = vpn;
+            ++m_count;
+        }
+        slot.pte = pte;
+    }
+    void remove( uint32_t vpn ) { 
+        size_t pos = findSlot( vpn );
+        if ( ! m_slots[pos].used ) {
+            return;
+        }
+        size_t mask = m_slots.size() - 1;
+        size_t next = ( pos + 1 ) & mask;
+        while ( m_slots[next].used ) {
+            size_t home = hash( m_slots[next].vpn ) & mask;
+            if ( ( ( next - home ) & mask ) >= ( ( next - pos ) & mask ) ) {
+                m_slots[pos] = m_slots[next];
+                pos = next;
+            }
+            next = ( next + 1 ) & mask;
+        }
+        m_slots[pos].used = false;
+        --m_count;
+    }
+    size_t size() const { return m_count; }
+    PTE* find( uint32_t vpn ) {
+        Slot& slot = m_slots[ findSlot( vpn ) ];
+        return slot.used ? &slot.pte : nullptr;
+    }
+    void removeWrite(  ) { 
+        for ( auto& slot : m_slots ) {
+            if ( slot.used ) {
+                slot.pte.perms &= ~0x2;
+            }
+        }
+    }
+    void print( const std::string str) {
+        for ( auto& slot : m_slots ) {
+            if ( slot.used ) {
+                printf("PageTabl::%s() %s vpn=%d ppn=%d perm=%#x\n",__func__,str.c_str(),slot.vpn,slot.pte.ppn,slot.pte.perms);
+            }
+        }
+    }
+  private:
+    struct Slot {
+        Slot() : used(false), vpn(0) {}
+        bool used;
+        uint32_t vpn;
+        PTE pte;
+    };
+
+    static size_t hash( uint32_t vpn ) {
+        return ( vpn * 0x9E3779B1u ) ^ ( vpn >> 16 );
+    }
+
+    size_t findSlot( uint32_t vpn ) {
+        size_t mask = m_slots.size() - 1;
+        size_t pos = hash( vpn ) & mask;
+        while ( m_slots[pos].used && m_slots[pos].vpn != vpn ) {
+            pos = ( pos + 1 ) & mask;
+        }
+        return pos;
+    }
+
+    void grow() {
+        std::vector<Slot> old( m_slots.size() * 2 );
+        old.swap( m_slots );
+        for ( auto& slot : old ) {
+            if ( slot.used ) {
+                m_slots[ findSlot( slot.vpn ) ] = slot;
+            }
+        }
+    }
+
+    size_t m_count;
+    std::vector<Slot> m_slots;
+};
+
+} //namespace MMU_Lib
+} //namespace SST
+
+#endif /* PAGE_TABLE_H */
@@ -21,7 +21,7 @@
 using namespace SST;
 using namespace SST::MMU_Lib;
 
-SimpleMMU::SimpleMMU(SST::ComponentId_t id, SST::Params& params) : MMU(id,params)
+SimpleMMU::SimpleMMU(SST::ComponentId_t id, SST::Params& params) : MMU(id,params), m_sharedTlb(nullptr), m_walkCache(nullptr)
 {
     char buffer[100];
     snprintf(buffer,100,"@t:SimpleMMU::@p():@l ");
@@ -35,6 +35,39 @@ SimpleMMU::SimpleMMU(SST::ComponentId_t id, SST::Params& params) : MMU(id,params
     for ( unsigned i = 0; i < m_coreToPid.size(); i++ ) {
         m_coreToPid[i].resize( m_numHwThreads, -1 );
     }
+
+    m_hardwareWalk = params.find<bool>("hardware_walk", false);
+    m_pageTableLevels = params.find<int>("page_table_levels", 4);
+    m_walkLatency = params.find<SimTime_t>("walk_latency", 0);
+    m_sharedTlbLatency = params.find<SimTime_t>("shared_tlb_latency", 0);
+
+    size_t sharedTlbEntries = params.find<size_t>("shared_tlb_entries", 0);
+    size_t pwcEntries = params.find<size_t>("pwc_entries", 0);
+
+    if ( m_hardwareWalk ) {
+        if ( m_pageTableLevels < 1 ) {
+            m_dbg.fatal(CALL_INFO, -1, "Error: %s, page_table_levels must be at least 1\n",getName().c_str());
+        }
+        if ( sharedTlbEntries ) {
+            int assoc = params.find<int>("shared_tlb_assoc", 4);
+            if ( assoc < 1 || sharedTlbEntries < assoc ) {
+                m_dbg.fatal(CALL_INFO, -1, "Error: %s, shared_tlb_assoc must be between 1 and shared_tlb_entries\n",getName().c_str());
+            }
+            m_sharedTlb = new TranslationCache( sharedTlbEntries, assoc );
+        }
+        if ( pwcEntries ) {
+            int assoc = params.find<int>("pwc_assoc", 4);
+            if ( assoc < 1 || pwcEntries < assoc ) {
+                m_dbg.fatal(CALL_INFO, -1, "Error: %s, pwc_assoc must be between 1 and pwc_entries\n",getName().c_str());
+            }
+            m_walkCache = new PageWalkCache( m_pageTableLevels, 9, pwcEntries, assoc );
+        }
+    }
+    m_dbg.debug(CALL_INFO_LONG,1,0,"hardwareWalk=%d sharedTlbEntries=%zu pwcEntries=%zu\n",m_hardwareWalk,sharedTlbEntries,pwcEntries);
+
+    statHardwareWalks = registerStatistic<uint64_t>("hardware_walks");
+    statSharedTlbHits = registerStatistic<uint64_t>("shared_tlb_hits");
+    statWalkReferences = registerStatistic<uint64_t>("walk_references");
 }
 
 void SimpleMMU::handleNicTlbEvent( Event* ev ) 
@@ -81,10 +114,62 @@ void SimpleMMU::handleTlbEvent( Event* ev, int link )
         link,getTlbName(link).c_str(),core,hwThread,pid,req->getVPN(),req->getPerms());
     
     m_dbg.debug(CALL_INFO_LONG,1,0,"reqId=%" PRIu64 " hwTHread=%d vpn=%zu %#" PRIx64 "\n", req->getReqId(), req->getHardwareThread(), req->getVPN(), (uint64_t) req->getVPN() << 12  );
+
+    PTE pte;
+    SimTime_t latency;
+    if ( m_hardwareWalk && hardwareWalk( pid, req->getVPN(), req->getPerms(), pte, latency ) ) {
+        m_dbg.debug(CALL_INFO_LONG,1,0,"hardware walk vpn=%zu ppn=%d latency=%" PRIu64 "\n", req->getVPN(), pte.ppn, latency );
+        sendEvent( link, new TlbFillEvent( req->getReqId(), pte ), latency );
+        delete ev;
+        return;
+    }
+
     m_permissionsCallback( req->getReqId(), link, core, hwThread, pid, req->getVPN(), req->getPerms(), req->getInstPtr(), req->getMemAddr() );
     delete ev;
 }
 
+// Resolve a TLB miss without involving the OS. Only a page that is present with the wanted
+// permissions can be filled this way, everything else (demand paging, COW, bad accesses)
+// still goes through the permissions callback.
+bool SimpleMMU::hardwareWalk( unsigned pid, uint32_t vpn, uint32_t perms, PTE& pte, SimTime_t& latency )
+{
+    latency = m_sharedTlbLatency;
+
+    // the OS is still filling this page, wait behind its fault
+    if ( m_faultsInFlight.count( std::make_pair( pid, vpn ) ) ) {
+        return false;
+    }
+
+    PTE* entry = nullptr;
+    if ( m_sharedTlb && ( entry = m_sharedTlb->find( pid, vpn ) ) ) {
+        statSharedTlbHits->addData(1);
+    } else {
+        auto pageTable = getPageTable( pid );
+        if ( nullptr == pageTable ) {
+            return false;
+        }
+
+        int refs = m_walkCache ? m_walkCache->walk( pid, vpn ) : m_pageTableLevels;
+        statWalkReferences->addData(refs);
+        latency += refs * m_walkLatency;
+
+        if ( nullptr == ( entry = pageTable->find( vpn ) ) ) {
+            return false;
+        }
+        if ( m_sharedTlb ) {
+            m_sharedTlb->insert( pid, vpn, *entry );
+        }
+    }
+
+    if ( ! checkPerms( perms, entry->perms ) ) {
+        return false;
+    }
+
+    statHardwareWalks->addData(1);
+    pte = *entry;
+    return true;
+}
+
 void SimpleMMU::map( unsigned pid, uint32_t vpn, uint32_t ppn, int pageSize, uint64_t flags ) 
 {
     m_dbg.debug(CALL_INFO_LONG,1,0,"pid=%d vpn=%d ppn=%d pageSize=%d flags=%#" PRIx64 "\n", pid, vpn, ppn, pageSize, flags );
@@ -92,6 +177,13 @@ void SimpleMMU::map( unsigned pid, uint32_t vpn, uint32_t ppn, int pageSize, uin
     assert( pageTable );
 
     pageTable->add( vpn, PTE( ppn, flags ) );
+    if ( m_sharedTlb ) {
+        m_sharedTlb->invalidate( pid, vpn );
+    }
+    // a map made outside of a fault (e.g. writeMem) stays in flight until a fault on the page completes
+    if ( m_hardwareWalk ) {
+        m_faultsInFlight.insert( std::make_pair( pid, vpn ) );
+    }
 }
 
 void SimpleMMU::map( unsigned pid, uint32_t vpn, std::vector<uint32_t>& ppns, int pageSize, uint64_t flags ) {
@@ -106,6 +198,9 @@ void SimpleMMU::unmap( unsigned pid, uint32_t vpn, size_t numPages ) {
     assert( pageTable );
     for ( auto i = 0; i < numPages; i++ ) {
         pageTable->remove( vpn + i );
+        if ( m_sharedTlb ) {
+            m_sharedTlb->invalidate( pid, vpn + i );
+        }
     }
 }
 
@@ -114,6 +209,9 @@ void SimpleMMU::removeWrite( unsigned pid ) {
     auto table = getPageTable(pid);
     assert( table );
     table->removeWrite();
+    if ( m_sharedTlb ) {
+        m_sharedTlb->invalidate( pid );
+    }
 }
 
 void SimpleMMU::dup( unsigned fromPid, unsigned toPid ) {
@@ -130,6 +228,9 @@ void SimpleMMU::dup( unsigned fromPid, unsigned toPid ) {
 
 void SimpleMMU::flushTlb( unsigned core, unsigned hwThread ) {
     m_dbg.debug(CALL_INFO_LONG,1,0,"core=%d hwThread=%d\n",core,hwThread);
+    if ( m_sharedTlb && getPageTable( m_coreToPid[core][hwThread] ) ) {
+        m_sharedTlb->invalidate( m_coreToPid[core][hwThread] );
+    }
 //    sendEvent( getLink(core,"itlb"), new TlbFlushEvent( hwThread ) );
     sendEvent( getLink(core,"dtlb"), new TlbFlushReqEvent( hwThread ) );
     if ( m_nicTlbLink ) {
@@ -139,6 +240,8 @@ void SimpleMMU::flushTlb( unsigned core, unsigned hwThread ) {
 
 void SimpleMMU::faultHandled( RequestID requestId, unsigned link, unsigned pid, unsigned vpn, bool success ) {
 
+    m_faultsInFlight.erase( std::make_pair( pid, (uint32_t) vpn ) );
+
     if ( success ) {
         auto pageTable = getPageTable(pid);
         assert( pageTable );
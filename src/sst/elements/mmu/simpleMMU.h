@@ -17,8 +17,11 @@
 #define SIMPLE_MMU_H
 
 #include <sst/core/link.h>
+#include <set>
 #include "mmu.h"
 #include "mmuTypes.h"
+#include "pageTable.h"
+#include "walkCache.h"
 
 namespace SST {
 
@@ -40,9 +43,27 @@ class SimpleMMU : public MMU {
 #if 0
         {"hitLatency", "latency of MMU hit in ns","0"},
 #endif
+        {"hardware_walk", "resolve TLB misses to present pages in the MMU instead of faulting to the OS","false"},
+        {"page_table_levels", "number of levels walked for a translation when hardware_walk is set","4"},
+        {"walk_latency", "latency of each page table reference in ns","0"},
+        {"shared_tlb_entries", "number of entries in the TLB shared by all cores, 0 disables it","0"},
+        {"shared_tlb_assoc", "associativity of the shared TLB","4"},
+        {"shared_tlb_latency", "latency of a shared TLB lookup in ns","0"},
+        {"pwc_entries", "number of entries per level in the page walk cache, 0 disables it","0"},
+        {"pwc_assoc", "associativity of the page walk cache","4"},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        {"hardware_walks", "TLB misses resolved by the MMU without a fault", "count", 1},
+        {"shared_tlb_hits", "TLB misses that hit in the shared TLB", "count", 1},
+        {"walk_references", "page table references made by hardware walks", "count", 1},
     )
 
     SimpleMMU(SST::ComponentId_t id, SST::Params& params);
+    ~SimpleMMU() {
+        delete m_sharedTlb;
+        delete m_walkCache;
+    }
 
     virtual void removeWrite( unsigned pid );
     virtual void map( unsigned pid, uint32_t vpn, std::vector<uint32_t>& ppns, int pageSize, uint64_t flags );
@@ -98,35 +119,6 @@ class SimpleMMU : public MMU {
 
   private:
 
-    class PageTable {
-      public:
-        void add( uint32_t vpn, PTE pte ) { 
-            pteMap[vpn] = pte;
-        }
-        void remove( uint32_t vpn ) { 
-            pteMap.erase(vpn);
-        }
-        PTE* find( uint32_t vpn ) {
-            if ( pteMap.find( vpn ) == pteMap.end() ) {
-                return nullptr;
-            } else { 
-                return &pteMap[vpn];
-            }
-        }
-        void removeWrite(  ) { 
-            for ( auto& kv : pteMap ) {
-                kv.second.perms &= ~0x2;
-            }
-        }
-        void print( const std::string str) {
-            for ( auto& kv : pteMap ) {
-                printf("PageTabl::%s() %s vpn=%d ppn=%d perm=%#x\n",__func__,str.c_str(),kv.first,kv.second.ppn,kv.second.perms);
-            }
-        }
-      private:
-        std::map<uint32_t,PTE> pteMap; 
-    };
-
     void initPageTable( unsigned pid, PageTable* table = nullptr ) {
         m_dbg.debug(CALL_INFO_LONG,1,0,"pid=%d\n",pid);
         auto iter = m_pageTableMap.find(pid);
@@ -136,12 +128,20 @@ class SimpleMMU : public MMU {
             }    
              
             m_pageTableMap[pid] = table;
+
+            if ( m_sharedTlb ) {
+                m_sharedTlb->invalidate( pid );
+            }
+            if ( m_walkCache ) {
+                m_walkCache->invalidate( pid );
+            }
         } else {
             assert(0);
         }
     }
 
     void handleTlbEvent( Event* ev, int link );
+    bool hardwareWalk( unsigned pid, uint32_t vpn, uint32_t perms, PTE& pte, SimTime_t& latency );
     void handleNicTlbEvent( Event* ev );
 
 
@@ -166,7 +166,22 @@ class SimpleMMU : public MMU {
 
     std::map< unsigned, PageTable* > m_pageTableMap;
 
+    // pages the OS has mapped but not finished writing (zero fill, ELF load, COW copy),
+    // they are only handed out once the OS reports the fault handled
+    std::set< std::pair< unsigned, uint32_t > > m_faultsInFlight;
+
     std::vector< std::vector< unsigned > > m_coreToPid;
+
+    bool m_hardwareWalk;
+    int m_pageTableLevels;
+    SimTime_t m_walkLatency;
+    SimTime_t m_sharedTlbLatency;
+    TranslationCache* m_sharedTlb;
+    PageWalkCache* m_walkCache;
+
+    Statistic<uint64_t>* statHardwareWalks;
+    Statistic<uint64_t>* statSharedTlbHits;
+    Statistic<uint64_t>* statWalkReferences;
 };
 
 } //namespace MMU_Lib
@@ -58,15 +58,8 @@ SimpleTLB::SimpleTLB(SST::ComponentId_t id, SST::Params& params) : TLB(id,params
     }
 
     m_waitingMiss.resize( numHwThreads );
-    m_tlbData.resize( numHwThreads );
-    for ( int i=0; i < m_tlbData.size(); i++ ) {
-        m_tlbData[i].resize( m_tlbSize );
-        for ( int j=0; j < m_tlbData[i].size(); j++ ) {
-            m_tlbData[i][j].resize( m_tlbSetSize );
-        }
-    }
+    m_tlb.init( numHwThreads, m_tlbSize, m_tlbSetSize );
     m_dbg.debug(CALL_INFO,1,0,"numHwTHreads=%d tlbSize=%zu tlbSetSize=%d\n",numHwThreads,m_tlbSize,m_tlbSetSize);
-    m_tlbIndexShift = log2( m_tlbSize );
 }
 
 void SimpleTLB::init(unsigned int phase) 
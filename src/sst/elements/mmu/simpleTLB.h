@@ -21,7 +21,9 @@
 
 #include "mmuEvents.h"
 #include "tlb.h"
+#include "tlbArray.h"
 #include <queue>
+#include <unordered_map>
 
 namespace SST {
 
@@ -29,30 +31,7 @@ namespace MMU_Lib {
 
 class SimpleTLB : public TLB {
 
-    class TlbEntry {
-      public:
-        TlbEntry() : m_valid(false) {}
-        ~TlbEntry() {}
-        void setInvalid() { m_valid = false; }
-        bool isValid() { return m_valid; }
-        bool isDirty() { return m_dirty; }
-        uint32_t perms() { return m_perms; }
-        size_t tag() { return m_tag; }
-        size_t ppn() { return m_ppn; }
-        void init( size_t tag, size_t ppn, uint32_t perms ) { 
-            m_tag = tag;
-            m_ppn = ppn;
-            m_perms = perms;
-            m_dirty = false;
-            m_valid = true;
-        }
-      private:
-        int m_valid : 1;
-        int m_dirty : 1;
-        uint32_t m_perms: 3;
-        size_t m_tag : 52; 
-        size_t m_ppn : 52;
-    };
+    typedef TlbArray::Entry TlbEntry;
 
     class TlbRecord { 
       public:
@@ -124,64 +103,22 @@ class SimpleTLB : public TLB {
     }
 
     void fillTlbEntry( int hwThreadId, size_t vpn, size_t ppn, uint32_t perms ) {
-        size_t tag = vpn >> m_tlbIndexShift;
-        int index = vpn & ( m_tlbSize - 1 );
-        auto& vec = m_tlbData[ hwThreadId ][ index ];
-        
-        for ( int i = 0; i<vec.size(); i++ ) {
-            if ( vec[i].isValid() ) {
-                m_dbg.debug(CALL_INFO,1,0,"vpn=%zu, tag=%#" PRIx64 " ppn %#lx -> %zu, perms %#x -> %#x \n",
-                        vpn, (uint64_t) vec[i].tag(), vec[i].ppn(), ppn, vec[i].perms(), perms  );
-
-                if ( tag == vec[i].tag() ) {
-                    vec[ i ].init( tag, ppn, perms );
-                    return;
-                }
-            }
-        } 
-
         assert(vpn);
-        int slot = pickVictim();
-        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu ppn=%zu tag%#" PRIx64 " index=%#x slot=%d\n",hwThreadId,
-            vpn, ppn, (uint64_t) tag, index, slot );
-        vec[ slot ].init( tag, ppn, perms );
+        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu ppn=%zu tag%#" PRIx64 " index=%#zx\n",hwThreadId,
+            vpn, ppn, (uint64_t) ( vpn >> m_tlb.indexShift() ), vpn & ( m_tlbSize - 1 ) );
+        m_tlb.fill( hwThreadId, vpn, ppn, perms, [this]() { return pickVictim(); } );
     }  
 
     TlbEntry* findTlbEntry( int hwThreadId, size_t vpn ) {
-        size_t tag = vpn >> m_tlbIndexShift;
-        int index = vpn & ( m_tlbSize - 1 );
-
-        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu tag=%#" PRIx64 " index=%#x\n",
-            hwThreadId, vpn, (uint64_t) tag, index );
-
-        auto& vec = m_tlbData[ hwThreadId ][ index ];
-        for ( int i = 0; i < vec.size(); i++ ) {
-
-            m_dbg.debug(CALL_INFO,2,0,"check valid=%d wantTag=%#" PRIx64 "\n",vec[i].isValid(), (uint64_t) tag );
-            if ( vec[i].isValid() && tag == vec[i].tag() ) {
-                m_dbg.debug(CALL_INFO,1,0,"found tag=%#" PRIx64 " index=%#x slot=%d\n",(uint64_t) tag, index, i );
-                return& vec[i];
-            }
-        }
-        return nullptr;
+        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu tag=%#" PRIx64 " index=%#zx\n",
+            hwThreadId, vpn, (uint64_t) ( vpn >> m_tlb.indexShift() ), vpn & ( m_tlbSize - 1 ) );
+
+        return m_tlb.find( hwThreadId, vpn );
     }
 
     void flushThread( int hwThread ) {
-    
-        auto& slice = m_tlbData[ hwThread ];
-        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d size=%zu\n",hwThread,slice.size() );
-
-        for ( int i = 0; i < slice.size(); i++ ) {
-            auto& set = slice[i]; 
-            //m_dbg.debug(CALL_INFO,1,0,"size=%zu\n",set.size() );
-            for ( int j = 0; j < set.size(); j++ ) {  
-                if ( set[j].isValid() ) {
-                    m_dbg.debug(CALL_INFO,1,0,"hwThread=%d index=%d set=%d vpn=%zu\n",
-                            hwThread,i,j, (size_t) ( set[j].tag() << m_tlbIndexShift | i ));
-                    set[j].setInvalid();
-                }
-            }
-        }
+        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d size=%zu\n",hwThread,m_tlbSize );
+        m_tlb.flush( hwThread );
     }
 
     Link* m_selfLink;
@@ -192,14 +129,13 @@ class SimpleTLB : public TLB {
     int m_tlbSetSize;
     int m_pageSize;
     int m_pageShift;
-    int m_tlbIndexShift;
-    std::vector< std::vector< std::vector< TlbEntry > > > m_tlbData;
+    TlbArray m_tlb;
     RNG::XORShiftRNG rng;
 
     uint64_t m_minVirtAddr;
     uint64_t m_maxVirtAddr;
 
-    std::vector< std::map<size_t,std::queue<RequestID> > > m_waitingMiss;
+    std::vector< std::unordered_map<size_t,std::queue<RequestID> > > m_waitingMiss;
 };
 
 } //namespace MMU_Lib
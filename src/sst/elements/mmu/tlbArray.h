@@ -0,0 +1,115 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef TLB_ARRAY_H
+#define TLB_ARRAY_H
+
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SST {
+
+namespace MMU_Lib {
+
+// Set associative storage of a SimpleTLB. The sets of every hardware thread live in one
+// array, thread major. A vpn selects a set with its low bits and is tagged with the rest.
+class TlbArray {
+  public:
+    class Entry {
+      public:
+        Entry() : m_valid(false) {}
+        ~Entry() {}
+        void setInvalid() { m_valid = false; }
+        bool isValid() { return m_valid; }
+        bool isDirty() { return m_dirty; }
+        uint32_t perms() { return m_perms; }
+        size_t tag() { return m_tag; }
+        size_t ppn() { return m_ppn; }
+        void init( size_t tag, size_t ppn, uint32_t perms ) { 
+            m_tag = tag;
+            m_ppn = ppn;
+            m_perms = perms;
+            m_dirty = false;
+            m_valid = true;
+        }
+      private:
+        int m_valid : 1;
+        int m_dirty : 1;
+        uint32_t m_perms: 3;
+        size_t m_tag : 52; 
+        size_t m_ppn : 52;
+    };
+
+    TlbArray() : m_numSets(0), m_setSize(0), m_indexShift(0) {}
+
+    void init( int numHwThreads, size_t numSets, int setSize ) {
+        m_numSets = numSets;
+        m_setSize = setSize;
+        m_indexShift = log2( numSets );
+        m_entries.resize( (size_t) numHwThreads * numSets * setSize );
+    }
+
+    Entry* getSet( int hwThreadId, size_t index ) {
+        return &m_entries[ ( (size_t) hwThreadId * m_numSets + index ) * m_setSize ];
+    }
+
+    Entry* find( int hwThreadId, size_t vpn ) {
+        size_t tag = vpn >> m_indexShift;
+        Entry* set = getSet( hwThreadId, vpn & ( m_numSets - 1 ) );
+        for ( int i = 0; i < m_setSize; i++ ) {
+            if ( set[i].isValid() && tag == set[i].tag() ) {
+                return &set[i];
+            }
+        }
+        return nullptr;
+    }
+
+    // pickVictim() is only called when the vpn isn't already in its set
+    template< class PickVictim >
+    void fill( int hwThreadId, size_t vpn, size_t ppn, uint32_t perms, PickVictim pickVictim ) {
+        size_t tag = vpn >> m_indexShift;
+        Entry* set = getSet( hwThreadId, vpn & ( m_numSets - 1 ) );
+        for ( int i = 0; i < m_setSize; i++ ) {
+            if ( set[i].isValid() && tag == set[i].tag() ) {
+                set[i].init( tag, ppn, perms );
+                return;
+            }
+        }
+        set[ pickVictim() ].init( tag, ppn, perms );
+    }
+
+    void flush( int hwThreadId ) {
+        Entry* set = getSet( hwThreadId, 0 );
+        for ( size_t i = 0; i < m_numSets * m_setSize; i++ ) {
+            set[i].setInvalid();
+        }
+    }
+
+    size_t numSets() { return m_numSets; }
+    int setSize() { return m_setSize; }
+    int indexShift() { return m_indexShift; }
+
+  private:
+    size_t m_numSets;
+    int m_setSize;
+    int m_indexShift;
+    std::vector< Entry > m_entries;
+};
+
+} //namespace MMU_Lib
+} //namespace SST
+
+#endif /* TLB_ARRAY_H */
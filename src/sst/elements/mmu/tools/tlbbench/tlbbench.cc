@@ -0,0 +1,289 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * TLB and page table benchmark
+ *
+ * Replays a synthetic stream of page numbers through the translation
+ * structures of the MMU element and reports the hit rate and translations
+ * per second of host time for each: the SimpleTLB set array, the L2 TLB and
+ * page walk cache of SimpleMMU, the flattened PageTable and all of them
+ * chained the way a SimpleTLB miss is handled by SimpleMMU. The stream
+ * drifts through a hot set of pages and jumps to a random page of the
+ * footprint every so often.
+ *
+ * Before timing anything the PageTable is checked against a std::map with
+ * a random mix of add, remove and find over a small vpn range, so probe
+ * runs collide, deletes shift entries back and the table grows several
+ * times. Exits non-zero if the two ever disagree.
+ *
+ * usage: tlbbench [-n translations] [-p pages] [-r repeat] [-c checks]
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "pageTable.h"
+#include "tlbArray.h"
+#include "walkCache.h"
+
+using namespace SST::MMU_Lib;
+
+/* xorshift64* */
+class BenchRNG {
+public:
+    BenchRNG(uint64_t seed) : state(seed ? seed : 1) { }
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+private:
+    uint64_t state;
+};
+
+/*
+ * Random add/remove/find against a std::map. The vpn range is a few times
+ * the number of live entries so both hits and misses are common.
+ */
+static bool check(size_t ops) {
+    const uint32_t range = 8192;
+    BenchRNG rng(99);
+    PageTable table;
+    std::map<uint32_t, PTE> expect;
+
+    for (size_t i = 0; i < ops; i++) {
+        uint32_t vpn = rng.next() % range;
+        /* bias towards adds for the first half so the table grows, then towards removes */
+        int op = rng.next() % 8;
+        bool adding = i < ops / 2 ? op < 5 : op < 3;
+
+        if (adding) {
+            PTE pte(rng.next() % (1 << 29), rng.next() % 8);
+            table.add(vpn, pte);
+            expect[vpn] = pte;
+        } else if (op < 6) {
+            table.remove(vpn);
+            expect.erase(vpn);
+        }
+
+        PTE* got = table.find(vpn);
+        std::map<uint32_t, PTE>::iterator it = expect.find(vpn);
+        if ((got == nullptr) != (it == expect.end()) ||
+                (got && (got->ppn != it->second.ppn || got->perms != it->second.perms))) {
+            printf("FAIL: op %zu vpn %" PRIu32 " %s in the page table, %s in the map\n", i, vpn,
+                    got ? "found" : "missing", it == expect.end() ? "missing" : "found");
+            return false;
+        }
+        if (table.size() != expect.size()) {
+            printf("FAIL: op %zu page table holds %zu entries, the map %zu\n", i, table.size(), expect.size());
+            return false;
+        }
+
+        /* every so often look at the whole range, a bad backward shift strands entries out of their probe run */
+        if (i % (ops / 16 + 1) == 0) {
+            PageTable copy(table);
+            for (uint32_t v = 0; v < range; v++) {
+                PTE* p = copy.find(v);
+                if ((p == nullptr) != (expect.find(v) == expect.end())) {
+                    printf("FAIL: op %zu vpn %" PRIu32 " %s in the page table after a full scan\n", i, v,
+                            p ? "found" : "missing");
+                    return false;
+                }
+            }
+        }
+    }
+    printf("PASS: %zu page table operations match std::map, %zu entries left\n", ops, expect.size());
+    return true;
+}
+
+/* A hot set of 64 pages that drifts by one page every 256 translations, plus 1 in 64 random pages */
+static void generate(std::vector<uint32_t>& vpns, size_t count, uint32_t pages) {
+    BenchRNG rng(12345);
+    uint32_t base = 0;
+    vpns.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        if (i % 256 == 0)
+            base = (base + 1) % pages;
+        if (rng.next() % 64 == 0)
+            vpns[i] = 1 + rng.next() % pages;
+        else
+            vpns[i] = 1 + (base + rng.next() % 64) % pages;
+    }
+}
+
+struct Result {
+    double seconds;
+    uint64_t hits;
+};
+
+/* The default SimpleTLB geometry, 32 sets of 4 ways for one hardware thread */
+static Result runTlb(const std::vector<uint32_t>& vpns, uint32_t) {
+    TlbArray tlb;
+    BenchRNG rng(1);
+    uint64_t hits = 0;
+    tlb.init(1, 32, 4);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vpns.size(); i++) {
+        if (tlb.find(0, vpns[i]))
+            hits++;
+        else
+            tlb.fill(0, vpns[i], vpns[i], 7, [&rng]() { return (int)(rng.next() % 4); });
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count(), hits};
+}
+
+/* The default SimpleMMU L2 TLB, 1024 entries 8 way */
+static Result runL2(const std::vector<uint32_t>& vpns, uint32_t) {
+    TranslationCache l2(1024, 8);
+    uint64_t hits = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vpns.size(); i++) {
+        if (l2.find(1, vpns[i]))
+            hits++;
+        else
+            l2.insert(1, vpns[i], PTE(vpns[i], 7));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count(), hits};
+}
+
+/* A 4 level, 9 bit radix walk with 64 entry 4 way caches, a hit is a walk that needed only the PTE */
+static Result runWalk(const std::vector<uint32_t>& vpns, uint32_t) {
+    PageWalkCache pwc(4, 9, 64, 4);
+    uint64_t hits = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vpns.size(); i++) {
+        if (pwc.walk(1, vpns[i]) == 1)
+            hits++;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count(), hits};
+}
+
+static void fillTable(PageTable& table, uint32_t pages) {
+    for (uint32_t vpn = 1; vpn <= pages; vpn++)
+        table.add(vpn, PTE(vpn, 7));
+}
+
+static Result runTable(const std::vector<uint32_t>& vpns, uint32_t pages) {
+    PageTable table;
+    uint64_t hits = 0;
+    fillTable(table, pages);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vpns.size(); i++) {
+        if (table.find(vpns[i]))
+            hits++;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count(), hits};
+}
+
+/* TLB, then L2 TLB, then a walk through the walk cache and the page table, refilling on the way back */
+static Result runChain(const std::vector<uint32_t>& vpns, uint32_t pages) {
+    TlbArray tlb;
+    TranslationCache l2(1024, 8);
+    PageWalkCache pwc(4, 9, 64, 4);
+    PageTable table;
+    BenchRNG rng(1);
+    uint64_t hits = 0;
+    tlb.init(1, 32, 4);
+    fillTable(table, pages);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < vpns.size(); i++) {
+        uint32_t vpn = vpns[i];
+        if (tlb.find(0, vpn)) {
+            hits++;
+            continue;
+        }
+        PTE* pte = l2.find(1, vpn);
+        if (pte == nullptr) {
+            pwc.walk(1, vpn);
+            pte = table.find(vpn);
+            l2.insert(1, vpn, *pte);
+        }
+        tlb.fill(0, vpn, pte->ppn, pte->perms, [&rng]() { return (int)(rng.next() % 4); });
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count(), hits};
+}
+
+typedef Result (*Runner)(const std::vector<uint32_t>&, uint32_t);
+
+static void bench(const char* name, Runner run, const std::vector<uint32_t>& vpns, uint32_t pages, int repeat) {
+    double best = 0.;
+    uint64_t hits = 0;
+    for (int r = 0; r < repeat; r++) {
+        Result res = run(vpns, pages);
+        if (r == 0 || res.seconds < best)
+            best = res.seconds;
+        hits = res.hits;
+    }
+    printf("%-12s %10.2f%% %16.0f\n", name, 100.0 * hits / vpns.size(), vpns.size() / best);
+}
+
+int main(int argc, char* argv[]) {
+    size_t translations = 10000000;
+    uint32_t pages = 262144;
+    int repeat = 3;
+    size_t checks = 1000000;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            translations = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-p") == 0) {
+            pages = strtoul(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-r") == 0) {
+            repeat = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "-c") == 0) {
+            checks = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: tlbbench [-n translations] [-p pages] [-r repeat] [-c checks]\n");
+            exit(1);
+        }
+    }
+    if (translations == 0 || pages == 0 || pages >= (1 << 29) || repeat < 1) {
+        fprintf(stderr, "tlbbench: translations and repeat must be at least 1, pages between 1 and 2^29-1\n");
+        exit(1);
+    }
+
+    if (checks > 0 && !check(checks))
+        return 1;
+
+    std::vector<uint32_t> vpns;
+    generate(vpns, translations, pages);
+
+    printf("%zu translations over %" PRIu32 " pages, best of %d\n", vpns.size(), pages, repeat);
+    printf("%-12s %11s %16s\n", "structure", "hit rate", "translations/s");
+
+    bench("tlb", runTlb, vpns, pages, repeat);
+    bench("l2 tlb", runL2, vpns, pages, repeat);
+    bench("walk cache", runWalk, vpns, pages, repeat);
+    bench("page table", runTable, vpns, pages, repeat);
+    bench("tlb+mmu", runChain, vpns, pages, repeat);
+    return 0;
+}
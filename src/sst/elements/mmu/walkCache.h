@@ -0,0 +1,151 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef WALK_CACHE_H
+#define WALK_CACHE_H
+
+#include <cassert>
+#include <stdint.h>
+#include <vector>
+#include "mmuTypes.h"
+
+namespace SST {
+
+namespace MMU_Lib {
+
+// Set associative, LRU cache of translations tagged by pid. Used by the MMU both as the
+// shared L2 TLB (tag is the vpn, payload the PTE) and for each level of the page walk cache
+// (tag is the vpn prefix that selects an upper level entry, payload unused).
+class TranslationCache {
+
+    struct Entry {
+        Entry() : valid(false), pid(0), tag(0), lastUse(0) {}
+        bool valid;
+        unsigned pid;
+        uint64_t tag;
+        PTE pte;
+        uint64_t lastUse;
+    };
+
+  public:
+    TranslationCache( size_t numEntries, int assoc ) : m_assoc(assoc), m_numSets(numEntries/assoc), m_useCount(0) {
+        assert( m_numSets > 0 );
+        m_entries.resize( m_numSets * m_assoc );
+    }
+
+    PTE* find( unsigned pid, uint64_t tag ) {
+        Entry* set = getSet( pid, tag );
+        for ( int i = 0; i < m_assoc; i++ ) {
+            if ( set[i].valid && set[i].tag == tag && set[i].pid == pid ) {
+                set[i].lastUse = ++m_useCount;
+                return &set[i].pte;
+            }
+        }
+        return nullptr;
+    }
+
+    void insert( unsigned pid, uint64_t tag, PTE pte = PTE() ) {
+        Entry* set = getSet( pid, tag );
+        Entry* victim = &set[0];
+        for ( int i = 0; i < m_assoc; i++ ) {
+            if ( set[i].valid && set[i].tag == tag && set[i].pid == pid ) {
+                victim = &set[i];
+                break;
+            }
+            if ( ! set[i].valid ) {
+                victim = &set[i];
+            } else if ( victim->valid && set[i].lastUse < victim->lastUse ) {
+                victim = &set[i];
+            }
+        }
+        victim->valid = true;
+        victim->pid = pid;
+        victim->tag = tag;
+        victim->pte = pte;
+        victim->lastUse = ++m_useCount;
+    }
+
+    void invalidate( unsigned pid, uint64_t tag ) {
+        Entry* set = getSet( pid, tag );
+        for ( int i = 0; i < m_assoc; i++ ) {
+            if ( set[i].valid && set[i].tag == tag && set[i].pid == pid ) {
+                set[i].valid = false;
+            }
+        }
+    }
+
+    void invalidate( unsigned pid ) {
+        for ( size_t i = 0; i < m_entries.size(); i++ ) {
+            if ( m_entries[i].pid == pid ) {
+                m_entries[i].valid = false;
+            }
+        }
+    }
+
+  private:
+    Entry* getSet( unsigned pid, uint64_t tag ) {
+        // spread the pids so processes sharing a vpn range don't all land in the same sets
+        return &m_entries[ ( ( tag + (uint64_t) pid * 0x9E3779B1 ) % m_numSets ) * m_assoc ];
+    }
+
+    int m_assoc;
+    size_t m_numSets;
+    uint64_t m_useCount;
+    std::vector<Entry> m_entries;
+};
+
+// Caches the upper levels of a radix page table walk. Level 0 is the PTE and is never
+// cached here, level N holds the entry selected by the vpn bits above N * bitsPerLevel.
+class PageWalkCache {
+  public:
+    PageWalkCache( int numLevels, int bitsPerLevel, size_t numEntries, int assoc ) :
+        m_numLevels(numLevels), m_bitsPerLevel(bitsPerLevel)
+    {
+        for ( int i = 1; i < m_numLevels; i++ ) {
+            m_levels.push_back( TranslationCache( numEntries, assoc ) );
+        }
+    }
+
+    // returns the number of page table references needed to reach the PTE for vpn
+    // and caches the upper level entries read along the way
+    int walk( unsigned pid, uint64_t vpn ) {
+        int level = 1;
+        for ( ; level < m_numLevels; level++ ) {
+            if ( m_levels[level-1].find( pid, vpn >> ( level * m_bitsPerLevel ) ) ) {
+                break;
+            }
+        }
+        for ( int i = 1; i < level; i++ ) {
+            m_levels[i-1].insert( pid, vpn >> ( i * m_bitsPerLevel ) );
+        }
+        return level;
+    }
+
+    void invalidate( unsigned pid ) {
+        for ( size_t i = 0; i < m_levels.size(); i++ ) {
+            m_levels[i].invalidate( pid );
+        }
+    }
+
+  private:
+    int m_numLevels;
+    int m_bitsPerLevel;
+    std::vector<TranslationCache> m_levels;
+};
+
+} //namespace MMU_Lib
+} //namespace SST
+
+#endif /* WALK_CACHE_H */
@@ -71,24 +71,111 @@ Pool::Pool(Params params, SST::OpalComponent::MemType mem_type, int id)
 
 }
 
+void FrameBitmap::build(uint64_t frames)
+{
+	this->frames = frames;
+	levels.clear();
+
+	// every level has a bit per word of the level below, until a single word covers everything
+	uint64_t bits = frames;
+	do {
+		std::vector<uint64_t> level((bits + 63) / 64, ~0ULL);
+		if (bits % 64)
+			level.back() = (1ULL << (bits % 64)) - 1;
+		levels.push_back(level);
+		bits = level.size();
+	} while (bits > 1);
+}
+
+void FrameBitmap::setFree(uint64_t frame)
+{
+	uint64_t index = frame;
+	for (size_t level = 0; level < levels.size(); level++) {
+		uint64_t& word = levels[level][index / 64];
+		bool wasEmpty = (word == 0);
+		word |= 1ULL << (index % 64);
+		if (!wasEmpty)
+			break;
+		index /= 64;
+	}
+}
+
+void FrameBitmap::setUsed(uint64_t frame)
+{
+	uint64_t index = frame;
+	for (size_t level = 0; level < levels.size(); level++) {
+		uint64_t& word = levels[level][index / 64];
+		word &= ~(1ULL << (index % 64));
+		if (word != 0)
+			break;
+		index /= 64;
+	}
+}
+
+uint64_t FrameBitmap::findNext(size_t level, uint64_t index)
+{
+	std::vector<uint64_t>& bits = levels[level];
+	uint64_t word = index / 64;
+	if (word >= bits.size())
+		return NONE;
+
+	uint64_t masked = bits[word] & (~0ULL << (index % 64));
+	if (masked)
+		return word * 64 + __builtin_ctzll(masked);
+
+	// nothing left in this word, ask the level above for the next word with a free bit
+	if (level + 1 == levels.size())
+		return NONE;
+
+	uint64_t next = findNext(level + 1, word + 1);
+	if (next == NONE)
+		return NONE;
+
+	return next * 64 + __builtin_ctzll(bits[next]);
+}
+
+uint64_t FrameBitmap::findRun(uint64_t n, uint64_t align)
+{
+	uint64_t frame = 0;
+
+	while (true) {
+		frame = findFree(frame);
+		if (frame == NONE)
+			return NONE;
+
+		frame = ((frame + align - 1) / align) * align;
+		if (frame + n > frames)
+			return NONE;
+
+		// look for a used frame inside the candidate run, a word at a time
+		uint64_t end = frame + n;
+		uint64_t used = NONE;
+		for (uint64_t i = frame; i < end; ) {
+			uint64_t inWord = std::min<uint64_t>(64 - (i % 64), end - i);
+			uint64_t mask = (inWord == 64) ? ~0ULL : (((1ULL << inWord) - 1) << (i % 64));
+			uint64_t holes = ~levels[0][i / 64] & mask;
+			if (holes) {
+				used = (i / 64) * 64 + __builtin_ctzll(holes);
+				break;
+			}
+			i += inWord;
+		}
+
+		if (used == NONE)
+			return frame;
+
+		frame = used + 1;
+	}
+}
+
 //Create free frames of size framesize, note that the size is in KB
 void Pool::build_mem()
 {
-	int i=0;
 	num_frames = ceil(size/frsize);
 	real_size = num_frames * frsize;
 
-	//std::vector<int> numbers;
-	//for(int i=0; i<num_frames; i++)       // add 0-99 to the vector
-    //	numbers.push_back(i);
-
-    // random allocation of frames
-	//unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-	//std::shuffle(numbers.begin(), numbers.end(), std::default_random_engine(seed));
-
-	for(i=0; i< num_frames; i++) {
-		freelist.push_back(((uint64_t) i*frsize*1024) + start);
-	}
+	// all frames start out free, frames are handed out lowest address first
+	freeframes_map.build(num_frames);
 
 	available_frames = num_frames;
 
@@ -96,51 +183,42 @@ void Pool::build_mem()
 
 }
 
+uint64_t Pool::frame_index(uint64_t address)
+{
+	uint64_t frame_bytes = (uint64_t) frsize * 1024;
+
+	if (address < start || (address - start) % frame_bytes)
+		return FrameBitmap::NONE;
+
+	uint64_t frame = (address - start) / frame_bytes;
+	if (frame >= (uint64_t) num_frames)
+		return FrameBitmap::NONE;
+
+	return frame;
+}
+
 REQRESPONSE Pool::allocate_frames(int pages)
 {
 
 	REQRESPONSE response;
 	response.status =0;
 
-	if(available_frames < pages) {
+	if(pages < 1 || available_frames < pages) {
 		return response;
 	}
 
-	int frames = pages;
-	std::list<Frame*> frames_allocated;
-
-	// Fixme: Shuffle memory to make continuous memory available
-	while(frames) {
-		// Make sure pool has free frames in the requested memory pool type. If not deallocate allocated frames (if number of frames to be allocated are > 1)
-		if(freelist.empty()) {
-			while(!frames_allocated.empty()) {
-				Frame *frame = frames_allocated.front();
-				freelist.push_back(frame->starting_address);
-				alloclist.erase(frame->starting_address);
-				frames_allocated.pop_front();
-				available_frames++;
-				delete frame;
-			}
-			break;
-		}
-		else
-		{
-			uint64_t frameAddr = freelist.front();
-			freelist.erase(freelist.begin());
-			Frame *frame = new Frame(frameAddr,0);
-			alloclist[frame->starting_address] = frame;
-			frames_allocated.push_back(frame);
-			available_frames--;
-		}
-		frames--;
+	// The frames don't have to be contiguous, the response carries the first one
+	for(int i = 0; i < pages; i++) {
+		uint64_t frame = freeframes_map.findFree(0);
+		freeframes_map.setUsed(frame);
+		available_frames--;
 
+		if(i == 0)
+			response.address = frame_address(frame);
 	}
 
-	if(!frames_allocated.empty()) {
-		response.address = (frames_allocated.front())->starting_address;
-		response.pages = pages;
-		response.status = 1;
-	}
+	response.pages = pages;
+	response.status = 1;
 
 	return response;
 
@@ -155,27 +233,54 @@ REQRESPONSE Pool::allocate_frame(int N)
 
 
 	// Make sure we have free frames first
-	if(freelist.empty())
+	if(N < 1 || available_frames < N)
 		return response;
 
-	// For now, we will assume you can only allocate 1 frame, TODO: We will implemenet a buddy-allocator style that enables allocating contigous physical spaces
-	if(N>1)
+	uint64_t frame;
+	if(N == 1) {
+		frame = freeframes_map.findFree(0);
+	} else {
+		uint64_t align = (N & (N - 1)) ? 1 : N;
+		frame = freeframes_map.findRun(N, align);
+	}
+
+	if(frame == FrameBitmap::NONE)
 		return response;
 
-	else
-	{
-		// Simply, pop the first free frame and assign it
-		uint64_t frameAddr = freelist.front();
-		freelist.erase(freelist.begin());
-		Frame *temp = new Frame(frameAddr,0);
-		alloclist[temp->starting_address] = temp;
-		available_frames--;
-		response.address = temp->starting_address;
-		response.pages = 1;
-		response.status = 1;
+	for(int i = 0; i < N; i++)
+		freeframes_map.setUsed(frame + i);
+
+	available_frames -= N;
+	response.address = frame_address(frame);
+	response.pages = N;
+	response.status = 1;
+	return response;
+
+}
+
+// Allocate N contigiuous frames starting at a given physical address, fails if any of them is taken
+REQRESPONSE Pool::allocate_frame_address(uint64_t address, int N)
+{
+
+	REQRESPONSE response;
+	response.status = 0;
+
+	uint64_t frame = frame_index(address);
+	if(N < 1 || frame == FrameBitmap::NONE || frame + N > (uint64_t) num_frames)
 		return response;
 
-	}
+	for(int i = 0; i < N; i++)
+		if(!freeframes_map.isFree(frame + i))
+			return response;
+
+	for(int i = 0; i < N; i++)
+		freeframes_map.setUsed(frame + i);
+
+	available_frames -= N;
+	response.address = address;
+	response.pages = N;
+	response.status = 1;
+	return response;
 
 }
 
@@ -187,32 +292,25 @@ REQRESPONSE Pool::deallocate_frames(int pages, uint64_t starting_pAddress)
 
 	REQRESPONSE response;
 	int frames = pages;
-	uint64_t pAddress = starting_pAddress;
-	uint64_t frame_number;
+	uint64_t frame = frame_index(starting_pAddress);
 
 	while(frames) {
 
-		// If we can find the frame to be free in the allocated list
-		std::map<uint64_t, Frame*>::iterator it;
-		it = alloclist.find(pAddress);
-		if (it != alloclist.end())
+		// If the frame is allocated, return it to the free map
+		if (frame < (uint64_t) num_frames && !freeframes_map.isFree(frame))
 		{
-			//Remove from allocation map and add to free list
-			Frame *temp = it->second;
-			freelist.push_back(temp->starting_address);
-			alloclist.erase(pAddress);
-			delete temp;
+			freeframes_map.setFree(frame);
+			available_frames++;
 		}
 		else
 		{
-			response.address = pAddress; //physical address of the frame which failed to deallocate.
+			response.address = (frame == FrameBitmap::NONE) ? starting_pAddress : frame_address(frame); //physical address of the frame which failed to deallocate.
 			response.pages = frames; //This indicates number of frames that are not deallocated.
 			response.status = 0;
 			return response;
 		}
 
-		frame_number = (pAddress - start) / frsize * 1024;
-		pAddress += ((uint64_t) (frame_number+1)*frsize*1024) + start; //to get the next frame physical address
+		frame++;
 		frames--;
 	}
 
@@ -227,68 +325,29 @@ REQRESPONSE Pool::deallocate_frame(uint64_t X, int N)
 	REQRESPONSE response;
 	response.status = 0;
 
-
-	// For now, we will assume you can free only 1 frame, TODO: We will implemenet a buddy-allocator style that enables allocating and freeing contigous physical spaces
-	if(N>1)
+	uint64_t frame = frame_index(X);
+	if(N < 1 || frame == FrameBitmap::NONE || frame + N > (uint64_t) num_frames)
 		return response;
-	else
-	{
-		// If we can find the frame to be free in the allocated list
-		if(alloclist.find(X)!=alloclist.end())
-		{
-			// Remove from allocation map and add to free list
-			Frame * temp = alloclist[X];
-			freelist.push_back(temp->starting_address);
-			alloclist.erase(X);
-			delete temp;
-			available_frames++;
-			response.status = 1;
-		}
-		else // Means we couldn't find an allocated frame that is being unmapped
-			response.status = 0;
 
-	}
+	// Means we couldn't find an allocated frame that is being unmapped
+	for(int i = 0; i < N; i++)
+		if(freeframes_map.isFree(frame + i))
+			return response;
+
+	for(int i = 0; i < N; i++)
+		freeframes_map.setFree(frame + i);
+
+	available_frames += N;
+	response.status = 1;
 
 	return response;
 }
 
 bool Pool::isAllocated(uint64_t address)
 {
-	if(alloclist.find(address)==alloclist.end())
+	uint64_t frame = frame_index(address);
+	if(frame == FrameBitmap::NONE)
 		return false;
 
-	return true;
+	return !freeframes_map.isFree(frame);
 }
-
-/*REQRESPONSE Pool::allocate_frame_address(uint64_t address)
-{
-
-	REQRESPONSE response;
-	response.status = 0;
-
-	// Make sure we have free frames first
-	if(freelist.empty())
-		return response;
-
-	// For now, we will assume you can only allocate 1 frame, TODO: We will implemenet a buddy-allocator style that enables allocating contigous physical spaces
-	if(N>1)
-		return response;
-
-	else
-	{
-		int index = freelist_index[address];
-		Frame * temp = freelist[index];
-		//freelist.remove(temp);
-		freelist.erase(freelist.begin()+index);
-		alloclist[temp->starting_address] = temp;
-		available_frames--;
-		response.address = temp->starting_address;
-		response.pages = 1;
-		response.status = 1;
-		return response;
-
-	}
-
-}*/
-
-
@@ -12,8 +12,7 @@
 
 #include "opal_event.h"
 
-#include <list>
-#include <map>
+#include <vector>
 #include <cmath>
 
 
@@ -25,25 +24,36 @@ typedef struct reqresponse {
 }REQRESPONSE;
 
 
-// This defines a physical frame of size 4KB by default
-class Frame{
+// Hierarchical bitmap of free frames. Level 0 has one bit per frame (set when free), every
+// level above has one bit per word of the level below, set when that word has any free bit,
+// so finding the lowest free frame only touches one word per level.
+class FrameBitmap{
 
 	public:
-		// Constructor
-		Frame() { starting_address = 0; metadata = 0;}
 
-		// Constructor with paramteres
-		Frame(uint64_t st, uint64_t md) { starting_address = st; metadata = 0;}
+		static const uint64_t NONE = ~0ULL;
 
-		~Frame(){}
+		void build(uint64_t frames);
 
-		// The starting address of the frame
-		uint64_t starting_address;
+		bool isFree(uint64_t frame) { return (levels[0][frame / 64] >> (frame % 64)) & 1; }
 
-		// This will be used to store information about current allocation
-		int metadata;
+		void setFree(uint64_t frame);
 
-		int frame_number;
+		void setUsed(uint64_t frame);
+
+		// Lowest free frame at or after 'frame', NONE if there is none
+		uint64_t findFree(uint64_t frame) { return findNext(0, frame); }
+
+		// Lowest run of n free frames whose start is a multiple of align, NONE if there is none
+		uint64_t findRun(uint64_t n, uint64_t align);
+
+	private:
+
+		uint64_t findNext(size_t level, uint64_t index);
+
+		uint64_t frames;
+
+		std::vector<std::vector<uint64_t> > levels;
 
 };
 
@@ -57,19 +67,7 @@ class Pool{
 		//Constructor for pool
 		Pool(Params parmas, SST::OpalComponent::MemType mem_type, int id);
 
-		~Pool() {
-/*			while(!freelist.empty()) {
-				Frame* frame = freelist.front();
-				freelist.erase(freelist.begin());
-				delete frame;
-			}
-*/
-			std::map<uint64_t, Frame*>::iterator it;
-			for(it=alloclist.begin();it!=alloclist.end();it++) {
-				Frame* frame = it->second;
-				delete frame;
-			}
-		}
+		~Pool() {}
 
 		void finish() {}
 
@@ -80,6 +78,7 @@ class Pool{
 		uint64_t start;
 
 		// Allocate N contigiuous frames, returns the starting address if successfull, or -1 if it fails!
+		// Runs that are a power of two in length are aligned to their size so they can back huge pages
 		REQRESPONSE allocate_frame(int N);
 
 		// Allocate 'size' contigiuous memory, returns a structure with starting address and number of frames allocated
@@ -96,7 +95,7 @@ class Pool{
 		bool isAllocated(uint64_t address);
 
 		// Current number of free frames
-		int freeframes() { return freelist.size(); }
+		int freeframes() { return available_frames; }
 
 		// Frame size in KBs
 		int frsize;
@@ -130,6 +129,11 @@ class Pool{
 
 		Output *output;
 
+		// Frame index of a physical address, or FrameBitmap::NONE if it is not a frame of this pool
+		uint64_t frame_index(uint64_t address);
+
+		uint64_t frame_address(uint64_t frame) { return (frame * frsize * 1024) + start; }
+
 		//memory pool id
 		int poolId;
 
@@ -139,13 +143,8 @@ class Pool{
 		//Memory technology
 		SST::OpalComponent::MemTech memTech;
 
-		// The list of free frames
-		std::list<uint64_t> freelist;
-
-		//std::map<uint64_t, int> freelist_index;
-
-		// The list of allocated frames --- the key is the starting physical address
-		std::map<uint64_t, Frame*> alloclist;
+		// Free frames, allocated frames are the clear bits
+		FrameBitmap freeframes_map;
 
 };
 
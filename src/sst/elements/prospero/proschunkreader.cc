@@ -0,0 +1,214 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "proschunkreader.h"
+
+#include <algorithm>
+#include <unistd.h>
+
+using namespace SST::Prospero;
+
+
+ProsperoChunkedTraceReader::ProsperoChunkedTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out), traceInput(NULL), currentChunk(0), nextChunk(0), currentEntry(0), cycleBase(0),
+	nextToDecode(0), decodeFailed(false), shutdown(false) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	uint32_t decodeThreads = params.find<uint32_t>("decode_threads", 2);
+	prefetchChunks = params.find<size_t>("prefetch_chunks", 4);
+	uint64_t startEntry = params.find<uint64_t>("start_entry", 0);
+	uint64_t startCycle = params.find<uint64_t>("start_cycle", 0);
+
+	if(0 == decodeThreads) {
+		decodeThreads = 1;
+	}
+
+	if(0 == prefetchChunks) {
+		prefetchChunks = 1;
+	}
+
+	loadIndex(traceFile);
+
+	// Find the chunk holding the first entry to replay
+	size_t skipEntries = 0;
+
+	if(startCycle > 0 || startEntry > 0) {
+		const size_t chunk = prosperoFindStartChunk(chunkIndex, startEntry, startCycle);
+
+		currentChunk = chunk;
+		nextToDecode = chunk;
+		nextChunk = chunk;
+
+		if(chunk < chunkIndex.size() && readChunk(chunk, current)) {
+			// Entries are issued relative to where replay starts
+			skipEntries = prosperoSkipToStart(chunkIndex, chunk, current, startEntry, startCycle, cycleBase);
+
+			nextToDecode = chunk + 1;
+			nextChunk = chunk + 1;
+		}
+
+		output->verbose(CALL_INFO, 1, 0, "Starting replay in chunk %" PRIu64 " at entry %" PRIu64 ", cycles are offset by %" PRIu64 "\n",
+			(uint64_t) chunk, (uint64_t) (chunk < chunkIndex.size() ? chunkIndex[chunk].firstEntry + skipEntries : 0), cycleBase);
+	}
+
+	currentEntry = skipEntries;
+
+	for(uint32_t i = 0; i < decodeThreads; ++i) {
+		decoders.push_back(std::thread(&ProsperoChunkedTraceReader::decodeLoop, this));
+	}
+}
+
+ProsperoChunkedTraceReader::~ProsperoChunkedTraceReader() {
+	{
+		std::lock_guard<std::mutex> lock(decodeLock);
+		shutdown = true;
+	}
+	decodeChanged.notify_all();
+
+	for(size_t i = 0; i < decoders.size(); ++i) {
+		decoders[i].join();
+	}
+
+	if(NULL != traceInput) {
+		fclose(traceInput);
+	}
+}
+
+void ProsperoChunkedTraceReader::loadIndex(const std::string& traceFile) {
+	traceInput = fopen(traceFile.c_str(), "rb");
+
+	if(NULL == traceInput) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: attempted to open: %s but the file could not be opened.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	uint8_t header[PROSPERO_CHUNK_HEADER_BYTES];
+	uint8_t trailer[PROSPERO_CHUNK_TRAILER_BYTES];
+
+	if(fread(header, 1, sizeof(header), traceInput) != sizeof(header) ||
+		0 != memcmp(header, PROSPERO_CHUNK_FILE_MAGIC, PROSPERO_CHUNK_MAGIC_LENGTH)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s is not a chunked trace file.\n", getName().c_str(), traceFile.c_str());
+	}
+
+	if(PROSPERO_CHUNK_VERSION != prosperoGetLE(&header[PROSPERO_CHUNK_MAGIC_LENGTH], 4) ||
+		PROSPERO_CHUNK_CODEC_ZLIB != prosperoGetLE(&header[PROSPERO_CHUNK_MAGIC_LENGTH + 4], 4)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s uses an unsupported version or codec.\n", getName().c_str(), traceFile.c_str());
+	}
+
+	if(0 != fseeko(traceInput, -((off_t) sizeof(trailer)), SEEK_END) ||
+		fread(trailer, 1, sizeof(trailer), traceInput) != sizeof(trailer) ||
+		0 != memcmp(&trailer[24], PROSPERO_CHUNK_INDEX_MAGIC, PROSPERO_CHUNK_MAGIC_LENGTH)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s has no chunk index, the trace may be truncated.\n", getName().c_str(), traceFile.c_str());
+	}
+
+	const uint64_t indexOffset = prosperoGetLE(&trailer[0], 8);
+	const uint64_t chunkCount  = prosperoGetLE(&trailer[8], 8);
+	const uint64_t entryCount  = prosperoGetLE(&trailer[16], 8);
+
+	std::vector<uint8_t> index(chunkCount * PROSPERO_CHUNK_INDEX_ENTRY_BYTES);
+
+	if(0 != fseeko(traceInput, (off_t) indexOffset, SEEK_SET) ||
+		(!index.empty() && fread(&index[0], 1, index.size(), traceInput) != index.size())) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unable to read the chunk index of %s.\n", getName().c_str(), traceFile.c_str());
+	}
+
+	chunkIndex.resize(chunkCount);
+
+	for(uint64_t i = 0; i < chunkCount; ++i) {
+		prosperoUnpackIndexEntry(&index[i * PROSPERO_CHUNK_INDEX_ENTRY_BYTES], chunkIndex[i]);
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Chunked trace %s holds %" PRIu64 " entries in %" PRIu64 " chunks\n",
+		traceFile.c_str(), entryCount, chunkCount);
+}
+
+// Safe to call from several threads at once, each read is positioned
+bool ProsperoChunkedTraceReader::readChunk(const size_t chunk, std::vector<ProsperoChunkEntry>& entries) {
+	const ProsperoChunkIndexEntry& info = chunkIndex[chunk];
+	std::vector<uint8_t> compressed(info.compressedBytes);
+	std::vector<uint8_t> raw;
+
+	if(info.compressedBytes > 0 &&
+		pread(fileno(traceInput), &compressed[0], info.compressedBytes, (off_t) info.offset) != (ssize_t) info.compressedBytes) {
+		return false;
+	}
+
+	return prosperoUncompressChunk(compressed, raw, info.rawBytes) &&
+		prosperoDecodeChunk(raw.empty() ? NULL : &raw[0], raw.size(), info.entries, entries);
+}
+
+void ProsperoChunkedTraceReader::decodeLoop() {
+	std::unique_lock<std::mutex> lock(decodeLock);
+
+	while(true) {
+		// Only run ahead of replay by prefetchChunks
+		decodeChanged.wait(lock, [this] {
+			return shutdown || (nextToDecode < chunkIndex.size() && nextToDecode <= currentChunk + prefetchChunks);
+		});
+
+		if(shutdown) {
+			return;
+		}
+
+		const size_t chunk = nextToDecode++;
+
+		lock.unlock();
+		std::vector<ProsperoChunkEntry> entries;
+		const bool ok = readChunk(chunk, entries);
+		lock.lock();
+
+		if(ok) {
+			decoded[chunk].swap(entries);
+		} else {
+			decodeFailed = true;
+			decoded[chunk].clear();
+		}
+
+		decodeChanged.notify_all();
+	}
+}
+
+ProsperoTraceEntry* ProsperoChunkedTraceReader::readNextEntry() {
+	output->verbose(CALL_INFO, 4, 0, "Reading next trace entry...\n");
+
+	while(currentEntry >= current.size()) {
+		if(nextChunk >= chunkIndex.size()) {
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			return NULL;
+		}
+
+		std::unique_lock<std::mutex> lock(decodeLock);
+
+		currentChunk = nextChunk++;
+		decodeChanged.notify_all();
+		decodeChanged.wait(lock, [this] { return decoded.count(currentChunk) > 0; });
+
+		if(decodeFailed) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: chunk %" PRIu64 " of the trace could not be decoded.\n",
+				getName().c_str(), (uint64_t) currentChunk);
+		}
+
+		current.swap(decoded[currentChunk]);
+		decoded.erase(currentChunk);
+		currentEntry = 0;
+	}
+
+	const ProsperoChunkEntry& entry = current[currentEntry++];
+
+	return new ProsperoTraceEntry(entry.cycles - cycleBase, entry.address, entry.length,
+		entry.write ? WRITE : READ);
+}
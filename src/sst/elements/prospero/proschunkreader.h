@@ -0,0 +1,91 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_CHUNK_READER
+#define _H_SST_PROSPERO_CHUNK_READER
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "prosreader.h"
+#include "prostracechunk.h"
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Reads the chunked trace format (see prostracechunk.h). The chunk index is
+ * loaded up front, worker threads decompress and decode the chunks ahead of
+ * the one being replayed, and replay can start at any entry or cycle.
+ */
+class ProsperoChunkedTraceReader : public ProsperoTraceReader {
+
+public:
+    ProsperoChunkedTraceReader( ComponentId_t id, Params& params, Output* out );
+    ~ProsperoChunkedTraceReader();
+    ProsperoTraceEntry* readNextEntry();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        ProsperoChunkedTraceReader,
+        "prospero",
+        "ProsperoChunkedTraceReader",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Chunked, compressed and indexed trace reader with parallel decompression",
+        SST::Prospero::ProsperoTraceReader
+	)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "file", "Sets the file for the trace reader to use", "" },
+        { "decode_threads", "Number of threads decompressing chunks ahead of replay", "2" },
+        { "prefetch_chunks", "Number of chunks decoded ahead of the one being replayed", "4" },
+        { "start_entry", "Begin replay at this entry of the trace", "0" },
+        { "start_cycle", "Begin replay at the first entry issued at or after this cycle, overrides start_entry when non-zero", "0" }
+    )
+
+private:
+	void loadIndex(const std::string& traceFile);
+	void decodeLoop();
+	bool readChunk(const size_t chunk, std::vector<ProsperoChunkEntry>& entries);
+
+	FILE* traceInput;
+	std::vector<ProsperoChunkIndexEntry> chunkIndex;
+
+	// Replay position
+	std::vector<ProsperoChunkEntry> current;
+	size_t currentChunk;
+	size_t nextChunk;
+	size_t currentEntry;
+	uint64_t cycleBase;
+
+	// Shared with the decode threads
+	std::vector<std::thread> decoders;
+	std::mutex decodeLock;
+	std::condition_variable decodeChanged;
+	std::map<size_t, std::vector<ProsperoChunkEntry> > decoded;
+	size_t nextToDecode;
+	size_t prefetchChunks;
+	bool decodeFailed;
+	bool shutdown;
+
+};
+
+}
+}
+
+#endif
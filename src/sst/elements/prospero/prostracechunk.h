@@ -0,0 +1,287 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_TRACE_CHUNK
+#define _H_SST_PROSPERO_TRACE_CHUNK
+
+/*
+ * Chunked trace container, written by Ariel's ChunkedTraceGenerator and read
+ * by ProsperoChunkedTraceReader. This header has no SST dependencies so that
+ * both elements (and offline tools) can use it.
+ *
+ * File layout:
+ *
+ *   header   magic "PRSCHNK1", uint32 version, uint32 codec, uint32 chunk entries
+ *   chunk*   compressed chunk data
+ *   index    one ProsperoChunkIndexEntry per chunk
+ *   trailer  uint64 index offset, uint64 chunk count, uint64 total entries, magic "PRSCIDX1"
+ *
+ * Each chunk holds up to 'chunk entries' trace entries and is compressed on its
+ * own, so chunks can be decompressed in parallel and replay can start at any
+ * chunk. Inside a chunk every entry is three varints:
+ *
+ *   zigzag(cycles - previous cycles)
+ *   (length << 1) | is-write
+ *   zigzag(address - previous address)
+ *
+ * where the previous values are zero at the start of each chunk. All integers
+ * in the header, index and trailer are little endian.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "zlib.h"
+
+namespace SST {
+namespace Prospero {
+
+#define PROSPERO_CHUNK_FILE_MAGIC    "PRSCHNK1"
+#define PROSPERO_CHUNK_INDEX_MAGIC   "PRSCIDX1"
+#define PROSPERO_CHUNK_MAGIC_LENGTH  8
+#define PROSPERO_CHUNK_VERSION       1
+#define PROSPERO_CHUNK_HEADER_BYTES  (PROSPERO_CHUNK_MAGIC_LENGTH + 3 * sizeof(uint32_t))
+#define PROSPERO_CHUNK_TRAILER_BYTES (3 * sizeof(uint64_t) + PROSPERO_CHUNK_MAGIC_LENGTH)
+
+typedef enum {
+    PROSPERO_CHUNK_CODEC_ZLIB = 1
+} ProsperoChunkCodec;
+
+struct ProsperoChunkEntry {
+    uint64_t cycles;
+    uint64_t address;
+    uint32_t length;
+    bool     write;
+};
+
+struct ProsperoChunkIndexEntry {
+    uint64_t offset;            // file offset of the compressed chunk
+    uint64_t firstEntry;        // trace position of the chunk's first entry
+    uint64_t firstCycle;        // cycles of the chunk's first entry
+    uint32_t compressedBytes;
+    uint32_t rawBytes;
+    uint32_t entries;
+};
+
+#define PROSPERO_CHUNK_INDEX_ENTRY_BYTES (3 * sizeof(uint64_t) + 3 * sizeof(uint32_t))
+
+static inline uint64_t prosperoZigZag(const int64_t v) {
+    return (((uint64_t) v) << 1) ^ (uint64_t) (v >> 63);
+}
+
+static inline int64_t prosperoUnZigZag(const uint64_t v) {
+    return (int64_t) (v >> 1) ^ -((int64_t) (v & 1));
+}
+
+static inline void prosperoPutVarint(std::vector<uint8_t>& buffer, uint64_t v) {
+    while(v >= 0x80) {
+        buffer.push_back((uint8_t) (v | 0x80));
+        v >>= 7;
+    }
+    buffer.push_back((uint8_t) v);
+}
+
+// Returns false if the varint runs past 'end'
+static inline bool prosperoGetVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for(uint32_t shift = 0; shift < 64 && p < end; shift += 7) {
+        const uint8_t byte = *p++;
+        v |= ((uint64_t) (byte & 0x7F)) << shift;
+
+        if(0 == (byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline void prosperoPutLE(uint8_t* dest, uint64_t v, const size_t bytes) {
+    for(size_t i = 0; i < bytes; ++i) {
+        dest[i] = (uint8_t) (v >> (8 * i));
+    }
+}
+
+static inline uint64_t prosperoGetLE(const uint8_t* src, const size_t bytes) {
+    uint64_t v = 0;
+    for(size_t i = 0; i < bytes; ++i) {
+        v |= ((uint64_t) src[i]) << (8 * i);
+    }
+    return v;
+}
+
+/*
+ * Builds the uncompressed form of one chunk
+ */
+class ProsperoChunkEncoder {
+public:
+    ProsperoChunkEncoder() { reset(); }
+
+    void reset() {
+        raw.clear();
+        entryCount = 0;
+        firstCycle = 0;
+        lastCycle = 0;
+        lastAddress = 0;
+    }
+
+    void append(const uint64_t cycles, const uint64_t address, const uint32_t length, const bool write) {
+        if(0 == entryCount) {
+            firstCycle = cycles;
+        }
+
+        prosperoPutVarint(raw, prosperoZigZag((int64_t) (cycles - lastCycle)));
+        prosperoPutVarint(raw, (((uint64_t) length) << 1) | (write ? 1 : 0));
+        prosperoPutVarint(raw, prosperoZigZag((int64_t) (address - lastAddress)));
+
+        lastCycle = cycles;
+        lastAddress = address;
+        entryCount++;
+    }
+
+    uint32_t entries() const { return entryCount; }
+    uint64_t getFirstCycle() const { return firstCycle; }
+    std::vector<uint8_t>& data() { return raw; }
+
+private:
+    std::vector<uint8_t> raw;
+    uint32_t entryCount;
+    uint64_t firstCycle;
+    uint64_t lastCycle;
+    uint64_t lastAddress;
+};
+
+static inline bool prosperoDecodeChunk(const uint8_t* raw, const size_t rawBytes, const uint32_t entries,
+        std::vector<ProsperoChunkEntry>& out) {
+    const uint8_t* p   = raw;
+    const uint8_t* end = raw + rawBytes;
+    uint64_t cycles  = 0;
+    uint64_t address = 0;
+
+    out.resize(entries);
+
+    for(uint32_t i = 0; i < entries; ++i) {
+        uint64_t dCycles, lengthOp, dAddress;
+
+        if(!prosperoGetVarint(p, end, dCycles) || !prosperoGetVarint(p, end, lengthOp) ||
+                !prosperoGetVarint(p, end, dAddress)) {
+            return false;
+        }
+
+        cycles  += (uint64_t) prosperoUnZigZag(dCycles);
+        address += (uint64_t) prosperoUnZigZag(dAddress);
+
+        out[i].cycles  = cycles;
+        out[i].address = address;
+        out[i].length  = (uint32_t) (lengthOp >> 1);
+        out[i].write   = (lengthOp & 1) != 0;
+    }
+
+    return p == end;
+}
+
+static inline bool prosperoCompressChunk(const std::vector<uint8_t>& raw, std::vector<uint8_t>& out, const int level) {
+    uLongf outBytes = compressBound(raw.size());
+    out.resize(outBytes);
+
+    if(Z_OK != compress2(&out[0], &outBytes, raw.empty() ? (const Bytef*) "" : &raw[0], raw.size(), level)) {
+        return false;
+    }
+
+    out.resize(outBytes);
+    return true;
+}
+
+static inline bool prosperoUncompressChunk(const std::vector<uint8_t>& in, std::vector<uint8_t>& raw, const uint32_t rawBytes) {
+    uLongf outBytes = rawBytes;
+    raw.resize(rawBytes);
+
+    if(0 == rawBytes) {
+        return true;
+    }
+
+    return Z_OK == uncompress(&raw[0], &outBytes, &in[0], in.size()) && outBytes == rawBytes;
+}
+
+static inline void prosperoPackIndexEntry(uint8_t* dest, const ProsperoChunkIndexEntry& entry) {
+    prosperoPutLE(&dest[0],  entry.offset, 8);
+    prosperoPutLE(&dest[8],  entry.firstEntry, 8);
+    prosperoPutLE(&dest[16], entry.firstCycle, 8);
+    prosperoPutLE(&dest[24], entry.compressedBytes, 4);
+    prosperoPutLE(&dest[28], entry.rawBytes, 4);
+    prosperoPutLE(&dest[32], entry.entries, 4);
+}
+
+static inline void prosperoUnpackIndexEntry(const uint8_t* src, ProsperoChunkIndexEntry& entry) {
+    entry.offset          = prosperoGetLE(&src[0], 8);
+    entry.firstEntry      = prosperoGetLE(&src[8], 8);
+    entry.firstCycle      = prosperoGetLE(&src[16], 8);
+    entry.compressedBytes = (uint32_t) prosperoGetLE(&src[24], 4);
+    entry.rawBytes        = (uint32_t) prosperoGetLE(&src[28], 4);
+    entry.entries         = (uint32_t) prosperoGetLE(&src[32], 4);
+}
+
+/*
+ * Picks the chunk holding the first entry to replay, the last chunk that starts at
+ * or before startCycle (or startEntry when startCycle is zero)
+ */
+static inline size_t prosperoFindStartChunk(const std::vector<ProsperoChunkIndexEntry>& index,
+        const uint64_t startEntry, const uint64_t startCycle) {
+    size_t chunk = 0;
+
+    for(; chunk + 1 < index.size(); ++chunk) {
+        const ProsperoChunkIndexEntry& next = index[chunk + 1];
+
+        if((startCycle > 0) ? (next.firstCycle > startCycle) : (next.firstEntry > startEntry)) {
+            break;
+        }
+    }
+
+    return chunk;
+}
+
+/*
+ * Returns how many entries of 'chunk' come before the start and sets cycleBase to the
+ * cycles of the first entry replayed. If the start lies past the last entry of the
+ * chunk replay begins with the next chunk, whose first cycle is in the index.
+ */
+static inline size_t prosperoSkipToStart(const std::vector<ProsperoChunkIndexEntry>& index, const size_t chunk,
+        const std::vector<ProsperoChunkEntry>& entries, const uint64_t startEntry, const uint64_t startCycle,
+        uint64_t& cycleBase) {
+    size_t skip = 0;
+
+    while(skip < entries.size() &&
+        ((startCycle > 0) ? (entries[skip].cycles < startCycle) : (index[chunk].firstEntry + skip < startEntry))) {
+        skip++;
+    }
+
+    if(skip < entries.size()) {
+        cycleBase = entries[skip].cycles;
+    } else if(chunk + 1 < index.size()) {
+        cycleBase = index[chunk + 1].firstCycle;
+    } else {
+        cycleBase = 0;
+    }
+
+    return skip;
+}
+
+}
+}
+
+#endif
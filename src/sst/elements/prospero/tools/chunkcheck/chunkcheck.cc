@@ -0,0 +1,270 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Chunked trace round trip check
+ *
+ * Writes a random trace in the chunked format of prostracechunk.h the way
+ * Ariel's ChunkedTraceGenerator does, reads it back through the index the
+ * way ProsperoChunkedTraceReader does and compares every entry. Replay is
+ * then started at a set of entries and cycles, including cycles that fall
+ * between the last entry of one chunk and the first of the next, and the
+ * entries replayed and their rebased cycles are checked.
+ *
+ * usage: chunkcheck [-f file] [-n entries] [-c chunk-entries]
+ * Exits non-zero if any check fails.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "prostracechunk.h"
+
+using namespace SST::Prospero;
+
+/* xorshift64* */
+class CheckRNG {
+public:
+    CheckRNG(uint64_t seed) : state(seed ? seed : 1) { }
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+private:
+    uint64_t state;
+};
+
+/*
+ * Cycles step by 1 to 8 within a chunk and jump by 1000 between chunks, so
+ * every chunk boundary has a gap of cycles that belong to no entry.
+ */
+static void generate(std::vector<ProsperoChunkEntry>& trace, size_t count, uint32_t chunkEntries) {
+    CheckRNG rng(31);
+    uint64_t cycles = 100;
+    uint64_t address = 0x100000;
+    trace.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        cycles += (i % chunkEntries == 0) ? 1000 : 1 + rng.next() % 8;
+        /* mostly strided with some jumps backwards and forwards */
+        if (rng.next() % 16 == 0)
+            address = rng.next() % (1ULL << 48);
+        else
+            address += 64;
+        trace[i].cycles = cycles;
+        trace[i].address = address;
+        trace[i].length = 1 + rng.next() % 64;
+        trace[i].write = rng.next() & 1;
+    }
+}
+
+static bool writeTrace(const std::string& file, const std::vector<ProsperoChunkEntry>& trace, uint32_t chunkEntries) {
+    FILE* f = fopen(file.c_str(), "wb");
+    if (f == NULL)
+        return false;
+
+    uint8_t header[PROSPERO_CHUNK_HEADER_BYTES];
+    memcpy(&header[0], PROSPERO_CHUNK_FILE_MAGIC, PROSPERO_CHUNK_MAGIC_LENGTH);
+    prosperoPutLE(&header[PROSPERO_CHUNK_MAGIC_LENGTH], PROSPERO_CHUNK_VERSION, 4);
+    prosperoPutLE(&header[PROSPERO_CHUNK_MAGIC_LENGTH + 4], PROSPERO_CHUNK_CODEC_ZLIB, 4);
+    prosperoPutLE(&header[PROSPERO_CHUNK_MAGIC_LENGTH + 8], chunkEntries, 4);
+    bool ok = fwrite(header, 1, sizeof(header), f) == sizeof(header);
+
+    std::vector<ProsperoChunkIndexEntry> chunkIndex;
+    std::vector<uint8_t> compressed;
+    ProsperoChunkEncoder encoder;
+    uint64_t offset = sizeof(header);
+
+    for (size_t i = 0; ok && i < trace.size(); i++) {
+        encoder.append(trace[i].cycles, trace[i].address, trace[i].length, trace[i].write);
+        if (encoder.entries() < chunkEntries && i + 1 < trace.size())
+            continue;
+
+        ProsperoChunkIndexEntry entry;
+        entry.offset = offset;
+        entry.firstEntry = i + 1 - encoder.entries();
+        entry.firstCycle = encoder.getFirstCycle();
+        entry.rawBytes = (uint32_t) encoder.data().size();
+        entry.entries = encoder.entries();
+
+        ok = prosperoCompressChunk(encoder.data(), compressed, 1) &&
+            fwrite(&compressed[0], 1, compressed.size(), f) == compressed.size();
+        entry.compressedBytes = (uint32_t) compressed.size();
+        chunkIndex.push_back(entry);
+        offset += compressed.size();
+        encoder.reset();
+    }
+
+    std::vector<uint8_t> index(chunkIndex.size() * PROSPERO_CHUNK_INDEX_ENTRY_BYTES + PROSPERO_CHUNK_TRAILER_BYTES);
+    for (size_t i = 0; i < chunkIndex.size(); i++)
+        prosperoPackIndexEntry(&index[i * PROSPERO_CHUNK_INDEX_ENTRY_BYTES], chunkIndex[i]);
+
+    uint8_t* trailer = &index[chunkIndex.size() * PROSPERO_CHUNK_INDEX_ENTRY_BYTES];
+    prosperoPutLE(&trailer[0], offset, 8);
+    prosperoPutLE(&trailer[8], chunkIndex.size(), 8);
+    prosperoPutLE(&trailer[16], trace.size(), 8);
+    memcpy(&trailer[24], PROSPERO_CHUNK_INDEX_MAGIC, PROSPERO_CHUNK_MAGIC_LENGTH);
+
+    ok = ok && fwrite(&index[0], 1, index.size(), f) == index.size();
+    return fclose(f) == 0 && ok;
+}
+
+class TraceFile {
+public:
+    TraceFile() : f(NULL) { }
+    ~TraceFile() { if (f != NULL) fclose(f); }
+
+    bool open(const std::string& file) {
+        uint8_t header[PROSPERO_CHUNK_HEADER_BYTES];
+        uint8_t trailer[PROSPERO_CHUNK_TRAILER_BYTES];
+
+        f = fopen(file.c_str(), "rb");
+        if (f == NULL || fread(header, 1, sizeof(header), f) != sizeof(header) ||
+                memcmp(header, PROSPERO_CHUNK_FILE_MAGIC, PROSPERO_CHUNK_MAGIC_LENGTH) != 0)
+            return false;
+        if (fseek(f, -((long) sizeof(trailer)), SEEK_END) != 0 || fread(trailer, 1, sizeof(trailer), f) != sizeof(trailer) ||
+                memcmp(&trailer[24], PROSPERO_CHUNK_INDEX_MAGIC, PROSPERO_CHUNK_MAGIC_LENGTH) != 0)
+            return false;
+
+        std::vector<uint8_t> index(prosperoGetLE(&trailer[8], 8) * PROSPERO_CHUNK_INDEX_ENTRY_BYTES);
+        if (fseek(f, (long) prosperoGetLE(&trailer[0], 8), SEEK_SET) != 0 ||
+                (!index.empty() && fread(&index[0], 1, index.size(), f) != index.size()))
+            return false;
+
+        chunkIndex.resize(index.size() / PROSPERO_CHUNK_INDEX_ENTRY_BYTES);
+        for (size_t i = 0; i < chunkIndex.size(); i++)
+            prosperoUnpackIndexEntry(&index[i * PROSPERO_CHUNK_INDEX_ENTRY_BYTES], chunkIndex[i]);
+        return true;
+    }
+
+    bool readChunk(size_t chunk, std::vector<ProsperoChunkEntry>& entries) {
+        const ProsperoChunkIndexEntry& info = chunkIndex[chunk];
+        std::vector<uint8_t> compressed(info.compressedBytes);
+        std::vector<uint8_t> raw;
+
+        if (fseek(f, (long) info.offset, SEEK_SET) != 0 ||
+                (!compressed.empty() && fread(&compressed[0], 1, compressed.size(), f) != compressed.size()))
+            return false;
+        return prosperoUncompressChunk(compressed, raw, info.rawBytes) &&
+            prosperoDecodeChunk(raw.empty() ? NULL : &raw[0], raw.size(), info.entries, entries);
+    }
+
+    /* Replays from a start entry or cycle with the reader's seek, cycles are rebased */
+    bool replay(uint64_t startEntry, uint64_t startCycle, std::vector<ProsperoChunkEntry>& out) {
+        std::vector<ProsperoChunkEntry> entries;
+        size_t chunk = 0;
+        size_t skip = 0;
+        uint64_t cycleBase = 0;
+
+        out.clear();
+        if (chunkIndex.empty())
+            return true;
+        if (startCycle > 0 || startEntry > 0) {
+            chunk = prosperoFindStartChunk(chunkIndex, startEntry, startCycle);
+            if (!readChunk(chunk, entries))
+                return false;
+            skip = prosperoSkipToStart(chunkIndex, chunk, entries, startEntry, startCycle, cycleBase);
+        } else if (!readChunk(chunk, entries)) {
+            return false;
+        }
+
+        while (true) {
+            for (size_t i = skip; i < entries.size(); i++) {
+                out.push_back(entries[i]);
+                out.back().cycles -= cycleBase;
+            }
+            skip = 0;
+            if (++chunk >= chunkIndex.size())
+                return true;
+            if (!readChunk(chunk, entries))
+                return false;
+        }
+    }
+
+    std::vector<ProsperoChunkIndexEntry> chunkIndex;
+
+private:
+    FILE* f;
+};
+
+/* Replay must produce trace[first...] with cycles relative to 'base' */
+static bool check(TraceFile& reader, const std::vector<ProsperoChunkEntry>& trace, const char* what,
+        uint64_t startEntry, uint64_t startCycle, size_t first, uint64_t base) {
+    std::vector<ProsperoChunkEntry> got;
+    bool ok = reader.replay(startEntry, startCycle, got) && got.size() == trace.size() - first;
+
+    for (size_t i = 0; ok && i < got.size(); i++) {
+        const ProsperoChunkEntry& want = trace[first + i];
+        ok = got[i].cycles == want.cycles - base && got[i].address == want.address &&
+            got[i].length == want.length && got[i].write == want.write;
+    }
+    printf("%s: %s, start entry %" PRIu64 " cycle %" PRIu64 ", %zu entries replayed\n",
+            ok ? "PASS" : "FAIL", what, startEntry, startCycle, got.size());
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    std::string file = "/tmp/chunkcheck.trace.chk";
+    size_t count = 100000;
+    uint32_t chunkEntries = 4096;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-f") == 0) {
+            file = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            count = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-c") == 0) {
+            chunkEntries = strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: chunkcheck [-f file] [-n entries] [-c chunk-entries]\n");
+            exit(1);
+        }
+    }
+    if (count < 2 || chunkEntries < 2 || count <= chunkEntries) {
+        fprintf(stderr, "chunkcheck: need at least two chunks of at least two entries\n");
+        exit(1);
+    }
+
+    std::vector<ProsperoChunkEntry> trace;
+    generate(trace, count, chunkEntries);
+
+    TraceFile reader;
+    if (!writeTrace(file, trace, chunkEntries) || !reader.open(file)) {
+        printf("FAIL: unable to write and reopen %s\n", file.c_str());
+        return 1;
+    }
+
+    int failures = 0;
+    const size_t last = chunkEntries - 1;  /* last entry of the first chunk */
+
+    failures += !check(reader, trace, "whole trace", 0, 0, 0, 0);
+    failures += !check(reader, trace, "mid chunk entry", chunkEntries / 2, 0, chunkEntries / 2, trace[chunkEntries / 2].cycles);
+    failures += !check(reader, trace, "first entry of a chunk", chunkEntries, 0, chunkEntries, trace[chunkEntries].cycles);
+    failures += !check(reader, trace, "last entry", count - 1, 0, count - 1, trace[count - 1].cycles);
+    failures += !check(reader, trace, "cycle of an entry", 0, trace[last].cycles, last, trace[last].cycles);
+    failures += !check(reader, trace, "cycle between entries", 0, trace[last - 1].cycles + 1, last, trace[last].cycles);
+    /* Skips all of the first chunk, replay starts with the next chunk and at its first cycle */
+    failures += !check(reader, trace, "cycle past the end of a chunk", 0, trace[last].cycles + 1,
+            chunkEntries, trace[chunkEntries].cycles);
+    failures += !check(reader, trace, "cycle past the end of the trace", 0, trace[count - 1].cycles + 1, count, 0);
+
+    remove(file.c_str());
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_SAMBA_PAGE_TABLE
+#define _H_SST_SAMBA_PAGE_TABLE
+
+#include <stdint.h>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace SambaComponent {
+
+// Radix table keyed by page number, used for the PGD/PUD/PMD/PTE tables and the
+// pending/mapped page sets. Each key is split into three 9-bit indices (leaf, middle,
+// upper) like a hardware page table; whatever bits remain above that select an upper
+// node through a small directory, which for 48-bit virtual addresses is one entry.
+//
+// Nodes come from an arena and are only released when the table is destroyed, erase
+// just clears the presence bit. The interface mirrors the subset of std::map used by
+// Samba: find() returns a pointer to the value or end() (NULL) when the key is absent,
+// and operator[] inserts a value-initialized entry.
+template<typename T>
+class PageTableMap {
+public:
+    typedef uint64_t key_type;
+    typedef T* iterator;
+
+    PageTableMap() : count(0), cachedTop(~0ULL), cachedUpper(NULL), cachedLeafKey(~0ULL), cachedLeaf(NULL),
+        nodesLeft(0), leavesLeft(0) {}
+
+    ~PageTableMap() {
+        for (size_t i = 0; i < nodeBlocks.size(); i++) delete [] nodeBlocks[i];
+        for (size_t i = 0; i < leafBlocks.size(); i++) delete [] leafBlocks[i];
+    }
+
+    T* find(key_type key) {
+        Leaf* leaf = getLeaf(key, false);
+        if (leaf == NULL) return end();
+
+        const uint32_t index = key & INDEX_MASK;
+        return leaf->isPresent(index) ? &leaf->value[index] : end();
+    }
+
+    T* end() const { return NULL; }
+
+    T& operator[](key_type key) {
+        Leaf* leaf = getLeaf(key, true);
+        const uint32_t index = key & INDEX_MASK;
+
+        if (!leaf->isPresent(index)) {
+            leaf->present[index / 64] |= (1ULL << (index % 64));
+            leaf->value[index] = T();
+            count++;
+        }
+        return leaf->value[index];
+    }
+
+    size_t erase(key_type key) {
+        Leaf* leaf = getLeaf(key, false);
+        if (leaf == NULL) return 0;
+
+        const uint32_t index = key & INDEX_MASK;
+        if (!leaf->isPresent(index)) return 0;
+
+        leaf->present[index / 64] &= ~(1ULL << (index % 64));
+        count--;
+        return 1;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    PageTableMap(const PageTableMap&) = delete;
+    PageTableMap& operator=(const PageTableMap&) = delete;
+
+    static const uint32_t INDEX_BITS = 9;
+    static const uint32_t FANOUT = 1 << INDEX_BITS;
+    static const uint64_t INDEX_MASK = FANOUT - 1;
+    static const uint32_t BLOCK_NODES = 16;
+
+    struct Leaf {
+        uint64_t present[FANOUT / 64];
+        T value[FANOUT];
+
+        bool isPresent(uint32_t index) const {
+            return (present[index / 64] >> (index % 64)) & 1;
+        }
+    };
+
+    struct Node {
+        void* child[FANOUT];
+    };
+
+    Leaf* getLeaf(key_type key, bool create) {
+        const key_type leafKey = key >> INDEX_BITS;
+        if (leafKey == cachedLeafKey) return cachedLeaf;
+
+        Node* upper = getUpper(key >> (3 * INDEX_BITS), create);
+        if (upper == NULL) return NULL;
+
+        void*& middleSlot = upper->child[(key >> (2 * INDEX_BITS)) & INDEX_MASK];
+        if (middleSlot == NULL) {
+            if (!create) return NULL;
+            middleSlot = allocateNode();
+        }
+
+        void*& leafSlot = static_cast<Node*>(middleSlot)->child[(key >> INDEX_BITS) & INDEX_MASK];
+        if (leafSlot == NULL) {
+            if (!create) return NULL;
+            leafSlot = allocateLeaf();
+        }
+
+        cachedLeafKey = leafKey;
+        cachedLeaf = static_cast<Leaf*>(leafSlot);
+        return cachedLeaf;
+    }
+
+    Node* getUpper(key_type top, bool create) {
+        if (top == cachedTop) return cachedUpper;
+
+        Node* upper = NULL;
+        typename std::unordered_map<key_type, Node*>::iterator it = directory.find(top);
+        if (it != directory.end()) {
+            upper = it->second;
+        } else if (create) {
+            upper = allocateNode();
+            directory[top] = upper;
+        } else {
+            return NULL;
+        }
+
+        cachedTop = top;
+        cachedUpper = upper;
+        return upper;
+    }
+
+    Node* allocateNode() {
+        if (nodesLeft == 0) {
+            nodeBlocks.push_back(new Node[BLOCK_NODES]);
+            std::memset(nodeBlocks.back(), 0, sizeof(Node) * BLOCK_NODES);
+            nodesLeft = BLOCK_NODES;
+        }
+        return &nodeBlocks.back()[BLOCK_NODES - nodesLeft--];
+    }
+
+    Leaf* allocateLeaf() {
+        if (leavesLeft == 0) {
+            leafBlocks.push_back(new Leaf[BLOCK_NODES]);
+            for (uint32_t i = 0; i < BLOCK_NODES; i++)
+                std::memset(leafBlocks.back()[i].present, 0, sizeof(leafBlocks.back()[i].present));
+            leavesLeft = BLOCK_NODES;
+        }
+        return &leafBlocks.back()[BLOCK_NODES - leavesLeft--];
+    }
+
+    size_t count;
+
+    std::unordered_map<key_type, Node*> directory;
+    key_type cachedTop;
+    Node* cachedUpper;
+    key_type cachedLeafKey;
+    Leaf* cachedLeaf;
+
+    std::vector<Node*> nodeBlocks;
+    std::vector<Leaf*> leafBlocks;
+    uint32_t nodesLeft;
+    uint32_t leavesLeft;
+};
+
+}
+}
+
+#endif
@@ -102,9 +102,9 @@ PageTableWalker::PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker *
     assoc = new int[sizes];
     page_size = new uint64_t[sizes];
     sets = new int[sizes];
-    tags = new Address_t**[sizes];
-    valid = new bool**[sizes];
-    lru = new int **[sizes];
+    tags = new Address_t*[sizes];
+    valid = new bool*[sizes];
+    lru = new int*[sizes];
 
 
     // page table offsets
@@ -132,22 +132,19 @@ PageTableWalker::PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker *
     for(int id=0; id< sizes; id++)
     {
 
-        tags[id] = new Address_t*[sets[id]];
+        tags[id] = new Address_t[sets[id]*assoc[id]];
 
-        valid[id] = new bool*[sets[id]];
+        valid[id] = new bool[sets[id]*assoc[id]];
 
-        lru[id] = new int*[sets[id]];
+        lru[id] = new int[sets[id]*assoc[id]];
 
         for(int i=0; i < sets[id]; i++)
         {
-            tags[id][i]=new Address_t[assoc[id]];
-            valid[id][i]=new bool[assoc[id]];
-            lru[id][i]=new int[assoc[id]];
             for(int j=0; j<assoc[id];j++)
             {
-                tags[id][i][j]=-1;
-                valid[id][i][j]=false;
-                lru[id][i][j]=j;
+                tags[id][i*assoc[id] + j]=-1;
+                valid[id][i*assoc[id] + j]=false;
+                lru[id][i*assoc[id] + j]=j;
             }
         }
 
@@ -904,9 +901,9 @@ void PageTableWalker::initaitePageMigration(Address_t vaddress, Address_t paddre
 void PageTableWalker::insert_way(Address_t vaddr, int way, int struct_id)
 {
 
-    int set=abs_int_Samba((vaddr/page_size[struct_id])%sets[struct_id]);
-    tags[struct_id][set][way]=vaddr/page_size[struct_id];
-    valid[struct_id][set][way]=true;
+    int set_base= abs_int_Samba((vaddr/page_size[struct_id])%sets[struct_id])*assoc[struct_id];
+    tags[struct_id][set_base+way]=vaddr/page_size[struct_id];
+    valid[struct_id][set_base+way]=true;
 
 }
 
@@ -925,10 +922,10 @@ void PageTableWalker::invalidate(Address_t vadd, int id)
 
     for(int id=0; id<sizes; id++)
     {
-        int set= abs_int_Samba((vadd*page_size[0]/page_size[id])%sets[id]);
+        int set_base= abs_int_Samba((vadd*page_size[0]/page_size[id])%sets[id])*assoc[id];
         for(int i=0; i<assoc[id]; i++) {
-            if(tags[id][set][i]==vadd*page_size[0]/page_size[id] && valid[id][set][i]) {
-                valid[id][set][i] = false;
+            if(tags[id][set_base+i]==vadd*page_size[0]/page_size[id] && valid[id][set_base+i]) {
+                valid[id][set_base+i] = false;
                 break;
             }
         }
@@ -950,11 +947,11 @@ bool PageTableWalker::check_hit(Address_t vadd, int struct_id)
 {
 
 
-    int set= abs_int_Samba((vadd/page_size[struct_id])%sets[struct_id]);
+    int set_base= abs_int_Samba((vadd/page_size[struct_id])%sets[struct_id])*assoc[struct_id];
 
     for(int i=0; i<assoc[struct_id];i++)
-        if(tags[struct_id][set][i]==vadd/page_size[struct_id])
-            return valid[struct_id][set][i];
+        if(tags[struct_id][set_base+i]==vadd/page_size[struct_id])
+            return valid[struct_id][set_base+i];
 
     return false;
 }
@@ -963,10 +960,10 @@ bool PageTableWalker::check_hit(Address_t vadd, int struct_id)
 int PageTableWalker::find_victim_way(Address_t vadd, int struct_id)
 {
 
-    int set= abs_int_Samba((vadd/page_size[struct_id])%sets[struct_id]);
+    int set_base= abs_int_Samba((vadd/page_size[struct_id])%sets[struct_id])*assoc[struct_id];
 
     for(int i=0; i<assoc[struct_id]; i++)
-        if(lru[struct_id][set][i]==(assoc[struct_id]-1))
+        if(lru[struct_id][set_base+i]==(assoc[struct_id]-1))
             return i;
 
 
@@ -978,19 +975,19 @@ void PageTableWalker::update_lru(Address_t vaddr, int struct_id)
 {
     int lru_place=assoc[struct_id]-1;
 
-    int set= abs_int_Samba((vaddr/page_size[struct_id])%sets[struct_id]);
+    int set_base= abs_int_Samba((vaddr/page_size[struct_id])%sets[struct_id])*assoc[struct_id];
     for(int i=0; i<assoc[struct_id];i++) {
-        if(tags[struct_id][set][i]==vaddr/page_size[struct_id])
+        if(tags[struct_id][set_base+i]==vaddr/page_size[struct_id])
         {
-            lru_place = lru[struct_id][set][i];
+            lru_place = lru[struct_id][set_base+i];
             break;
         }
     }
     for(int i=0; i<assoc[struct_id];i++) {
-        if(lru[struct_id][set][i]==lru_place)
-            lru[struct_id][set][i]=0;
-        else if(lru[struct_id][set][i]<lru_place)
-            lru[struct_id][set][i]++;
+        if(lru[struct_id][set_base+i]==lru_place)
+            lru[struct_id][set_base+i]=0;
+        else if(lru[struct_id][set_base+i]<lru_place)
+            lru[struct_id][set_base+i]++;
     }
 }
 
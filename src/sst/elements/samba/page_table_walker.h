@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "utils.h"
+#include "page_table.h"
 #include "page_fault_handler.h"
 
 // This file defines the page table walker
@@ -72,10 +73,10 @@ class PageTableWalker : public ComponentExtension
     int* assoc; // associativity of i-th PTWC (param)
     int* sets;  // number of sets in i-th PTWC (calculated)
 
-    // === PTWC data: arranged like so: [PTWC_level][set][ent_in_set]
-    Address_t *** tags;
-    bool *** valid;
-    int *** lru; // lru positions
+    // === PTWC data: arranged like so: [PTWC_level][set*assoc + ent_in_set]
+    Address_t ** tags;
+    bool ** valid;
+    int ** lru; // lru positions
 
     // == Stats
     int hits; // number of hits
@@ -106,21 +107,21 @@ class PageTableWalker : public ComponentExtension
 
     // Holds the PGD, PUD, PMT, PTE physical pointers
     // PTE should give you the exact physical address of the page
-    std::map<Address_t, Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
-    std::map<Address_t, Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
-    std::map<Address_t, Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
-    std::map<Address_t, Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
+    PageTableMap<Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
+    PageTableMap<Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
+    PageTableMap<Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
+    PageTableMap<Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
 
     // The structures below are used to quickly check if the page is mapped or not
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
+    PageTableMap<int> * MAPPED_PAGE_SIZE4KB;
+    PageTableMap<int> * MAPPED_PAGE_SIZE2MB;
+    PageTableMap<int> * MAPPED_PAGE_SIZE1GB;
 
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
+    PageTableMap<int> *PENDING_PAGE_FAULTS;
+    PageTableMap<int> *PENDING_PAGE_FAULTS_PGD;
+    PageTableMap<int> *PENDING_PAGE_FAULTS_PUD;
+    PageTableMap<int> *PENDING_PAGE_FAULTS_PMD;
+    PageTableMap<int> *PENDING_PAGE_FAULTS_PTE;
 
     // This link is used to send internal events within the page table walker
     SST::Link * s_EventChan;
@@ -138,11 +139,11 @@ class PageTableWalker : public ComponentExtension
     // === Holds incoming requests, "input queue"
     std::vector<MemHierarchy::MemEventBase *> not_serviced;
     std::vector<MemHierarchy::MemEventBase *> * service_back; // This is used to pass ready requests back to the previous level
-    std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * service_back_size; // This is used to pass the size of the  requests back to the previous level
+    MemEventIdMap<long long int> * service_back_size; // This is used to pass the size of the  requests back to the previous level
 
     // === Holds requests that have gotten the data they need, but we need to wait the duration of the latency before returning
     std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare> ready_by;
-    std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> ready_by_size; // keeps track of requests' sizes inside this structure
+    MemEventIdMap<long long int> ready_by_size; // keeps track of requests' sizes inside this structure
     std::vector<MemHierarchy::MemEventBase *> pending_misses; // This the number of pending misses, only erased when pushed back from next level
 
     SST::Cycle_t currTime;
@@ -156,9 +157,9 @@ class PageTableWalker : public ComponentExtension
     PageTableWalker(ComponentId_t id, int page_size, int assoc, PageTableWalker * next_level, int size);
     PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker * Next_level,int level, SST::Params& params);
 
-    void setPageTablePointers( Address_t * cr3, std::map<Address_t, Address_t> * pgd,  std::map<Address_t, Address_t> * pud,  std::map<Address_t, Address_t> * pmd, std::map<Address_t, Address_t> * pte,
-            std::map<Address_t,int> * gb,  std::map<Address_t,int> * mb,  std::map<Address_t,int> * kb, std::map<Address_t,int> * pr, int *cr3I, std::map<Address_t,int> *pf_pgd,  std::map<Address_t,int> *pf_pud,
-            std::map<Address_t,int> *pf_pmd, std::map<Address_t,int> * pf_pte)
+    void setPageTablePointers( Address_t * cr3, PageTableMap<Address_t> * pgd,  PageTableMap<Address_t> * pud,  PageTableMap<Address_t> * pmd, PageTableMap<Address_t> * pte,
+            PageTableMap<int> * gb,  PageTableMap<int> * mb,  PageTableMap<int> * kb, PageTableMap<int> * pr, int *cr3I, PageTableMap<int> *pf_pgd,  PageTableMap<int> *pf_pud,
+            PageTableMap<int> *pf_pmd, PageTableMap<int> * pf_pte)
     {
         CR3 = cr3;
         PGD = pgd;
@@ -223,12 +224,12 @@ class PageTableWalker : public ComponentExtension
 
     bool recvPageFaultResp(PageFaultHandler::PageFaultHandlerPacket pkt);
 
-    void setServiceBackSize( std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * x) { service_back_size = x;}
+    void setServiceBackSize( MemEventIdMap<long long int> * x) { service_back_size = x;}
 
 
     //==== JVOROBY: these appear to be unused? There's no lower-level TLB below the PTW, so noone to push-back to us
     //std::vector<MemHierarchy::MemEventBase *> * getPushedBack(){return & pushed_back;}
-    //std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * getPushedBackSize(){return & pushed_back_size;}
+    //MemEventIdMap<long long int> * getPushedBackSize(){return & pushed_back_size;}
 
 
     //===== Memory-request tracking structs
@@ -26,6 +26,7 @@
 #include <string>
 
 #include "utils.h"
+#include "page_table.h"
 #include "tlb_entry.h"
 #include "tlb_unit.h"
 #include "page_table_walker.h"
@@ -88,7 +89,7 @@ class TLBhierarchy : public ComponentExtension
     std::vector<SST::MemHierarchy::MemEventBase *> mem_reqs; // holds the current requests to be translated
 
     std::vector<std::pair<Address_t, int> > invalid_addrs;  // holds the invalidation requests
-    std::map<SST::MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> mem_reqs_sizes;
+    MemEventIdMap<long long int> mem_reqs_sizes;
                                                     // holds the current requests to be translated
     std::map<SST::Event *, uint64_t> time_tracker;   // used to track time spent on translating each request
 
@@ -102,23 +103,23 @@ class TLBhierarchy : public ComponentExtension
     Address_t *CR3;
 
     // Holds the PGD, PUD, PMT, PTE physical pointers
-    std::map<Address_t, Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
-    std::map<Address_t, Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
-    std::map<Address_t, Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
-    std::map<Address_t, Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
+    PageTableMap<Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
+    PageTableMap<Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
+    PageTableMap<Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
+    PageTableMap<Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
                                             // PTE should give you the exact physical address of the page
 
     // The structures below are used to quickly check if the page is mapped or not
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
+    PageTableMap<int> * MAPPED_PAGE_SIZE4KB;
+    PageTableMap<int> * MAPPED_PAGE_SIZE2MB;
+    PageTableMap<int> * MAPPED_PAGE_SIZE1GB;
 
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
-    std::map<Address_t,int> *PENDING_SHOOTDOWN_EVENTS;
+    PageTableMap<int> *PENDING_PAGE_FAULTS;
+    PageTableMap<int> *PENDING_PAGE_FAULTS_PGD;
+    PageTableMap<int> *PENDING_PAGE_FAULTS_PUD;
+    PageTableMap<int> *PENDING_PAGE_FAULTS_PMD;
+    PageTableMap<int> *PENDING_PAGE_FAULTS_PTE;
+    PageTableMap<int> *PENDING_SHOOTDOWN_EVENTS;
 
 
     public:
@@ -133,19 +134,19 @@ class TLBhierarchy : public ComponentExtension
 
 
     void setPageTablePointers(  Address_t * cr3,
-                                std::map<Address_t, Address_t> * pgd,
-                                std::map<Address_t, Address_t> * pud,
-                                std::map<Address_t, Address_t> * pmd,
-                                std::map<Address_t, Address_t> * pte,
-                                std::map<Address_t,int> * gb,
-                                std::map<Address_t,int> * mb,
-                                std::map<Address_t,int> * kb,
-                                std::map<Address_t,int> * pr,
+                                PageTableMap<Address_t> * pgd,
+                                PageTableMap<Address_t> * pud,
+                                PageTableMap<Address_t> * pmd,
+                                PageTableMap<Address_t> * pte,
+                                PageTableMap<int> * gb,
+                                PageTableMap<int> * mb,
+                                PageTableMap<int> * kb,
+                                PageTableMap<int> * pr,
                                 int *cr3I,
-                                std::map<Address_t,int> *pf_pgd,
-                                std::map<Address_t,int> *pf_pud,
-                                std::map<Address_t,int> *pf_pmd,
-                                std::map<Address_t,int> * pf_pte)
+                                PageTableMap<int> *pf_pgd,
+                                PageTableMap<int> *pf_pud,
+                                PageTableMap<int> *pf_pmd,
+                                PageTableMap<int> * pf_pte)
     {
                     CR3 = cr3;
                     PGD = pgd;
@@ -104,10 +104,10 @@ TLB::TLB(ComponentId_t id, int tlb_id, TLB * Next_level, int Level, SST::Params&
 	page_size = new uint64_t[sizes];
 	sets = new int[sizes];
 
-    // data arrays `foo[page_sizes][set][way]`
-	tags  = new Address_t**[sizes];
-	valid = new bool**[sizes];
-	lru   = new int **[sizes];
+    // data arrays `foo[page_sizes][set*assoc + way]`
+	tags  = new Address_t*[sizes];
+	valid = new bool*[sizes];
+	lru   = new int*[sizes];
 
     //Loop over each supported page size, getting params
 	for(int i=0; i < sizes; i++)
@@ -131,21 +131,17 @@ TLB::TLB(ComponentId_t id, int tlb_id, TLB * Next_level, int Level, SST::Params&
 	for(int id=0; id< sizes; id++)
 	{
 
-		tags[id]  = new Address_t*[sets[id]];
-		valid[id] = new bool*[sets[id]];
-		lru[id]   = new int*[sets[id]];
+		tags[id]  = new Address_t[sets[id]*assoc[id]];
+		valid[id] = new bool[sets[id]*assoc[id]];
+		lru[id]   = new int[sets[id]*assoc[id]];
 
 		for(int i=0; i < sets[id]; i++)
 		{
-			tags[id][i]  = new Address_t[assoc[id]];
-			valid[id][i] = new bool[assoc[id]];
-			lru[id][i]   = new int[assoc[id]];
-
 			for(int j=0; j<assoc[id];j++)
 			{
-				tags [id][i][j] = -1;
-				valid[id][i][j] = true;
-				lru  [id][i][j] = j;
+				tags [id][i*assoc[id] + j] = -1;
+				valid[id][i*assoc[id] + j] = true;
+				lru  [id][i*assoc[id] + j] = j;
 			}
 		}
 
@@ -435,9 +431,9 @@ bool TLB::tick(SST::Cycle_t x)
 void TLB::insert_way(Address_t vaddr, int way, int struct_id)
 {
 
-	int set=abs_int((vaddr/page_size[struct_id])%sets[struct_id]);
-	tags[struct_id][set][way]=vaddr/page_size[struct_id];
-	valid[struct_id][set][way]=true;
+	int set_base= abs_int((vaddr/page_size[struct_id])%sets[struct_id])*assoc[struct_id];
+	tags[struct_id][set_base+way]=vaddr/page_size[struct_id];
+	valid[struct_id][set_base+way]=true;
 
 }
 
@@ -459,11 +455,11 @@ void TLB::invalidate(Address_t vadd, int id)
 	for(int id=0; id<sizes; id++)
 	{
 		//std::cout << getName().c_str() << " TLB " << coreId << " id: " << id << " invalidate address: " << vadd << " index: " << vadd*page_size[0]/page_size[id] << std::endl;
-		int set= abs_int((vadd*page_size[0]/page_size[id])%sets[id]);
+		int set_base= abs_int((vadd*page_size[0]/page_size[id])%sets[id])*assoc[id];
 		for(int i=0; i<assoc[id]; i++) {
-			if(tags[id][set][i]==vadd*page_size[0]/page_size[id] && valid[id][set][i]) {
+			if(tags[id][set_base+i]==vadd*page_size[0]/page_size[id] && valid[id][set_base+i]) {
 				//std::cout << getName().c_str() << " TLB " << coreId << " invalidate address: " << vadd << " index: " << vadd*page_size[0]/page_size[id] << " found" << std::endl;
-				valid[id][set][i] = false;
+				valid[id][set_base+i] = false;
 				break;
 			}
 		}
@@ -479,10 +475,10 @@ bool TLB::check_hit(Address_t vadd, int struct_id)
 {
 
 
-	int set= abs_int((vadd/page_size[struct_id])%sets[struct_id]);
+	int set_base= abs_int((vadd/page_size[struct_id])%sets[struct_id])*assoc[struct_id];
 	for(int i=0; i<assoc[struct_id];i++)
-		if(tags[struct_id][set][i]==vadd/page_size[struct_id])
-			return valid[struct_id][set][i];
+		if(tags[struct_id][set_base+i]==vadd/page_size[struct_id])
+			return valid[struct_id][set_base+i];
 
 	return false;
 }
@@ -491,10 +487,10 @@ bool TLB::check_hit(Address_t vadd, int struct_id)
 int TLB::find_victim_way(Address_t vadd, int struct_id)
 {
 
-	int set= abs_int((vadd/page_size[struct_id])%sets[struct_id]);
+	int set_base= abs_int((vadd/page_size[struct_id])%sets[struct_id])*assoc[struct_id];
 
 	for(int i=0; i<assoc[struct_id]; i++)
-		if(lru[struct_id][set][i]==(assoc[struct_id]-1))
+		if(lru[struct_id][set_base+i]==(assoc[struct_id]-1))
 			return i;
 
 
@@ -507,19 +503,19 @@ void TLB::update_lru(Address_t vaddr, int struct_id)
 
 	int lru_place=assoc[struct_id]-1;
 
-	int set= abs_int((vaddr/page_size[struct_id])%sets[struct_id]);
+	int set_base= abs_int((vaddr/page_size[struct_id])%sets[struct_id])*assoc[struct_id];
 	for(int i=0; i<assoc[struct_id];i++)
-		if(tags[struct_id][set][i]==vaddr/page_size[struct_id])
+		if(tags[struct_id][set_base+i]==vaddr/page_size[struct_id])
 		{
-			lru_place = lru[struct_id][set][i];
+			lru_place = lru[struct_id][set_base+i];
 			break;
 		}
 	for(int i=0; i<assoc[struct_id];i++)
 	{
-		if(lru[struct_id][set][i]==lru_place)
-			lru[struct_id][set][i]=0;
-		else if(lru[struct_id][set][i]<lru_place)
-			lru[struct_id][set][i]++;
+		if(lru[struct_id][set_base+i]==lru_place)
+			lru[struct_id][set_base+i]=0;
+		else if(lru[struct_id][set_base+i]<lru_place)
+			lru[struct_id][set_base+i]++;
 	}
 
 
@@ -21,6 +21,7 @@
 #include <map>
 #include <vector>
 #include "utils.h"
+#include "page_table.h"
 
 // This file defines a TLB structure
 
@@ -55,10 +56,10 @@ class TLB : public ComponentExtension
 
     // === Cache data for TLB entries
     // - separate cache for each size of page
-    // - accessed as `tags[page_size][set][way]`
-	Address_t *** tags;
-	bool ***valid; // status of the tags
-	int *** lru;   // lru positions
+    // - each page size keeps its sets in one flat array, accessed as `tags[page_size][set*assoc + way]`
+	Address_t ** tags;
+	bool **valid; // status of the tags
+	int ** lru;   // lru positions
 
 
     // === Counters
@@ -75,7 +76,7 @@ class TLB : public ComponentExtension
 	std::map<long long int, int> SIZE_LOOKUP; // This structure checks if a size is supported inside the structure, and its index structure
 
 	std::map< Address_t, std::map< MemHierarchy::MemEventBase *, int, MemEventPtrCompare>> SAME_MISS; // This tracks the misses for the same location and deduplicates them
-	std::map<Address_t, int> PENDING_MISS; // This tracks the addresses of the current master misses (other contained misses are tracked in SAME_MISS)
+	PageTableMap<int> PENDING_MISS; // This tracks the addresses of the current master misses (other contained misses are tracked in SAME_MISS)
 
 
     //=======================================================================
@@ -96,7 +97,7 @@ class TLB : public ComponentExtension
 
     // === Holds requests that have gotten the data they need, but we need to wait the duration of the latency before returning
 	std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare> ready_by; 
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> ready_by_size; // keeps track of requests' sizes inside this structure
+	MemEventIdMap<long long int> ready_by_size; // keeps track of requests' sizes inside this structure
 
 
     // === Buffers for sending requests up/down TLB hierarchy:
@@ -105,12 +106,12 @@ class TLB : public ComponentExtension
     
     // completed requests from deeper in TLB hierarchy will be returned into `this->pushed_back`
 	std::vector<MemHierarchy::MemEventBase *> pushed_back; // translation for requests, returned from lower-level structures
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> pushed_back_size; // page_sizes of the returned translations
+	MemEventIdMap<long long int> pushed_back_size; // page_sizes of the returned translations
 
     // when we're finished with a request, we send it back up the hierarchy by inserting into `service_back`
     // - pointer is wired up to `pushed_back` buffers of the next level up at TLB in constructor of TLBHierarchy
 	std::vector<MemHierarchy::MemEventBase *> * service_back; // used to pass ready requests back to the previous level
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * service_back_size; // page_size of ready requests for next level up
+	MemEventIdMap<long long int> * service_back_size; // page_size of ready requests for next level up
 
 
 
@@ -139,11 +140,11 @@ class TLB : public ComponentExtension
     // === Called by parent to wire up TLB levels to each other
     // this TLB will push completed requests into service_back (sending them back up the levels towards core)
 	void setServiceBack( std::vector<MemHierarchy::MemEventBase *> * x) { service_back = x;}
-	void setServiceBackSize( std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * x) { service_back_size = x;}
+	void setServiceBackSize( MemEventIdMap<long long int> * x) { service_back_size = x;}
 
     // lower-levels will return answered requests into this->pushed_back
 	std::vector<MemHierarchy::MemEventBase *> * getPushedBack(){return & pushed_back;}
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * getPushedBackSize(){return & pushed_back_size;}
+	MemEventIdMap<long long int> * getPushedBackSize(){return & pushed_back_size;}
 
 	void update_lru(Address_t vaddr, int struct_id);
 
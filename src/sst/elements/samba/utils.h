@@ -12,6 +12,8 @@
 #ifndef _H_SST_SAMBA_UTILS
 #define _H_SST_SAMBA_UTILS
 
+#include <vector>
+
 #include <sst/core/sst_types.h>
 #include <sst/core/event.h>
 #include <sst/elements/memHierarchy/memEventBase.h>
@@ -29,6 +31,82 @@ namespace SambaComponent {
             }
         }
     };
+
+    // Open-addressed table keyed by event ID, used for per-request bookkeeping that is only
+    // ever looked up by event (never iterated). Linear probing, erase shifts the following
+    // entries back so no tombstones are needed.
+    template<typename T>
+    class MemEventIdMap {
+    public:
+        MemEventIdMap() : count(0), slots(64) {}
+
+        T& operator[](const MemHierarchy::MemEventBase* ev) {
+            if ((count + 1) * 4 > slots.size() * 3) grow();
+
+            const SST::Event::id_type id = ev->getID();
+            size_t pos = findSlot(id);
+            if (!slots[pos].used) {
+                slots[pos].used = true;
+                slots[pos].id = id;
+                slots[pos].value = T();
+                count++;
+            }
+            return slots[pos].value;
+        }
+
+        size_t erase(const MemHierarchy::MemEventBase* ev) {
+            size_t pos = findSlot(ev->getID());
+            if (!slots[pos].used) return 0;
+
+            const size_t mask = slots.size() - 1;
+            size_t next = (pos + 1) & mask;
+            while (slots[next].used) {
+                size_t home = hash(slots[next].id) & mask;
+                // Move the entry into the hole unless its home lies cyclically in (pos, next]
+                if (((next - home) & mask) >= ((next - pos) & mask)) {
+                    slots[pos] = slots[next];
+                    pos = next;
+                }
+                next = (next + 1) & mask;
+            }
+            slots[pos].used = false;
+            count--;
+            return 1;
+        }
+
+        size_t size() const { return count; }
+
+    private:
+        struct Slot {
+            Slot() : used(false), value() {}
+            bool used;
+            SST::Event::id_type id;
+            T value;
+        };
+
+        static size_t hash(const SST::Event::id_type& id) {
+            uint64_t h = id.first * 0x9E3779B97F4A7C15ULL + (uint64_t) id.second;
+            return h ^ (h >> 29);
+        }
+
+        size_t findSlot(const SST::Event::id_type& id) const {
+            const size_t mask = slots.size() - 1;
+            size_t pos = hash(id) & mask;
+            while (slots[pos].used && slots[pos].id != id) pos = (pos + 1) & mask;
+            return pos;
+        }
+
+        void grow() {
+            std::vector<Slot> old(slots.size() * 2);
+            old.swap(slots);
+            for (size_t i = 0; i < old.size(); i++) {
+                if (old[i].used) slots[findSlot(old[i].id)] = old[i];
+            }
+        }
+
+        size_t count;
+        std::vector<Slot> slots;
+    };
 }
 }
 
@@ -18,6 +18,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <bitset>
 
@@ -28,7 +29,7 @@ template <typename T>
 class VanadisCircularQueue
 {
 public:
-    VanadisCircularQueue(const int size) : max_capacity(size) {
+    VanadisCircularQueue(const int size) : max_capacity(size), push_count(0) {
         data = new T[size];
         clear();
 
@@ -50,6 +51,7 @@ public:
         data[tail] = item;
         tail = incrementIndex(tail);
         count++;
+        push_count++;
     }
 
     T peek() {
@@ -78,6 +80,10 @@ public:
     size_t size() const { return count; }
     size_t capacity() const { return max_capacity; }
 
+    // Total number of items ever pushed, not reset by clear(). Lets a
+    // consumer find the entries added at the tail since it last looked.
+    uint64_t pushed() const { return push_count; }
+
     void clear() {
         head = 0;
         tail = 0;
@@ -97,6 +103,7 @@ private:
     int head;
     int tail;
     int count;
+    uint64_t push_count;
 
     T* data;
 
@@ -20,6 +20,7 @@
 #include <list>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 namespace SST {
 namespace Vanadis {
@@ -30,6 +31,9 @@ enum class VanadisCacheRecordDeletion {
     VANADIS_PERFORM_DELETE_ARRAY
 };
 
+// LRU cache of key/value records.  Recency is kept in a list and
+// each map entry holds its position in that list, so find, touch and
+// store are all O(1) (the list node is moved, never searched for).
 template <typename I, typename T, SST::Vanadis::VanadisCacheRecordDeletion D> class VanadisCache {
 public:
     VanadisCache(const size_t cache_entries) : max_entries(cache_entries) { reset(); }
@@ -40,18 +44,7 @@ public:
 
     void clear() {
         for (auto val_itr = data_values.begin(); val_itr != data_values.end(); val_itr++ ) {
-            switch(D) {
-                case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE: 
-                {
-                    delete val_itr->second;
-                } break;
-                case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY:
-                {
-                    delete[] val_itr->second;
-                } break;
-                case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_NO_DELETION:
-                {} break;
-            }
+            delete_value(val_itr->second.first);
         }
 
         ordering_q.clear();
@@ -66,24 +59,35 @@ public:
     bool contains(const I& value) const { return (data_values.find(value) != data_values.end()); }
 
     T find(const I& key) {
-        send_key_to_front(key);
-        return data_values.find(key)->second;
+        auto find_key = data_values.find(key);
+        send_key_to_front(find_key->second.second);
+        return find_key->second.first;
     }
 
     void store(const I& key, T value) {
-        if (LIKELY(contains(key))) {
-            send_key_to_front(key);
-	        data_values[key] = value;
+        auto find_key = data_values.find(key);
+
+        if (LIKELY(find_key != data_values.end())) {
+            send_key_to_front(find_key->second.second);
+
+            // the old record is owned by the cache, so it has to go
+            // when it is replaced
+            if (find_key->second.first != value) {
+                delete_value(find_key->second.first);
+                find_key->second.first = value;
+            }
         } else {
             kill_lru_key();
-            data_values.insert(std::pair<I, T>(key, value));
             ordering_q.push_front(key);
+            data_values.insert(std::make_pair(key, std::make_pair(value, ordering_q.begin())));
         }
     }
 
     void touch(const I& key) {
-        if (LIKELY(contains(key))) {
-            send_key_to_front(key);
+        auto find_key = data_values.find(key);
+
+        if (LIKELY(find_key != data_values.end())) {
+            send_key_to_front(find_key->second.second);
         }
     }
 
@@ -91,55 +95,44 @@ public:
     size_t capacity() const { return max_entries; }
 
 private:
-    void kill_lru_key() {
-        // if we aren't full yet, then keep entries otherwise we will
-        // throw away
-        if (UNLIKELY(ordering_q.size() < max_entries)) {
-            return;
-        }
-
-        const I remove_key = ordering_q.back();
-        ordering_q.pop_back();
-
-        auto find_key = data_values.find(remove_key);
+    typedef typename std::list<I>::iterator order_itr_t;
 
+    void delete_value(T value) {
         switch(D) {
-            case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE: 
+            case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE:
             {
-                delete find_key->second;
+                delete value;
             } break;
             case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY:
             {
-                delete[] find_key->second;
+                delete[] value;
             } break;
             case SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_NO_DELETION:
             {} break;
         }
-
-        data_values.erase(find_key);
     }
 
-    void send_key_to_front(const I& key) {
-        bool found_key = false;
-
-        for (auto order_itr = ordering_q.begin(); order_itr != ordering_q.end();) {
-            if (UNLIKELY(key == (*order_itr))) {
-                ordering_q.erase(order_itr);
-                found_key = true;
-                break;
-            } else {
-                order_itr++;
-            }
+    void kill_lru_key() {
+        // if we aren't full yet, then keep entries otherwise we will
+        // throw away
+        if (UNLIKELY(data_values.size() < max_entries) || UNLIKELY(ordering_q.empty())) {
+            return;
         }
 
-        if (LIKELY(found_key)) {
-            ordering_q.push_front(key);
-        }
+        auto find_key = data_values.find(ordering_q.back());
+        ordering_q.pop_back();
+
+        delete_value(find_key->second.first);
+        data_values.erase(find_key);
+    }
+
+    void send_key_to_front(order_itr_t order_itr) {
+        ordering_q.splice(ordering_q.begin(), ordering_q, order_itr);
     }
 
     const size_t max_entries;
     std::list<I> ordering_q;
-    std::unordered_map<I, T> data_values;
+    std::unordered_map<I, std::pair<T, order_itr_t>> data_values;
 };
 
 } // namespace Vanadis
@@ -24,6 +24,7 @@
 #include "lsq/vlsq.h"
 #include "os/vcpuos.h"
 #include "vbranch/vbranchbasic.h"
+#include "vbranch/vbranchdir.h"
 #include "vbranch/vbranchunit.h"
 #include "velf/velfinfo.h"
 #include "vinsloader.h"
@@ -79,7 +80,11 @@ public:
                               "Number of cache lines to store in the local L0 cache for instructions "
                               "pending decoding.", "4" },
                             { "loader_mode",
-                              "Operation of the loader, 0 = LRU (more accurate), 1 = INFINITE cache (faster simulation)", "0"})
+                              "Operation of the loader, 0 = LRU (more accurate), 1 = INFINITE cache (faster simulation)", "0"},
+                            { "shared_uop_cache",
+                              "Name of a micro-op cache shared by all decoders (on the same simulation thread) that give the "
+                              "same name, so code is decoded once rather than once per hardware thread. Within a name, threads "
+                              "only share with threads of the same process and binary. Empty means each decoder has its own cache.", ""})
 
     SST_ELI_DOCUMENT_STATISTICS( 
 				VANADIS_DECODER_ELI_STATISTICS
@@ -113,6 +118,11 @@ public:
             break;
         }
 
+        const std::string shared_uop_cache = params.find<std::string>("shared_uop_cache", "");
+        if ( ! shared_uop_cache.empty() ) {
+            ins_loader->shareUopCache(shared_uop_cache, uop_cache_size);
+        }
+
         branch_predictor = loadUserSubComponent<SST::Vanadis::VanadisBranchUnit>("branch_unit");
         os_handler       = loadUserSubComponent<SST::Vanadis::VanadisCPUOSHandler>("os_handler");
 
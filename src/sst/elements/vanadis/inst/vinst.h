@@ -19,6 +19,7 @@
 #include "decoder/visaopts.h"
 #include "inst/regfile.h"
 #include "inst/regstack.h"
+#include "inst/vinstpool.h"
 #include "inst/vinsttype.h"
 #include "inst/vregfmt.h"
 
@@ -48,30 +49,9 @@ public:
         count_isa_fp_reg_in(c_isa_fp_reg_in),
         count_isa_fp_reg_out(c_isa_fp_reg_out)
     {
-        phys_int_regs_in = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        std::memset(phys_int_regs_in, 0, count_phys_int_reg_in * sizeof( uint16_t ));
-
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-        std::memset(phys_int_regs_out, 0, count_phys_int_reg_out * sizeof( uint16_t ) );
-  
-        isa_int_regs_in = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        std::memset(isa_int_regs_in, 0, count_isa_int_reg_in * sizeof( uint16_t ));
- 
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-        std::memset(isa_int_regs_out, 0, count_isa_int_reg_out * sizeof( uint16_t ) );
-
-        phys_fp_regs_in = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        std::memset(phys_fp_regs_in, 0, count_phys_fp_reg_in * sizeof( uint16_t ));
-
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-        std::memset(phys_fp_regs_out, 0, count_phys_fp_reg_out * sizeof( uint16_t ));
-
-        isa_fp_regs_in = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        std::memset(isa_fp_regs_in, 0, count_isa_fp_reg_in * sizeof( uint16_t ) );
-
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-        std::memset(isa_fp_regs_out, 0, count_isa_fp_reg_out * sizeof( uint16_t ));
-  
+        allocateRegisterArrays();
+        if ( reg_block != nullptr ) { std::memset(reg_block, 0, countRegisterIndices() * sizeof(uint16_t)); }
+
         trapError             = false;
         hasExecuted           = false;
         hasIssued             = false;
@@ -80,17 +60,14 @@ public:
         hasROBSlot            = false;
     }
 
-    virtual ~VanadisInstruction()
-    {
-        if ( phys_int_regs_in != nullptr ) delete[] phys_int_regs_in;
-        if ( phys_int_regs_out != nullptr ) delete[] phys_int_regs_out;
-        if ( isa_int_regs_in != nullptr ) delete[] isa_int_regs_in;
-        if ( isa_int_regs_out != nullptr ) delete[] isa_int_regs_out;
-        if ( phys_fp_regs_in != nullptr ) delete[] phys_fp_regs_in;
-        if ( phys_fp_regs_out != nullptr ) delete[] phys_fp_regs_out;
-        if ( isa_fp_regs_in != nullptr ) delete[] isa_fp_regs_in;
-        if ( isa_fp_regs_out != nullptr ) delete[] isa_fp_regs_out;
-    }
+    virtual ~VanadisInstruction() { releaseRegisterArrays(); }
+
+    // Micro-ops are cloned into the ROB and deleted at retire/flush every
+    // cycle, so take the storage from the per-thread instruction pool
+    // rather than the host allocator. The sized delete is handed the size
+    // of the most derived type through the virtual destructor.
+    static void* operator new(size_t size) { return VanadisInstructionPool::allocate(size); }
+    static void  operator delete(void* ptr, size_t size) { VanadisInstructionPool::release(ptr, size); }
 
     VanadisInstruction(const VanadisInstruction& copy_me) :
         ins_address(copy_me.ins_address),
@@ -112,48 +89,9 @@ public:
         isFrontOfROB          = false;
         hasROBSlot            = false;
 
-        phys_int_regs_in  = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-
-        isa_int_regs_in  = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-
-        phys_fp_regs_in  = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-
-        isa_fp_regs_in  = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-
-        for ( uint16_t i = 0; i < count_phys_int_reg_in; ++i ) {
-            phys_int_regs_in[i] = copy_me.phys_int_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_int_reg_out; ++i ) {
-            phys_int_regs_out[i] = copy_me.phys_int_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_int_reg_in; ++i ) {
-            isa_int_regs_in[i] = copy_me.isa_int_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_int_reg_out; ++i ) {
-            isa_int_regs_out[i] = copy_me.isa_int_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_fp_reg_in; ++i ) {
-            phys_fp_regs_in[i] = copy_me.phys_fp_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_fp_reg_out; ++i ) {
-            phys_fp_regs_out[i] = copy_me.phys_fp_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_fp_reg_in; ++i ) {
-            isa_fp_regs_in[i] = copy_me.isa_fp_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_fp_reg_out; ++i ) {
-            isa_fp_regs_out[i] = copy_me.isa_fp_regs_out[i];
+        allocateRegisterArrays();
+        if ( reg_block != nullptr ) {
+            std::memcpy(reg_block, copy_me.reg_block, countRegisterIndices() * sizeof(uint16_t));
         }
     }
 
@@ -349,6 +287,48 @@ public:
     }
 
 protected:
+    // Change the number of registers after construction, preserving the
+    // indices already assigned to the registers that remain
+    void resizeRegisterArrays(
+        const uint16_t c_phys_int_reg_in, const uint16_t c_phys_int_reg_out, const uint16_t c_isa_int_reg_in,
+        const uint16_t c_isa_int_reg_out, const uint16_t c_phys_fp_reg_in, const uint16_t c_phys_fp_reg_out,
+        const uint16_t c_isa_fp_reg_in, const uint16_t c_isa_fp_reg_out)
+    {
+        uint16_t*       old_block = reg_block;
+        const size_t    old_total = countRegisterIndices();
+        const uint16_t* old_regs[8] = { phys_int_regs_in, phys_int_regs_out, isa_int_regs_in, isa_int_regs_out,
+                                        phys_fp_regs_in,  phys_fp_regs_out,  isa_fp_regs_in,  isa_fp_regs_out };
+        const uint16_t  old_counts[8] = { count_phys_int_reg_in, count_phys_int_reg_out, count_isa_int_reg_in,
+                                          count_isa_int_reg_out, count_phys_fp_reg_in,  count_phys_fp_reg_out,
+                                          count_isa_fp_reg_in,   count_isa_fp_reg_out };
+
+        count_phys_int_reg_in  = c_phys_int_reg_in;
+        count_phys_int_reg_out = c_phys_int_reg_out;
+        count_isa_int_reg_in   = c_isa_int_reg_in;
+        count_isa_int_reg_out  = c_isa_int_reg_out;
+        count_phys_fp_reg_in   = c_phys_fp_reg_in;
+        count_phys_fp_reg_out  = c_phys_fp_reg_out;
+        count_isa_fp_reg_in    = c_isa_fp_reg_in;
+        count_isa_fp_reg_out   = c_isa_fp_reg_out;
+
+        allocateRegisterArrays();
+        if ( reg_block != nullptr ) { std::memset(reg_block, 0, countRegisterIndices() * sizeof(uint16_t)); }
+
+        uint16_t* new_regs[8] = { phys_int_regs_in, phys_int_regs_out, isa_int_regs_in, isa_int_regs_out,
+                                  phys_fp_regs_in,  phys_fp_regs_out,  isa_fp_regs_in,  isa_fp_regs_out };
+        const uint16_t new_counts[8] = { count_phys_int_reg_in, count_phys_int_reg_out, count_isa_int_reg_in,
+                                         count_isa_int_reg_out, count_phys_fp_reg_in,  count_phys_fp_reg_out,
+                                         count_isa_fp_reg_in,   count_isa_fp_reg_out };
+
+        for ( int i = 0; i < 8; ++i ) {
+            for ( uint16_t j = 0; j < new_counts[i] && j < old_counts[i]; ++j ) {
+                new_regs[i][j] = old_regs[i][j];
+            }
+        }
+
+        VanadisInstructionPool::release(old_block, old_total * sizeof(uint16_t));
+    }
+
     const uint64_t ins_address;
     const uint32_t hw_thread;
 
@@ -380,6 +360,46 @@ protected:
     bool hasROBSlot;
 
     const VanadisDecoderOptions* isa_options;
+
+    // All eight register index arrays live in one pooled block
+    uint16_t* reg_block;
+
+private:
+    size_t countRegisterIndices() const
+    {
+        return (size_t)count_phys_int_reg_in + count_phys_int_reg_out + count_isa_int_reg_in + count_isa_int_reg_out +
+               count_phys_fp_reg_in + count_phys_fp_reg_out + count_isa_fp_reg_in + count_isa_fp_reg_out;
+    }
+
+    uint16_t* carveRegisters(uint16_t*& next, const uint16_t count)
+    {
+        uint16_t* regs = (count > 0) ? next : nullptr;
+        next += count;
+        return regs;
+    }
+
+    void allocateRegisterArrays()
+    {
+        const size_t total = countRegisterIndices();
+        reg_block = (total > 0) ? static_cast<uint16_t*>(VanadisInstructionPool::allocate(total * sizeof(uint16_t)))
+                                : nullptr;
+
+        uint16_t* next    = reg_block;
+        phys_int_regs_in  = carveRegisters(next, count_phys_int_reg_in);
+        phys_int_regs_out = carveRegisters(next, count_phys_int_reg_out);
+        isa_int_regs_in   = carveRegisters(next, count_isa_int_reg_in);
+        isa_int_regs_out  = carveRegisters(next, count_isa_int_reg_out);
+        phys_fp_regs_in   = carveRegisters(next, count_phys_fp_reg_in);
+        phys_fp_regs_out  = carveRegisters(next, count_phys_fp_reg_out);
+        isa_fp_regs_in    = carveRegisters(next, count_isa_fp_reg_in);
+        isa_fp_regs_out   = carveRegisters(next, count_isa_fp_reg_out);
+    }
+
+    void releaseRegisterArrays()
+    {
+        VanadisInstructionPool::release(reg_block, countRegisterIndices() * sizeof(uint16_t));
+        reg_block = nullptr;
+    }
 };
 
 } // namespace Vanadis
@@ -0,0 +1,129 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_INSTRUCTION_POOL
+#define _H_VANADIS_INSTRUCTION_POOL
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace SST {
+namespace Vanadis {
+
+// Free lists for instruction objects and their register index arrays.
+//
+// Every micro-op that enters the ROB is a clone() of the decoded
+// instruction held in the uop cache and is deleted again at retire or
+// on a pipeline flush, so a running core allocates and frees the same
+// handful of object sizes every cycle. Blocks are segregated by size
+// (which, for instructions, means by concrete type) and kept on a per
+// host-thread free list, so once the pipeline has filled, clone() just
+// copy-constructs into a recycled block and never reaches the host
+// allocator. Lists are per host thread so that cores on different SST
+// threads never contend; nothing is ever returned to the host until
+// the thread exits.
+class VanadisInstructionPool {
+public:
+    static void* allocate(size_t bytes) {
+        const size_t size_class = sizeClass(bytes);
+
+        if ( size_class < NUM_SIZE_CLASSES && !listsDestroyed() ) {
+            FreeBlock* block = lists().head[size_class];
+
+            if ( nullptr != block ) {
+                lists().head[size_class] = block->next;
+                return block;
+            }
+
+            bytes = (size_class + 1) * GRANULE;
+        }
+
+        hostAllocationCount()++;
+        return ::operator new(bytes);
+    }
+
+    static void release(void* ptr, size_t bytes) {
+        if ( nullptr == ptr ) { return; }
+
+        const size_t size_class = sizeClass(bytes);
+
+        if ( size_class < NUM_SIZE_CLASSES && !listsDestroyed() ) {
+            FreeBlock* block         = static_cast<FreeBlock*>(ptr);
+            block->next              = lists().head[size_class];
+            lists().head[size_class] = block;
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+    // Number of times this host thread has had to go to the host
+    // allocator for an instruction or register array
+    static uint64_t hostAllocations() { return hostAllocationCount(); }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static const size_t GRANULE          = 16;
+    static const size_t NUM_SIZE_CLASSES = 32;
+
+    struct FreeLists {
+        FreeBlock* head[NUM_SIZE_CLASSES];
+
+        FreeLists() {
+            for ( size_t i = 0; i < NUM_SIZE_CLASSES; ++i ) {
+                head[i] = nullptr;
+            }
+        }
+
+        ~FreeLists() {
+            for ( size_t i = 0; i < NUM_SIZE_CLASSES; ++i ) {
+                while ( nullptr != head[i] ) {
+                    FreeBlock* next = head[i]->next;
+                    ::operator delete(head[i]);
+                    head[i] = next;
+                }
+            }
+
+            // Instructions deleted after this point (e.g. by a component
+            // torn down late in thread exit) go straight back to the host
+            listsDestroyed() = true;
+        }
+    };
+
+    static size_t sizeClass(size_t bytes) { return (bytes == 0) ? 0 : (bytes - 1) / GRANULE; }
+
+    static FreeLists& lists() {
+        static thread_local FreeLists free_lists;
+        return free_lists;
+    }
+
+    static uint64_t& hostAllocationCount() {
+        static thread_local uint64_t host_allocations = 0;
+        return host_allocations;
+    }
+
+    static bool& listsDestroyed() {
+        static thread_local bool lists_destroyed = false;
+        return lists_destroyed;
+    }
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
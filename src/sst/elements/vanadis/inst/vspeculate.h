@@ -58,6 +58,13 @@ public:
     virtual VanadisDelaySlotRequirement getDelaySlotType() const { return delayType; }
     uint64_t                            getInstructionWidth() const { return ins_width; }
 
+    // Address of the next instruction if the branch is not taken
+    uint64_t getFallThroughAddress() const
+    {
+        return (delayType == VANADIS_NO_DELAY_SLOT) ? getInstructionAddress() + ins_width
+                                                    : getInstructionAddress() + (ins_width * 2);
+    }
+
 protected:
     uint64_t calculateStandardNotTakenAddress()
     {
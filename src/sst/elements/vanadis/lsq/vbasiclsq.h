@@ -25,9 +25,12 @@
 #include "util/vsignx.h"
 #include "inst/vstorecond.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <cstdint>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <queue>
 
@@ -54,7 +57,8 @@ public:
             { "max_loads", "Set the maximum number of loads permitted in the queue", "16" },
             { "address_mask", "Can mask off address bits if needed during construction of a operation", "0xFFFFFFFFFFFFFFFF"},
             { "issues_per_cycle", "Maximum number of issues the LSQ can attempt per cycle.", "2"},
-            { "cache_line_width", "Number of bytes in a (L1) cache line", "64"}
+            { "cache_line_width", "Number of bytes in a (L1) cache line", "64"},
+            { "load_coalescing", "Combine loads waiting in the queue to the same cache line into one memory request", "1"}
         )
 
     SST_ELI_DOCUMENT_STATISTICS({ "bytes_read", "Count all the bytes read for data operations", "bytes", 1 },
@@ -70,7 +74,9 @@ public:
                                 { "stores_in_flight", "Count the number of stores which are in-flight", "operations", 1},
                                 { "store_buffer_entries", "Count the number of stores held in the store buffer", "operations", 1},
                                 { "split_stores", "Count the number of stores which are fractured due to cache boundaries", "operations", 1},
-                                { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1})
+                                { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1},
+                                { "loads_forwarded", "Count the number of loads which took their data from a pending store", "operations", 1},
+                                { "loads_coalesced", "Count the number of loads which shared a memory request with an older load", "operations", 1})
 
     VanadisBasicLoadStoreQueue(ComponentId_t id, Params& params, int coreid, int hwthreads) : VanadisLoadStoreQueue(id, params, coreid, hwthreads),
         max_stores(params.find<size_t>("max_stores", 8)),
@@ -87,6 +93,7 @@ public:
         address_mask = params.find<uint64_t>("address_mask", 0xFFFFFFFFFFFFFFFFULL);
 
         cache_line_width = params.find<uint64_t>("cache_line_width", 64);
+        load_coalescing = params.find<bool>("load_coalescing", true);
 
         op_q.resize(hw_threads);
         op_q_index = 0;
@@ -95,6 +102,7 @@ public:
         stores_pending.resize(hw_threads);
         stores_pending_index = 0;
         stores_pending_size = 0;
+        store_granules.resize(hw_threads);
 
         stat_loads_issued = registerStatistic<uint64_t>("loads_issued", "1");
         stat_stores_issued = registerStatistic<uint64_t>("stores_issued", "1");
@@ -111,6 +119,8 @@ public:
         stat_stores_pending = registerStatistic<uint64_t>("stores_in_flight", "1");
         stat_loads_pending = registerStatistic<uint64_t>("loads_in_flight", "1");
         stat_op_q_size = registerStatistic<uint64_t>("operations_pending");
+        stat_loads_forwarded = registerStatistic<uint64_t>("loads_forwarded", "1");
+        stat_loads_coalesced = registerStatistic<uint64_t>("loads_coalesced", "1");
     }
 
     virtual ~VanadisBasicLoadStoreQueue() {
@@ -171,6 +181,7 @@ public:
         }
 
         stores_pending_size -= stores_pending[thread].size();
+        store_granules[thread].clear();
         for(auto store_itr = stores_pending[thread].begin(); store_itr != stores_pending[thread].end(); ) {
             delete (*store_itr);
             store_itr = stores_pending[thread].erase(store_itr);
@@ -272,31 +283,48 @@ protected:
             out->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "-> handle read-response (virt-addr: 0x%" PRI_ADDR ")\n", ev->vAddr);
             lsq->stat_loaded_bytes->addData(ev->size);
 
-            auto load_itr = lsq->loads_pending.begin();
-            VanadisBasicLoadPendingEntry* load_entry = nullptr;
+            bool found = false;
 
-            for(; load_itr != lsq->loads_pending.end(); load_itr++) {
-                if((*load_itr)->containsRequest(ev->getID())) {
-                    load_entry = *load_itr;
-                    break;
+            // a coalesced request answers several loads, each takes its own bytes from the payload
+            for(auto load_itr = lsq->loads_pending.begin(); load_itr != lsq->loads_pending.end(); ) {
+                VanadisBasicLoadPendingEntry* load_entry = *load_itr;
+
+                if(! load_entry->containsRequest(ev->getID())) {
+                    load_itr++;
+                    continue;
+                }
+
+                found = true;
+
+                if(handleLoadResponse(ev, load_entry)) {
+                    load_itr = lsq->loads_pending.erase(load_itr);
+                    delete load_entry;
+                } else {
+                    load_itr++;
                 }
             }
 
 #ifdef VANADIS_BUILD_DEBUG
-        if ( lsq->isDbgAddr( ev->vAddr ) ) {
-            VanadisLoadInstruction* load_ins = nullptr;
-            if ( load_entry ) {
-                load_ins = load_entry->getLoadInstruction();
+            if ( ! found && lsq->isDbgAddr( ev->vAddr ) ) {
+                printf("ReadResp::%s() load_address=%#" PRIx64 " %s ins_addr=%#" PRIx64 "\n",__func__,
+                    ev->vAddr, ev->getFail()? "Failed":"Success", (uint64_t) 0 );
             }
-            printf("ReadResp::%s() load_address=%#" PRIx64 " %s ins_addr=%#" PRIx64 "\n",__func__,
-                ev->vAddr, ev->getFail()? "Failed":"Success", load_ins ? load_ins->getInstructionAddress() : 0 );
-        }
 #endif
 
-            if(nullptr == load_entry) {
-                // not found, so previous cleared by a branch mis-predict ignore
-                return;
+            // if not found, the load was previously cleared by a branch mis-predict so ignore
+            delete ev;
+        }
+
+        // returns true when the load has all of its data and is executed
+        bool handleLoadResponse(StandardMem::ReadResp* ev, VanadisBasicLoadPendingEntry* load_entry) {
+            VanadisLoadInstruction* load_ins = load_entry->getLoadInstruction();
+
+#ifdef VANADIS_BUILD_DEBUG
+            if ( lsq->isDbgAddr( ev->vAddr ) ) {
+                printf("ReadResp::%s() load_address=%#" PRIx64 " %s ins_addr=%#" PRIx64 "\n",__func__,
+                    ev->vAddr, ev->getFail()? "Failed":"Success", load_ins->getInstructionAddress() );
             }
+#endif
 
             if(out->getVerboseLevel() >= 16) {
                 out->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG,
@@ -305,22 +333,19 @@ protected:
                                 ev->pAddr, load_entry->getHWThread());
             }
 
-            VanadisLoadInstruction* load_ins = load_entry->getLoadInstruction();
-
-            const uint16_t load_width = ev->size;
             const uint64_t load_address = load_entry->getLoadAddress();
-            const uint32_t hw_thr     = load_ins->getHWThread();
+            const uint32_t hw_thr       = load_ins->getHWThread();
+
+            // the part of the response which belongs to this load
+            const uint64_t data_start = std::max(ev->vAddr, load_address);
+            const uint64_t data_end   = std::min(ev->vAddr + ev->size, load_address + load_entry->getLoadWidth());
+            const uint16_t load_width = data_end - data_start;
+            const uint64_t addr_offset = data_start - load_address;
 
-            if ( ev->getFail() || ev->vAddr < 64) {
+            if ( ev->getFail() || data_start < 64) {
                 load_ins->flagError();
             }
 
-            uint16_t target_reg = 0;
-            uint16_t target_isa_reg = 0;
-            uint64_t reg_offset  = load_ins->getRegisterOffset();
-            uint64_t addr_offset = ev->vAddr - load_address;
-            uint32_t reg_width = 0;
-
             if(out->getVerboseLevel() >= 8) {
                 std::ostringstream str;
                 str << ", Payload: 0x";
@@ -328,91 +353,16 @@ protected:
                 for ( std::vector<uint8_t>::iterator it = ev->data.begin(); it != ev->data.end(); it++ ) {
                     str << std::setw(2) << static_cast<unsigned>(*it);
                 }
-                out->verbose(CALL_INFO, 0, VANADIS_DBG_LSQ_LOAD_FLG, "---> LSQ recv load event ins: 0x%" PRI_ADDR " / hw-thr: %" PRIu32 " / entry-addr: 0x%" PRI_ADDR " / entry-width: %" PRIu16 " / reg-offset: %" PRIu64 " / ev-addr: 0x%" PRI_ADDR " / ev-width: %" PRIu64 " / addr-offset %" PRIu64 " / sign-extend: %s / target-isa-reg: %" PRIu16 " / target-phys-reg: %" PRIu16 " / reg-type: %s / %s\n",
-                    load_ins->getInstructionAddress(), hw_thr, load_address, load_width, reg_offset, ev->vAddr, ev->size,
+                out->verbose(CALL_INFO, 0, VANADIS_DBG_LSQ_LOAD_FLG, "---> LSQ recv load event ins: 0x%" PRI_ADDR " / hw-thr: %" PRIu32 " / entry-addr: 0x%" PRI_ADDR " / entry-width: %" PRIu16 " / reg-offset: %" PRIu64 " / ev-addr: 0x%" PRI_ADDR " / ev-width: %" PRIu64 " / addr-offset %" PRIu64 " / sign-extend: %s / reg-type: %s / %s\n",
+                    load_ins->getInstructionAddress(), hw_thr, load_address, load_width, (uint64_t) load_ins->getRegisterOffset(), ev->vAddr, ev->size,
                     addr_offset, (load_ins->performSignExtension() ? "yes" : "no"),
-                    target_isa_reg, target_reg,
                     (load_ins->getValueRegisterType() == LOAD_INT_REGISTER) ? "int" : "fp",str.str().c_str());
 
             }
 
-
-            switch(load_ins->getValueRegisterType()) {
-            case LOAD_INT_REGISTER: {
-
-                if ( ! load_ins->trapsError() ) {;
-
-                target_isa_reg = load_ins->getISAIntRegOut(0);
-                target_reg = load_ins->getPhysIntRegOut(0);
-
-                assert(target_isa_reg < load_ins->getISAOptions()->countISAIntRegisters());
-
-                if(target_reg != load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
-                    reg_width = lsq->registerFiles->at(hw_thr)->getIntRegWidth();
-                    std::vector<uint8_t> register_value(reg_width);
-                    // copy entire register here
-                    lsq->registerFiles->at(hw_thr)->copyFromIntRegister(target_reg, 0, &register_value[0], reg_width);
-
-                    assert((reg_offset + addr_offset + ev->size) <= reg_width);
-
-                    for(auto i = 0; i < ev->size; ++i) {
-                        register_value.at(reg_offset + addr_offset + i) = ev->data[i];
-                    }
-
-                    // if we are the last request to be processed for this load (if any were split)
-                    // and we promised to do sign extension, then perform it now
-                    if(load_entry->countRequests() == 1) {
-                        if(load_ins->performSignExtension()) {
-                            if((register_value.at(reg_offset + addr_offset + load_width - 1) & 0x80) != 0) {
-                                for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                    register_value.at(i) = 0xFF;
-                                }
-                            } else {
-                                for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                    register_value.at(i) = 0x00;
-                                }
-                            }
-                        } else {
-                            for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                register_value.at(i) = 0x00;
-                            }
-                        }
-                    }
-
-                    lsq->registerFiles->at(hw_thr)->copyToIntRegister(target_reg, 0, &register_value[0], register_value.size());
-                }
-                }
-            } break;
-            case LOAD_FP_REGISTER: {
-
-                if ( ! load_ins->trapsError() ) {
-
-                target_isa_reg = load_ins->getISAFPRegOut(0);
-                target_reg = load_ins->getPhysFPRegOut(0);
-
-                reg_width = lsq->registerFiles->at(hw_thr)->getFPRegWidth();
-                std::vector<uint8_t> register_value(reg_width);
-
-                // copy entire register here
-                lsq->registerFiles->at(hw_thr)->copyFromFPRegister(target_reg, 0, &register_value[0], reg_width);
-
-                assert((reg_offset + addr_offset + ev->size) <= reg_width);
-
-                for(auto i = reg_offset + addr_offset; i < ev->size; ++i) {
-                    register_value.at(reg_offset + addr_offset + i) = ev->data[i];
-                }
-
-                if(load_entry->countRequests() == 1) {
-                    for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                        register_value.at(i) = 0xff;
-                    }
-                }
-
-                lsq->registerFiles->at(hw_thr)->copyToFPRegister(target_reg, 0, &register_value[0], reg_width);
-                }
-            } break;
-            default:
-                out->fatal(CALL_INFO, -1, "Unknown register type.\n");
+            if ( ! load_ins->trapsError() ) {
+                lsq->writeLoadRegister(load_ins, addr_offset, &ev->data[data_start - ev->vAddr], load_width,
+                    load_entry->countRequests() == 1);
             }
 
             ///////////////////////////////////////////////////////////////////////////////////
@@ -429,17 +379,15 @@ protected:
 
                 load_ins->markExecuted();
                 lsq->stat_loads_executed->addData(1);
-                lsq->loads_pending.erase(load_itr);
-                delete load_entry;
+                return true;
             } else {
                 if(out->getVerboseLevel() >= 9) {
                     out->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG,
                         "---> LSQ Execute: %s (0x%" PRI_ADDR " / thr:%" PRIu32 ") does not have all requests completed yet %zu left, will not execute until all done.\n",
                             load_ins->getInstCode(), load_ins->getInstructionAddress(), load_ins->getHWThread(), load_entry->countRequests());
                 }
+                return false;
             }
-
-            delete ev;
         }
 
         virtual void handle(StandardMem::WriteResp* ev) {
@@ -504,6 +452,7 @@ protected:
                     }
 
                     store_entry->getInstruction()->markExecuted();
+                    lsq->unindexStore(thr, store_entry);
                     lsq->stores_pending[thr].erase(lsq->stores_pending[thr].begin());
                     lsq->stores_pending_size--;
                     delete store_entry;
@@ -512,6 +461,7 @@ protected:
                 case MEM_TRANSACTION_LOCK:
                 {
                     store_entry->getInstruction()->markExecuted();
+                    lsq->unindexStore(thr, store_entry);
                     lsq->stores_pending[thr].erase(lsq->stores_pending[thr].begin());
                     lsq->stores_pending_size--;
                     delete store_entry;
@@ -576,6 +526,7 @@ protected:
 
                 // this was a standard store (not LLSC/LOCK) and we issued into system successfully
                 if(LIKELY(issue_result)) {
+                    unindexStore(thr, current_store);
                     stores_pending[thr].pop_front();
                     stores_pending_size--;
                     delete current_store;
@@ -610,7 +561,9 @@ protected:
         const uint64_t store_address = store_entry->getStoreAddress();
         const uint64_t store_width   = store_entry->getStoreWidth();
         StandardMem::Request* store_req = nullptr;
-        std::vector<uint8_t> payload(store_width);
+        uint8_t store_value[MAX_REGISTER_BYTES];
+
+        assert(store_width <= MAX_REGISTER_BYTES);
 
 #ifdef VANADIS_BUILD_DEBUG
         if ( isDbgInsAddr( store_ins->getInstructionAddress() ) || isDbgAddr( store_address ) ) {
@@ -619,28 +572,30 @@ protected:
 #endif
 
         const bool needs_split = operationStraddlesCacheLine(store_address, store_width);
+
+        // read the value once, split stores and the payload vectors are cut from this copy
+        registerFiles->at(store_entry->getHWThread())->copyFromRegister(store_ins->getValueRegisterType() == STORE_FP_REGISTER ?
+            store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1), store_ins->getRegisterOffset(), store_value, store_width,
+            store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+
         if(output->getVerboseLevel() >= 8) {
-            std::vector<uint8_t> tmp(store_width);
-            registerFiles->at(store_entry->getHWThread())->copyFromRegister(store_ins->getValueRegisterType() == STORE_FP_REGISTER ?
-                store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1), store_ins->getRegisterOffset(), &tmp[0], store_width,
-                store_ins->getValueRegisterType() == STORE_FP_REGISTER);
             std::ostringstream str;
             str << ", Payload: 0x";
             str << std::hex << std::setfill('0');
-            for ( std::vector<uint8_t>::iterator it = tmp.begin(); it != tmp.end(); it++ ) {
-                str << std::setw(2) << static_cast<unsigned>(*it);
+            for ( uint64_t i = 0; i < store_width; i++ ) {
+                str << std::setw(2) << static_cast<unsigned>(store_value[i]);
             }
             output->verbose(CALL_INFO, 0, VANADIS_DBG_LSQ_STORE_FLG, "--> thr %d, issue-store at ins: 0x%" PRI_ADDR " / store-addr: 0x%" PRI_ADDR " / width: %" PRIu64 " / partial: %s / split: %s / offset: %" PRIu32 " / %s\n",
                 store_ins->getHWThread(), store_ins->getInstructionAddress(), store_address, store_width, store_ins->isPartialStore() ? "yes" : "no", needs_split ? "yes" : "no",
                 store_ins->getRegisterOffset(), str.str().c_str());
         }
 
-        // if the store is not a split operation, then copy payload we are good to go, if it is split
+        // if the store is not a split operation the whole value is the payload, if it is split
         // handle this case later after we do a load of address and width calculation
+        std::vector<uint8_t> payload;
+
         if(LIKELY(! needs_split)) {
-            registerFiles->at(store_entry->getHWThread())->copyFromRegister(store_ins->getValueRegisterType() == STORE_FP_REGISTER ?
-                store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1), store_ins->getRegisterOffset(), &payload[0], store_width,
-                store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+            payload.assign(store_value, store_value + store_width);
         }
 
         switch(store_ins->getTransactionType()) {
@@ -664,26 +619,17 @@ protected:
                         store_address, store_width_left, store_address_right, store_width_right);
                 }
 
-                payload.resize(store_width_left);
-                registerFiles->at(store_entry->getHWThread())->copyFromRegister(store_ins->getValueRegisterType() == STORE_FP_REGISTER ?
-                    store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1), store_ins->getRegisterOffset(), &payload[0], store_width_left,
-                    store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+                payload.assign(store_value, store_value + store_width_left);
 
-                store_req = new StandardMem::Write(store_address & address_mask, payload.size(), payload,
+                store_req = new StandardMem::Write(store_address & address_mask, store_width_left, std::move(payload),
                     false, 0, store_address, store_ins->getInstructionAddress(), store_ins->getHWThread());
 
                 std_stores_in_flight.insert(store_req->getID());
                 memInterface->send(store_req);
 
-                payload.clear();
+                payload.assign(store_value + store_width_left, store_value + store_width);
 
-                payload.resize(store_width_right);
-                registerFiles->at(store_entry->getHWThread())->copyFromRegister(store_ins->getValueRegisterType() == STORE_FP_REGISTER ?
-                    store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1), store_ins->getRegisterOffset() + store_width_left, &payload[0],
-                    store_width_right,
-                    store_ins->getValueRegisterType() == STORE_FP_REGISTER);
-
-                store_req = new StandardMem::Write(store_address_right & address_mask, payload.size(), payload,
+                store_req = new StandardMem::Write(store_address_right & address_mask, store_width_right, std::move(payload),
                     false, 0, store_address_right, store_ins->getInstructionAddress(), store_ins->getHWThread());
                 memInterface->send(store_req);
                 std_stores_in_flight.insert(store_req->getID());
@@ -703,7 +649,7 @@ protected:
                     output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "}\n");
                 }
 
-                store_req = new StandardMem::Write(store_address & address_mask, payload.size(), payload,
+                store_req = new StandardMem::Write(store_address & address_mask, store_width, std::move(payload),
                     false, 0, store_address, store_ins->getInstructionAddress(), store_ins->getHWThread());
                 std_stores_in_flight.insert(store_req->getID());
                 memInterface->send(store_req);
@@ -824,8 +770,15 @@ protected:
                         load_ins->flagError();
                         load_req = nullptr;
                     } else {
-                        load_req = new StandardMem::Read(load_address & address_mask, load_width, 0,
-                            load_address, load_ins->getInstructionAddress(), load_ins->getHWThread());
+                        uint64_t read_start = load_address;
+                        uint64_t read_end   = load_address + load_width;
+
+                        if(load_coalescing) {
+                            coalesceLoads(load_ins->getHWThread(), load_address, read_start, read_end);
+                        }
+
+                        load_req = new StandardMem::Read(read_start & address_mask, read_end - read_start, 0,
+                            read_start, load_ins->getInstructionAddress(), load_ins->getHWThread());
                     }
                 }
             } break;
@@ -872,6 +825,65 @@ protected:
             memInterface->send(load_req);
 
             loads_pending.push_back(load_entry);
+
+            // any loads which were combined into this request wait for the same response
+            for(auto coalesced_entry : coalesced_loads) {
+                coalesced_entry->addRequest(load_req->getID());
+                loads_pending.push_back(coalesced_entry);
+            }
+        }
+
+        coalesced_loads.clear();
+    }
+
+    // Take the run of loads directly behind the front of the thread's queue which read
+    // the same cache line as the front load and widen [read_start, read_end) to cover
+    // them, so that one request to the cache answers all of them. Only the loads which
+    // would have issued next are taken, so loads still leave the queue in order.
+    void coalesceLoads(const uint32_t thr, const uint64_t load_address, uint64_t& read_start, uint64_t& read_end) {
+        const uint64_t line = load_address / cache_line_width;
+
+        for(auto op_q_itr = op_q[thr].begin() + 1; op_q_itr != op_q[thr].end(); ) {
+            if(loads_pending.size() + 1 + coalesced_loads.size() >= max_loads) {
+                break;
+            }
+
+            if((*op_q_itr)->getEntryOp() != VanadisBasicLoadStoreEntryOp::LOAD ||
+                (! (*op_q_itr)->getInstruction()->completedIssue())) {
+                break;
+            }
+
+            VanadisLoadInstruction* next_ins = dynamic_cast<VanadisLoadInstruction*>((*op_q_itr)->getInstruction());
+
+            if(nullptr == next_ins || next_ins->getTransactionType() != MEM_TRANSACTION_NONE || next_ins->isPartialLoad()) {
+                break;
+            }
+
+            uint64_t next_address = 0;
+            uint16_t next_width   = 0;
+
+            next_ins->computeLoadAddress(output, registerFiles->at(thr), &next_address, &next_width);
+
+            if(next_ins->trapsError() || (next_address / cache_line_width) != line ||
+                operationStraddlesCacheLine(next_address, next_width) || (0 == (next_address & address_mask)) ||
+                (nullptr != findStoreConflict(thr, next_address, next_width))) {
+                break;
+            }
+
+            if(output->getVerboseLevel() >= 16) {
+                output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "---> coalesce load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " load-at: 0x%" PRI_ADDR " width: %" PRIu16 "\n",
+                    next_ins->getInstructionAddress(), thr, next_address, next_width);
+            }
+
+            read_start = std::min(read_start, next_address);
+            read_end   = std::max(read_end, next_address + next_width);
+
+            coalesced_loads.push_back(new VanadisBasicLoadPendingEntry(next_ins, next_address, next_width));
+            stat_loads_coalesced->addData(1);
+
+            delete (*op_q_itr);
+            op_q_itr = op_q[thr].erase(op_q_itr);
+            op_q_size--;
         }
     }
 
@@ -934,8 +946,13 @@ protected:
                     }
 
                     // check to see if loading from this address would conflict with a store which
-                    // we have pending, if yes, wait for conflict to clear and then we can proceed
-                    if(UNLIKELY(checkStoreConflict(load_ins->getHWThread(), load_address, load_width))) {
+                    // we have pending, if the youngest such store holds all of the bytes we can take
+                    // them from it, otherwise wait for conflict to clear and then we can proceed
+                    VanadisBasicStorePendingEntry* conflict_store = findStoreConflict(load_ins->getHWThread(), load_address, load_width);
+
+                    if(UNLIKELY(nullptr != conflict_store) && canForwardStore(conflict_store, load_ins, load_address, load_width)) {
+                        forwardStore(conflict_store, load_ins, load_address, load_width);
+                    } else if(UNLIKELY(nullptr != conflict_store)) {
                         if(output->getVerboseLevel() >= 16) {
                             output->verbose(CALL_INFO, 16, 0, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " conflicts with store entry, will not issue until conflict is resolved (load-addr: 0x%" PRI_ADDR " / width: %" PRIu32 ")\n",
                                 load_ins->getInstructionAddress(), load_ins->getHWThread(), load_address, load_width);
@@ -1011,6 +1028,7 @@ protected:
                         store_ins->getValueRegister());
 
                     stores_pending[store_ins->getHWThread()].push_back(new_pending_store);
+                    indexStore(store_ins->getHWThread(), new_pending_store);
                     stores_pending_size++;
                 }
 
@@ -1105,25 +1123,180 @@ protected:
         return matchID;
     }
 
-    bool checkStoreConflict(const uint32_t thread, const uint64_t address, const uint64_t width) {
-        bool conflicts = false;
+    // Pending stores are indexed by the 8-byte granules they touch, so a load which
+    // shares no granule with any pending store (the common case) is cleared without
+    // walking the store queue
+    uint64_t firstGranule(const uint64_t address) const { return address >> 3; }
+    uint64_t lastGranule(const uint64_t address, const uint64_t width) const { return (address + width - 1) >> 3; }
+
+    void indexStore(const uint32_t thread, const VanadisBasicStorePendingEntry* store) {
+        const uint64_t last = lastGranule(store->getStoreAddress(), store->getStoreWidth());
+
+        for(uint64_t granule = firstGranule(store->getStoreAddress()); granule <= last; ++granule) {
+            store_granules[thread][granule]++;
+        }
+    }
+
+    void unindexStore(const uint32_t thread, const VanadisBasicStorePendingEntry* store) {
+        const uint64_t last = lastGranule(store->getStoreAddress(), store->getStoreWidth());
+
+        for(uint64_t granule = firstGranule(store->getStoreAddress()); granule <= last; ++granule) {
+            auto granule_itr = store_granules[thread].find(granule);
 
-        for(auto store_itr = stores_pending[thread].begin(); store_itr != stores_pending[thread].end(); store_itr++) {
+            if(granule_itr != store_granules[thread].end() && --(granule_itr->second) == 0) {
+                store_granules[thread].erase(granule_itr);
+            }
+        }
+    }
+
+    // Returns the youngest pending store which overlaps the access, or nullptr if there is none
+    VanadisBasicStorePendingEntry* findStoreConflict(const uint32_t thread, const uint64_t address, const uint64_t width) {
+        bool granule_hit = false;
+        const uint64_t last = lastGranule(address, width);
+
+        for(uint64_t granule = firstGranule(address); granule <= last; ++granule) {
+            if(store_granules[thread].find(granule) != store_granules[thread].end()) {
+                granule_hit = true;
+                break;
+            }
+        }
+
+        if(LIKELY(! granule_hit)) {
+            return nullptr;
+        }
+
+        for(auto store_itr = stores_pending[thread].rbegin(); store_itr != stores_pending[thread].rend(); store_itr++) {
             VanadisBasicStorePendingEntry* current_entry = (*store_itr);
 
             if(UNLIKELY(current_entry->storeAddressOverlaps(address, width))) {
-                conflicts = true;
-                break;
+                return current_entry;
             }
         }
 
-        return conflicts;
+        return nullptr;
+    }
+
+    bool canForwardStore(VanadisBasicStorePendingEntry* store_entry, VanadisLoadInstruction* load_ins,
+            const uint64_t load_address, const uint64_t load_width) {
+        VanadisStoreInstruction* store_ins = store_entry->getStoreInstruction();
+
+        return (store_ins->getTransactionType() == MEM_TRANSACTION_NONE) && (! store_ins->isPartialStore()) &&
+            (load_ins->getTransactionType() == MEM_TRANSACTION_NONE) && (! load_ins->isPartialLoad()) &&
+            store_entry->storeAddressCovers(load_address, load_width);
+    }
+
+    // The store's value register cannot change until the store retires, which is
+    // after the load has taken its bytes
+    void forwardStore(VanadisBasicStorePendingEntry* store_entry, VanadisLoadInstruction* load_ins,
+            const uint64_t load_address, const uint64_t load_width) {
+        VanadisStoreInstruction* store_ins = store_entry->getStoreInstruction();
+        uint8_t value[MAX_REGISTER_BYTES];
+
+        assert(load_width <= MAX_REGISTER_BYTES);
+
+        if(output->getVerboseLevel() >= 16) {
+            output->verbose(CALL_INFO, 16, 0, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " forwarded from store ins: 0x%" PRI_ADDR " (load-addr: 0x%" PRI_ADDR " / width: %" PRIu64 ")\n",
+                load_ins->getInstructionAddress(), load_ins->getHWThread(), store_ins->getInstructionAddress(), load_address, load_width);
+        }
+
+        registerFiles->at(store_ins->getHWThread())->copyFromRegister(store_ins->getValueRegisterType() == STORE_FP_REGISTER ?
+            store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1),
+            store_ins->getRegisterOffset() + (load_address - store_entry->getStoreAddress()), value, load_width,
+            store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+
+        // same checks as issueLoad and a response from the memory system
+        if(UNLIKELY(0 == (load_address & address_mask)) || load_address < 64) {
+            load_ins->flagError();
+        }
+
+        if(! load_ins->trapsError()) {
+            writeLoadRegister(load_ins, 0, value, load_width, true);
+        }
+
+        load_ins->markExecuted();
+        stat_loads_forwarded->addData(1);
+        stat_loads_executed->addData(1);
     }
 
+    // Place size bytes of loaded data at addr_offset in the load's target register, on
+    // the last part of a load also sign or zero extend the rest of the register
+    void writeLoadRegister(VanadisLoadInstruction* load_ins, const uint64_t addr_offset, const uint8_t* data,
+            const uint16_t size, const bool last_request) {
+        const uint32_t hw_thr     = load_ins->getHWThread();
+        const uint64_t reg_offset = load_ins->getRegisterOffset();
+        uint8_t        register_value[MAX_REGISTER_BYTES];
+
+        switch(load_ins->getValueRegisterType()) {
+        case LOAD_INT_REGISTER: {
+            const uint16_t target_reg = load_ins->getPhysIntRegOut(0);
+
+            assert(load_ins->getISAIntRegOut(0) < load_ins->getISAOptions()->countISAIntRegisters());
+
+            if(target_reg != load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
+                const uint32_t reg_width = registerFiles->at(hw_thr)->getIntRegWidth();
+                assert(reg_width <= MAX_REGISTER_BYTES);
+
+                // copy entire register here
+                registerFiles->at(hw_thr)->copyFromIntRegister(target_reg, 0, register_value, reg_width);
+
+                assert((reg_offset + addr_offset + size) <= reg_width);
+
+                for(auto i = 0; i < size; ++i) {
+                    register_value[reg_offset + addr_offset + i] = data[i];
+                }
+
+                // if we are the last request to be processed for this load (if any were split)
+                // and we promised to do sign extension, then perform it now
+                if(last_request) {
+                    const uint8_t fill = (load_ins->performSignExtension() &&
+                        ((register_value[reg_offset + addr_offset + size - 1] & 0x80) != 0)) ? 0xFF : 0x00;
+
+                    for(auto i = reg_offset + addr_offset + size; i < reg_width; ++i) {
+                        register_value[i] = fill;
+                    }
+                }
+
+                registerFiles->at(hw_thr)->copyToIntRegister(target_reg, 0, register_value, reg_width);
+            }
+        } break;
+        case LOAD_FP_REGISTER: {
+            const uint16_t target_reg = load_ins->getPhysFPRegOut(0);
+            const uint32_t reg_width  = registerFiles->at(hw_thr)->getFPRegWidth();
+            assert(reg_width <= MAX_REGISTER_BYTES);
+
+            // copy entire register here
+            registerFiles->at(hw_thr)->copyFromFPRegister(target_reg, 0, register_value, reg_width);
+
+            assert((reg_offset + addr_offset + size) <= reg_width);
+
+            for(auto i = 0; i < size; ++i) {
+                register_value[reg_offset + addr_offset + i] = data[i];
+            }
+
+            if(last_request) {
+                for(auto i = reg_offset + addr_offset + size; i < reg_width; ++i) {
+                    register_value[i] = 0xff;
+                }
+            }
+
+            registerFiles->at(hw_thr)->copyToFPRegister(target_reg, 0, register_value, reg_width);
+        } break;
+        default:
+            output->fatal(CALL_INFO, -1, "Unknown register type.\n");
+        }
+    }
+
+    // Largest register a load or store moves, values are staged on the stack
+    static const uint32_t MAX_REGISTER_BYTES = 8;
+
     // Per-hardware-thread queues
     std::vector< std::deque<VanadisBasicLoadStoreEntry*> > op_q;
     std::vector< std::deque<VanadisBasicStorePendingEntry*> > stores_pending;
+    // count of pending stores touching each 8-byte granule, per hardware thread
+    std::vector< std::unordered_map<uint64_t, uint32_t> > store_granules;
     std::deque<VanadisBasicLoadPendingEntry*> loads_pending;
+    // loads sharing the request being built by issueLoad
+    std::vector<VanadisBasicLoadPendingEntry*> coalesced_loads;
     std::set<StandardMem::Request::id_t> std_stores_in_flight;
     int op_q_index; // Next hw_thread to check in op_q queues
     int stores_pending_index; // Next hw thread to check in stores_pending q's
@@ -1140,6 +1313,7 @@ protected:
 
     uint64_t cache_line_width;
     uint64_t address_mask;
+    bool load_coalescing;
 
     Statistic<uint64_t>* stat_store_buffer_entries;
     Statistic<uint64_t>* stat_op_q_size;
@@ -1155,6 +1329,8 @@ protected:
     Statistic<uint64_t>* stat_split_loads;
     Statistic<uint64_t>* stat_stored_bytes;
     Statistic<uint64_t>* stat_loaded_bytes;
+    Statistic<uint64_t>* stat_loads_forwarded;
+    Statistic<uint64_t>* stat_loads_coalesced;
 };
 
 } // namespace Vanadis
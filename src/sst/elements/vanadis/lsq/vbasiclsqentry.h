@@ -164,6 +164,11 @@ public:
         return overlaps;
     }
 
+    // Case 1 and 5 above, every byte of the load is written by the store
+    bool    storeAddressCovers(const uint64_t loadAddress, const uint64_t loadWidth) const {
+        return (loadAddress >= storeAddress) && ((loadAddress + loadWidth) <= (storeAddress + storeWidth));
+    }
+
     VanadisStoreRegisterType getValueRegisterType() const {
         return valueRegisterType;
     }
@@ -313,6 +313,8 @@ class ProcessInfo {
     uint64_t getEntryPoint() { return m_elfInfo->getEntryPoint(); }
     VanadisELFInfo* getElfInfo() { return m_elfInfo; }
     bool isELF32() { return m_elfInfo->isELF32();}
+    // the threads of a process run the same image, a forked child gets its own
+    std::string getImageName() { return std::string( m_elfInfo->getBinaryPath() ) + ":" + std::to_string( m_pid ); }
 
   private:  
 
@@ -18,6 +18,8 @@
 
 #include <sst/core/event.h>
 
+#include <string>
+
 namespace SST {
 namespace Vanadis {
 
@@ -39,6 +41,8 @@ public:
     void setFpRegs( std::vector<uint64_t>& regs ) { fpRegs = regs; } 
     std::vector<uint64_t>& getIntRegs() { return intRegs; }
     std::vector<uint64_t>& getFpRegs() { return fpRegs; }
+    void setImage( const std::string& name ) { image = name; }
+    const std::string& getImage() { return image; }
 
 
 private:
@@ -51,6 +55,7 @@ private:
         ser& tlsAddr;
         ser& intRegs;
         ser& fpRegs;
+        ser& image;
     }
 
     ImplementSerializable(SST::Vanadis::_VanadisStartThreadBaseReq);
@@ -63,6 +68,8 @@ private:
 
     std::vector<uint64_t> intRegs;
     std::vector<uint64_t> fpRegs;
+
+    std::string image;
 };
 
 class VanadisStartThreadFirstReq : public _VanadisStartThreadBaseReq {
@@ -67,6 +67,8 @@ exe_name= full_exe_name.split("/")[-1]
 verbosity = int(os.getenv("VANADIS_VERBOSE", 0))
 os_verbosity = os.getenv("VANADIS_OS_VERBOSE", verbosity)
 pipe_trace_file = os.getenv("VANADIS_PIPE_TRACE", "")
+branch_trace_file = os.getenv("VANADIS_BRANCH_TRACE", "")
+branch_unit = os.getenv("VANADIS_BRANCH_UNIT", "vanadis.VanadisBasicBranchUnit")
 lsq_ld_entries = os.getenv("VANADIS_LSQ_LD_ENTRIES", 16)
 lsq_st_entries = os.getenv("VANADIS_LSQ_ST_ENTRIES", 8)
 
@@ -95,6 +97,9 @@ if (verbosity > 0):
 # vanadis_cpu_type = "vanadisdbg.VanadisCPU"
 
 app_args = os.getenv("VANADIS_EXE_ARGS", "")
+# optional second process, started on the next free hardware thread
+second_exe = os.getenv("VANADIS_EXE2", "")
+shared_uop_cache = os.getenv("VANADIS_SHARED_UOP_CACHE", "")
 
 app_params = {}
 if app_args != "":
@@ -151,6 +156,15 @@ processList = (
 
 processList[0][1].update(app_params)
 
+if second_exe != "":
+    processList += ( ( 1, {
+        "env_count" : 1,
+        "env0" : "OMP_NUM_THREADS={}".format(numCpus*numThreads),
+        "exe" : second_exe,
+        "arg0" : os.path.basename(second_exe),
+        "argc" : 1,
+    } ), )
+
 osl1cacheParams = {
     "access_latency_cycles" : "2",
     "cache_frequency" : cpu_clock,
@@ -169,6 +183,8 @@ mmuParams = {
     "num_cores": numCpus,
     "num_threads": numThreads,
     "page_size": 4096,
+    "hardware_walk": os.getenv("VANADIS_MMU_HARDWARE_WALK", 0),
+    "shared_tlb_entries": os.getenv("VANADIS_MMU_SHARED_TLB_ENTRIES", 0),
 }
 
 memRtrParams ={
@@ -229,7 +245,8 @@ tlbWrapperParams = {
 decoderParams = {
     "loader_mode" : loader_mode,
     "uop_cache_entries" : 1536,
-    "predecode_cache_entries" : 4
+    "predecode_cache_entries" : 4,
+    "shared_uop_cache" : shared_uop_cache,
 }
 
 osHdlrParams = { }
@@ -252,11 +269,16 @@ cpuParams = {
     "print_int_reg" : False,
     "print_fp_reg" : False,
     "pipeline_trace_file" : pipe_trace_file,
+    "branch_trace_file" : branch_trace_file,
     "reorder_slots" : rob_slots,
     "decodes_per_cycle" : decodes_per_cycle,
     "issues_per_cycle" :  issues_per_cycle,
     "retires_per_cycle" : retires_per_cycle,
     "pause_when_retire_address" : os.getenv("VANADIS_HALT_AT_ADDRESS", 0),
+    "sampling" : os.getenv("VANADIS_SAMPLING", "none"),
+    "sample_period" : os.getenv("VANADIS_SAMPLE_PERIOD", 1000000),
+    "sample_length" : os.getenv("VANADIS_SAMPLE_LENGTH", 1000),
+    "sample_warmup" : os.getenv("VANADIS_SAMPLE_WARMUP", 2000),
     "start_verbose_when_issue_address": dbgAddr,
     "stop_verbose_when_retire_address": stopDbg,
     "print_rob" : False,
@@ -346,7 +368,7 @@ class CPU_Builder:
             os_hdlr.addParams( osHdlrParams )
 
             # CPU.decocer.branch_pred
-            branch_pred = decode.setSubComponent( "branch_unit", "vanadis.VanadisBasicBranchUnit" )
+            branch_pred = decode.setSubComponent( "branch_unit", branch_unit )
             branch_pred.addParams( branchPredParams )
             branch_pred.enableAllStatistics()
 
@@ -475,6 +497,8 @@ if pythonDebug:
 # node OS MMU
 node_os_mmu = node_os.setSubComponent( "mmu", "mmu." + mmuType )
 node_os_mmu.addParams(mmuParams)
+if mmuParams["hardware_walk"] not in (0, "0"):
+    node_os_mmu.enableAllStatistics()
 
 # node OS memory interface to L1 data cache
 node_os_mem_if = node_os.setSubComponent( "mem_interface", "memHierarchy.standardInterface" )
@@ -4,6 +4,8 @@ from sst_unittest import *
 from sst_unittest_support import *
 from sst_unittest_parameterized import parameterized
 import subprocess
+import glob
+import re
 
 module_init = 0
 module_sema = threading.Semaphore()
@@ -42,6 +44,26 @@ def build_vanadis_test_matrix():
         for arch in arch_list:
             testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, "", 300])
 
+    # Two binaries in one uop cache group, both are linked at the same addresses
+    # so a bundle decoded for one must never be handed to the other
+    tests = ["hello-world"]
+    for test in tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test,arch, 2, 1, "shared-uop", 300,
+                { "VANADIS_SHARED_UOP_CACHE" : "uops",
+                  "VANADIS_EXE2" : "{test_path}/" + location + "/printf-check/{isa}/printf-check" }])
+
+
+    # Periodic sampling fast-forwards between windows, the program must still
+    # run to completion and both kinds of cycle must have been counted
+    tests = ["hello-world"]
+    for test in tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, "sampling", 300,
+                { "VANADIS_SAMPLING" : "periodic", "VANADIS_SAMPLE_PERIOD" : "2000",
+                  "VANADIS_SAMPLE_LENGTH" : "200", "VANADIS_SAMPLE_WARMUP" : "400" },
+                ["fast_forward_cycles", "fast_forward_instructions", "sampled_cycles", "sampled_instructions"]])
+
 
     # basic-math
     location="small/basic-math"
@@ -62,10 +84,13 @@ def build_vanadis_test_matrix():
     # misc 
     location="small/misc"
     tests = ["stream","gettime","splitLoad","mt-dgemm","stream-fortran","uname"]
+    # stream reads each array line with several loads in flight and reloads spilled
+    # stack slots, the LSQ must have coalesced some loads and forwarded others
+    lsq_stats = { "stream" : ["loads_forwarded", "loads_coalesced"] }
     #tests = []
     for test in tests:
         for arch in arch_list:
-            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, "", 300])
+            testlist.append(["basic_vanadis.py", location, test,arch, 1, 1, "", 300, {}, lsq_stats.get(test, [])])
 
     tests = ["fork","clone","pthread"]
     #tests = []
@@ -91,6 +116,17 @@ def build_vanadis_test_matrix():
             testlist.append(["basic_vanadis.py", location, test,arch, 1,32, "32thread", 300])
             testlist.append(["basic_vanadis.py", location, test,arch, 4,8, "4core-8thread", 300])
 
+    # Every core faults on the same text, stack and heap pages at once, with the MMU walking
+    # the page table itself another core must not be handed a page the OS is still filling
+    tests = ["openmp2"]
+    arch_list = ["riscv64"]
+    for test in tests:
+        for arch in arch_list:
+            testlist.append(["basic_vanadis.py", location, test,arch, 16,1, "16core-hwwalk", 300,
+                { "VANADIS_MMU_HARDWARE_WALK" : "1", "VANADIS_MMU_SHARED_TLB_ENTRIES" : "256" }, ["hardware_walks"]])
+            testlist.append(["basic_vanadis.py", location, test,arch, 4,8, "4core-8thread-hwwalk", 300,
+                { "VANADIS_MMU_HARDWARE_WALK" : "1" }, ["hardware_walks"]])
+
     # Process each line and crack up into an index, hash, options and sdl file
     for testnum, test_info in enumerate(testlist):
         # Make testnum start at 1
@@ -103,10 +139,14 @@ def build_vanadis_test_matrix():
         numHwThreads = test_info[5]
         goldfiledir = test_info[6]
         timeout_sec = test_info[7]
+        # Optional environment settings passed to the sdl file
+        envVars = test_info[8] if len(test_info) > 8 else {}
+        # Optional statistics that must have counted something
+        statChecks = test_info[9] if len(test_info) > 9 else []
         testname = "{0}_{1}_{2}_{3}".format(elftestdir.replace("/", "_"), elffile,isa,goldfiledir)
 
         # Build the test_data structure
-        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec )
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, envVars, statChecks )
         vanadis_test_matrix.append(test_data)
 
 ################################################################################
@@ -162,17 +202,17 @@ class testcase_vanadis(SSTTestCase):
 #####
 
     @parameterized.expand(vanadis_test_matrix, name_func=gen_custom_name)
-    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec):
+    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, envVars, statChecks):
         self._checkSkipConditions( isa )
 
         if MakeTests:
             self.makeTest( testname, isa, elftestdir, elffile )
         log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa, timeout_sec))
-        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec )
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, envVars, statChecks )
 
 #####
 
-    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, testtimeout=120):
+    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, testtimeout=120, envVars={}, statChecks=[]):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = "{0}/vanadis_tests/{1}/{2}/{3}/{4}".format(self.get_test_output_run_dir(), elftestdir,elffile,isa,goldfiledir)
@@ -211,7 +251,20 @@ class testcase_vanadis(SSTTestCase):
         testfile_exists = os.path.exists(testfilepath) and os.path.isfile(testfilepath)
         self.assertTrue(testfile_exists, "Vanadis test {0} does not exist".format(testfilepath))
 
-        oscmd = self.run_sst(sdlfile, sst_outfile, sst_errfile, mpi_out_files=mpioutfiles, set_cwd=outdir, timeout_sec=testtimeout)
+        # The environment outlives this test, put back whatever the settings replaced
+        savedEnv = {}
+        for key, value in envVars.items():
+            savedEnv[key] = os.environ.get(key)
+            os.environ[key] = value.format(test_path=test_path, isa=isa)
+
+        try:
+            oscmd = self.run_sst(sdlfile, sst_outfile, sst_errfile, mpi_out_files=mpioutfiles, set_cwd=outdir, timeout_sec=testtimeout)
+        finally:
+            for key, value in savedEnv.items():
+                if value is None:
+                    del os.environ[key]
+                else:
+                    os.environ[key] = value
 
         # Perform the tests
         # Verify that the errfile from SST is empty
@@ -263,6 +316,22 @@ class testcase_vanadis(SSTTestCase):
 
         self.assertTrue(cmp_result, "Vanadis os error file {0} does not match reference error file {1}".format(os_outfile, ref_os_outfile))
 
+        # Any further process has gold files named after its pid, e.g. vanadis.stdout-101.gold
+        ref_pid_files = glob.glob("{0}/{1}/{2}/{3}/{4}vanadis.std*-*.gold".format(test_path, elftestdir, elffile, isa, goldfiledir))
+        for ref_pid_file in sorted(ref_pid_files):
+            pid_file = "{0}/{1}".format(outdir, os.path.basename(ref_pid_file)[len("vanadis."):-len(".gold")])
+            cmp_result = testing_compare_diff(testname, pid_file, ref_pid_file)
+            if (cmp_result == False):
+                diffdata = testing_get_diff_data(testname)
+                log_failure(oscmd)
+                log_failure(diffdata)
+
+            self.assertTrue(cmp_result, "Vanadis os output file {0} does not match reference file {1}".format(pid_file, ref_pid_file))
+
+        for stat in statChecks:
+            total = self._sumStatistic(sst_outfile, stat)
+            self.assertTrue(total > 0, "Vanadis statistic {0} in {1} is {2}, expected it to count".format(stat, sst_outfile, total))
+
         # DEVELOPER NOTE: In the future, we may want to compare the SST output (statisics) vs some reference file
 
 
@@ -280,6 +349,18 @@ class testcase_vanadis(SSTTestCase):
         if testing_check_get_num_threads() > 1:
             self.skipTest("Vanadis Skipping Test - threads > 1 not supported")
 
+###
+    # Sum of an accumulator statistic over every component that reported it
+    def _sumStatistic(self, sst_outfile, stat):
+        total = 0
+        pattern = re.compile(r"[.:]{0}(\.\w+)? : Accumulator : Sum\.[us]64 = (-?\d+)".format(re.escape(stat)))
+        with open(sst_outfile, 'r') as f:
+            for line in f:
+                match = pattern.search(line)
+                if match:
+                    total += int(match.group(2))
+        return total
+
 ###
     def _is_musl_compiler_available(self,isa):
 
@@ -0,0 +1,207 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Branch predictor benchmark
+ *
+ * Replays a branch trace through each direction predictor and reports the
+ * misprediction rate, mispredictions per thousand branches and predictions
+ * per second of host time. Each branch is predicted, pushed into the
+ * speculative history, trained and (if wrong) recovered, the same calls the
+ * Vanadis branch units make between decode and retire.
+ *
+ * Traces are written by the Vanadis CPU when 'branch_trace_file' is set, one
+ * retired branch per line: "<address> <next-address> <taken>". Without a
+ * trace a synthetic stream is used which mixes loop branches, branches
+ * correlated with earlier branches, biased branches and random branches.
+ *
+ * usage: bpbench [-f trace] [-n branches] [-r repeat]
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "vbranch/vbranchpred.h"
+
+using namespace SST::Vanadis;
+
+struct BranchRecord {
+    uint64_t pc;
+    bool     taken;
+};
+
+/* xorshift64* */
+class BenchRNG {
+public:
+    BenchRNG(uint64_t seed) : state(seed ? seed : 1) { }
+    uint64_t generateNextUInt64() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+private:
+    uint64_t state;
+};
+
+static bool load(const char* path, std::vector<BranchRecord>& trace) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "bpbench: unable to open %s\n", path);
+        return false;
+    }
+
+    uint64_t pc, next;
+    int taken;
+    while (fscanf(f, "%" SCNx64 " %" SCNx64 " %d", &pc, &next, &taken) == 3) {
+        trace.push_back(BranchRecord{pc, taken != 0});
+    }
+    fclose(f);
+    return true;
+}
+
+/*
+ * A loop body of static branches, executed over and over. Each static
+ * branch has one of four behaviours.
+ */
+static void generate(std::vector<BranchRecord>& trace, size_t count) {
+    const int body = 64;
+    BenchRNG rng(12345);
+    std::vector<int> trip(body, 0), iter(body, 0), kind(body, 0);
+    for (int i = 0; i < body; i++) {
+        kind[i] = i % 4;
+        trip[i] = 2 + rng.generateNextUInt64() % 14;
+    }
+
+    uint64_t history = 0;
+    trace.reserve(count);
+    while (trace.size() < count) {
+        for (int i = 0; i < body && trace.size() < count; i++) {
+            bool taken = false;
+            switch (kind[i]) {
+            case 0:     /* loop back edge */
+                taken = (++iter[i] % trip[i]) != 0;
+                break;
+            case 1:     /* correlated with the last two branches */
+                taken = ((history >> 1) ^ (history >> 2)) & 1;
+                break;
+            case 2:     /* 90% taken */
+                taken = (rng.generateNextUInt64() % 10) != 0;
+                break;
+            default:    /* unpredictable */
+                taken = rng.generateNextUInt64() & 1;
+                break;
+            }
+            trace.push_back(BranchRecord{0x10000 + 4 * (uint64_t)i, taken});
+            history = (history << 1) | (taken ? 1 : 0);
+        }
+    }
+}
+
+struct Result {
+    double seconds;
+    uint64_t mispredicts;
+};
+
+static Result run(VanadisBranchPredictor* predictor, const std::vector<BranchRecord>& trace) {
+    VanadisBranchPredictInfo info;
+    uint64_t mispredicts = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < trace.size(); i++) {
+        const BranchRecord& br = trace[i];
+        bool pred = predictor->predict(br.pc, info);
+        predictor->speculate(br.pc, pred);
+        predictor->update(br.pc, br.taken, info);
+        if (pred != br.taken) {
+            mispredicts++;
+            predictor->recover(br.pc, br.taken, info);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return Result{elapsed.count(), mispredicts};
+}
+
+typedef VanadisBranchPredictor* (*Factory)();
+
+static void bench(const char* name, Factory make, const std::vector<BranchRecord>& trace, int repeat) {
+    double best = 0.;
+    uint64_t mispredicts = 0;
+    uint64_t bits = 0;
+    for (int r = 0; r < repeat; r++) {
+        std::unique_ptr<VanadisBranchPredictor> predictor(make());
+        Result res = run(predictor.get(), trace);
+        if (r == 0 || res.seconds < best)
+            best = res.seconds;
+        mispredicts = res.mispredicts;
+        bits = predictor->getStorageBits();
+    }
+    printf("%-12s %10.1f %10.2f%% %10.2f %14.0f\n", name, bits / 8192.0, 100.0 * mispredicts / trace.size(),
+            1000.0 * mispredicts / trace.size(), trace.size() / best);
+}
+
+static VanadisBranchPredictor* makeBimodal() { return new VanadisGShareBranchPredictor(14, 0); }
+static VanadisBranchPredictor* makeGShare() { return new VanadisGShareBranchPredictor(14, 14); }
+static VanadisBranchPredictor* makePerceptron() { return new VanadisPerceptronBranchPredictor(512, 32); }
+static VanadisBranchPredictor* makeTAGE() { return new VanadisTAGEBranchPredictor(7, 13, 10, 4, 640, 8); }
+
+int main(int argc, char* argv[]) {
+    const char* path = NULL;
+    size_t branches = 10000000;
+    int repeat = 3;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "-f") == 0) {
+            path = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) {
+            branches = strtoull(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && strcmp(argv[i], "-r") == 0) {
+            repeat = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: bpbench [-f trace] [-n branches] [-r repeat]\n");
+            exit(1);
+        }
+    }
+    if (branches == 0 || repeat < 1) {
+        fprintf(stderr, "bpbench: branches and repeat must be at least 1\n");
+        exit(1);
+    }
+
+    std::vector<BranchRecord> trace;
+    if (path != NULL) {
+        if (!load(path, trace))
+            exit(1);
+        if (trace.empty()) {
+            fprintf(stderr, "bpbench: no branches in %s\n", path);
+            exit(1);
+        }
+    } else {
+        generate(trace, branches);
+    }
+
+    printf("%zu branches from %s, best of %d\n", trace.size(), path ? path : "synthetic stream", repeat);
+    printf("%-12s %10s %11s %10s %14s\n", "predictor", "size KB", "mispredict", "MPKB", "predictions/s");
+
+    bench("bimodal", makeBimodal, trace, repeat);
+    bench("gshare", makeGShare, trace, repeat);
+    bench("perceptron", makePerceptron, trace, repeat);
+    bench("tage", makeTAGE, trace, repeat);
+    return 0;
+}
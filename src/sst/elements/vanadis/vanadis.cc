@@ -21,7 +21,9 @@
 
 #include "os/resp/vosexitresp.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <map>
 #include <sst/core/output.h>
 #include <vector>
 
@@ -33,6 +35,8 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     instPrintBuffer = new char[1024];
     pipelineTrace   = nullptr;
+    branchTrace     = nullptr;
+    sampler         = nullptr;
 
     max_cycle = params.find<uint64_t>("max_cycle", std::numeric_limits<uint64_t>::max());
 
@@ -171,6 +175,8 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
             CALL_INFO, 8, 0, "Reorder buffer set to %" PRIu32 " entries, these are shared by all threads.\n",
             rob_count);
         rob.push_back(new VanadisCircularQueue<VanadisInstruction*>(rob_count));
+        issue_queues.push_back(new VanadisIssueQueue(
+            thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg()));
         // WE NEED ISA INTEGER AND FP COUNTS HERE NOT ZEROS
         issue_isa_tables.push_back(new VanadisISATable( "issue",
             thread_decoders[i]->getDecoderOptions(), thread_decoders[i]->countISAIntReg(),
@@ -340,6 +346,97 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         if ( pipelineTrace == nullptr ) { output->fatal(CALL_INFO, -1, "Failed to open pipeline trace file.\n"); }
     }
 
+    std::string branch_trace_path = params.find<std::string>("branch_trace_file", "");
+
+    if ( branch_trace_path != "" ) {
+        output->verbose(CALL_INFO, 8, 0, "Opening a branch trace output at: %s\n", branch_trace_path.c_str());
+        branchTrace = fopen(branch_trace_path.c_str(), "wt");
+
+        if ( branchTrace == nullptr ) { output->fatal(CALL_INFO, -1, "Failed to open branch trace file.\n"); }
+    }
+
+    fast_forward_ins_per_cycle = params.find<uint32_t>("fast_forward_ins_per_cycle", 64);
+
+    const std::string sampling = params.find<std::string>("sampling", "none");
+    const uint64_t    sample_warmup = params.find<uint64_t>("sample_warmup", 2000);
+
+    if ( sampling == "periodic" ) {
+        const uint64_t sample_period = params.find<uint64_t>("sample_period", 1000000);
+        const uint64_t sample_length = params.find<uint64_t>("sample_length", 1000);
+
+        if ( sample_length == 0 || sample_length > sample_period ) {
+            output->fatal(
+                CALL_INFO, -1,
+                "Error: sample_length (%" PRIu64 ") must be non-zero and no larger than sample_period (%" PRIu64 ")\n",
+                sample_length, sample_period);
+        }
+
+        output->verbose(
+            CALL_INFO, 2, 0,
+            "Periodic sampling: %" PRIu64 " instructions measured every %" PRIu64 " after %" PRIu64 " of warm-up\n",
+            sample_length, sample_period, sample_warmup);
+        sampler = new VanadisSampler(sample_period, sample_warmup, sample_length);
+    }
+    else if ( sampling == "simpoint" ) {
+        const std::string points_path  = params.find<std::string>("simpoint_file", "");
+        const std::string weights_path = params.find<std::string>("simpoint_weights_file", "");
+        const uint64_t    interval     = params.find<uint64_t>("simpoint_interval", 10000000);
+
+        if ( points_path == "" || weights_path == "" || interval == 0 ) {
+            output->fatal(
+                CALL_INFO, -1,
+                "Error: simpoint sampling needs simpoint_file, simpoint_weights_file and a non-zero "
+                "simpoint_interval\n");
+        }
+
+        // Both files are keyed by cluster id
+        std::map<uint64_t, uint64_t> cluster_interval;
+        std::map<uint64_t, double>   cluster_weight;
+        uint64_t                     point, cluster;
+        double                       weight;
+
+        FILE* points_file = fopen(points_path.c_str(), "rt");
+        if ( points_file == nullptr ) { output->fatal(CALL_INFO, -1, "Failed to open %s.\n", points_path.c_str()); }
+        while ( fscanf(points_file, "%" SCNu64 " %" SCNu64, &point, &cluster) == 2 ) {
+            cluster_interval[cluster] = point;
+        }
+        fclose(points_file);
+
+        FILE* weights_file = fopen(weights_path.c_str(), "rt");
+        if ( weights_file == nullptr ) { output->fatal(CALL_INFO, -1, "Failed to open %s.\n", weights_path.c_str()); }
+        while ( fscanf(weights_file, "%lf %" SCNu64, &weight, &cluster) == 2 ) {
+            cluster_weight[cluster] = weight;
+        }
+        fclose(weights_file);
+
+        std::vector<VanadisSampleWindow> windows;
+        for ( auto& next_point : cluster_interval ) {
+            if ( cluster_weight.find(next_point.first) == cluster_weight.end() ) {
+                output->fatal(
+                    CALL_INFO, -1, "Error: cluster %" PRIu64 " in %s has no weight in %s\n", next_point.first,
+                    points_path.c_str(), weights_path.c_str());
+            }
+
+            windows.push_back({ next_point.second * interval, interval, cluster_weight[next_point.first] });
+        }
+
+        if ( windows.empty() ) { output->fatal(CALL_INFO, -1, "Error: no simulation points in %s\n", points_path.c_str()); }
+
+        std::sort(windows.begin(), windows.end(), [](const VanadisSampleWindow& a, const VanadisSampleWindow& b) {
+            return a.start < b.start;
+        });
+
+        output->verbose(
+            CALL_INFO, 2, 0, "SimPoint sampling: %" PRIu64 " intervals of %" PRIu64 " instructions\n",
+            (uint64_t)windows.size(), interval);
+        sampler = new VanadisSampler(sample_warmup, windows);
+    }
+    else if ( sampling != "none" ) {
+        output->fatal(
+            CALL_INFO, -1, "Error: unknown sampling mode '%s', expected none, periodic or simpoint\n",
+            sampling.c_str());
+    }
+
     pause_on_retire_address = params.find<uint64_t>("pause_when_retire_address", 0);
     stop_verbose_when_retire_address = params.find<uint64_t>("stop_verbose_when_retire_address", 0);
 
@@ -348,6 +445,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     // Register statistics ///////////////////////////////////////////////////////
     stat_ins_retired          = registerStatistic<uint64_t>("instructions_retired", "1");
     stat_ins_decoded          = registerStatistic<uint64_t>("instructions_decoded", "1");
+    stat_ins_host_allocs      = registerStatistic<uint64_t>("instruction_host_allocations", "1");
     stat_ins_issued           = registerStatistic<uint64_t>("instructions_issued", "1");
     stat_loads_issued         = registerStatistic<uint64_t>("loads_issued", "1");
     stat_stores_issued        = registerStatistic<uint64_t>("stores_issued", "1");
@@ -357,6 +455,10 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     stat_rob_entries          = registerStatistic<uint64_t>("rob_slots_in_use", "1");
     stat_rob_cleared_entries  = registerStatistic<uint64_t>("rob_cleared_entries", "1");
     stat_syscall_cycles       = registerStatistic<uint64_t>("syscall-cycles", "1");
+    stat_ff_cycles            = registerStatistic<uint64_t>("fast_forward_cycles", "1");
+    stat_ff_ins               = registerStatistic<uint64_t>("fast_forward_instructions", "1");
+    stat_sampled_cycles       = registerStatistic<uint64_t>("sampled_cycles", "1");
+    stat_sampled_ins          = registerStatistic<uint64_t>("sampled_instructions", "1");
     stat_int_phys_regs_in_use = registerStatistic<uint64_t>("phys_int_reg_in_use", "1");
     stat_fp_phys_regs_in_use  = registerStatistic<uint64_t>("phys_fp_reg_in_use", "1");
 
@@ -371,9 +473,13 @@ VANADIS_COMPONENT::~VANADIS_COMPONENT()
 
     for ( int i= 0; i < rob.size(); i++ ) {
         delete rob[i];
+        delete issue_queues[i];
     }
 
     if ( pipelineTrace != nullptr ) { fclose(pipelineTrace); }
+    if ( branchTrace != nullptr ) { fclose(branchTrace); }
+
+    delete sampler;
 
 	for( VanadisFloatingPointFlags* next_fp_flags : fp_flags ) {
 		delete next_fp_flags;
@@ -488,7 +594,7 @@ VANADIS_COMPONENT::resetRegisterUseTemps(const uint16_t int_reg_count, const uin
 }
 
 int
-VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_start, int& unallocated_memory_op_seen)
+VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& issue_start, int& unallocated_memory_op_seen)
 {
 #ifdef VANADIS_BUILD_DEBUG
     const int output_verbosity = output->getVerboseLevel();
@@ -508,11 +614,11 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_s
             // we have not issued an instruction this cycle
             issued_an_ins = false;
 
-            // Find the next instruction which has not been issued yet
-            const auto rob_size = rob[i]->size();
+            // Walk the instructions which have not been issued yet, oldest first
+            VanadisIssueQueue* issue_queue = issue_queues[i];
 
-            for ( auto j = rob_start; j < rob_size; ++j ) {
-                VanadisInstruction* ins = rob[i]->peekAt(j);
+            for ( auto j = issue_start; j < issue_queue->size(); ++j ) {
+                VanadisInstruction* ins = issue_queue->at(j);
 
                 if ( ! ins->completedIssue() ) {
 #ifdef VANADIS_BUILD_DEBUG
@@ -624,8 +730,11 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_s
 
                 // We issued an instruction this cycle, so exit
                 if ( issued_an_ins ) {
-                    // tell the caller where we got this from
-                    rob_start = j;
+                    issue_queue->issue(j);
+
+                    // tell the caller where we got this from, the entry at j
+                    // is now the next unissued instruction
+                    issue_start = j;
                     break;
                 }
             }
@@ -862,8 +971,15 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 }
                 }
 #endif
-                thread_decoders[ins_thread]->getBranchPredictor()->push(
-                    spec_ins->getInstructionAddress(), pipeline_reset_addr);
+                const bool branch_taken = (pipeline_reset_addr != spec_ins->getFallThroughAddress());
+
+                thread_decoders[ins_thread]->getBranchPredictor()->update(
+                    spec_ins->getInstructionAddress(), pipeline_reset_addr, branch_taken);
+
+                if ( branchTrace != nullptr ) {
+                    fprintf(branchTrace, "0x%" PRI_ADDR " 0x%" PRI_ADDR " %d\n", spec_ins->getInstructionAddress(),
+                        pipeline_reset_addr, branch_taken ? 1 : 0);
+                }
 
                 if ( stop_verbose_when_retire_address > 0 && (rob_front->getInstructionAddress() == stop_verbose_when_retire_address) ) {
                     output->setVerboseLevel(0);
@@ -1196,6 +1312,8 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         return true;
     }
 
+    if ( nullptr != sampler && !sampler->detailed() ) { return tickFastForward(cycle); }
+
 #ifdef VANADIS_BUILD_DEBUG
     const auto output_verbosity = output->getVerboseLevel();
 #endif
@@ -1310,8 +1428,17 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
     }
 
+    // Writes from instructions issued in earlier cycles still block
+    // dependent instructions until they retire
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        issue_queues[i]->collect(rob[i]);
+        issue_queues[i]->markInFlightWrites(
+            tmp_int_reg_write[i], thread_decoders[i]->countISAIntReg(), tmp_fp_reg_write[i],
+            thread_decoders[i]->countISAFPReg());
+    }
+
 {
-    std::vector<uint32_t> rob_start(hw_threads,0);
+    std::vector<uint32_t> issue_start(hw_threads,0);
     std::vector<int> unallocated_memory_op_seen(hw_threads,false);
 
     // Attempt to perform issues, cranking through the entire ROB call by call or until we
@@ -1329,7 +1456,7 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         // we found a unblocked hardware thread
         if ( cnt ) {
             auto thr = m_curIssueHwThread;
-            rc[thr] = performIssue(cycle, thr, rob_start[thr], unallocated_memory_op_seen[thr]);
+            rc[thr] = performIssue(cycle, thr, issue_start[thr], unallocated_memory_op_seen[thr]);
             ++m_curIssueHwThread;
             m_curIssueHwThread %= hw_threads;
             cnt = hw_threads;
@@ -1352,11 +1479,14 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
             "<==========================================================\n");
     }
 #endif
+    const uint64_t host_allocs_before_decode = VanadisInstructionPool::hostAllocations();
+
     for ( uint32_t i = 0; i < decodes_per_cycle; ++i ) {
         if ( performDecode(cycle) != 0 ) { break; }
     }
 
     stat_ins_decoded->addData(ins_decoded_this_cycle);
+    stat_ins_host_allocs->addData(VanadisInstructionPool::hostAllocations() - host_allocs_before_decode);
 
     // Fetch
     // //////////////////////////////////////////////////////////////////////////
@@ -1387,6 +1517,8 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     }
 #endif
 
+    if ( nullptr != sampler ) { advanceSampler(); }
+
     current_cycle++;
 
     uint64_t used_phys_int = 0;
@@ -1413,6 +1545,162 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     }
 }
 
+// Run a cycle without the out-of-order timing model: each hardware thread
+// issues its instructions in program order and executes them as they
+// issue, retiring them as soon as they complete. Loads and stores still
+// go through the LSQ, so the caches see every access and stay warm, and
+// syscalls go to the OS as usual.
+bool
+VANADIS_COMPONENT::tickFastForward(SST::Cycle_t cycle)
+{
+    ins_issued_this_cycle  = 0;
+    ins_retired_this_cycle = 0;
+    ins_decoded_this_cycle = 0;
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
+    }
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        performFastForward(cycle, i);
+    }
+
+    // Instructions left in the functional units by the last detailed
+    // window finish here, and the LSQ talks to the caches
+    performExecute(cycle);
+
+    stat_cycles->addData(1);
+    stat_ins_retired->addData(ins_retired_this_cycle);
+    stat_ins_issued->addData(ins_issued_this_cycle);
+    stat_ins_decoded->addData(ins_decoded_this_cycle);
+
+    advanceSampler();
+
+    current_cycle++;
+
+    if ( current_cycle >= max_cycle ) {
+        output->verbose(CALL_INFO, 1, 0, "Reached maximum cycle %" PRIu64 ". Core stops processing.\n", current_cycle);
+        return true;
+    }
+
+    return false;
+}
+
+void
+VANADIS_COMPONENT::performFastForward(const uint64_t cycle, const uint32_t hw_thr)
+{
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob     = rob[hw_thr];
+    VanadisIssueQueue*                         issue_queue = issue_queues[hw_thr];
+
+    const uint16_t int_reg_count = thread_decoders[hw_thr]->countISAIntReg();
+    const uint16_t fp_reg_count  = thread_decoders[hw_thr]->countISAFPReg();
+    const uint16_t zero_reg      = isa_options[hw_thr]->getRegisterIgnoreWrites();
+
+    for ( uint32_t executed = 0; executed < fast_forward_ins_per_cycle; ++executed ) {
+        if ( halted_masks[hw_thr] ) { break; }
+
+        // Retire whatever has completed, performRetire needs a second call
+        // to mark a stalled instruction as the front of the ROB
+        uint32_t retired_before = 0;
+        do {
+            retired_before = ins_retired_this_cycle;
+            performRetire(hw_thr, thr_rob, cycle);
+        } while ( ins_retired_this_cycle != retired_before && !halted_masks[hw_thr] );
+
+        if ( halted_masks[hw_thr] ) { break; }
+
+        // Nothing more to do until the OS answers
+        if ( !thr_rob->empty() && INST_SYSCALL == thr_rob->peek()->getInstFuncType() &&
+             thr_rob->peek()->completedIssue() ) {
+            break;
+        }
+
+        issue_queue->collect(thr_rob);
+
+        if ( 0 == issue_queue->size() ) {
+            const size_t rob_before_decode = thr_rob->size();
+            thread_decoders[hw_thr]->tick(output, (uint64_t)cycle);
+            ins_decoded_this_cycle += thr_rob->size() - rob_before_decode;
+
+            issue_queue->collect(thr_rob);
+
+            if ( 0 == issue_queue->size() ) { break; }
+        }
+
+        // The oldest unissued instruction only waits on the results of
+        // older ones still in flight (loads, stores and syscalls)
+        VanadisInstruction* ins = issue_queue->at(0);
+
+        if ( zero_reg < isa_options[hw_thr]->countISAIntRegisters() ) {
+            register_files[hw_thr]->setIntReg<uint64_t>(issue_isa_tables[hw_thr]->getIntPhysReg(zero_reg), 0);
+        }
+
+        issue_queue->markInFlightWrites(
+            tmp_int_reg_write[hw_thr], int_reg_count, tmp_fp_reg_write[hw_thr], fp_reg_count);
+
+        if ( 0 != checkInstructionResources(ins, int_register_stack, fp_register_stack, issue_isa_tables[hw_thr]) ) {
+            break;
+        }
+
+        // Arithmetic and branches execute straight away, everything else
+        // goes where it would in the detailed pipeline
+        bool execute_now = false;
+
+        switch ( ins->getInstFuncType() ) {
+        case INST_INT_ARITH:
+        case INST_INT_DIV:
+        case INST_FP_ARITH:
+        case INST_FP_DIV:
+        case INST_BRANCH:
+            execute_now = true;
+            break;
+        default:
+            break;
+        }
+
+        if ( !execute_now && 0 != allocateFunctionalUnit(ins) ) { break; }
+
+        assignRegistersToInstruction(
+            int_reg_count, fp_reg_count, ins, int_register_stack, fp_register_stack, issue_isa_tables[hw_thr]);
+
+        ins->markIssued();
+        ins_issued_this_cycle++;
+        issue_queue->issue(0);
+
+        if ( execute_now ) { ins->execute(output, register_files[hw_thr]); }
+    }
+}
+
+void
+VANADIS_COMPONENT::advanceSampler()
+{
+    const VanadisSamplePhase phase_before = sampler->phase();
+
+    switch ( phase_before ) {
+    case VANADIS_SAMPLE_FAST_FORWARD:
+        stat_ff_cycles->addData(1);
+        stat_ff_ins->addData(ins_retired_this_cycle);
+        break;
+    case VANADIS_SAMPLE_MEASURE:
+        stat_sampled_cycles->addData(1);
+        stat_sampled_ins->addData(ins_retired_this_cycle);
+        break;
+    default:
+        break;
+    }
+
+    sampler->advance(ins_retired_this_cycle);
+
+    if ( sampler->phase() != phase_before ) {
+        output->verbose(
+            CALL_INFO, 2, 0, "Sampling: %s at %" PRIu64 " instructions (cycle %" PRIu64 ")\n",
+            (VANADIS_SAMPLE_FAST_FORWARD == sampler->phase()) ? "fast-forward"
+            : (VANADIS_SAMPLE_WARMUP == sampler->phase())     ? "detailed warm-up"
+                                                              : "detailed measurement",
+            sampler->instructionCount(), current_cycle);
+    }
+}
+
 int
 VANADIS_COMPONENT::checkInstructionResources(
     VanadisInstruction* ins, VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs, VanadisISATable* isa_table)
@@ -1673,6 +1961,8 @@ VANADIS_COMPONENT::recoverRetiredRegisters(
     VanadisInstruction* ins, VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs,
     VanadisISATable* issue_isa_table, VanadisISATable* retire_isa_table)
 {
+    issue_queues[ins->getHWThread()]->retire(ins);
+
     std::vector<uint16_t> recovered_phys_reg_int;
     std::vector<uint16_t> recovered_phys_reg_fp;
 
@@ -1770,7 +2060,37 @@ VANADIS_COMPONENT::setup()
 
 void
 VANADIS_COMPONENT::finish()
-{}
+{
+    if ( nullptr == sampler ) { return; }
+
+    const VanadisSampleSummary summary      = sampler->summarize();
+    const uint64_t             instructions = sampler->instructionCount();
+
+    output->verbose(
+        CALL_INFO, 0, 0, "Sampled simulation (%s): %" PRIu64 " windows measured, %" PRIu64 " instructions retired\n",
+        sampler->periodic() ? "periodic" : "simpoint", summary.windows, instructions);
+
+    if ( 0 == summary.windows ) { return; }
+
+    if ( summary.cpi_error >= 0 ) {
+        const double cpi_low  = summary.cpi - summary.cpi_error;
+        const double cpi_high = summary.cpi + summary.cpi_error;
+
+        output->verbose(
+            CALL_INFO, 0, 0, "-> CPI: %.4f +/- %.4f (95%% confidence)\n", summary.cpi, summary.cpi_error);
+        output->verbose(
+            CALL_INFO, 0, 0, "-> IPC: %.4f (%.4f - %.4f)\n", 1.0 / summary.cpi, 1.0 / cpi_high,
+            (cpi_low > 0) ? 1.0 / cpi_low : std::numeric_limits<double>::infinity());
+        output->verbose(
+            CALL_INFO, 0, 0, "-> Extrapolated cycles: %.0f (%.0f - %.0f)\n", instructions * summary.cpi,
+            instructions * std::max(cpi_low, 0.0), instructions * cpi_high);
+    }
+    else {
+        output->verbose(CALL_INFO, 0, 0, "-> CPI: %.4f\n", summary.cpi);
+        output->verbose(CALL_INFO, 0, 0, "-> IPC: %.4f\n", 1.0 / summary.cpi);
+        output->verbose(CALL_INFO, 0, 0, "-> Extrapolated cycles: %.0f\n", instructions * summary.cpi);
+    }
+}
 
 void
 VANADIS_COMPONENT::printStatus(SST::Output& output)
@@ -1915,6 +2235,7 @@ VANADIS_COMPONENT::clearROBMisspeculate(const uint32_t hw_thr)
 
     // clear the ROB entries and reset
     thr_rob->clear();
+    issue_queues[hw_thr]->clear(thr_rob);
 }
 
 void
@@ -1968,6 +2289,7 @@ void VANADIS_COMPONENT::recvOSEvent(SST::Event* ev) {
 
         VanadisStartThreadFirstReq* os_req = dynamic_cast<VanadisStartThreadFirstReq*>(ev);
         if ( nullptr != os_req ) {
+            thread_decoders[os_req->getThread()]->getInstructionLoader()->setImage( os_req->getImage() );
             startThread( os_req->getThread(), os_req->getStackAddr(), os_req->getInstPtr() );
         } else {
 
@@ -2026,6 +2348,7 @@ void VANADIS_COMPONENT::startThreadClone( VanadisStartThreadCloneReq* req )
     auto reg_file = register_files[hw_thr];
 
     resetHwThread( hw_thr );
+    thr_decoder->getInstructionLoader()->setImage( req->getImage() );
 
     output->verbose(CALL_INFO, 8, 0,"instPtr=%#" PRIx64 " stackAddr=%#" PRIx64 " argAddr=%#" PRIx64 " tlsAddr=%#" PRIx64 "\n",
         req->getInstPtr(), req->getStackAddr(), req->getArgAddr(), req->getTlsAddr() );
@@ -2062,6 +2385,7 @@ void VANADIS_COMPONENT::startThreadFork( VanadisStartThreadForkReq* req )
     auto reg_file = register_files[hw_thr];
 
     resetHwThread( hw_thr );
+    thr_decoder->getInstructionLoader()->setImage( req->getImage() );
 
     output->verbose(CALL_INFO, 8, 0,"start thread fork, thread=%d instPtr=%#" PRIx64 " tlsPtr=%#" PRIx64 "\n",
                 req->getThread(), req->getInstPtr(), req->getTlsAddr() );
@@ -2152,6 +2476,7 @@ VANADIS_COMPONENT::resetHwThread(uint32_t thr)
     auto thr_rob = rob[thr];
 
     thr_rob->clear();
+    issue_queues[thr]->clear(thr_rob);
 
 #if 0
     output->setVerboseLevel( 16 );
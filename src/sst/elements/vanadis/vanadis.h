@@ -27,6 +27,8 @@
 #include "velf/velfinfo.h"
 #include "vfpflags.h"
 #include "vfuncunit.h"
+#include "vissueq.h"
+#include "vsampler.h"
 
 #include "os/vgetthreadstate.h"
 #include "os/vdumpregsreq.h"
@@ -118,6 +120,22 @@ public:
                                         "address is retired, set verbose to 0", ""},
         { "pause_when_retire_address", "If specified, the simulation will stop when this address is retired.", "0"},
         { "pipeline_trace_file", "If specified, a trace of the pipeline activity will be generated to this file.", ""},
+        { "branch_trace_file", "If specified, every retired branch is written to this file as 'address next-address taken', "
+          "for replay with the bpbench tool.", ""},
+        { "sampling", "Sampled simulation: 'none' simulates every instruction in detail, 'periodic' simulates a "
+          "window at the end of every sample_period instructions (SMARTS), 'simpoint' simulates the intervals in "
+          "simpoint_file. Instructions outside the windows are fast-forwarded: they still pass through the ROB, "
+          "issue queue and LSQ and every load and store still goes to the caches, only the out-of-order timing is "
+          "skipped, so the speedup over detailed simulation is limited.", "none"},
+        { "sample_period", "Instructions in each sampling period (periodic sampling)", "1000000"},
+        { "sample_length", "Instructions measured in each window (periodic sampling)", "1000"},
+        { "sample_warmup", "Instructions simulated in detail before each measured window to refill the pipeline, "
+          "these are not measured", "2000"},
+        { "simpoint_file", "SimPoint .simpoints file, one '<interval> <cluster>' per line (simpoint sampling)", ""},
+        { "simpoint_weights_file", "SimPoint .weights file, one '<weight> <cluster>' per line (simpoint sampling)", ""},
+        { "simpoint_interval", "Instructions in each SimPoint interval (simpoint sampling)", "10000000"},
+        { "fast_forward_ins_per_cycle", "Maximum number of instructions each hardware thread executes per cycle while "
+          "fast-forwarding", "64"},
         { "max_cycle", "Maximum number of cycles to execute. The core will halt after this many cycles." , "std::numeric_limits<uint64_t>::max()"},
         { "node_id", "Identifier for the node this core belongs to. Each node in the system needs a unique ID between 0 and (number of nodes) - 1. Used to tag output.", "0"},
         { "core_id", "Identifier for this core. Each core in the system needs a unique ID between 0 and (number of cores) - 1.", 0 },
@@ -160,10 +178,18 @@ public:
         { "instructions_issued", "Number of instructions issued", "instructions", 1 },
         { "instructions_retired", "Number of instructions retired", "instructions", 1 },
         { "instructions_decoded", "Number of instructions decoded", "instructions", 1 },
+        { "instruction_host_allocations",
+          "Number of host memory allocations made for micro-op objects during decode, compare with "
+          "instructions_decoded",
+          "allocations", 1 },
         { "branch_mispredicts", "Number of retired branches which were mis-predicted", "instructions", 1 },
         { "branches", "Number of retired branches", "instructions", 1 },
         { "loads_issued", "Number of load instructions issued to the LSQ", "instructions", 1 },
         { "stores_issued", "Number of store instructions issued to the LSQ", "instructions", 1 },
+        { "fast_forward_cycles", "Number of cycles spent fast-forwarding between sampled windows", "cycles", 1 },
+        { "fast_forward_instructions", "Number of instructions retired while fast-forwarding", "instructions", 1 },
+        { "sampled_cycles", "Number of cycles in measured sample windows", "cycles", 1 },
+        { "sampled_instructions", "Number of instructions retired in measured sample windows", "instructions", 1 },
         { "phys_int_reg_in_use", "Number of physical integer registers that are in use each cycle", "registers", 1 },
         { "phys_fp_reg_in_use", "Number of physical floating point registers than are in use each cycle", "registers",
           1 })
@@ -238,9 +264,12 @@ private:
 
     int  performFetch(const uint64_t cycle);
     int  performDecode(const uint64_t cycle);
-    int  performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_start, int& unallocated_memory_op_seen);
+    int  performIssue(const uint64_t cycle, int hwThr, uint32_t& issue_start, int& unallocated_memory_op_seen);
     int  performExecute(const uint64_t cycle);
     int  performRetire(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle);
+    void performFastForward(const uint64_t cycle, const uint32_t hw_thr);
+    bool tickFastForward(SST::Cycle_t cycle);
+    void advanceSampler();
     int  allocateFunctionalUnit(VanadisInstruction* ins);
     bool mapInstructiontoFunctionalUnit(VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units);
     void printRob(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob);
@@ -285,6 +314,7 @@ private:
     uint32_t m_curIssueHwThread;
 
     std::vector<VanadisCircularQueue<VanadisInstruction*>*> rob;
+    std::vector<VanadisIssueQueue*>                         issue_queues;
     std::vector<VanadisDecoder*>                            thread_decoders;
     std::vector<const VanadisDecoderOptions*>               isa_options;
 
@@ -327,9 +357,14 @@ private:
     Clock::Handler<VANADIS_COMPONENT>* cpuClockHandler;
 
     FILE*           pipelineTrace;
+    FILE*           branchTrace;
+
+    VanadisSampler* sampler;
+    uint32_t        fast_forward_ins_per_cycle;
 
     Statistic<uint64_t>* stat_ins_retired;
     Statistic<uint64_t>* stat_ins_decoded;
+    Statistic<uint64_t>* stat_ins_host_allocs;
     Statistic<uint64_t>* stat_ins_issued;
     Statistic<uint64_t>* stat_loads_issued;
     Statistic<uint64_t>* stat_stores_issued;
@@ -339,6 +374,10 @@ private:
     Statistic<uint64_t>* stat_rob_entries;
     Statistic<uint64_t>* stat_rob_cleared_entries;
     Statistic<uint64_t>* stat_syscall_cycles;
+    Statistic<uint64_t>* stat_ff_cycles;
+    Statistic<uint64_t>* stat_ff_ins;
+    Statistic<uint64_t>* stat_sampled_cycles;
+    Statistic<uint64_t>* stat_sampled_ins;
     Statistic<uint64_t>* stat_int_phys_regs_in_use;
     Statistic<uint64_t>* stat_fp_phys_regs_in_use;
 
@@ -0,0 +1,283 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_DIRECTION
+#define _H_VANADIS_BRANCH_UNIT_DIRECTION
+
+#include "vbranch/vbranchpred.h"
+#include "vbranch/vbranchunit.h"
+
+#include <deque>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Branch unit built from a direction predictor and a direct-mapped
+// branch target buffer. A branch is predicted taken only if the
+// direction predictor says so and the BTB has a target for it,
+// otherwise the decoder falls through.
+//
+// Predictions are made at decode and trained at retire, so each
+// prediction is kept (oldest first) until its branch retires. A
+// misprediction flushes everything younger, so the in-flight list is
+// dropped and the predictor's speculative history is repaired.
+class VanadisDirectionBranchUnit : public VanadisBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED_API(SST::Vanadis::VanadisDirectionBranchUnit, SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "btb_entries", "Number of entries in the branch target buffer, must be a power of two",
+                              "1024" })
+
+    SST_ELI_DOCUMENT_STATISTICS({ "branch_predictions", "Number of conditional and unconditional branches predicted "
+                                                        "and then retired", "branches", 1 },
+                                { "branch_direction_mispredicts", "Number of retired branches whose predicted "
+                                                                  "direction was wrong", "branches", 1 },
+                                { "branch_target_mispredicts", "Number of retired branches predicted taken in the "
+                                                               "right direction but to the wrong target", "branches", 1 },
+                                { "btb_miss", "Number of branches predicted taken with no target in the BTB",
+                                  "branches", 1 })
+
+    VanadisDirectionBranchUnit(ComponentId_t id, Params& params) : VanadisBranchUnit(id, params), predictor(nullptr) {
+        const uint32_t btb_entries = params.find<uint32_t>("btb_entries", 1024);
+
+        if ( btb_entries == 0 || (btb_entries & (btb_entries - 1)) != 0 ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "%s, Error: btb_entries must be a power of two, got %" PRIu32 "\n",
+                getName().c_str(), btb_entries);
+        }
+
+        btb.resize(btb_entries);
+        btb_mask         = btb_entries - 1;
+        predicted_target = 0;
+
+        stat_predictions       = registerStatistic<uint64_t>("branch_predictions", "1");
+        stat_direction_miss    = registerStatistic<uint64_t>("branch_direction_mispredicts", "1");
+        stat_target_miss       = registerStatistic<uint64_t>("branch_target_mispredicts", "1");
+        stat_btb_miss          = registerStatistic<uint64_t>("btb_miss", "1");
+    }
+
+    virtual ~VanadisDirectionBranchUnit() { delete predictor; }
+
+    virtual bool contains(const uint64_t addr) {
+        InFlightBranch branch;
+        branch.ins_addr = addr;
+
+        const bool     predict_taken = predictor->predict(addr, branch.info);
+        const BTBEntry& entry         = btb[btbIndex(addr)];
+        const bool     btb_hit       = entry.valid && entry.ins_addr == addr;
+
+        if ( predict_taken && !btb_hit ) { stat_btb_miss->addData(1); }
+
+        branch.taken  = predict_taken && btb_hit;
+        branch.target = btb_hit ? entry.target : 0;
+
+        predictor->speculate(addr, branch.taken);
+
+        if ( in_flight.size() >= MAX_IN_FLIGHT ) { in_flight.pop_front(); }
+        in_flight.push_back(branch);
+
+        predicted_target = branch.target;
+        return branch.taken;
+    }
+
+    virtual uint64_t predictAddress(const uint64_t /*addr*/) { return predicted_target; }
+
+    // Target only, used when the caller cannot tell the direction
+    virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) { updateBTB(ins_addr, pred_addr); }
+
+    virtual void update(const uint64_t ins_addr, const uint64_t next_addr, const bool taken) {
+        if ( taken ) { updateBTB(ins_addr, next_addr); }
+
+        // Anything older than this branch was flushed before it retired
+        while ( !in_flight.empty() && in_flight.front().ins_addr != ins_addr ) {
+            in_flight.pop_front();
+        }
+
+        if ( in_flight.empty() ) { return; }
+
+        const InFlightBranch branch = in_flight.front();
+        in_flight.pop_front();
+
+        predictor->update(ins_addr, taken, branch.info);
+        stat_predictions->addData(1);
+
+        bool mispredict = false;
+
+        if ( branch.taken != taken ) {
+            stat_direction_miss->addData(1);
+            mispredict = true;
+        } else if ( taken && branch.target != next_addr ) {
+            stat_target_miss->addData(1);
+            mispredict = true;
+        }
+
+        if ( mispredict ) {
+            predictor->recover(ins_addr, taken, branch.info);
+            in_flight.clear();
+        }
+    }
+
+protected:
+    struct BTBEntry {
+        BTBEntry() : valid(false), ins_addr(0), target(0) {}
+
+        bool     valid;
+        uint64_t ins_addr;
+        uint64_t target;
+    };
+
+    struct InFlightBranch {
+        uint64_t                 ins_addr;
+        uint64_t                 target;
+        bool                     taken;
+        VanadisBranchPredictInfo info;
+    };
+
+    static const size_t MAX_IN_FLIGHT = 4096;
+
+    uint32_t btbIndex(const uint64_t addr) const { return (uint32_t)((addr >> 1) ^ (addr >> 15)) & btb_mask; }
+
+    void updateBTB(const uint64_t ins_addr, const uint64_t target) {
+        BTBEntry& entry = btb[btbIndex(ins_addr)];
+        entry.valid     = true;
+        entry.ins_addr  = ins_addr;
+        entry.target    = target;
+    }
+
+    VanadisBranchPredictor*    predictor;
+    std::vector<BTBEntry>      btb;
+    uint32_t                   btb_mask;
+    std::deque<InFlightBranch> in_flight;
+    uint64_t                   predicted_target;
+
+    Statistic<uint64_t>* stat_predictions;
+    Statistic<uint64_t>* stat_direction_miss;
+    Statistic<uint64_t>* stat_target_miss;
+    Statistic<uint64_t>* stat_btb_miss;
+};
+
+class VanadisGShareBranchUnit : public VanadisDirectionBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisGShareBranchUnit, "vanadis", "VanadisGShareBranchUnit",
+                                  SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                  "gshare direction predictor (global history xor PC indexing two bit counters) "
+                                  "with a branch target buffer",
+                                  SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "log_entries", "Log2 of the number of two bit counters", "14" },
+                            { "history_bits", "Number of global history bits xor'd into the index", "14" })
+
+    VanadisGShareBranchUnit(ComponentId_t id, Params& params) : VanadisDirectionBranchUnit(id, params) {
+        const uint32_t log_entries  = params.find<uint32_t>("log_entries", 14);
+        const uint32_t history_bits = params.find<uint32_t>("history_bits", log_entries);
+
+        if ( log_entries == 0 || log_entries > 28 ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "%s, Error: log_entries must be between 1 and 28, got %" PRIu32 "\n",
+                getName().c_str(), log_entries);
+        }
+
+        predictor = new VanadisGShareBranchPredictor(log_entries, history_bits);
+    }
+};
+
+class VanadisPerceptronBranchUnit : public VanadisDirectionBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisPerceptronBranchUnit, "vanadis", "VanadisPerceptronBranchUnit",
+                                  SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                  "Global history perceptron direction predictor with a branch target buffer",
+                                  SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "perceptrons", "Number of perceptrons (rows of weights)", "512" },
+                            { "history_bits", "Global history length, at most 63", "32" })
+
+    VanadisPerceptronBranchUnit(ComponentId_t id, Params& params) : VanadisDirectionBranchUnit(id, params) {
+        const uint32_t perceptrons  = params.find<uint32_t>("perceptrons", 512);
+        const uint32_t history_bits = params.find<uint32_t>("history_bits", 32);
+
+        if ( perceptrons == 0 || history_bits == 0 || history_bits > 63 ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1,
+                "%s, Error: perceptrons must be non-zero and history_bits between 1 and 63, got %" PRIu32
+                " and %" PRIu32 "\n",
+                getName().c_str(), perceptrons, history_bits);
+        }
+
+        predictor = new VanadisPerceptronBranchPredictor(perceptrons, history_bits);
+    }
+};
+
+class VanadisTAGEBranchUnit : public VanadisDirectionBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisTAGEBranchUnit, "vanadis", "VanadisTAGEBranchUnit",
+                                  SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                  "TAGE direction predictor (bimodal base plus tagged geometric history tables) "
+                                  "with a branch target buffer",
+                                  SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "tables", "Number of tagged tables, at most 12", "7" },
+                            { "log_bimodal_entries", "Log2 of the number of bimodal counters", "13" },
+                            { "log_table_entries", "Log2 of the number of entries in each tagged table", "10" },
+                            { "min_history", "History length of the shortest tagged table", "4" },
+                            { "max_history", "History length of the longest tagged table, at most 2048", "640" },
+                            { "tag_bits", "Tag width of the shortest table, longer tables add one bit every two "
+                                          "tables up to 16", "8" })
+
+    VanadisTAGEBranchUnit(ComponentId_t id, Params& params) : VanadisDirectionBranchUnit(id, params) {
+        const uint32_t tables      = params.find<uint32_t>("tables", 7);
+        const uint32_t log_bimodal = params.find<uint32_t>("log_bimodal_entries", 13);
+        const uint32_t log_entries = params.find<uint32_t>("log_table_entries", 10);
+        const uint32_t min_history = params.find<uint32_t>("min_history", 4);
+        const uint32_t max_history = params.find<uint32_t>("max_history", 640);
+        const uint32_t tag_bits    = params.find<uint32_t>("tag_bits", 8);
+
+        if ( tables == 0 || tables > VANADIS_TAGE_MAX_TABLES ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "%s, Error: tables must be between 1 and %d, got %" PRIu32 "\n", getName().c_str(),
+                VANADIS_TAGE_MAX_TABLES, tables);
+        }
+        if ( min_history == 0 || min_history > max_history || max_history > 2048 ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1,
+                "%s, Error: history lengths must satisfy 0 < min_history <= max_history <= 2048, got %" PRIu32
+                " and %" PRIu32 "\n",
+                getName().c_str(), min_history, max_history);
+        }
+        if ( log_bimodal == 0 || log_bimodal > 28 || log_entries == 0 || log_entries > 20 ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1,
+                "%s, Error: log_bimodal_entries must be between 1 and 28 and log_table_entries between 1 and 20\n",
+                getName().c_str());
+        }
+        if ( tag_bits < 4 || tag_bits > 16 ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "%s, Error: tag_bits must be between 4 and 16, got %" PRIu32 "\n", getName().c_str(),
+                tag_bits);
+        }
+
+        predictor =
+            new VanadisTAGEBranchPredictor(tables, log_bimodal, log_entries, min_history, max_history, tag_bits);
+    }
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
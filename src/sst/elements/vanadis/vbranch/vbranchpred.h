@@ -0,0 +1,490 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_PREDICTORS
+#define _H_VANADIS_BRANCH_PREDICTORS
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Conditional branch direction predictors.
+//
+// These have no SST dependencies so the same code is used by the
+// branch unit subcomponents (vbranch/vbranchdir.h) and by the trace
+// replay benchmark (tools/bpbench). The protocol for each dynamic
+// branch is:
+//
+//   predict()   - look up a direction using the speculative history,
+//                 recording everything needed later in the info block
+//   speculate() - push the direction the front end followed into the
+//                 speculative history
+//   update()    - train with the resolved direction once the branch
+//                 retires
+//   recover()   - on a misprediction, rewind the history to just before
+//                 the branch and push the resolved direction
+//
+// A trace replay calls predict, speculate (with the predicted
+// direction), update and, if wrong, recover back to back.
+
+namespace SST {
+namespace Vanadis {
+
+#define VANADIS_TAGE_MAX_TABLES 12
+
+struct VanadisBranchPredictInfo {
+    bool     taken;
+    uint64_t history;
+    int32_t  output;
+
+    // TAGE state
+    uint32_t history_head;
+    uint32_t path;
+    uint32_t folded_index[VANADIS_TAGE_MAX_TABLES];
+    uint32_t folded_tag0[VANADIS_TAGE_MAX_TABLES];
+    uint32_t folded_tag1[VANADIS_TAGE_MAX_TABLES];
+    uint32_t index[VANADIS_TAGE_MAX_TABLES + 1];
+    uint16_t tag[VANADIS_TAGE_MAX_TABLES];
+    int8_t   provider;
+    int8_t   alt_provider;
+    bool     provider_pred;
+    bool     alt_pred;
+    bool     weak_provider;
+};
+
+class VanadisBranchPredictor {
+public:
+    virtual ~VanadisBranchPredictor() {}
+
+    virtual bool predict(const uint64_t pc, VanadisBranchPredictInfo& info) = 0;
+    virtual void speculate(const uint64_t pc, const bool taken) = 0;
+    virtual void update(const uint64_t pc, const bool taken, const VanadisBranchPredictInfo& info) = 0;
+    virtual void recover(const uint64_t pc, const bool taken, const VanadisBranchPredictInfo& info) = 0;
+
+    virtual const char* getName() const = 0;
+    virtual uint64_t    getStorageBits() const = 0;
+
+protected:
+    // Instructions are at least 2-byte aligned (RISC-V compressed)
+    static uint64_t hashPC(const uint64_t pc) { return (pc >> 1) ^ (pc >> 13); }
+};
+
+// Two bit saturating counters, four to a byte
+class VanadisPackedCounters {
+public:
+    VanadisPackedCounters(const uint32_t entries) : bits((entries + 3) / 4, 0xAA) {}
+
+    uint32_t get(const uint32_t index) const { return (bits[index >> 2] >> ((index & 3) * 2)) & 0x3; }
+
+    bool taken(const uint32_t index) const { return get(index) >= 2; }
+
+    void update(const uint32_t index, const bool taken) {
+        uint32_t       value = get(index);
+        const uint32_t shift = (index & 3) * 2;
+
+        if ( taken && value < 3 ) {
+            value++;
+        } else if ( !taken && value > 0 ) {
+            value--;
+        }
+
+        bits[index >> 2] = (bits[index >> 2] & ~(0x3 << shift)) | (value << shift);
+    }
+
+    uint64_t getStorageBits() const { return bits.size() * 8; }
+
+private:
+    std::vector<uint8_t> bits;
+};
+
+// McFarling gshare: global history xor'd with the PC indexes a table of
+// two bit counters
+class VanadisGShareBranchPredictor : public VanadisBranchPredictor {
+public:
+    VanadisGShareBranchPredictor(const uint32_t log_entries, const uint32_t history_bits) :
+        counters(1 << log_entries),
+        index_mask((1 << log_entries) - 1),
+        history_mask((history_bits >= 64) ? UINT64_MAX : ((UINT64_C(1) << history_bits) - 1)),
+        history(0)
+    {}
+
+    bool predict(const uint64_t pc, VanadisBranchPredictInfo& info) override {
+        info.history  = history;
+        info.index[0] = (hashPC(pc) ^ (history & history_mask)) & index_mask;
+        info.taken    = counters.taken(info.index[0]);
+        return info.taken;
+    }
+
+    void speculate(const uint64_t /*pc*/, const bool taken) override { history = (history << 1) | (taken ? 1 : 0); }
+
+    void update(const uint64_t /*pc*/, const bool taken, const VanadisBranchPredictInfo& info) override {
+        counters.update(info.index[0], taken);
+    }
+
+    void recover(const uint64_t /*pc*/, const bool taken, const VanadisBranchPredictInfo& info) override {
+        history = (info.history << 1) | (taken ? 1 : 0);
+    }
+
+    const char* getName() const override { return "gshare"; }
+    uint64_t    getStorageBits() const override { return counters.getStorageBits(); }
+
+private:
+    VanadisPackedCounters counters;
+    const uint32_t        index_mask;
+    const uint64_t        history_mask;
+    uint64_t              history;
+};
+
+// Jimenez and Lin global perceptron predictor, one row of signed 8-bit
+// weights per perceptron, selected by the PC
+class VanadisPerceptronBranchPredictor : public VanadisBranchPredictor {
+public:
+    VanadisPerceptronBranchPredictor(const uint32_t num_perceptrons, const uint32_t history_bits) :
+        rows(num_perceptrons),
+        history_length(history_bits > 63 ? 63 : history_bits),
+        threshold((int32_t)(1.93 * history_length + 14)),
+        weights((size_t)num_perceptrons * (history_length + 1), 0),
+        history(0)
+    {}
+
+    bool predict(const uint64_t pc, VanadisBranchPredictInfo& info) override {
+        const uint32_t row = hashPC(pc) % rows;
+        const int8_t*  w   = &weights[(size_t)row * (history_length + 1)];
+
+        int32_t y = w[0];
+        for ( uint32_t i = 0; i < history_length; ++i ) {
+            y += ((history >> i) & 1) ? w[i + 1] : -w[i + 1];
+        }
+
+        info.history  = history;
+        info.index[0] = row;
+        info.output   = y;
+        info.taken    = (y >= 0);
+        return info.taken;
+    }
+
+    void speculate(const uint64_t /*pc*/, const bool taken) override { history = (history << 1) | (taken ? 1 : 0); }
+
+    void update(const uint64_t /*pc*/, const bool taken, const VanadisBranchPredictInfo& info) override {
+        if ( (info.taken == taken) && (std::abs(info.output) > threshold) ) { return; }
+
+        int8_t* w = &weights[(size_t)info.index[0] * (history_length + 1)];
+
+        train(w[0], taken);
+        for ( uint32_t i = 0; i < history_length; ++i ) {
+            train(w[i + 1], (((info.history >> i) & 1) != 0) == taken);
+        }
+    }
+
+    void recover(const uint64_t /*pc*/, const bool taken, const VanadisBranchPredictInfo& info) override {
+        history = (info.history << 1) | (taken ? 1 : 0);
+    }
+
+    const char* getName() const override { return "perceptron"; }
+    uint64_t    getStorageBits() const override { return weights.size() * 8; }
+
+private:
+    static void train(int8_t& weight, const bool increase) {
+        if ( increase ) {
+            if ( weight < 127 ) { weight++; }
+        } else {
+            if ( weight > -127 ) { weight--; }
+        }
+    }
+
+    const uint32_t      rows;
+    const uint32_t      history_length;
+    const int32_t       threshold;
+    std::vector<int8_t> weights;
+    uint64_t            history;
+};
+
+// TAGE (Seznec and Michaud) without the statistical corrector and loop
+// predictor components: a bimodal base predictor and a set of tagged
+// tables indexed with geometrically increasing global history lengths.
+// The longest matching history provides the prediction.
+class VanadisTAGEBranchPredictor : public VanadisBranchPredictor {
+public:
+    VanadisTAGEBranchPredictor(
+        const uint32_t tables, const uint32_t log_bimodal, const uint32_t log_entries, const uint32_t min_history,
+        const uint32_t max_history, const uint32_t tag_bits) :
+        num_tables(tables),
+        log_table(log_entries),
+        bimodal(1 << log_bimodal),
+        bimodal_mask((1 << log_bimodal) - 1),
+        history_buffer(HISTORY_BUFFER, 0),
+        history_head(0),
+        path(0),
+        use_alt_on_na(0),
+        updates(0),
+        rng_state(0x2545F4914F6CDD1DULL)
+    {
+        for ( uint32_t i = 0; i < num_tables; ++i ) {
+            const double ratio = (num_tables > 1) ? (double)i / (double)(num_tables - 1) : 0.0;
+            history_length[i]  = (uint32_t)(min_history * std::pow((double)max_history / min_history, ratio) + 0.5);
+            tag_width[i]       = (tag_bits + i / 2) > 16 ? 16 : (tag_bits + i / 2);
+
+            folded_index[i].init(history_length[i], log_table);
+            folded_tag0[i].init(history_length[i], tag_width[i]);
+            folded_tag1[i].init(history_length[i], tag_width[i] - 1);
+
+            tagged[i].resize(1 << log_table);
+        }
+    }
+
+    bool predict(const uint64_t pc, VanadisBranchPredictInfo& info) override {
+        const uint64_t pc_hash = hashPC(pc);
+
+        info.history_head = history_head;
+        info.path         = path;
+        info.index[0]     = pc_hash & bimodal_mask;
+
+        info.provider     = -1;
+        info.alt_provider = -1;
+
+        for ( uint32_t i = 0; i < num_tables; ++i ) {
+            info.folded_index[i] = folded_index[i].comp;
+            info.folded_tag0[i]  = folded_tag0[i].comp;
+            info.folded_tag1[i]  = folded_tag1[i].comp;
+
+            info.index[i + 1] = tableIndex(i, pc_hash);
+            info.tag[i]       = tableTag(i, pc_hash);
+        }
+
+        for ( int i = num_tables - 1; i >= 0; --i ) {
+            if ( tagged[i][info.index[i + 1]].tag == info.tag[i] ) {
+                if ( info.provider < 0 ) {
+                    info.provider = i;
+                } else {
+                    info.alt_provider = i;
+                    break;
+                }
+            }
+        }
+
+        info.alt_pred = (info.alt_provider >= 0) ? (tagged[info.alt_provider][info.index[info.alt_provider + 1]].ctr >= 0)
+                                                 : bimodal.taken(info.index[0]);
+
+        if ( info.provider >= 0 ) {
+            const TaggedEntry& entry = tagged[info.provider][info.index[info.provider + 1]];
+
+            info.provider_pred = (entry.ctr >= 0);
+            info.weak_provider = (entry.ctr == 0 || entry.ctr == -1) && (entry.u == 0);
+            info.taken         = (info.weak_provider && use_alt_on_na >= 0) ? info.alt_pred : info.provider_pred;
+        } else {
+            info.provider_pred = info.alt_pred;
+            info.weak_provider = false;
+            info.taken         = info.alt_pred;
+        }
+
+        return info.taken;
+    }
+
+    void speculate(const uint64_t pc, const bool taken) override {
+        history_head                 = (history_head - 1) & (HISTORY_BUFFER - 1);
+        history_buffer[history_head] = taken ? 1 : 0;
+        path                         = ((path << 1) ^ (hashPC(pc) & 1)) & 0xFFFF;
+
+        for ( uint32_t i = 0; i < num_tables; ++i ) {
+            folded_index[i].update(history_buffer, history_head);
+            folded_tag0[i].update(history_buffer, history_head);
+            folded_tag1[i].update(history_buffer, history_head);
+        }
+    }
+
+    void update(const uint64_t /*pc*/, const bool taken, const VanadisBranchPredictInfo& info) override {
+        if ( info.provider >= 0 ) {
+            if ( info.weak_provider && (info.provider_pred != info.alt_pred) ) {
+                if ( info.alt_pred == taken ) {
+                    if ( use_alt_on_na < 7 ) { use_alt_on_na++; }
+                } else {
+                    if ( use_alt_on_na > -8 ) { use_alt_on_na--; }
+                }
+            }
+        }
+
+        // Allocate a longer history entry on a misprediction
+        if ( (info.taken != taken) && (info.provider < (int)num_tables - 1) ) {
+            allocate(taken, info);
+        }
+
+        if ( info.provider >= 0 ) {
+            TaggedEntry& entry = tagged[info.provider][info.index[info.provider + 1]];
+
+            // The entry may have been replaced since the prediction was made
+            if ( entry.tag == info.tag[info.provider] ) {
+                updateCounter(entry.ctr, taken);
+
+                if ( info.provider_pred != info.alt_pred ) {
+                    if ( info.provider_pred == taken ) {
+                        if ( entry.u < 3 ) { entry.u++; }
+                    } else {
+                        if ( entry.u > 0 ) { entry.u--; }
+                    }
+                }
+
+                if ( entry.u == 0 && info.alt_provider < 0 ) { bimodal.update(info.index[0], taken); }
+            }
+        } else {
+            bimodal.update(info.index[0], taken);
+        }
+
+        // Periodically age the useful bits so stale entries can be replaced
+        if ( (++updates & (USEFUL_RESET_PERIOD - 1)) == 0 ) {
+            for ( uint32_t i = 0; i < num_tables; ++i ) {
+                for ( TaggedEntry& entry : tagged[i] ) {
+                    entry.u >>= 1;
+                }
+            }
+        }
+    }
+
+    void recover(const uint64_t pc, const bool taken, const VanadisBranchPredictInfo& info) override {
+        history_head = info.history_head;
+        path         = info.path;
+
+        for ( uint32_t i = 0; i < num_tables; ++i ) {
+            folded_index[i].comp = info.folded_index[i];
+            folded_tag0[i].comp  = info.folded_tag0[i];
+            folded_tag1[i].comp  = info.folded_tag1[i];
+        }
+
+        speculate(pc, taken);
+    }
+
+    const char* getName() const override { return "tage"; }
+
+    uint64_t getStorageBits() const override {
+        uint64_t bits = bimodal.getStorageBits();
+        for ( uint32_t i = 0; i < num_tables; ++i ) {
+            // tag, 3-bit counter, 2-bit useful
+            bits += (uint64_t)tagged[i].size() * (tag_width[i] + 3 + 2);
+        }
+        return bits;
+    }
+
+    uint32_t getHistoryLength(const uint32_t table) const { return history_length[table]; }
+
+private:
+    // Long enough for the longest history plus every branch that can be
+    // in flight between prediction and retire
+    static const uint32_t HISTORY_BUFFER      = 8192;
+    static const uint32_t USEFUL_RESET_PERIOD = 1 << 18;
+
+    struct TaggedEntry {
+        TaggedEntry() : tag(0), ctr(0), u(0) {}
+
+        uint16_t tag;
+        int8_t   ctr;
+        uint8_t  u;
+    };
+
+    // Cyclic shift register folding a long history into a few bits
+    struct FoldedHistory {
+        uint32_t comp;
+        uint32_t comp_length;
+        uint32_t orig_length;
+        uint32_t outpoint;
+
+        void init(const uint32_t original, const uint32_t compressed) {
+            comp        = 0;
+            orig_length = original;
+            comp_length = compressed;
+            outpoint    = original % compressed;
+        }
+
+        void update(const std::vector<uint8_t>& buffer, const uint32_t head) {
+            comp = (comp << 1) ^ buffer[head];
+            comp ^= buffer[(head + orig_length) & (HISTORY_BUFFER - 1)] << outpoint;
+            comp ^= (comp >> comp_length);
+            comp &= (1 << comp_length) - 1;
+        }
+    };
+
+    uint32_t tableIndex(const uint32_t table, const uint64_t pc_hash) const {
+        const uint32_t path_bits = history_length[table] < 16 ? history_length[table] : 16;
+        const uint32_t path_hash = (path & ((1 << path_bits) - 1)) * (table + 1);
+
+        return (uint32_t)(pc_hash ^ (pc_hash >> (log_table - (table % log_table))) ^ folded_index[table].comp ^
+                          path_hash) &
+               ((1 << log_table) - 1);
+    }
+
+    uint16_t tableTag(const uint32_t table, const uint64_t pc_hash) const {
+        return (uint16_t)((pc_hash ^ folded_tag0[table].comp ^ (folded_tag1[table].comp << 1)) &
+                          ((1 << tag_width[table]) - 1));
+    }
+
+    static void updateCounter(int8_t& ctr, const bool taken) {
+        if ( taken ) {
+            if ( ctr < 3 ) { ctr++; }
+        } else {
+            if ( ctr > -4 ) { ctr--; }
+        }
+    }
+
+    void allocate(const bool taken, const VanadisBranchPredictInfo& info) {
+        uint32_t start = info.provider + 1;
+
+        // Skip one table half of the time so allocations spread out
+        rng_state ^= rng_state >> 12;
+        rng_state ^= rng_state << 25;
+        rng_state ^= rng_state >> 27;
+        if ( ((rng_state * 2685821657736338717ULL) >> 63) && (start + 1 < num_tables) ) { start++; }
+
+        for ( uint32_t i = start; i < num_tables; ++i ) {
+            TaggedEntry& entry = tagged[i][info.index[i + 1]];
+
+            if ( entry.u == 0 ) {
+                entry.tag = info.tag[i];
+                entry.ctr = taken ? 0 : -1;
+                return;
+            }
+        }
+
+        // Nothing free, make room for next time
+        for ( uint32_t i = start; i < num_tables; ++i ) {
+            TaggedEntry& entry = tagged[i][info.index[i + 1]];
+            if ( entry.u > 0 ) { entry.u--; }
+        }
+    }
+
+    const uint32_t num_tables;
+    const uint32_t log_table;
+
+    VanadisPackedCounters    bimodal;
+    const uint32_t           bimodal_mask;
+    std::vector<TaggedEntry> tagged[VANADIS_TAGE_MAX_TABLES];
+    uint32_t                 history_length[VANADIS_TAGE_MAX_TABLES];
+    uint32_t                 tag_width[VANADIS_TAGE_MAX_TABLES];
+
+    std::vector<uint8_t> history_buffer;
+    uint32_t             history_head;
+    uint32_t             path;
+    FoldedHistory        folded_index[VANADIS_TAGE_MAX_TABLES];
+    FoldedHistory        folded_tag0[VANADIS_TAGE_MAX_TABLES];
+    FoldedHistory        folded_tag1[VANADIS_TAGE_MAX_TABLES];
+
+    int32_t  use_alt_on_na;
+    uint64_t updates;
+    uint64_t rng_state;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -40,6 +40,13 @@ public:
     virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) = 0;
     virtual uint64_t predictAddress(const uint64_t addr) = 0;
     virtual bool contains(const uint64_t addr) = 0;
+
+    // Called when a branch retires with the address execution continued
+    // at. taken is false if that was the fall-through address. Units
+    // which only cache targets can rely on the default.
+    virtual void update(const uint64_t ins_addr, const uint64_t next_addr, const bool /*taken*/) {
+        push(ins_addr, next_addr);
+    }
 };
 
 } // namespace Vanadis
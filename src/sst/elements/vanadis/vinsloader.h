@@ -21,6 +21,11 @@
 
 #include <cinttypes>
 #include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <unordered_map>
 
@@ -37,14 +42,35 @@ enum class VanadisInstructionLoaderMode {
     LRU_CACHE_MODE
 };
 
+typedef VanadisCache<uint64_t, VanadisInstructionBundle*, SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE> VanadisUopCache;
+
+// Decoded bundles shared by every loader that joined the same group.
+// Cached bundles are only ever cloned into a ROB, so one copy can
+// serve all hardware threads (and cores) running the same binary.
+struct VanadisSharedUopCache {
+    VanadisSharedUopCache(const size_t entries) : lru_cache(entries), users(0) {}
+
+    ~VanadisSharedUopCache() {
+        for(auto infinite_itr = infinite_cache.cbegin(); infinite_itr != infinite_cache.cend(); infinite_itr++) {
+            delete infinite_itr->second;
+        }
+    }
+
+    VanadisUopCache lru_cache;
+    std::unordered_map<uint64_t, VanadisInstructionBundle*> infinite_cache;
+    uint32_t users;
+};
+
 class VanadisInstructionLoader {
 public:
     VanadisInstructionLoader(const size_t uop_cache_size, const size_t predecode_cache_entries,
                              const uint64_t cachelinewidth) {
 
         cache_line_width = cachelinewidth;
-        uop_cache = new VanadisCache<uint64_t, VanadisInstructionBundle*, SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE>(uop_cache_size);
+        uop_cache = new VanadisUopCache(uop_cache_size);
         predecode_cache = new VanadisCache<uint64_t, uint8_t*, SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY>(predecode_cache_entries);
+        infinite_uop_cache = &private_infinite_uop_cache;
+        shared_uop_cache = nullptr;
 
         mem_if = nullptr;
 
@@ -53,10 +79,33 @@ public:
     }
 
     ~VanadisInstructionLoader() {
-        delete uop_cache;
+        if(nullptr == shared_uop_cache) {
+            delete uop_cache;
+        } else {
+            releaseSharedUopCache();
+        }
+
         delete predecode_cache;
     }
 
+    // Use the uop cache of the named group instead of a private one.
+    // Groups are per simulation thread, so no locking is needed on
+    // the lookup path.  The first loader to join sets the size.
+    void shareUopCache(const std::string& group, const size_t uop_cache_size) {
+        joinSharedUopCache(group, "", uop_cache_size);
+    }
+
+    // Bundles are keyed by virtual address, so within a group only
+    // hardware threads running the same image (binary and process)
+    // may share a cache.  Called whenever the OS starts a thread.
+    void setImage(const std::string& image) {
+        if(nullptr == shared_uop_cache || image == std::get<1>(shared_uop_key)) {
+            return;
+        }
+
+        joinSharedUopCache(std::get<0>(shared_uop_key), image, uop_cache->capacity());
+    }
+
     void setLoaderMode(const VanadisInstructionLoaderMode new_loader_mode) {
         loader_mode = new_loader_mode;
         switchLoaderMode();
@@ -213,15 +262,19 @@ public:
         } break;
         case VanadisInstructionLoaderMode::INFINITE_CACHE_MODE:
         {
-            infinite_uop_cache.insert(std::pair<uint64_t, VanadisInstructionBundle*>(bundle->getInstructionAddress(), bundle));
+            infinite_uop_cache->insert(std::pair<uint64_t, VanadisInstructionBundle*>(bundle->getInstructionAddress(), bundle));
         } break;
         }
     }
 
     void clearCache() {
-        uop_cache->clear();
+        // Other threads are still decoding out of a shared cache, so
+        // only the private state is thrown away
+        if(nullptr == shared_uop_cache) {
+            uop_cache->clear();
+            infinite_uop_cache->clear();
+        }
         predecode_cache->clear();
-        infinite_uop_cache.clear();
     }
 
     bool hasBundleAt(const uint64_t addr) const {
@@ -232,7 +285,7 @@ public:
         } break;
         case VanadisInstructionLoaderMode::INFINITE_CACHE_MODE:
         {
-            return !(infinite_uop_cache.find(addr) == infinite_uop_cache.end());
+            return !(infinite_uop_cache->find(addr) == infinite_uop_cache->end());
         } break;
         }
         assert(0);
@@ -258,7 +311,7 @@ public:
         } break;
         case VanadisInstructionLoaderMode::INFINITE_CACHE_MODE:
         {
-            return infinite_uop_cache.find(addr)->second;
+            return infinite_uop_cache->find(addr)->second;
         } break;
         }
         assert(0);
@@ -354,14 +407,66 @@ private:
 		}
 	}
 
+    typedef std::tuple<std::string, std::string, std::thread::id> VanadisSharedUopKey;
+
+    static std::map<VanadisSharedUopKey, VanadisSharedUopCache*>& sharedUopCaches() {
+        static std::map<VanadisSharedUopKey, VanadisSharedUopCache*> caches;
+        return caches;
+    }
+
+    static std::mutex& sharedUopCacheMutex() {
+        static std::mutex cache_mutex;
+        return cache_mutex;
+    }
+
+    void joinSharedUopCache(const std::string& group, const std::string& image, const size_t uop_cache_size) {
+        if(nullptr == shared_uop_cache) {
+            switchLoaderMode();
+            delete uop_cache;
+        } else {
+            releaseSharedUopCache();
+        }
+
+        std::lock_guard<std::mutex> lock(sharedUopCacheMutex());
+        auto key = std::make_tuple(group, image, std::this_thread::get_id());
+        auto group_itr = sharedUopCaches().find(key);
+
+        if(group_itr == sharedUopCaches().end()) {
+            group_itr = sharedUopCaches().insert(std::make_pair(key, new VanadisSharedUopCache(uop_cache_size))).first;
+        }
+
+        shared_uop_cache = group_itr->second;
+        shared_uop_cache->users++;
+        shared_uop_key = key;
+
+        uop_cache = &shared_uop_cache->lru_cache;
+        infinite_uop_cache = &shared_uop_cache->infinite_cache;
+    }
+
+    void releaseSharedUopCache() {
+        std::lock_guard<std::mutex> lock(sharedUopCacheMutex());
+
+        if(0 == --shared_uop_cache->users) {
+            sharedUopCaches().erase(shared_uop_key);
+            delete shared_uop_cache;
+        }
+
+        shared_uop_cache = nullptr;
+    }
+
     void switchLoaderMode() {
+        // a shared cache is left alone, other loaders may be using it
+        if(nullptr != shared_uop_cache) {
+            return;
+        }
+
         // clear the infinite cache so we get fresh entries
-        for(auto infinite_itr = infinite_uop_cache.cbegin(); infinite_itr != infinite_uop_cache.cend(); infinite_itr++) {
+        for(auto infinite_itr = infinite_uop_cache->cbegin(); infinite_itr != infinite_uop_cache->cend(); infinite_itr++) {
             // delete all the bundles which have been cached to save memory, this could be substantial in very large executables
             delete infinite_itr->second;
         }
 
-        infinite_uop_cache.clear();
+        infinite_uop_cache->clear();
 
         // any additional mode-specific clean up which is needed
         switch(loader_mode) {
@@ -377,10 +482,14 @@ private:
     uint64_t cache_line_width;
     SST::Interfaces::StandardMem* mem_if;
 
-    VanadisCache<uint64_t, VanadisInstructionBundle*, SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE>* uop_cache;
+    VanadisUopCache* uop_cache;
     VanadisCache<uint64_t, uint8_t*, SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY>* predecode_cache;
 
-    std::unordered_map<uint64_t, VanadisInstructionBundle*> infinite_uop_cache;
+    std::unordered_map<uint64_t, VanadisInstructionBundle*>* infinite_uop_cache;
+    std::unordered_map<uint64_t, VanadisInstructionBundle*> private_infinite_uop_cache;
+
+    VanadisSharedUopCache* shared_uop_cache;
+    VanadisSharedUopKey shared_uop_key;
 
     std::unordered_map<SST::Interfaces::StandardMem::Request::id_t, SST::Interfaces::StandardMem::Read*> pending_loads;
 
@@ -0,0 +1,116 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_ISSUE_QUEUE
+#define _H_VANADIS_ISSUE_QUEUE
+
+#include "datastruct/cqueue.h"
+#include "inst/vinst.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Per-thread scheduling state for the issue stage.
+//
+// Holds the micro-ops in the ROB that have not issued yet, in program
+// order, so the issue stage only visits instructions that can still
+// issue instead of walking every ROB entry each cycle. Instructions
+// that have issued but not retired only matter to the issue checks
+// through the ISA registers they write; those are kept as per-register
+// counts, updated at issue and retire, which the issue stage turns
+// into its register-write marks at the start of each cycle.
+class VanadisIssueQueue {
+public:
+    VanadisIssueQueue(const uint16_t int_reg_count, const uint16_t fp_reg_count) :
+        int_writers(int_reg_count, 0),
+        fp_writers(fp_reg_count, 0),
+        rob_pushes_seen(0)
+    {}
+
+    // Pick up anything the decoder has added to the tail of the ROB
+    void collect(VanadisCircularQueue<VanadisInstruction*>* rob) {
+        const uint64_t new_entries = rob->pushed() - rob_pushes_seen;
+        const size_t   rob_size    = rob->size();
+
+        for ( size_t i = rob_size - new_entries; i < rob_size; ++i ) {
+            waiting.push_back(rob->peekAt(i));
+        }
+
+        rob_pushes_seen = rob->pushed();
+    }
+
+    size_t size() const { return waiting.size(); }
+    VanadisInstruction* at(const size_t index) const { return waiting[index]; }
+
+    // Instruction at index has issued, stop tracking it as waiting and
+    // count its writes until it retires
+    void issue(const size_t index) {
+        VanadisInstruction* ins = waiting[index];
+
+        for ( uint16_t i = 0; i < ins->countISAIntRegOut(); ++i ) {
+            int_writers[ins->getISAIntRegOut(i)]++;
+        }
+        for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+            fp_writers[ins->getISAFPRegOut(i)]++;
+        }
+
+        waiting.erase(waiting.begin() + index);
+    }
+
+    void retire(VanadisInstruction* ins) {
+        for ( uint16_t i = 0; i < ins->countISAIntRegOut(); ++i ) {
+            int_writers[ins->getISAIntRegOut(i)]--;
+        }
+        for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+            fp_writers[ins->getISAFPRegOut(i)]--;
+        }
+    }
+
+    // The ROB for this thread has been emptied
+    void clear(VanadisCircularQueue<VanadisInstruction*>* rob) {
+        waiting.clear();
+        std::fill(int_writers.begin(), int_writers.end(), 0);
+        std::fill(fp_writers.begin(), fp_writers.end(), 0);
+        rob_pushes_seen = rob->pushed();
+    }
+
+    // Set the marks for ISA registers written by issued, unretired instructions
+    void markInFlightWrites(uint8_t* int_reg_write, const uint16_t int_reg_count, uint8_t* fp_reg_write,
+        const uint16_t fp_reg_count) const
+    {
+        for ( uint16_t i = 0; i < int_reg_count; ++i ) {
+            int_reg_write[i] = (int_writers[i] > 0) ? 1 : 0;
+        }
+        for ( uint16_t i = 0; i < fp_reg_count; ++i ) {
+            fp_reg_write[i] = (fp_writers[i] > 0) ? 1 : 0;
+        }
+    }
+
+private:
+    std::vector<VanadisInstruction*> waiting;
+    std::vector<uint32_t>            int_writers;
+    std::vector<uint32_t>            fp_writers;
+    uint64_t                         rob_pushes_seen;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,198 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_SAMPLER
+#define _H_VANADIS_SAMPLER
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+enum VanadisSamplePhase {
+    VANADIS_SAMPLE_FAST_FORWARD,
+    VANADIS_SAMPLE_WARMUP,
+    VANADIS_SAMPLE_MEASURE
+};
+
+// A detailed window, 'start' and 'length' are in retired instructions.
+// The weight is only used for SimPoint windows.
+struct VanadisSampleWindow {
+    uint64_t start;
+    uint64_t length;
+    double   weight;
+};
+
+struct VanadisSampleSummary {
+    uint64_t windows;
+    double   cpi;
+    // Half width of the 95% confidence interval on the CPI, negative if
+    // there is no interval (SimPoint, or fewer than two windows)
+    double   cpi_error;
+};
+
+// Decides which parts of the run are simulated in detail.
+//
+// Periodic sampling (SMARTS) splits the run into periods of a fixed
+// number of instructions and measures the last 'length' instructions
+// of each period. SimPoint sampling measures the intervals listed by
+// SimPoint and weights them by cluster size. In both cases the core
+// runs in detail for 'warmup' instructions before each measurement to
+// refill the pipeline, and fast-forwards everywhere else.
+//
+// The core calls advance() once per cycle with the number of
+// instructions it retired in that cycle and checks phase() to decide
+// how to run the next one.
+class VanadisSampler {
+public:
+    // Periodic sampling
+    VanadisSampler(const uint64_t period, const uint64_t warmup, const uint64_t length) :
+        sample_period(period),
+        warmup_length(warmup),
+        next_window(0)
+    {
+        selectNextWindow(length);
+        updatePhase();
+    }
+
+    // SimPoint sampling, windows must be sorted by start
+    VanadisSampler(const uint64_t warmup, const std::vector<VanadisSampleWindow>& windows) :
+        sample_period(0),
+        warmup_length(warmup),
+        simpoints(windows),
+        next_window(0)
+    {
+        selectNextWindow(0);
+        updatePhase();
+    }
+
+    VanadisSamplePhase phase() const { return current_phase; }
+    bool               detailed() const { return current_phase != VANADIS_SAMPLE_FAST_FORWARD; }
+    bool               periodic() const { return sample_period > 0; }
+    uint64_t           instructionCount() const { return instructions; }
+
+    void advance(const uint64_t retired) {
+        instructions += retired;
+
+        if ( VANADIS_SAMPLE_MEASURE == current_phase ) {
+            window_cycles++;
+            window_instructions += retired;
+
+            if ( window_instructions < window.length ) { return; }
+
+            measured_cpi.push_back((double)window_cycles / (double)window_instructions);
+            measured_weight.push_back(window.weight);
+
+            selectNextWindow(window.length);
+        }
+
+        updatePhase();
+    }
+
+    VanadisSampleSummary summarize() const {
+        VanadisSampleSummary summary;
+        summary.windows   = measured_cpi.size();
+        summary.cpi       = 0;
+        summary.cpi_error = -1;
+
+        if ( measured_cpi.empty() ) { return summary; }
+
+        double total_weight = 0;
+        for ( size_t i = 0; i < measured_cpi.size(); ++i ) {
+            summary.cpi += measured_weight[i] * measured_cpi[i];
+            total_weight += measured_weight[i];
+        }
+        summary.cpi = (total_weight > 0) ? summary.cpi / total_weight : 0;
+
+        // SimPoint picks windows by clustering, not at random, so there is
+        // no sampling error to put an interval on
+        if ( periodic() && measured_cpi.size() > 1 ) {
+            const size_t n        = measured_cpi.size();
+            double       variance = 0;
+
+            for ( size_t i = 0; i < n; ++i ) {
+                variance += (measured_cpi[i] - summary.cpi) * (measured_cpi[i] - summary.cpi);
+            }
+            variance /= (double)(n - 1);
+
+            summary.cpi_error = studentT95(n - 1) * std::sqrt(variance / (double)n);
+        }
+
+        return summary;
+    }
+
+private:
+    // Two-sided 95% critical values of Student's t
+    static double studentT95(const size_t degrees) {
+        static const double table[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                        2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                        2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+
+        return (degrees <= 30) ? table[degrees - 1] : 1.960;
+    }
+
+    void selectNextWindow(const uint64_t length) {
+        if ( periodic() ) {
+            // Skip any period whose window we have already run past
+            do {
+                window.start  = (next_window + 1) * sample_period - length;
+                window.length = length;
+                window.weight = 1.0;
+                next_window++;
+            } while ( window.start < instructions );
+        } else if ( next_window < simpoints.size() ) {
+            window = simpoints[next_window++];
+        } else {
+            window.start  = std::numeric_limits<uint64_t>::max();
+            window.length = 0;
+            window.weight = 0;
+        }
+    }
+
+    void updatePhase() {
+        if ( instructions >= window.start ) {
+            current_phase       = VANADIS_SAMPLE_MEASURE;
+            window_cycles       = 0;
+            window_instructions = 0;
+        } else if ( window.start - instructions <= warmup_length ) {
+            current_phase = VANADIS_SAMPLE_WARMUP;
+        } else {
+            current_phase = VANADIS_SAMPLE_FAST_FORWARD;
+        }
+    }
+
+    const uint64_t                   sample_period;
+    const uint64_t                   warmup_length;
+    std::vector<VanadisSampleWindow> simpoints;
+    size_t                           next_window;
+
+    VanadisSamplePhase  current_phase       = VANADIS_SAMPLE_FAST_FORWARD;
+    VanadisSampleWindow window              = { 0, 0, 0 };
+    uint64_t            instructions        = 0;
+    uint64_t            window_cycles       = 0;
+    uint64_t            window_instructions = 0;
+
+    std::vector<double> measured_cpi;
+    std::vector<double> measured_weight;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif